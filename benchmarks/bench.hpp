@@ -0,0 +1,438 @@
+/// @file bench.hpp Harness of the <T>LAPACK benchmarks.
+//
+// Copyright (c) 2021, University of Colorado Denver. All rights reserved.
+//
+// This file is part of <T>LAPACK.
+// <T>LAPACK is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef __TLAPACK_BENCH_HH__
+#define __TLAPACK_BENCH_HH__
+
+// Plugins must be loaded before <T>LAPACK
+#ifdef TLAPACK_BENCH_EIGEN
+    #include <plugins/tlapack_eigen.hpp>
+    #include <Eigen/Dense>
+#endif
+#include <plugins/tlapack_mdspan.hpp>
+#include <slate_api/blas/mdspan.hpp>
+
+// Flop counts of the BLAS++ and LAPACK++ testers. They also load the
+// pointer interface of <T>BLAS and <T>LAPACK.
+#include <blas/flops.hh>
+#include <lapack/flops.hh>
+
+#include <tlapack.hpp>
+
+#include <chrono>
+#include <complex>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace bench {
+
+using idx_t = std::size_t;
+
+/// Sizes of a problem, as defined by each routine
+struct dims_t {
+    idx_t m, n, k;
+};
+
+/// Measurement of a routine
+struct result_t {
+    std::string routine;
+    char type;              ///< 's', 'd', 'c' or 'z'
+    std::string backend;    ///< "pointer", "mdspan" or "eigen"
+    dims_t dims;
+    double time;            ///< Best time of all runs, in seconds
+    double time_avg;        ///< Average time of all runs, in seconds
+    double gflop;           ///< Number of Gflop, or 0 if it is not known
+};
+
+/// Options of the benchmark driver
+struct options_t {
+    std::vector<idx_t> sizes = { 64, 128, 256, 512, 1024 };
+    std::vector<std::string> routines;  ///< All routines if empty
+    std::string types    = "sdcz";
+    std::vector<std::string> backends = { "pointer", "mdspan", "eigen" };
+    int nruns = 5;          ///< Number of measured runs
+    double min_time = 1e-3; ///< Minimum duration of a run, in seconds
+    std::string json;       ///< Output file, or nothing
+    bool verbose = true;
+};
+
+class context_t;
+
+/// Benchmark of a routine, one function per type: s, d, c and z.
+/// A null function means that the routine is not defined for the type.
+struct routine_t {
+    const char* name;
+    void (*run[4])( context_t& );
+};
+
+#define TLAPACK_BENCH( f ) \
+    bench::routine_t{ #f, { \
+        &bench_##f< float >, \
+        &bench_##f< double >, \
+        &bench_##f< std::complex<float> >, \
+        &bench_##f< std::complex<double> > } }
+
+#define TLAPACK_BENCH_REAL( f ) \
+    bench::routine_t{ #f, { \
+        &bench_##f< float >, \
+        &bench_##f< double >, \
+        nullptr, nullptr } }
+
+std::vector< routine_t > blas_routines();
+std::vector< routine_t > lapack_routines();
+
+// -----------------------------------------------------------------------------
+// Back-ends
+
+/// Column-major matrix in a std::vector seen through an mdspan
+template< class T >
+struct mdspan_matrix {
+    std::vector<T> data;
+    idx_t ld;
+    decltype( blas::internal::colmajor_matrix<T>( nullptr, 0, 0 ) ) view;
+
+    mdspan_matrix( idx_t m, idx_t n )
+    : data( m*n ), ld( (m > 0) ? m : 1 ),
+      view( blas::internal::colmajor_matrix<T>( data.data(), m, n, ld ) ) {}
+
+    mdspan_matrix( mdspan_matrix&& ) = default;
+    mdspan_matrix( const mdspan_matrix& ) = delete;
+
+    T* ptr() { return data.data(); }
+};
+
+/// Vector in a std::vector seen through an mdspan
+template< class T >
+struct mdspan_vector {
+    std::vector<T> data;
+    decltype( blas::internal::vector<T>( nullptr, 0 ) ) view;
+
+    mdspan_vector( idx_t n )
+    : data( n ), view( blas::internal::vector<T>( data.data(), n ) ) {}
+
+    mdspan_vector( mdspan_vector&& ) = default;
+    mdspan_vector( const mdspan_vector& ) = delete;
+
+    T* ptr() { return data.data(); }
+};
+
+/// Range of matrices for the batched routines
+template< class matrix_t >
+struct mdspan_range {
+    std::vector< matrix_t > matrices;
+    std::vector< decltype( std::declval<matrix_t&>().view ) > view;
+
+    mdspan_range( idx_t count, idx_t m, idx_t n ) {
+        matrices.reserve( count );
+        for( idx_t p = 0; p < count; ++p ) {
+            matrices.emplace_back( m, n );
+            view.push_back( matrices.back().view );
+        }
+    }
+};
+
+/// Generic interface on std::experimental::mdspan
+template< class T >
+struct mdspan_backend {
+    static const char* name() { return "mdspan"; }
+
+    mdspan_matrix<T> matrix( idx_t m, idx_t n ) { return { m, n }; }
+    mdspan_vector<T> vector( idx_t n ) { return { n }; }
+    mdspan_vector<idx_t> index_vector( idx_t n ) { return { n }; }
+    mdspan_range< mdspan_matrix<T> > matrix_range( idx_t count, idx_t m, idx_t n )
+        { return { count, m, n }; }
+};
+
+/// Pointer interface of <T>BLAS and <T>LAPACK, i.e., the slate_api.
+/// The data is stored as in mdspan_backend, and the benchmark passes
+/// ptr() and ld to the routines.
+template< class T >
+struct pointer_backend {
+    static const char* name() { return "pointer"; }
+
+    mdspan_matrix<T> matrix( idx_t m, idx_t n ) { return { m, n }; }
+    mdspan_vector<T> vector( idx_t n ) { return { n }; }
+    mdspan_vector<blas::int_t> index_vector( idx_t n ) { return { n }; }
+};
+
+#ifdef TLAPACK_BENCH_EIGEN
+
+template< class T >
+struct eigen_matrix {
+    Eigen::Matrix< T, Eigen::Dynamic, Eigen::Dynamic > view;
+    eigen_matrix( idx_t m, idx_t n ) : view( m, n ) {}
+};
+
+template< class T >
+struct eigen_vector {
+    Eigen::Matrix< T, Eigen::Dynamic, 1 > view;
+    eigen_vector( idx_t n ) : view( n ) {}
+};
+
+template< class T >
+struct eigen_range {
+    std::vector< Eigen::Matrix< T, Eigen::Dynamic, Eigen::Dynamic > > view;
+    eigen_range( idx_t count, idx_t m, idx_t n )
+    : view( count, Eigen::Matrix< T, Eigen::Dynamic, Eigen::Dynamic >( m, n ) ) {}
+};
+
+/// Generic interface on Eigen matrices
+template< class T >
+struct eigen_backend {
+    static const char* name() { return "eigen"; }
+
+    eigen_matrix<T> matrix( idx_t m, idx_t n ) { return { m, n }; }
+    eigen_vector<T> vector( idx_t n ) { return { n }; }
+    eigen_vector<Eigen::Index> index_vector( idx_t n ) { return { n }; }
+    eigen_range<T> matrix_range( idx_t count, idx_t m, idx_t n )
+        { return { count, m, n }; }
+};
+
+#endif // TLAPACK_BENCH_EIGEN
+
+// -----------------------------------------------------------------------------
+// Data
+
+/// Type character, as in the names of the BLAS routines
+template< class T > constexpr char type_char() { return lapack::tuning_type<T>(); }
+
+/// Random number in [-1,1], or in the square [-1,1]x[-1,1] if T is complex
+template< class T >
+struct random_scalar {
+    static T get( std::mt19937& gen ) {
+        std::uniform_real_distribution<T> dist( -1, 1 );
+        return dist( gen );
+    }
+};
+template< class T >
+struct random_scalar< std::complex<T> > {
+    static std::complex<T> get( std::mt19937& gen ) {
+        std::uniform_real_distribution<T> dist( -1, 1 );
+        const T re = dist( gen );
+        return std::complex<T>( re, dist( gen ) );
+    }
+};
+
+/// Fills the matrix A with random numbers
+template< class matrix_t >
+void random_matrix( matrix_t& A, std::mt19937& gen )
+{
+    using T = blas::type_t< matrix_t >;
+    for( idx_t j = 0; j < idx_t( blas::ncols(A) ); ++j )
+        for( idx_t i = 0; i < idx_t( blas::nrows(A) ); ++i )
+            A(i,j) = random_scalar<T>::get( gen );
+}
+
+/// Fills the vector x with random numbers
+template< class vector_t >
+void random_vector( vector_t& x, std::mt19937& gen )
+{
+    using T = blas::type_t< vector_t >;
+    for( idx_t i = 0; i < idx_t( blas::size(x) ); ++i )
+        x[i] = random_scalar<T>::get( gen );
+}
+
+/// Fills the matrix A with random numbers and adds n to its diagonal, so
+/// that its triangles and A itself are well conditioned
+template< class matrix_t >
+void random_dominant( matrix_t& A, std::mt19937& gen )
+{
+    random_matrix( A, gen );
+    const idx_t n = std::min<idx_t>( blas::nrows(A), blas::ncols(A) );
+    for( idx_t i = 0; i < n; ++i )
+        A(i,i) += blas::real_type< blas::type_t< matrix_t > >( n );
+}
+
+/// Fills the square matrix A with a random Hermitian positive definite
+/// matrix
+template< class matrix_t >
+void random_hpd( matrix_t& A, std::mt19937& gen )
+{
+    using blas::conj;
+    using blas::real;
+
+    random_dominant( A, gen );
+    const idx_t n = blas::nrows(A);
+    for( idx_t j = 0; j < n; ++j ) {
+        A(j,j) = real( A(j,j) );
+        for( idx_t i = j+1; i < n; ++i )
+            A(j,i) = conj( A(i,j) );
+    }
+}
+
+/// Makes a value visible to the compiler as used, so that the call that
+/// computed it is not removed
+template< class T >
+inline void keep( const T& x )
+{
+    #ifdef __GNUC__
+        asm volatile( "" : : "g"( &x ) : "memory" );
+    #else
+        static char sink;
+        volatile char* p = &sink;
+        *p = *reinterpret_cast< const volatile char* >( &x );
+        (void) *p;
+    #endif
+}
+
+// -----------------------------------------------------------------------------
+// Driver
+
+/** Runs the benchmarks of a routine on all selected back-ends.
+ *
+ * Each benchmark is written as a function of the back-end B, which creates
+ * the data, and of a timer, which is called with the operation to measure:
+ *
+ *     ctx.run<T>( "gemm", {m,n,k}, blas::Gflop<T>::gemm(m,n,k),
+ *         [&]( auto& B, auto&& time ) {
+ *             auto A = B.matrix( m, k );
+ *             ...
+ *             time( [&]() { blas::gemm( ..., A.view, ... ); } );
+ *         } );
+ *
+ * time( call ) repeats call until each run lasts at least min_time seconds.
+ * time( reset, call ) calls reset before each call, without measuring it.
+ * It must be used for routines that overwrite their input.
+ *
+ * The first function receives the generic back-ends (mdspan and Eigen). The
+ * optional second function receives the pointer back-end.
+ */
+class context_t {
+public:
+    options_t opts;
+    std::vector< result_t > results;
+    std::mt19937 gen;
+
+    explicit context_t( const options_t& o ) : opts( o ), gen( 3 ) {}
+
+    bool has_backend( const char* name ) const {
+        for( const auto& b : opts.backends )
+            if( b == name ) return true;
+        return false;
+    }
+
+    template< class T, class generic_f, class pointer_f >
+    void run( const char* routine, dims_t dims, double gflop,
+              generic_f&& generic, pointer_f&& pointer )
+    {
+        if( has_backend( "pointer" ) ) {
+            pointer_backend<T> B;
+            pointer( B, timer_t<T>{ *this, routine, B.name(), dims, gflop } );
+        }
+        run<T>( routine, dims, gflop, generic );
+    }
+
+    template< class T, class generic_f >
+    void run( const char* routine, dims_t dims, double gflop,
+              generic_f&& generic )
+    {
+        if( has_backend( "mdspan" ) ) {
+            mdspan_backend<T> B;
+            generic( B, timer_t<T>{ *this, routine, B.name(), dims, gflop } );
+        }
+        #ifdef TLAPACK_BENCH_EIGEN
+        if( has_backend( "eigen" ) ) {
+            eigen_backend<T> B;
+            generic( B, timer_t<T>{ *this, routine, B.name(), dims, gflop } );
+        }
+        #endif
+    }
+
+private:
+
+    using clock = std::chrono::steady_clock;
+
+    template< class T >
+    struct timer_t {
+        context_t& ctx;
+        const char* routine;
+        const char* backend;
+        dims_t dims;
+        double gflop;
+
+        template< class call_t >
+        void operator()( call_t&& call ) const {
+            // Number of calls per run
+            auto start = clock::now();
+            call();
+            double t = std::chrono::duration<double>( clock::now() - start ).count();
+            const long reps = ( t > 0 && t < ctx.opts.min_time )
+                ? long( ctx.opts.min_time / t ) + 1 : 1;
+
+            std::vector<double> times;
+            for( int r = 0; r < ctx.opts.nruns; ++r ) {
+                start = clock::now();
+                for( long i = 0; i < reps; ++i )
+                    call();
+                t = std::chrono::duration<double>( clock::now() - start ).count();
+                times.push_back( t / reps );
+            }
+            ctx.record<T>( routine, backend, dims, gflop, times );
+        }
+
+        template< class reset_t, class call_t >
+        void operator()( reset_t&& reset, call_t&& call ) const {
+            // Warm up
+            reset();
+            call();
+
+            std::vector<double> times;
+            for( int r = 0; r < ctx.opts.nruns; ++r ) {
+                reset();
+                const auto start = clock::now();
+                call();
+                times.push_back(
+                    std::chrono::duration<double>( clock::now() - start ).count() );
+            }
+            ctx.record<T>( routine, backend, dims, gflop, times );
+        }
+    };
+
+    template< class T >
+    void record(
+        const char* routine, const char* backend, dims_t dims, double gflop,
+        const std::vector<double>& times );
+};
+
+/// Prints the header of the table of results
+void print_header();
+
+/// Prints a result as a line of the table
+void print_result( const result_t& r );
+
+/// Writes the results to a JSON file
+bool write_json( const std::string& file, const context_t& ctx );
+
+template< class T >
+void context_t::record(
+    const char* routine, const char* backend, dims_t dims, double gflop,
+    const std::vector<double>& times )
+{
+    result_t r;
+    r.routine = routine;
+    r.type = type_char<T>();
+    r.backend = backend;
+    r.dims = dims;
+    r.gflop = gflop;
+    r.time = times[0];
+    r.time_avg = 0;
+    for( double t : times ) {
+        if( t < r.time ) r.time = t;
+        r.time_avg += t;
+    }
+    r.time_avg /= times.size();
+
+    results.push_back( r );
+    if( opts.verbose )
+        print_result( r );
+}
+
+} // namespace bench
+
+#endif // __TLAPACK_BENCH_HH__
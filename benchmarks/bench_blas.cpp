@@ -0,0 +1,980 @@
+/// @file bench_blas.cpp Benchmarks of the routines in tblas.hpp.
+//
+// Copyright (c) 2021, University of Colorado Denver. All rights reserved.
+//
+// This file is part of <T>LAPACK.
+// <T>LAPACK is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+//
+// The Level 1 routines run on vectors of length n^2, i.e., on as many
+// entries as the other routines on n-by-n matrices. The batched routines run
+// on n problems of size 16.
+
+#include "bench.hpp"
+
+namespace bench {
+
+using blas::Layout;
+using blas::Op;
+using blas::Uplo;
+using blas::Side;
+using blas::Diag;
+
+/// Size of the problems of the batched routines
+const idx_t batch_size = 16;
+
+/// Gflop of a plane rotation applied to vectors of length n
+template< class T >
+double gflop_rot( double n ) {
+    return 1e-9 * ( blas::FlopTraits<T>::mul_ops * 4*n
+                  + blas::FlopTraits<T>::add_ops * 2*n );
+}
+
+// -----------------------------------------------------------------------------
+// Level 1 BLAS
+
+template< class T >
+void bench_asum( context_t& ctx )
+{
+    for( idx_t n : ctx.opts.sizes ) {
+        const idx_t N = n*n;
+        ctx.run<T>( "asum", {N,1,1}, blas::Gflop<T>::asum(N),
+            [&]( auto& B, auto&& time ) {
+                auto x = B.vector( N );
+                random_vector( x.view, ctx.gen );
+                time( [&]() { keep( blas::asum( x.view ) ); } );
+            },
+            [&]( auto& B, auto&& time ) {
+                auto x = B.vector( N );
+                random_vector( x.view, ctx.gen );
+                time( [&]() { keep( blas::asum( N, x.ptr(), 1 ) ); } );
+            } );
+    }
+}
+
+template< class T >
+void bench_axpy( context_t& ctx )
+{
+    const T alpha = T( 0.5 );
+    for( idx_t n : ctx.opts.sizes ) {
+        const idx_t N = n*n;
+        ctx.run<T>( "axpy", {N,1,1}, blas::Gflop<T>::axpy(N),
+            [&]( auto& B, auto&& time ) {
+                auto x = B.vector( N );
+                auto y = B.vector( N );
+                random_vector( x.view, ctx.gen );
+                random_vector( y.view, ctx.gen );
+                time( [&]() { blas::axpy( alpha, x.view, y.view ); } );
+            },
+            [&]( auto& B, auto&& time ) {
+                auto x = B.vector( N );
+                auto y = B.vector( N );
+                random_vector( x.view, ctx.gen );
+                random_vector( y.view, ctx.gen );
+                time( [&]() { blas::axpy( N, alpha, x.ptr(), 1, y.ptr(), 1 ); } );
+            } );
+    }
+}
+
+template< class T >
+void bench_copy( context_t& ctx )
+{
+    for( idx_t n : ctx.opts.sizes ) {
+        const idx_t N = n*n;
+        ctx.run<T>( "copy", {N,1,1}, blas::Gflop<T>::copy(N),
+            [&]( auto& B, auto&& time ) {
+                auto x = B.vector( N );
+                auto y = B.vector( N );
+                random_vector( x.view, ctx.gen );
+                time( [&]() { blas::copy( x.view, y.view ); } );
+            },
+            [&]( auto& B, auto&& time ) {
+                auto x = B.vector( N );
+                auto y = B.vector( N );
+                random_vector( x.view, ctx.gen );
+                time( [&]() { blas::copy( N, x.ptr(), 1, y.ptr(), 1 ); } );
+            } );
+    }
+}
+
+template< class T >
+void bench_dot( context_t& ctx )
+{
+    for( idx_t n : ctx.opts.sizes ) {
+        const idx_t N = n*n;
+        ctx.run<T>( "dot", {N,1,1}, blas::Gflop<T>::dot(N),
+            [&]( auto& B, auto&& time ) {
+                auto x = B.vector( N );
+                auto y = B.vector( N );
+                random_vector( x.view, ctx.gen );
+                random_vector( y.view, ctx.gen );
+                time( [&]() { keep( blas::dot( x.view, y.view ) ); } );
+            },
+            [&]( auto& B, auto&& time ) {
+                auto x = B.vector( N );
+                auto y = B.vector( N );
+                random_vector( x.view, ctx.gen );
+                random_vector( y.view, ctx.gen );
+                time( [&]() { keep( blas::dot( N, x.ptr(), 1, y.ptr(), 1 ) ); } );
+            } );
+    }
+}
+
+template< class T >
+void bench_dotu( context_t& ctx )
+{
+    for( idx_t n : ctx.opts.sizes ) {
+        const idx_t N = n*n;
+        ctx.run<T>( "dotu", {N,1,1}, blas::Gflop<T>::dot(N),
+            [&]( auto& B, auto&& time ) {
+                auto x = B.vector( N );
+                auto y = B.vector( N );
+                random_vector( x.view, ctx.gen );
+                random_vector( y.view, ctx.gen );
+                time( [&]() { keep( blas::dotu( x.view, y.view ) ); } );
+            },
+            [&]( auto& B, auto&& time ) {
+                auto x = B.vector( N );
+                auto y = B.vector( N );
+                random_vector( x.view, ctx.gen );
+                random_vector( y.view, ctx.gen );
+                time( [&]() { keep( blas::dotu( N, x.ptr(), 1, y.ptr(), 1 ) ); } );
+            } );
+    }
+}
+
+template< class T >
+void bench_iamax( context_t& ctx )
+{
+    for( idx_t n : ctx.opts.sizes ) {
+        const idx_t N = n*n;
+        ctx.run<T>( "iamax", {N,1,1}, blas::Gflop<T>::iamax(N),
+            [&]( auto& B, auto&& time ) {
+                auto x = B.vector( N );
+                random_vector( x.view, ctx.gen );
+                time( [&]() { keep( blas::iamax( x.view ) ); } );
+            },
+            [&]( auto& B, auto&& time ) {
+                auto x = B.vector( N );
+                random_vector( x.view, ctx.gen );
+                time( [&]() { keep( blas::iamax( N, x.ptr(), 1 ) ); } );
+            } );
+    }
+}
+
+template< class T >
+void bench_nrm2( context_t& ctx )
+{
+    for( idx_t n : ctx.opts.sizes ) {
+        const idx_t N = n*n;
+        ctx.run<T>( "nrm2", {N,1,1}, blas::Gflop<T>::nrm2(N),
+            [&]( auto& B, auto&& time ) {
+                auto x = B.vector( N );
+                random_vector( x.view, ctx.gen );
+                time( [&]() { keep( blas::nrm2( x.view ) ); } );
+            },
+            [&]( auto& B, auto&& time ) {
+                auto x = B.vector( N );
+                random_vector( x.view, ctx.gen );
+                time( [&]() { keep( blas::nrm2( N, x.ptr(), 1 ) ); } );
+            } );
+    }
+}
+
+template< class T >
+void bench_rot( context_t& ctx )
+{
+    using real_t = blas::real_type<T>;
+    const real_t c = real_t( 0.6 );
+    const real_t s = real_t( 0.8 );
+    for( idx_t n : ctx.opts.sizes ) {
+        const idx_t N = n*n;
+        ctx.run<T>( "rot", {N,1,1}, gflop_rot<T>(N),
+            [&]( auto& B, auto&& time ) {
+                auto x = B.vector( N );
+                auto y = B.vector( N );
+                random_vector( x.view, ctx.gen );
+                random_vector( y.view, ctx.gen );
+                time( [&]() { blas::rot( x.view, y.view, c, s ); } );
+            },
+            [&]( auto& B, auto&& time ) {
+                auto x = B.vector( N );
+                auto y = B.vector( N );
+                random_vector( x.view, ctx.gen );
+                random_vector( y.view, ctx.gen );
+                time( [&]() { blas::rot( N, x.ptr(), 1, y.ptr(), 1, c, T(s) ); } );
+            } );
+    }
+}
+
+template< class T >
+void bench_rotm( context_t& ctx )
+{
+    const T H[4]     = { T(0.6), T(-0.8), T(0.8), T(0.6) };
+    const T param[5] = { T(-1), T(0.6), T(-0.8), T(0.8), T(0.6) };
+    for( idx_t n : ctx.opts.sizes ) {
+        const idx_t N = n*n;
+        ctx.run<T>( "rotm", {N,1,1}, gflop_rot<T>(N),
+            [&]( auto& B, auto&& time ) {
+                auto x = B.vector( N );
+                auto y = B.vector( N );
+                random_vector( x.view, ctx.gen );
+                random_vector( y.view, ctx.gen );
+                time( [&]() { blas::rotm<-1>( x.view, y.view, H ); } );
+            },
+            [&]( auto& B, auto&& time ) {
+                auto x = B.vector( N );
+                auto y = B.vector( N );
+                random_vector( x.view, ctx.gen );
+                random_vector( y.view, ctx.gen );
+                time( [&]() { blas::rotm( N, x.ptr(), 1, y.ptr(), 1, param ); } );
+            } );
+    }
+}
+
+template< class T >
+void bench_scal( context_t& ctx )
+{
+    // alpha = 1 keeps the data unchanged across the calls
+    const T alpha = T( 1 );
+    for( idx_t n : ctx.opts.sizes ) {
+        const idx_t N = n*n;
+        ctx.run<T>( "scal", {N,1,1}, blas::Gflop<T>::scal(N),
+            [&]( auto& B, auto&& time ) {
+                auto x = B.vector( N );
+                random_vector( x.view, ctx.gen );
+                time( [&]() { blas::scal( alpha, x.view ); } );
+            },
+            [&]( auto& B, auto&& time ) {
+                auto x = B.vector( N );
+                random_vector( x.view, ctx.gen );
+                time( [&]() { blas::scal( N, alpha, x.ptr(), 1 ); } );
+            } );
+    }
+}
+
+template< class T >
+void bench_swap( context_t& ctx )
+{
+    for( idx_t n : ctx.opts.sizes ) {
+        const idx_t N = n*n;
+        ctx.run<T>( "swap", {N,1,1}, blas::Gflop<T>::swap(N),
+            [&]( auto& B, auto&& time ) {
+                auto x = B.vector( N );
+                auto y = B.vector( N );
+                random_vector( x.view, ctx.gen );
+                random_vector( y.view, ctx.gen );
+                time( [&]() { blas::swap( x.view, y.view ); } );
+            },
+            [&]( auto& B, auto&& time ) {
+                auto x = B.vector( N );
+                auto y = B.vector( N );
+                random_vector( x.view, ctx.gen );
+                random_vector( y.view, ctx.gen );
+                time( [&]() { blas::swap( N, x.ptr(), 1, y.ptr(), 1 ); } );
+            } );
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Level 2 BLAS
+
+template< class T >
+void bench_gemv( context_t& ctx )
+{
+    for( idx_t n : ctx.opts.sizes ) {
+        ctx.run<T>( "gemv", {n,n,1}, blas::Gflop<T>::gemv(n,n),
+            [&]( auto& B, auto&& time ) {
+                auto A = B.matrix( n, n );
+                auto x = B.vector( n );
+                auto y = B.vector( n );
+                random_matrix( A.view, ctx.gen );
+                random_vector( x.view, ctx.gen );
+                time( [&]() {
+                    blas::gemv( Op::NoTrans, T(1), A.view, x.view, T(0), y.view );
+                } );
+            },
+            [&]( auto& B, auto&& time ) {
+                auto A = B.matrix( n, n );
+                auto x = B.vector( n );
+                auto y = B.vector( n );
+                random_matrix( A.view, ctx.gen );
+                random_vector( x.view, ctx.gen );
+                time( [&]() {
+                    blas::gemv( Layout::ColMajor, Op::NoTrans, n, n,
+                        T(1), A.ptr(), A.ld, x.ptr(), 1, T(0), y.ptr(), 1 );
+                } );
+            } );
+    }
+}
+
+template< class T >
+void bench_ger( context_t& ctx )
+{
+    for( idx_t n : ctx.opts.sizes ) {
+        ctx.run<T>( "ger", {n,n,1}, blas::Gflop<T>::ger(n,n),
+            [&]( auto& B, auto&& time ) {
+                auto A = B.matrix( n, n );
+                auto x = B.vector( n );
+                auto y = B.vector( n );
+                random_matrix( A.view, ctx.gen );
+                random_vector( x.view, ctx.gen );
+                random_vector( y.view, ctx.gen );
+                time( [&]() { blas::ger( T(1), x.view, y.view, A.view ); } );
+            },
+            [&]( auto& B, auto&& time ) {
+                auto A = B.matrix( n, n );
+                auto x = B.vector( n );
+                auto y = B.vector( n );
+                random_matrix( A.view, ctx.gen );
+                random_vector( x.view, ctx.gen );
+                random_vector( y.view, ctx.gen );
+                time( [&]() {
+                    blas::ger( Layout::ColMajor, n, n,
+                        T(1), x.ptr(), 1, y.ptr(), 1, A.ptr(), A.ld );
+                } );
+            } );
+    }
+}
+
+template< class T >
+void bench_geru( context_t& ctx )
+{
+    for( idx_t n : ctx.opts.sizes ) {
+        ctx.run<T>( "geru", {n,n,1}, blas::Gflop<T>::ger(n,n),
+            [&]( auto& B, auto&& time ) {
+                auto A = B.matrix( n, n );
+                auto x = B.vector( n );
+                auto y = B.vector( n );
+                random_matrix( A.view, ctx.gen );
+                random_vector( x.view, ctx.gen );
+                random_vector( y.view, ctx.gen );
+                time( [&]() { blas::geru( T(1), x.view, y.view, A.view ); } );
+            },
+            [&]( auto& B, auto&& time ) {
+                auto A = B.matrix( n, n );
+                auto x = B.vector( n );
+                auto y = B.vector( n );
+                random_matrix( A.view, ctx.gen );
+                random_vector( x.view, ctx.gen );
+                random_vector( y.view, ctx.gen );
+                time( [&]() {
+                    blas::geru( Layout::ColMajor, n, n,
+                        T(1), x.ptr(), 1, y.ptr(), 1, A.ptr(), A.ld );
+                } );
+            } );
+    }
+}
+
+template< class T >
+void bench_hemv( context_t& ctx )
+{
+    for( idx_t n : ctx.opts.sizes ) {
+        ctx.run<T>( "hemv", {n,n,1}, blas::Gflop<T>::hemv(n),
+            [&]( auto& B, auto&& time ) {
+                auto A = B.matrix( n, n );
+                auto x = B.vector( n );
+                auto y = B.vector( n );
+                random_hpd( A.view, ctx.gen );
+                random_vector( x.view, ctx.gen );
+                time( [&]() {
+                    blas::hemv( Uplo::Lower, T(1), A.view, x.view, T(0), y.view );
+                } );
+            },
+            [&]( auto& B, auto&& time ) {
+                auto A = B.matrix( n, n );
+                auto x = B.vector( n );
+                auto y = B.vector( n );
+                random_hpd( A.view, ctx.gen );
+                random_vector( x.view, ctx.gen );
+                time( [&]() {
+                    blas::hemv( Layout::ColMajor, Uplo::Lower, n,
+                        T(1), A.ptr(), A.ld, x.ptr(), 1, T(0), y.ptr(), 1 );
+                } );
+            } );
+    }
+}
+
+template< class T >
+void bench_her( context_t& ctx )
+{
+    using real_t = blas::real_type<T>;
+    for( idx_t n : ctx.opts.sizes ) {
+        ctx.run<T>( "her", {n,n,1}, blas::Gflop<T>::her(n),
+            [&]( auto& B, auto&& time ) {
+                auto A = B.matrix( n, n );
+                auto x = B.vector( n );
+                random_hpd( A.view, ctx.gen );
+                random_vector( x.view, ctx.gen );
+                time( [&]() { blas::her( Uplo::Lower, real_t(1), x.view, A.view ); } );
+            },
+            [&]( auto& B, auto&& time ) {
+                auto A = B.matrix( n, n );
+                auto x = B.vector( n );
+                random_hpd( A.view, ctx.gen );
+                random_vector( x.view, ctx.gen );
+                time( [&]() {
+                    blas::her( Layout::ColMajor, Uplo::Lower, n,
+                        real_t(1), x.ptr(), 1, A.ptr(), A.ld );
+                } );
+            } );
+    }
+}
+
+template< class T >
+void bench_her2( context_t& ctx )
+{
+    for( idx_t n : ctx.opts.sizes ) {
+        ctx.run<T>( "her2", {n,n,1}, blas::Gflop<T>::her2(n),
+            [&]( auto& B, auto&& time ) {
+                auto A = B.matrix( n, n );
+                auto x = B.vector( n );
+                auto y = B.vector( n );
+                random_hpd( A.view, ctx.gen );
+                random_vector( x.view, ctx.gen );
+                random_vector( y.view, ctx.gen );
+                time( [&]() { blas::her2( Uplo::Lower, T(1), x.view, y.view, A.view ); } );
+            },
+            [&]( auto& B, auto&& time ) {
+                auto A = B.matrix( n, n );
+                auto x = B.vector( n );
+                auto y = B.vector( n );
+                random_hpd( A.view, ctx.gen );
+                random_vector( x.view, ctx.gen );
+                random_vector( y.view, ctx.gen );
+                time( [&]() {
+                    blas::her2( Layout::ColMajor, Uplo::Lower, n,
+                        T(1), x.ptr(), 1, y.ptr(), 1, A.ptr(), A.ld );
+                } );
+            } );
+    }
+}
+
+template< class T >
+void bench_symv( context_t& ctx )
+{
+    for( idx_t n : ctx.opts.sizes ) {
+        ctx.run<T>( "symv", {n,n,1}, blas::Gflop<T>::symv(n),
+            [&]( auto& B, auto&& time ) {
+                auto A = B.matrix( n, n );
+                auto x = B.vector( n );
+                auto y = B.vector( n );
+                random_matrix( A.view, ctx.gen );
+                random_vector( x.view, ctx.gen );
+                time( [&]() {
+                    blas::symv( Uplo::Lower, T(1), A.view, x.view, T(0), y.view );
+                } );
+            },
+            [&]( auto& B, auto&& time ) {
+                auto A = B.matrix( n, n );
+                auto x = B.vector( n );
+                auto y = B.vector( n );
+                random_matrix( A.view, ctx.gen );
+                random_vector( x.view, ctx.gen );
+                time( [&]() {
+                    blas::symv( Layout::ColMajor, Uplo::Lower, n,
+                        T(1), A.ptr(), A.ld, x.ptr(), 1, T(0), y.ptr(), 1 );
+                } );
+            } );
+    }
+}
+
+template< class T >
+void bench_syr( context_t& ctx )
+{
+    for( idx_t n : ctx.opts.sizes ) {
+        ctx.run<T>( "syr", {n,n,1}, blas::Gflop<T>::syr(n),
+            [&]( auto& B, auto&& time ) {
+                auto A = B.matrix( n, n );
+                auto x = B.vector( n );
+                random_matrix( A.view, ctx.gen );
+                random_vector( x.view, ctx.gen );
+                time( [&]() { blas::syr( Uplo::Lower, T(1), x.view, A.view ); } );
+            },
+            [&]( auto& B, auto&& time ) {
+                auto A = B.matrix( n, n );
+                auto x = B.vector( n );
+                random_matrix( A.view, ctx.gen );
+                random_vector( x.view, ctx.gen );
+                time( [&]() {
+                    blas::syr( Layout::ColMajor, Uplo::Lower, n,
+                        T(1), x.ptr(), 1, A.ptr(), A.ld );
+                } );
+            } );
+    }
+}
+
+template< class T >
+void bench_syr2( context_t& ctx )
+{
+    for( idx_t n : ctx.opts.sizes ) {
+        ctx.run<T>( "syr2", {n,n,1}, blas::Gflop<T>::syr2(n),
+            [&]( auto& B, auto&& time ) {
+                auto A = B.matrix( n, n );
+                auto x = B.vector( n );
+                auto y = B.vector( n );
+                random_matrix( A.view, ctx.gen );
+                random_vector( x.view, ctx.gen );
+                random_vector( y.view, ctx.gen );
+                time( [&]() { blas::syr2( Uplo::Lower, T(1), x.view, y.view, A.view ); } );
+            },
+            [&]( auto& B, auto&& time ) {
+                auto A = B.matrix( n, n );
+                auto x = B.vector( n );
+                auto y = B.vector( n );
+                random_matrix( A.view, ctx.gen );
+                random_vector( x.view, ctx.gen );
+                random_vector( y.view, ctx.gen );
+                time( [&]() {
+                    blas::syr2( Layout::ColMajor, Uplo::Lower, n,
+                        T(1), x.ptr(), 1, y.ptr(), 1, A.ptr(), A.ld );
+                } );
+            } );
+    }
+}
+
+template< class T >
+void bench_trmv( context_t& ctx )
+{
+    for( idx_t n : ctx.opts.sizes ) {
+        ctx.run<T>( "trmv", {n,n,1}, blas::Gflop<T>::trmv(n),
+            [&]( auto& B, auto&& time ) {
+                auto A = B.matrix( n, n );
+                auto x0 = B.vector( n );
+                auto x = B.vector( n );
+                random_dominant( A.view, ctx.gen );
+                random_vector( x0.view, ctx.gen );
+                time(
+                    [&]() { blas::copy( x0.view, x.view ); },
+                    [&]() {
+                        blas::trmv( Uplo::Lower, Op::NoTrans, Diag::NonUnit,
+                            A.view, x.view );
+                    } );
+            },
+            [&]( auto& B, auto&& time ) {
+                auto A = B.matrix( n, n );
+                auto x0 = B.vector( n );
+                auto x = B.vector( n );
+                random_dominant( A.view, ctx.gen );
+                random_vector( x0.view, ctx.gen );
+                time(
+                    [&]() { blas::copy( x0.view, x.view ); },
+                    [&]() {
+                        blas::trmv( Layout::ColMajor, Uplo::Lower, Op::NoTrans,
+                            Diag::NonUnit, n, A.ptr(), A.ld, x.ptr(), 1 );
+                    } );
+            } );
+    }
+}
+
+template< class T >
+void bench_trsv( context_t& ctx )
+{
+    for( idx_t n : ctx.opts.sizes ) {
+        ctx.run<T>( "trsv", {n,n,1}, blas::Gflop<T>::trsv(n),
+            [&]( auto& B, auto&& time ) {
+                auto A = B.matrix( n, n );
+                auto x0 = B.vector( n );
+                auto x = B.vector( n );
+                random_dominant( A.view, ctx.gen );
+                random_vector( x0.view, ctx.gen );
+                time(
+                    [&]() { blas::copy( x0.view, x.view ); },
+                    [&]() {
+                        blas::trsv( Uplo::Lower, Op::NoTrans, Diag::NonUnit,
+                            A.view, x.view );
+                    } );
+            },
+            [&]( auto& B, auto&& time ) {
+                auto A = B.matrix( n, n );
+                auto x0 = B.vector( n );
+                auto x = B.vector( n );
+                random_dominant( A.view, ctx.gen );
+                random_vector( x0.view, ctx.gen );
+                time(
+                    [&]() { blas::copy( x0.view, x.view ); },
+                    [&]() {
+                        blas::trsv( Layout::ColMajor, Uplo::Lower, Op::NoTrans,
+                            Diag::NonUnit, n, A.ptr(), A.ld, x.ptr(), 1 );
+                    } );
+            } );
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Level 3 BLAS
+
+template< class T >
+void bench_gemm( context_t& ctx )
+{
+    for( idx_t n : ctx.opts.sizes ) {
+        ctx.run<T>( "gemm", {n,n,n}, blas::Gflop<T>::gemm(n,n,n),
+            [&]( auto& B, auto&& time ) {
+                auto A  = B.matrix( n, n );
+                auto Bm = B.matrix( n, n );
+                auto C  = B.matrix( n, n );
+                random_matrix( A.view, ctx.gen );
+                random_matrix( Bm.view, ctx.gen );
+                time( [&]() {
+                    blas::gemm( Op::NoTrans, Op::NoTrans,
+                        T(1), A.view, Bm.view, T(0), C.view );
+                } );
+            },
+            [&]( auto& B, auto&& time ) {
+                auto A  = B.matrix( n, n );
+                auto Bm = B.matrix( n, n );
+                auto C  = B.matrix( n, n );
+                random_matrix( A.view, ctx.gen );
+                random_matrix( Bm.view, ctx.gen );
+                time( [&]() {
+                    blas::gemm( Layout::ColMajor, Op::NoTrans, Op::NoTrans,
+                        n, n, n, T(1), A.ptr(), A.ld, Bm.ptr(), Bm.ld,
+                        T(0), C.ptr(), C.ld );
+                } );
+            } );
+    }
+}
+
+template< class T >
+void bench_hemm( context_t& ctx )
+{
+    for( idx_t n : ctx.opts.sizes ) {
+        ctx.run<T>( "hemm", {n,n,1}, blas::Gflop<T>::hemm(Side::Left,n,n),
+            [&]( auto& B, auto&& time ) {
+                auto A  = B.matrix( n, n );
+                auto Bm = B.matrix( n, n );
+                auto C  = B.matrix( n, n );
+                random_hpd( A.view, ctx.gen );
+                random_matrix( Bm.view, ctx.gen );
+                time( [&]() {
+                    blas::hemm( Side::Left, Uplo::Lower,
+                        T(1), A.view, Bm.view, T(0), C.view );
+                } );
+            },
+            [&]( auto& B, auto&& time ) {
+                auto A  = B.matrix( n, n );
+                auto Bm = B.matrix( n, n );
+                auto C  = B.matrix( n, n );
+                random_hpd( A.view, ctx.gen );
+                random_matrix( Bm.view, ctx.gen );
+                time( [&]() {
+                    blas::hemm( Layout::ColMajor, Side::Left, Uplo::Lower,
+                        n, n, T(1), A.ptr(), A.ld, Bm.ptr(), Bm.ld,
+                        T(0), C.ptr(), C.ld );
+                } );
+            } );
+    }
+}
+
+template< class T >
+void bench_herk( context_t& ctx )
+{
+    using real_t = blas::real_type<T>;
+    for( idx_t n : ctx.opts.sizes ) {
+        ctx.run<T>( "herk", {n,n,n}, blas::Gflop<T>::herk(n,n),
+            [&]( auto& B, auto&& time ) {
+                auto A = B.matrix( n, n );
+                auto C = B.matrix( n, n );
+                random_matrix( A.view, ctx.gen );
+                time( [&]() {
+                    blas::herk( Uplo::Lower, Op::NoTrans,
+                        real_t(1), A.view, real_t(0), C.view );
+                } );
+            },
+            [&]( auto& B, auto&& time ) {
+                auto A = B.matrix( n, n );
+                auto C = B.matrix( n, n );
+                random_matrix( A.view, ctx.gen );
+                time( [&]() {
+                    blas::herk( Layout::ColMajor, Uplo::Lower, Op::NoTrans,
+                        n, n, real_t(1), A.ptr(), A.ld,
+                        real_t(0), C.ptr(), C.ld );
+                } );
+            } );
+    }
+}
+
+template< class T >
+void bench_her2k( context_t& ctx )
+{
+    using real_t = blas::real_type<T>;
+    for( idx_t n : ctx.opts.sizes ) {
+        ctx.run<T>( "her2k", {n,n,n}, blas::Gflop<T>::her2k(n,n),
+            [&]( auto& B, auto&& time ) {
+                auto A  = B.matrix( n, n );
+                auto Bm = B.matrix( n, n );
+                auto C  = B.matrix( n, n );
+                random_matrix( A.view, ctx.gen );
+                random_matrix( Bm.view, ctx.gen );
+                time( [&]() {
+                    blas::her2k( Uplo::Lower, Op::NoTrans,
+                        T(1), A.view, Bm.view, real_t(0), C.view );
+                } );
+            },
+            [&]( auto& B, auto&& time ) {
+                auto A  = B.matrix( n, n );
+                auto Bm = B.matrix( n, n );
+                auto C  = B.matrix( n, n );
+                random_matrix( A.view, ctx.gen );
+                random_matrix( Bm.view, ctx.gen );
+                time( [&]() {
+                    blas::her2k( Layout::ColMajor, Uplo::Lower, Op::NoTrans,
+                        n, n, T(1), A.ptr(), A.ld, Bm.ptr(), Bm.ld,
+                        real_t(0), C.ptr(), C.ld );
+                } );
+            } );
+    }
+}
+
+template< class T >
+void bench_symm( context_t& ctx )
+{
+    for( idx_t n : ctx.opts.sizes ) {
+        ctx.run<T>( "symm", {n,n,1}, blas::Gflop<T>::symm(Side::Left,n,n),
+            [&]( auto& B, auto&& time ) {
+                auto A  = B.matrix( n, n );
+                auto Bm = B.matrix( n, n );
+                auto C  = B.matrix( n, n );
+                random_matrix( A.view, ctx.gen );
+                random_matrix( Bm.view, ctx.gen );
+                time( [&]() {
+                    blas::symm( Side::Left, Uplo::Lower,
+                        T(1), A.view, Bm.view, T(0), C.view );
+                } );
+            },
+            [&]( auto& B, auto&& time ) {
+                auto A  = B.matrix( n, n );
+                auto Bm = B.matrix( n, n );
+                auto C  = B.matrix( n, n );
+                random_matrix( A.view, ctx.gen );
+                random_matrix( Bm.view, ctx.gen );
+                time( [&]() {
+                    blas::symm( Layout::ColMajor, Side::Left, Uplo::Lower,
+                        n, n, T(1), A.ptr(), A.ld, Bm.ptr(), Bm.ld,
+                        T(0), C.ptr(), C.ld );
+                } );
+            } );
+    }
+}
+
+template< class T >
+void bench_syrk( context_t& ctx )
+{
+    for( idx_t n : ctx.opts.sizes ) {
+        ctx.run<T>( "syrk", {n,n,n}, blas::Gflop<T>::syrk(n,n),
+            [&]( auto& B, auto&& time ) {
+                auto A = B.matrix( n, n );
+                auto C = B.matrix( n, n );
+                random_matrix( A.view, ctx.gen );
+                time( [&]() {
+                    blas::syrk( Uplo::Lower, Op::NoTrans,
+                        T(1), A.view, T(0), C.view );
+                } );
+            },
+            [&]( auto& B, auto&& time ) {
+                auto A = B.matrix( n, n );
+                auto C = B.matrix( n, n );
+                random_matrix( A.view, ctx.gen );
+                time( [&]() {
+                    blas::syrk( Layout::ColMajor, Uplo::Lower, Op::NoTrans,
+                        n, n, T(1), A.ptr(), A.ld, T(0), C.ptr(), C.ld );
+                } );
+            } );
+    }
+}
+
+template< class T >
+void bench_syr2k( context_t& ctx )
+{
+    for( idx_t n : ctx.opts.sizes ) {
+        ctx.run<T>( "syr2k", {n,n,n}, blas::Gflop<T>::syr2k(n,n),
+            [&]( auto& B, auto&& time ) {
+                auto A  = B.matrix( n, n );
+                auto Bm = B.matrix( n, n );
+                auto C  = B.matrix( n, n );
+                random_matrix( A.view, ctx.gen );
+                random_matrix( Bm.view, ctx.gen );
+                time( [&]() {
+                    blas::syr2k( Uplo::Lower, Op::NoTrans,
+                        T(1), A.view, Bm.view, T(0), C.view );
+                } );
+            },
+            [&]( auto& B, auto&& time ) {
+                auto A  = B.matrix( n, n );
+                auto Bm = B.matrix( n, n );
+                auto C  = B.matrix( n, n );
+                random_matrix( A.view, ctx.gen );
+                random_matrix( Bm.view, ctx.gen );
+                time( [&]() {
+                    blas::syr2k( Layout::ColMajor, Uplo::Lower, Op::NoTrans,
+                        n, n, T(1), A.ptr(), A.ld, Bm.ptr(), Bm.ld,
+                        T(0), C.ptr(), C.ld );
+                } );
+            } );
+    }
+}
+
+template< class T >
+void bench_trmm( context_t& ctx )
+{
+    for( idx_t n : ctx.opts.sizes ) {
+        ctx.run<T>( "trmm", {n,n,1}, blas::Gflop<T>::trmm(Side::Left,n,n),
+            [&]( auto& B, auto&& time ) {
+                auto A  = B.matrix( n, n );
+                auto B0 = B.matrix( n, n );
+                auto Bm = B.matrix( n, n );
+                random_dominant( A.view, ctx.gen );
+                random_matrix( B0.view, ctx.gen );
+                time(
+                    [&]() { lapack::lacpy( lapack::general_matrix, B0.view, Bm.view ); },
+                    [&]() {
+                        blas::trmm( Side::Left, Uplo::Lower, Op::NoTrans,
+                            Diag::NonUnit, T(1), A.view, Bm.view );
+                    } );
+            },
+            [&]( auto& B, auto&& time ) {
+                auto A  = B.matrix( n, n );
+                auto B0 = B.matrix( n, n );
+                auto Bm = B.matrix( n, n );
+                random_dominant( A.view, ctx.gen );
+                random_matrix( B0.view, ctx.gen );
+                time(
+                    [&]() { lapack::lacpy( lapack::general_matrix, B0.view, Bm.view ); },
+                    [&]() {
+                        blas::trmm( Layout::ColMajor, Side::Left, Uplo::Lower,
+                            Op::NoTrans, Diag::NonUnit, n, n,
+                            T(1), A.ptr(), A.ld, Bm.ptr(), Bm.ld );
+                    } );
+            } );
+    }
+}
+
+template< class T >
+void bench_trsm( context_t& ctx )
+{
+    for( idx_t n : ctx.opts.sizes ) {
+        ctx.run<T>( "trsm", {n,n,1}, blas::Gflop<T>::trsm(Side::Left,n,n),
+            [&]( auto& B, auto&& time ) {
+                auto A  = B.matrix( n, n );
+                auto B0 = B.matrix( n, n );
+                auto Bm = B.matrix( n, n );
+                random_dominant( A.view, ctx.gen );
+                random_matrix( B0.view, ctx.gen );
+                time(
+                    [&]() { lapack::lacpy( lapack::general_matrix, B0.view, Bm.view ); },
+                    [&]() {
+                        blas::trsm( Side::Left, Uplo::Lower, Op::NoTrans,
+                            Diag::NonUnit, T(1), A.view, Bm.view );
+                    } );
+            },
+            [&]( auto& B, auto&& time ) {
+                auto A  = B.matrix( n, n );
+                auto B0 = B.matrix( n, n );
+                auto Bm = B.matrix( n, n );
+                random_dominant( A.view, ctx.gen );
+                random_matrix( B0.view, ctx.gen );
+                time(
+                    [&]() { lapack::lacpy( lapack::general_matrix, B0.view, Bm.view ); },
+                    [&]() {
+                        blas::trsm( Layout::ColMajor, Side::Left, Uplo::Lower,
+                            Op::NoTrans, Diag::NonUnit, n, n,
+                            T(1), A.ptr(), A.ld, Bm.ptr(), Bm.ld );
+                    } );
+            } );
+    }
+}
+
+template< class T >
+void bench_gemm_batch( context_t& ctx )
+{
+    const idx_t s = batch_size;
+    for( idx_t n : ctx.opts.sizes ) {
+        ctx.run<T>( "gemm_batch", {s,s,n}, n * blas::Gflop<T>::gemm(s,s,s),
+            [&]( auto& B, auto&& time ) {
+                auto A  = B.matrix_range( n, s, s );
+                auto Bm = B.matrix_range( n, s, s );
+                auto C  = B.matrix_range( n, s, s );
+                for( idx_t p = 0; p < n; ++p ) {
+                    random_matrix( A.view[p], ctx.gen );
+                    random_matrix( Bm.view[p], ctx.gen );
+                }
+                time( [&]() {
+                    blas::gemm_batch( Op::NoTrans, Op::NoTrans,
+                        T(1), A.view, Bm.view, T(0), C.view );
+                } );
+            } );
+    }
+}
+
+template< class T >
+void bench_trsm_batch( context_t& ctx )
+{
+    const idx_t s = batch_size;
+    for( idx_t n : ctx.opts.sizes ) {
+        ctx.run<T>( "trsm_batch", {s,s,n}, n * blas::Gflop<T>::trsm(Side::Left,s,s),
+            [&]( auto& B, auto&& time ) {
+                auto A  = B.matrix_range( n, s, s );
+                auto B0 = B.matrix_range( n, s, s );
+                auto Bm = B.matrix_range( n, s, s );
+                for( idx_t p = 0; p < n; ++p ) {
+                    random_dominant( A.view[p], ctx.gen );
+                    random_matrix( B0.view[p], ctx.gen );
+                }
+                time(
+                    [&]() {
+                        for( idx_t p = 0; p < n; ++p )
+                            lapack::lacpy( lapack::general_matrix, B0.view[p], Bm.view[p] );
+                    },
+                    [&]() {
+                        blas::trsm_batch( Side::Left, Uplo::Lower, Op::NoTrans,
+                            Diag::NonUnit, T(1), A.view, Bm.view );
+                    } );
+            } );
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+std::vector< routine_t > blas_routines()
+{
+    return {
+        // Level 1
+        TLAPACK_BENCH( asum ),
+        TLAPACK_BENCH( axpy ),
+        TLAPACK_BENCH( copy ),
+        TLAPACK_BENCH( dot ),
+        TLAPACK_BENCH( dotu ),
+        TLAPACK_BENCH( iamax ),
+        TLAPACK_BENCH( nrm2 ),
+        TLAPACK_BENCH( rot ),
+        TLAPACK_BENCH_REAL( rotm ),
+        TLAPACK_BENCH( scal ),
+        TLAPACK_BENCH( swap ),
+        // Level 2
+        TLAPACK_BENCH( gemv ),
+        TLAPACK_BENCH( ger ),
+        TLAPACK_BENCH( geru ),
+        TLAPACK_BENCH( hemv ),
+        TLAPACK_BENCH( her ),
+        TLAPACK_BENCH( her2 ),
+        TLAPACK_BENCH( symv ),
+        TLAPACK_BENCH( syr ),
+        TLAPACK_BENCH( syr2 ),
+        TLAPACK_BENCH( trmv ),
+        TLAPACK_BENCH( trsv ),
+        // Level 3
+        TLAPACK_BENCH( gemm ),
+        TLAPACK_BENCH( hemm ),
+        TLAPACK_BENCH( herk ),
+        TLAPACK_BENCH( her2k ),
+        TLAPACK_BENCH( symm ),
+        TLAPACK_BENCH( syrk ),
+        TLAPACK_BENCH( syr2k ),
+        TLAPACK_BENCH( trmm ),
+        TLAPACK_BENCH( trsm ),
+        TLAPACK_BENCH( gemm_batch ),
+        TLAPACK_BENCH( trsm_batch ),
+    };
+}
+
+} // namespace bench
@@ -0,0 +1,865 @@
+/// @file bench_lapack.cpp Benchmarks of the routines in tlapack.hpp.
+//
+// Copyright (c) 2021, University of Colorado Denver. All rights reserved.
+//
+// This file is part of <T>LAPACK.
+// <T>LAPACK is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+//
+// The routines run on n-by-n matrices, except:
+// - the vector routines, which run on vectors of length n^2;
+// - larft and larfb, which use n-by-32 reflectors;
+// - tsqr, tsqr_update and unmtsqr, which run on 4n-by-n matrices split in
+//   4 row-blocks, and getrf_calu, which splits the panel in 4 row-blocks.
+
+#include "bench.hpp"
+
+namespace bench {
+
+using pair = std::pair<idx_t,idx_t>;
+
+/// Number of reflectors of larft and larfb
+const idx_t nb_reflectors = 32;
+
+/// Number of row-blocks of tsqr and getrf_calu
+const idx_t nblocks = 4;
+
+/// Copies the matrix A to B
+template< class matrixA_t, class matrixB_t >
+inline void copy_matrix( const matrixA_t& A, matrixB_t& B )
+{
+    lapack::lacpy( lapack::general_matrix, A, B );
+}
+
+// -----------------------------------------------------------------------------
+// Auxiliary routines
+
+template< class T >
+void bench_larf( context_t& ctx )
+{
+    for( idx_t n : ctx.opts.sizes ) {
+        ctx.run<T>( "larf", {n,n,1}, 0,
+            [&]( auto& B, auto&& time ) {
+                auto v = B.vector( n );
+                auto C = B.matrix( n, n );
+                auto w = B.vector( n );
+                random_vector( v.view, ctx.gen );
+                random_matrix( C.view, ctx.gen );
+                T tau;
+                {
+                    T alpha = v.view[0];
+                    auto x = blas::subvector( v.view, pair{1,n} );
+                    lapack::larfg( alpha, x, tau );
+                    v.view[0] = T(1);
+                }
+                time( [&]() {
+                    lapack::larf( lapack::left_side, v.view, tau, C.view, w.view );
+                } );
+            },
+            [&]( auto& B, auto&& time ) {
+                auto v = B.vector( n );
+                auto C = B.matrix( n, n );
+                random_vector( v.view, ctx.gen );
+                random_matrix( C.view, ctx.gen );
+                T tau;
+                lapack::larfg( n, v.ptr()[0], v.ptr()+1, 1, tau );
+                v.ptr()[0] = T(1);
+                time( [&]() {
+                    lapack::larf( lapack::Side::Left, n, n,
+                        v.ptr(), 1, tau, C.ptr(), C.ld );
+                } );
+            } );
+    }
+}
+
+template< class T >
+void bench_larfg( context_t& ctx )
+{
+    for( idx_t n : ctx.opts.sizes ) {
+        const idx_t N = n*n;
+        ctx.run<T>( "larfg", {N,1,1}, lapack::Gflop<T>::larfg(N),
+            [&]( auto& B, auto&& time ) {
+                auto x0 = B.vector( N );
+                auto x = B.vector( N );
+                random_vector( x0.view, ctx.gen );
+                T alpha, tau;
+                time(
+                    [&]() { blas::copy( x0.view, x.view ); alpha = T(1); },
+                    [&]() { lapack::larfg( alpha, x.view, tau ); } );
+            },
+            [&]( auto& B, auto&& time ) {
+                auto x0 = B.vector( N );
+                auto x = B.vector( N );
+                random_vector( x0.view, ctx.gen );
+                T alpha, tau;
+                time(
+                    [&]() { blas::copy( x0.view, x.view ); alpha = T(1); },
+                    [&]() { lapack::larfg( N+1, alpha, x.ptr(), 1, tau ); } );
+            } );
+    }
+}
+
+template< class T >
+void bench_larft( context_t& ctx )
+{
+    for( idx_t n : ctx.opts.sizes ) {
+        const idx_t k = std::min( n, nb_reflectors );
+        ctx.run<T>( "larft", {n,k,1}, 0,
+            [&]( auto& B, auto&& time ) {
+                auto V = B.matrix( n, k );
+                auto tau = B.vector( k );
+                auto Tm = B.matrix( k, k );
+                random_matrix( V.view, ctx.gen );
+                random_vector( tau.view, ctx.gen );
+                time( [&]() {
+                    lapack::larft( lapack::forward, lapack::columnwise_storage,
+                        V.view, tau.view, Tm.view );
+                } );
+            },
+            [&]( auto& B, auto&& time ) {
+                auto V = B.matrix( n, k );
+                auto tau = B.vector( k );
+                auto Tm = B.matrix( k, k );
+                random_matrix( V.view, ctx.gen );
+                random_vector( tau.view, ctx.gen );
+                time( [&]() {
+                    lapack::larft(
+                        lapack::Direction::Forward, lapack::StoreV::Columnwise,
+                        n, k, V.ptr(), V.ld, tau.ptr(), Tm.ptr(), Tm.ld );
+                } );
+            } );
+    }
+}
+
+template< class T >
+void bench_larfb( context_t& ctx )
+{
+    // Reflectors of a QR factorization, so that the update is unitary
+    auto reflectors = [&]( auto& V, auto& Tm ) {
+        const idx_t k = blas::ncols( V );
+        std::vector<T> tau_( k );
+        auto tau = blas::internal::vector<T>( tau_.data(), k );
+        random_matrix( V, ctx.gen );
+        lapack::geqrt3( V, tau, Tm );
+    };
+
+    for( idx_t n : ctx.opts.sizes ) {
+        const idx_t k = std::min( n, nb_reflectors );
+        ctx.run<T>( "larfb", {n,n,k}, lapack::Gflop<T>::unmqr(lapack::Side::Left,n,n,k),
+            [&]( auto& B, auto&& time ) {
+                auto V = B.matrix( n, k );
+                auto Tm = B.matrix( k, k );
+                auto C = B.matrix( n, n );
+                reflectors( V.view, Tm.view );
+                random_matrix( C.view, ctx.gen );
+                const lapack::workinfo_t wi = lapack::larfb_worksize(
+                    lapack::left_side, lapack::conjTranspose,
+                    lapack::forward, lapack::columnwise_storage,
+                    V.view, Tm.view, C.view );
+                auto W = B.matrix( wi.m, wi.n );
+                time( [&]() {
+                    lapack::larfb( lapack::left_side, lapack::conjTranspose,
+                        lapack::forward, lapack::columnwise_storage,
+                        V.view, Tm.view, C.view, W.view );
+                } );
+            },
+            [&]( auto& B, auto&& time ) {
+                auto V = B.matrix( n, k );
+                auto Tm = B.matrix( k, k );
+                auto C = B.matrix( n, n );
+                reflectors( V.view, Tm.view );
+                random_matrix( C.view, ctx.gen );
+                time( [&]() {
+                    lapack::larfb( lapack::Side::Left, lapack::Op::ConjTrans,
+                        lapack::Direction::Forward, lapack::StoreV::Columnwise,
+                        n, n, k, V.ptr(), V.ld, Tm.ptr(), Tm.ld, C.ptr(), C.ld );
+                } );
+            } );
+    }
+}
+
+template< class T >
+void bench_laset( context_t& ctx )
+{
+    for( idx_t n : ctx.opts.sizes ) {
+        ctx.run<T>( "laset", {n,n,1}, 0,
+            [&]( auto& B, auto&& time ) {
+                auto A = B.matrix( n, n );
+                time( [&]() {
+                    lapack::laset( lapack::general_matrix, T(0), T(1), A.view );
+                } );
+            },
+            [&]( auto& B, auto&& time ) {
+                auto A = B.matrix( n, n );
+                time( [&]() {
+                    lapack::laset( lapack::MatrixType::General, n, n,
+                        T(0), T(1), A.ptr(), A.ld );
+                } );
+            } );
+    }
+}
+
+template< class T >
+void bench_lacpy( context_t& ctx )
+{
+    for( idx_t n : ctx.opts.sizes ) {
+        ctx.run<T>( "lacpy", {n,n,1}, 0,
+            [&]( auto& B, auto&& time ) {
+                auto A = B.matrix( n, n );
+                auto C = B.matrix( n, n );
+                random_matrix( A.view, ctx.gen );
+                time( [&]() {
+                    lapack::lacpy( lapack::general_matrix, A.view, C.view );
+                } );
+            },
+            [&]( auto& B, auto&& time ) {
+                auto A = B.matrix( n, n );
+                auto C = B.matrix( n, n );
+                random_matrix( A.view, ctx.gen );
+                time( [&]() {
+                    lapack::lacpy( lapack::MatrixType::General, n, n,
+                        A.ptr(), A.ld, C.ptr(), C.ld );
+                } );
+            } );
+    }
+}
+
+template< class T >
+void bench_lascl( context_t& ctx )
+{
+    using real_t = blas::real_type<T>;
+    const real_t b( 3 ), a( 2 );
+
+    for( idx_t n : ctx.opts.sizes ) {
+        ctx.run<T>( "lascl", {n,n,1}, blas::Gflop<T>::scal(n*n),
+            [&]( auto& B, auto&& time ) {
+                auto A0 = B.matrix( n, n );
+                auto A = B.matrix( n, n );
+                random_matrix( A0.view, ctx.gen );
+                time(
+                    [&]() { copy_matrix( A0.view, A.view ); },
+                    [&]() { lapack::lascl( lapack::general_matrix, b, a, A.view ); } );
+            },
+            [&]( auto& B, auto&& time ) {
+                auto A0 = B.matrix( n, n );
+                auto A = B.matrix( n, n );
+                random_matrix( A0.view, ctx.gen );
+                time(
+                    [&]() { copy_matrix( A0.view, A.view ); },
+                    [&]() {
+                        lapack::lascl( lapack::MatrixType::General, 0, 0, b, a,
+                            n, n, A.ptr(), A.ld );
+                    } );
+            } );
+    }
+}
+
+template< class T >
+void bench_lange( context_t& ctx )
+{
+    for( idx_t n : ctx.opts.sizes ) {
+        ctx.run<T>( "lange", {n,n,1}, lapack::Gflop<T>::lange(lapack::Norm::Fro,n,n),
+            [&]( auto& B, auto&& time ) {
+                auto A = B.matrix( n, n );
+                random_matrix( A.view, ctx.gen );
+                time( [&]() { keep( lapack::lange( lapack::frob_norm, A.view ) ); } );
+            },
+            [&]( auto& B, auto&& time ) {
+                auto A = B.matrix( n, n );
+                random_matrix( A.view, ctx.gen );
+                time( [&]() {
+                    keep( lapack::lange( lapack::Norm::Fro, n, n, A.ptr(), A.ld ) );
+                } );
+            } );
+    }
+}
+
+template< class T >
+void bench_lansy( context_t& ctx )
+{
+    for( idx_t n : ctx.opts.sizes ) {
+        ctx.run<T>( "lansy", {n,n,1}, lapack::Gflop<T>::lansy(lapack::Norm::Fro,n),
+            [&]( auto& B, auto&& time ) {
+                auto A = B.matrix( n, n );
+                random_matrix( A.view, ctx.gen );
+                time( [&]() {
+                    keep( lapack::lansy( lapack::frob_norm, lapack::lower_triangle, A.view ) );
+                } );
+            },
+            [&]( auto& B, auto&& time ) {
+                auto A = B.matrix( n, n );
+                random_matrix( A.view, ctx.gen );
+                time( [&]() {
+                    keep( lapack::lansy( lapack::Norm::Fro, lapack::Uplo::Lower,
+                        n, A.ptr(), A.ld ) );
+                } );
+            } );
+    }
+}
+
+template< class T >
+void bench_larnv( context_t& ctx )
+{
+    for( idx_t n : ctx.opts.sizes ) {
+        const idx_t N = n*n;
+        ctx.run<T>( "larnv", {N,1,1}, 0,
+            [&]( auto& B, auto&& time ) {
+                auto x = B.vector( N );
+                idx_t iseed = 1;
+                time( [&]() { lapack::larnv<2>( iseed, x.view ); } );
+            },
+            [&]( auto& B, auto&& time ) {
+                auto x = B.vector( N );
+                blas::idx_t iseed = 1;
+                time( [&]() { lapack::larnv( 2, &iseed, N, x.ptr() ); } );
+            } );
+    }
+}
+
+template< class T >
+void bench_lassq( context_t& ctx )
+{
+    using real_t = blas::real_type<T>;
+    for( idx_t n : ctx.opts.sizes ) {
+        const idx_t N = n*n;
+        ctx.run<T>( "lassq", {N,1,1}, blas::Gflop<T>::nrm2(N),
+            [&]( auto& B, auto&& time ) {
+                auto x = B.vector( N );
+                random_vector( x.view, ctx.gen );
+                time( [&]() {
+                    real_t scl( 1 ), sumsq( 0 );
+                    lapack::lassq( x.view, scl, sumsq );
+                    keep( sumsq );
+                } );
+            },
+            [&]( auto& B, auto&& time ) {
+                auto x = B.vector( N );
+                random_vector( x.view, ctx.gen );
+                time( [&]() {
+                    real_t scl( 1 ), sumsq( 0 );
+                    lapack::lassq( N, x.ptr(), 1, scl, sumsq );
+                    keep( sumsq );
+                } );
+            } );
+    }
+}
+
+template< class T >
+void bench_laswp( context_t& ctx )
+{
+    for( idx_t n : ctx.opts.sizes ) {
+        ctx.run<T>( "laswp", {n,n,1}, 0,
+            [&]( auto& B, auto&& time ) {
+                auto A = B.matrix( n, n );
+                auto piv = B.index_vector( n );
+                random_matrix( A.view, ctx.gen );
+                lapack::getrf( A.view, piv.view );
+                time( [&]() { lapack::laswp( lapack::forward, A.view, piv.view ); } );
+            },
+            [&]( auto& B, auto&& time ) {
+                auto A = B.matrix( n, n );
+                auto piv = B.index_vector( n );
+                random_matrix( A.view, ctx.gen );
+                lapack::getrf( n, n, A.ptr(), A.ld, piv.ptr() );
+                time( [&]() {
+                    lapack::laswp( n, A.ptr(), A.ld, 1, n, piv.ptr(), 1 );
+                } );
+            } );
+    }
+}
+
+// -----------------------------------------------------------------------------
+// QR factorization
+
+template< class T >
+void bench_geqr2( context_t& ctx )
+{
+    for( idx_t n : ctx.opts.sizes ) {
+        ctx.run<T>( "geqr2", {n,n,1}, lapack::Gflop<T>::geqrf(n,n),
+            [&]( auto& B, auto&& time ) {
+                auto A0 = B.matrix( n, n );
+                auto A = B.matrix( n, n );
+                auto tau = B.vector( n );
+                auto work = B.vector( n );
+                random_matrix( A0.view, ctx.gen );
+                time(
+                    [&]() { copy_matrix( A0.view, A.view ); },
+                    [&]() { lapack::geqr2( A.view, tau.view, work.view ); } );
+            },
+            [&]( auto& B, auto&& time ) {
+                auto A0 = B.matrix( n, n );
+                auto A = B.matrix( n, n );
+                auto tau = B.vector( n );
+                random_matrix( A0.view, ctx.gen );
+                time(
+                    [&]() { copy_matrix( A0.view, A.view ); },
+                    [&]() { lapack::geqr2( n, n, A.ptr(), A.ld, tau.ptr() ); } );
+            } );
+    }
+}
+
+template< class T >
+void bench_geqrt3( context_t& ctx )
+{
+    for( idx_t n : ctx.opts.sizes ) {
+        ctx.run<T>( "geqrt3", {n,n,1}, lapack::Gflop<T>::geqrt(n,n),
+            [&]( auto& B, auto&& time ) {
+                auto A0 = B.matrix( n, n );
+                auto A = B.matrix( n, n );
+                auto tau = B.vector( n );
+                auto Tm = B.matrix( n, n );
+                random_matrix( A0.view, ctx.gen );
+                time(
+                    [&]() { copy_matrix( A0.view, A.view ); },
+                    [&]() { lapack::geqrt3( A.view, tau.view, Tm.view ); } );
+            } );
+    }
+}
+
+template< class T >
+void bench_geqrf( context_t& ctx )
+{
+    for( idx_t n : ctx.opts.sizes ) {
+        ctx.run<T>( "geqrf", {n,n,1}, lapack::Gflop<T>::geqrf(n,n),
+            [&]( auto& B, auto&& time ) {
+                auto A0 = B.matrix( n, n );
+                auto A = B.matrix( n, n );
+                auto tau = B.vector( n );
+                random_matrix( A0.view, ctx.gen );
+                const lapack::workinfo_t wi = lapack::geqrf_worksize( A.view, tau.view );
+                auto W = B.matrix( wi.m, wi.n );
+                time(
+                    [&]() { copy_matrix( A0.view, A.view ); },
+                    [&]() { lapack::geqrf( A.view, tau.view, W.view ); } );
+            },
+            [&]( auto& B, auto&& time ) {
+                auto A0 = B.matrix( n, n );
+                auto A = B.matrix( n, n );
+                auto tau = B.vector( n );
+                random_matrix( A0.view, ctx.gen );
+                time(
+                    [&]() { copy_matrix( A0.view, A.view ); },
+                    [&]() { lapack::geqrf( n, n, A.ptr(), A.ld, tau.ptr() ); } );
+            } );
+    }
+}
+
+template< class T >
+void bench_geqrt( context_t& ctx )
+{
+    for( idx_t n : ctx.opts.sizes ) {
+        ctx.run<T>( "geqrt", {n,n,1}, lapack::Gflop<T>::geqrt(n,n),
+            [&]( auto& B, auto&& time ) {
+                auto A0 = B.matrix( n, n );
+                auto A = B.matrix( n, n );
+                auto Tm = B.matrix( n, n );
+                random_matrix( A0.view, ctx.gen );
+                const lapack::workinfo_t wi = lapack::geqrt_worksize( A.view, Tm.view );
+                auto W = B.matrix( wi.m, wi.n );
+                time(
+                    [&]() { copy_matrix( A0.view, A.view ); },
+                    [&]() { lapack::geqrt( A.view, Tm.view, W.view ); } );
+            } );
+    }
+}
+
+template< class T >
+void bench_tsqrt( context_t& ctx )
+{
+    for( idx_t n : ctx.opts.sizes ) {
+        ctx.run<T>( "tsqrt", {n,n,1}, 0,
+            [&]( auto& B, auto&& time ) {
+                auto R0 = B.matrix( n, n );
+                auto A0 = B.matrix( n, n );
+                auto R = B.matrix( n, n );
+                auto A = B.matrix( n, n );
+                auto Tm = B.matrix( n, n );
+                random_dominant( R0.view, ctx.gen );
+                random_matrix( A0.view, ctx.gen );
+                time(
+                    [&]() {
+                        copy_matrix( R0.view, R.view );
+                        copy_matrix( A0.view, A.view );
+                    },
+                    [&]() { lapack::tsqrt( R.view, A.view, Tm.view ); } );
+            } );
+    }
+}
+
+template< class T >
+void bench_tsqr( context_t& ctx )
+{
+    for( idx_t n : ctx.opts.sizes ) {
+        const idx_t m = nblocks * n;
+        ctx.run<T>( "tsqr", {m,n,1}, lapack::Gflop<T>::geqrf(m,n),
+            [&]( auto& B, auto&& time ) {
+                auto A0 = B.matrix( m, n );
+                auto A = B.matrix( m, n );
+                auto Tm = B.matrix( 2*n, nblocks*n );
+                random_matrix( A0.view, ctx.gen );
+                time(
+                    [&]() { copy_matrix( A0.view, A.view ); },
+                    [&]() { lapack::tsqr( A.view, Tm.view ); } );
+            } );
+    }
+}
+
+template< class T >
+void bench_tsqr_update( context_t& ctx )
+{
+    for( idx_t n : ctx.opts.sizes ) {
+        const idx_t m = nblocks * n;
+        ctx.run<T>( "tsqr_update", {m,n,1}, lapack::Gflop<T>::geqrf(m+n,n),
+            [&]( auto& B, auto&& time ) {
+                auto R0 = B.matrix( n, n );
+                auto A0 = B.matrix( m, n );
+                auto R = B.matrix( n, n );
+                auto A = B.matrix( m, n );
+                auto Tm = B.matrix( 2*n, nblocks*n );
+                random_dominant( R0.view, ctx.gen );
+                random_matrix( A0.view, ctx.gen );
+                time(
+                    [&]() {
+                        copy_matrix( R0.view, R.view );
+                        copy_matrix( A0.view, A.view );
+                    },
+                    [&]() { lapack::tsqr_update( R.view, A.view, Tm.view ); } );
+            } );
+    }
+}
+
+template< class T >
+void bench_org2r( context_t& ctx )
+{
+    for( idx_t n : ctx.opts.sizes ) {
+        ctx.run<T>( "org2r", {n,n,n}, lapack::Gflop<T>::ungqr(n,n,n),
+            [&]( auto& B, auto&& time ) {
+                auto A0 = B.matrix( n, n );
+                auto A = B.matrix( n, n );
+                auto tau = B.vector( n );
+                auto work = B.vector( n );
+                random_matrix( A0.view, ctx.gen );
+                lapack::geqr2( A0.view, tau.view, work.view );
+                time(
+                    [&]() { copy_matrix( A0.view, A.view ); },
+                    [&]() { lapack::org2r( n, A.view, tau.view, work.view ); } );
+            },
+            [&]( auto& B, auto&& time ) {
+                auto A0 = B.matrix( n, n );
+                auto A = B.matrix( n, n );
+                auto tau = B.vector( n );
+                random_matrix( A0.view, ctx.gen );
+                lapack::geqr2( n, n, A0.ptr(), A0.ld, tau.ptr() );
+                time(
+                    [&]() { copy_matrix( A0.view, A.view ); },
+                    [&]() { lapack::org2r( n, n, n, A.ptr(), A.ld, tau.ptr() ); } );
+            } );
+    }
+}
+
+template< class T >
+void bench_ungqr( context_t& ctx )
+{
+    for( idx_t n : ctx.opts.sizes ) {
+        ctx.run<T>( "ungqr", {n,n,n}, lapack::Gflop<T>::ungqr(n,n,n),
+            [&]( auto& B, auto&& time ) {
+                auto A0 = B.matrix( n, n );
+                auto A = B.matrix( n, n );
+                auto tau = B.vector( n );
+                auto work = B.vector( n );
+                random_matrix( A0.view, ctx.gen );
+                lapack::geqr2( A0.view, tau.view, work.view );
+                const lapack::workinfo_t wi = lapack::ungqr_worksize( n, A.view, tau.view );
+                auto W = B.matrix( wi.m, wi.n );
+                time(
+                    [&]() { copy_matrix( A0.view, A.view ); },
+                    [&]() { lapack::ungqr( n, A.view, tau.view, W.view ); } );
+            },
+            [&]( auto& B, auto&& time ) {
+                auto A0 = B.matrix( n, n );
+                auto A = B.matrix( n, n );
+                auto tau = B.vector( n );
+                random_matrix( A0.view, ctx.gen );
+                lapack::geqr2( n, n, A0.ptr(), A0.ld, tau.ptr() );
+                time(
+                    [&]() { copy_matrix( A0.view, A.view ); },
+                    [&]() { lapack::ungqr( n, n, n, A.ptr(), A.ld, tau.ptr() ); } );
+            } );
+    }
+}
+
+template< class T >
+void bench_unmqr( context_t& ctx )
+{
+    for( idx_t n : ctx.opts.sizes ) {
+        ctx.run<T>( "unmqr", {n,n,n}, lapack::Gflop<T>::unmqr(lapack::Side::Left,n,n,n),
+            [&]( auto& B, auto&& time ) {
+                auto A = B.matrix( n, n );
+                auto tau = B.vector( n );
+                auto C = B.matrix( n, n );
+                auto work = B.vector( n );
+                random_matrix( A.view, ctx.gen );
+                random_matrix( C.view, ctx.gen );
+                lapack::geqr2( A.view, tau.view, work.view );
+                const lapack::workinfo_t wi = lapack::unmqr_worksize(
+                    lapack::left_side, lapack::conjTranspose,
+                    A.view, tau.view, C.view );
+                auto W = B.matrix( wi.m, wi.n );
+                time( [&]() {
+                    lapack::unmqr( lapack::left_side, lapack::conjTranspose,
+                        A.view, tau.view, C.view, W.view );
+                } );
+            },
+            [&]( auto& B, auto&& time ) {
+                auto A = B.matrix( n, n );
+                auto tau = B.vector( n );
+                auto C = B.matrix( n, n );
+                random_matrix( A.view, ctx.gen );
+                random_matrix( C.view, ctx.gen );
+                lapack::geqr2( n, n, A.ptr(), A.ld, tau.ptr() );
+                time( [&]() {
+                    lapack::unmqr( lapack::Side::Left, lapack::Op::ConjTrans,
+                        n, n, n, A.ptr(), A.ld, tau.ptr(), C.ptr(), C.ld );
+                } );
+            } );
+    }
+}
+
+template< class T >
+void bench_unmqrt( context_t& ctx )
+{
+    for( idx_t n : ctx.opts.sizes ) {
+        ctx.run<T>( "unmqrt", {n,n,n}, lapack::Gflop<T>::unmqr(lapack::Side::Left,n,n,n),
+            [&]( auto& B, auto&& time ) {
+                auto V = B.matrix( n, n );
+                auto Tm = B.matrix( n, n );
+                auto C = B.matrix( n, n );
+                random_matrix( V.view, ctx.gen );
+                random_matrix( C.view, ctx.gen );
+                {
+                    const lapack::workinfo_t wi = lapack::geqrt_worksize( V.view, Tm.view );
+                    auto W = B.matrix( wi.m, wi.n );
+                    lapack::geqrt( V.view, Tm.view, W.view );
+                }
+                const lapack::workinfo_t wi = lapack::unmqrt_worksize(
+                    lapack::conjTranspose, V.view, Tm.view, C.view );
+                auto W = B.matrix( wi.m, wi.n );
+                time( [&]() {
+                    lapack::unmqrt( lapack::conjTranspose,
+                        V.view, Tm.view, C.view, W.view );
+                } );
+            } );
+    }
+}
+
+template< class T >
+void bench_tsmqrt( context_t& ctx )
+{
+    for( idx_t n : ctx.opts.sizes ) {
+        ctx.run<T>( "tsmqrt", {n,n,n}, 0,
+            [&]( auto& B, auto&& time ) {
+                auto R = B.matrix( n, n );
+                auto V2 = B.matrix( n, n );
+                auto Tm = B.matrix( n, n );
+                auto C1 = B.matrix( n, n );
+                auto C2 = B.matrix( n, n );
+                random_dominant( R.view, ctx.gen );
+                random_matrix( V2.view, ctx.gen );
+                random_matrix( C1.view, ctx.gen );
+                random_matrix( C2.view, ctx.gen );
+                lapack::tsqrt( R.view, V2.view, Tm.view );
+                const lapack::workinfo_t wi = lapack::tsmqrt_worksize(
+                    lapack::conjTranspose, V2.view, Tm.view, C1.view, C2.view );
+                auto W = B.matrix( wi.m, wi.n );
+                time( [&]() {
+                    lapack::tsmqrt( lapack::conjTranspose,
+                        V2.view, Tm.view, C1.view, C2.view, W.view );
+                } );
+            } );
+    }
+}
+
+template< class T >
+void bench_unmtsqr( context_t& ctx )
+{
+    for( idx_t n : ctx.opts.sizes ) {
+        const idx_t m = nblocks * n;
+        ctx.run<T>( "unmtsqr", {m,n,n}, lapack::Gflop<T>::unmqr(lapack::Side::Left,m,n,n),
+            [&]( auto& B, auto&& time ) {
+                auto A = B.matrix( m, n );
+                auto Tm = B.matrix( 2*n, nblocks*n );
+                auto C = B.matrix( m, n );
+                random_matrix( A.view, ctx.gen );
+                random_matrix( C.view, ctx.gen );
+                lapack::tsqr( A.view, Tm.view );
+                const lapack::workinfo_t wi = lapack::unmtsqr_worksize(
+                    lapack::conjTranspose, A.view, Tm.view, C.view );
+                auto W = B.matrix( wi.m, wi.n );
+                time( [&]() {
+                    lapack::unmtsqr( lapack::conjTranspose,
+                        A.view, Tm.view, C.view, W.view );
+                } );
+            } );
+    }
+}
+
+template< class T >
+void bench_potrf2( context_t& ctx )
+{
+    for( idx_t n : ctx.opts.sizes ) {
+        ctx.run<T>( "potrf2", {n,n,1}, lapack::Gflop<T>::potrf(n),
+            [&]( auto& B, auto&& time ) {
+                auto A0 = B.matrix( n, n );
+                auto A = B.matrix( n, n );
+                random_hpd( A0.view, ctx.gen );
+                time(
+                    [&]() { copy_matrix( A0.view, A.view ); },
+                    [&]() { lapack::potrf2( lapack::lower_triangle, A.view ); } );
+            } );
+    }
+}
+
+template< class T >
+void bench_potrf( context_t& ctx )
+{
+    for( idx_t n : ctx.opts.sizes ) {
+        ctx.run<T>( "potrf", {n,n,1}, lapack::Gflop<T>::potrf(n),
+            [&]( auto& B, auto&& time ) {
+                auto A0 = B.matrix( n, n );
+                auto A = B.matrix( n, n );
+                random_hpd( A0.view, ctx.gen );
+                time(
+                    [&]() { copy_matrix( A0.view, A.view ); },
+                    [&]() { lapack::potrf( lapack::lower_triangle, A.view ); } );
+            } );
+    }
+}
+
+// -----------------------------------------------------------------------------
+// LU factorization
+
+template< class T >
+void bench_getrf( context_t& ctx )
+{
+    for( idx_t n : ctx.opts.sizes ) {
+        ctx.run<T>( "getrf", {n,n,1}, lapack::Gflop<T>::getrf(n,n),
+            [&]( auto& B, auto&& time ) {
+                auto A0 = B.matrix( n, n );
+                auto A = B.matrix( n, n );
+                auto piv = B.index_vector( n );
+                random_matrix( A0.view, ctx.gen );
+                time(
+                    [&]() { copy_matrix( A0.view, A.view ); },
+                    [&]() { lapack::getrf( A.view, piv.view ); } );
+            },
+            [&]( auto& B, auto&& time ) {
+                auto A0 = B.matrix( n, n );
+                auto A = B.matrix( n, n );
+                auto piv = B.index_vector( n );
+                random_matrix( A0.view, ctx.gen );
+                time(
+                    [&]() { copy_matrix( A0.view, A.view ); },
+                    [&]() { lapack::getrf( n, n, A.ptr(), A.ld, piv.ptr() ); } );
+            } );
+    }
+}
+
+template< class T >
+void bench_getrs( context_t& ctx )
+{
+    for( idx_t n : ctx.opts.sizes ) {
+        ctx.run<T>( "getrs", {n,n,1}, lapack::Gflop<T>::getrs(n,n),
+            [&]( auto& B, auto&& time ) {
+                auto A = B.matrix( n, n );
+                auto piv = B.index_vector( n );
+                auto X0 = B.matrix( n, n );
+                auto X = B.matrix( n, n );
+                random_dominant( A.view, ctx.gen );
+                random_matrix( X0.view, ctx.gen );
+                lapack::getrf( A.view, piv.view );
+                time(
+                    [&]() { copy_matrix( X0.view, X.view ); },
+                    [&]() {
+                        lapack::getrs( lapack::noTranspose, A.view, piv.view, X.view );
+                    } );
+            },
+            [&]( auto& B, auto&& time ) {
+                auto A = B.matrix( n, n );
+                auto piv = B.index_vector( n );
+                auto X0 = B.matrix( n, n );
+                auto X = B.matrix( n, n );
+                random_dominant( A.view, ctx.gen );
+                random_matrix( X0.view, ctx.gen );
+                lapack::getrf( n, n, A.ptr(), A.ld, piv.ptr() );
+                time(
+                    [&]() { copy_matrix( X0.view, X.view ); },
+                    [&]() {
+                        lapack::getrs( lapack::Op::NoTrans, n, n,
+                            A.ptr(), A.ld, piv.ptr(), X.ptr(), X.ld );
+                    } );
+            } );
+    }
+}
+
+template< class T >
+void bench_getrf_calu( context_t& ctx )
+{
+    for( idx_t n : ctx.opts.sizes ) {
+        ctx.run<T>( "getrf_calu", {n,n,1}, lapack::Gflop<T>::getrf(n,n),
+            [&]( auto& B, auto&& time ) {
+                auto A0 = B.matrix( n, n );
+                auto A = B.matrix( n, n );
+                auto piv = B.index_vector( n );
+                random_matrix( A0.view, ctx.gen );
+                const lapack::workinfo_t wi =
+                    lapack::getrf_calu_worksize( A.view, piv.view, nblocks );
+                auto W = B.matrix( wi.m, wi.n );
+                time(
+                    [&]() { copy_matrix( A0.view, A.view ); },
+                    [&]() { lapack::getrf_calu( A.view, piv.view, W.view ); } );
+            } );
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+std::vector< routine_t > lapack_routines()
+{
+    return {
+        // Auxiliary routines
+        TLAPACK_BENCH( larf ),
+        TLAPACK_BENCH( larfg ),
+        TLAPACK_BENCH( larft ),
+        TLAPACK_BENCH( larfb ),
+        TLAPACK_BENCH( laset ),
+        TLAPACK_BENCH( lacpy ),
+        TLAPACK_BENCH( lascl ),
+        TLAPACK_BENCH( lange ),
+        TLAPACK_BENCH( lansy ),
+        TLAPACK_BENCH( larnv ),
+        TLAPACK_BENCH( lassq ),
+        TLAPACK_BENCH( laswp ),
+        // QR factorization
+        TLAPACK_BENCH( geqr2 ),
+        TLAPACK_BENCH( geqrt3 ),
+        TLAPACK_BENCH( geqrf ),
+        TLAPACK_BENCH( geqrt ),
+        TLAPACK_BENCH( tsqrt ),
+        TLAPACK_BENCH( tsqr ),
+        TLAPACK_BENCH( tsqr_update ),
+        TLAPACK_BENCH( org2r ),
+        TLAPACK_BENCH( ungqr ),
+        TLAPACK_BENCH( unmqr ),
+        TLAPACK_BENCH( unmqrt ),
+        TLAPACK_BENCH( tsmqrt ),
+        TLAPACK_BENCH( unmtsqr ),
+        TLAPACK_BENCH( potrf2 ),
+        TLAPACK_BENCH( potrf ),
+        // LU factorization
+        TLAPACK_BENCH( getrf ),
+        TLAPACK_BENCH( getrs ),
+        TLAPACK_BENCH( getrf_calu ),
+    };
+}
+
+} // namespace bench
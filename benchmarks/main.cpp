@@ -0,0 +1,200 @@
+/// @file main.cpp Driver of the <T>LAPACK benchmarks.
+//
+// Copyright (c) 2021, University of Colorado Denver. All rights reserved.
+//
+// This file is part of <T>LAPACK.
+// <T>LAPACK is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "bench.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+namespace bench {
+
+void print_header()
+{
+    std::printf( "%-12s %4s %-8s %8s %8s %8s %12s %12s %10s\n",
+        "routine", "type", "backend", "m", "n", "k",
+        "time (s)", "avg (s)", "Gflop/s" );
+}
+
+void print_result( const result_t& r )
+{
+    std::printf( "%-12s %4c %-8s %8zu %8zu %8zu %12.4e %12.4e ",
+        r.routine.c_str(), r.type, r.backend.c_str(),
+        r.dims.m, r.dims.n, r.dims.k, r.time, r.time_avg );
+    if( r.gflop > 0 && r.time > 0 )
+        std::printf( "%10.3f\n", r.gflop / r.time );
+    else
+        std::printf( "%10s\n", "-" );
+    std::fflush( stdout );
+}
+
+bool write_json( const std::string& file, const context_t& ctx )
+{
+    std::ofstream out( file );
+    if( !out )
+        return false;
+
+    out.precision( 6 );
+    out << "{\n  \"context\": {\n";
+    #if defined(__VERSION__)
+        out << "    \"compiler\": \"" << __VERSION__ << "\",\n";
+    #endif
+    out << "    \"num_threads\": " << blas::get_num_threads() << ",\n";
+    out << "    \"nruns\": " << ctx.opts.nruns << ",\n";
+    out << "    \"min_time\": " << ctx.opts.min_time << ",\n";
+    out << "    \"sizes\": [";
+    for( idx_t i = 0; i < ctx.opts.sizes.size(); ++i )
+        out << ( (i > 0) ? ", " : "" ) << ctx.opts.sizes[i];
+    out << "]\n  },\n  \"results\": [";
+
+    for( idx_t i = 0; i < ctx.results.size(); ++i ) {
+        const result_t& r = ctx.results[i];
+        out << ( (i > 0) ? "," : "" ) << "\n    { "
+            << "\"routine\": \"" << r.routine << "\", "
+            << "\"type\": \"" << r.type << "\", "
+            << "\"backend\": \"" << r.backend << "\", "
+            << "\"m\": " << r.dims.m << ", "
+            << "\"n\": " << r.dims.n << ", "
+            << "\"k\": " << r.dims.k << ", "
+            << "\"time\": " << r.time << ", "
+            << "\"time_avg\": " << r.time_avg << ", "
+            << "\"gflops\": ";
+        if( r.gflop > 0 && r.time > 0 )
+            out << r.gflop / r.time;
+        else
+            out << "null";
+        out << " }";
+    }
+    out << "\n  ]\n}\n";
+
+    return bool( out );
+}
+
+} // namespace bench
+
+namespace {
+
+void usage( const char* prog )
+{
+    std::printf(
+        "Usage: %s [options]\n"
+        "\n"
+        "  --routine r1,r2,...   routines to run (default: all)\n"
+        "  --type    sdcz        scalar types (default: sdcz)\n"
+        "  --backend b1,b2,...   pointer, mdspan and/or eigen (default: all)\n"
+        "  --dim     n1,n2,...   problem sizes (default: 64,128,256,512,1024)\n"
+        "  --nruns   r           measured runs per problem (default: 5)\n"
+        "  --min-time t          minimum duration of a run, in seconds (default: 1e-3)\n"
+        "  --json    file        writes the results to file\n"
+        "  --quiet               does not print the results\n"
+        "  --list                lists the routines\n",
+        prog );
+}
+
+std::vector< std::string > split( const std::string& s )
+{
+    std::vector< std::string > v;
+    std::istringstream is( s );
+    std::string item;
+    while( std::getline( is, item, ',' ) )
+        if( !item.empty() )
+            v.push_back( item );
+    return v;
+}
+
+} // namespace
+
+int main( int argc, char** argv )
+{
+    using namespace bench;
+
+    std::vector< routine_t > routines = blas_routines();
+    for( const routine_t& r : lapack_routines() )
+        routines.push_back( r );
+
+    options_t opts;
+    for( int i = 1; i < argc; ++i ) {
+        const std::string arg = argv[i];
+        const bool has_value = ( i+1 < argc );
+        if( arg == "--list" ) {
+            for( const routine_t& r : routines )
+                std::printf( "%s\n", r.name );
+            return 0;
+        }
+        else if( arg == "--quiet" )
+            opts.verbose = false;
+        else if( arg == "--routine" && has_value )
+            opts.routines = split( argv[++i] );
+        else if( arg == "--type" && has_value )
+            opts.types = argv[++i];
+        else if( arg == "--backend" && has_value )
+            opts.backends = split( argv[++i] );
+        else if( arg == "--dim" && has_value ) {
+            opts.sizes.clear();
+            for( const std::string& s : split( argv[++i] ) )
+                opts.sizes.push_back( std::strtoul( s.c_str(), nullptr, 10 ) );
+        }
+        else if( arg == "--nruns" && has_value )
+            opts.nruns = std::max( 1, std::atoi( argv[++i] ) );
+        else if( arg == "--min-time" && has_value )
+            opts.min_time = std::atof( argv[++i] );
+        else if( arg == "--json" && has_value )
+            opts.json = argv[++i];
+        else {
+            usage( argv[0] );
+            return ( arg == "--help" || arg == "-h" ) ? 0 : 1;
+        }
+    }
+
+    #ifndef TLAPACK_BENCH_EIGEN
+    for( const std::string& b : opts.backends )
+        if( b == "eigen" )
+            std::fprintf( stderr, "Eigen was not found: the eigen back-end is skipped.\n" );
+    #endif
+
+    // Check the names of the routines
+    for( const std::string& name : opts.routines ) {
+        bool found = false;
+        for( const routine_t& r : routines )
+            found = found || ( name == r.name );
+        if( !found ) {
+            std::fprintf( stderr, "Unknown routine: %s. See --list.\n", name.c_str() );
+            return 1;
+        }
+    }
+
+    context_t ctx( opts );
+    if( opts.verbose )
+        print_header();
+
+    const char types[] = "sdcz";
+    for( const routine_t& r : routines ) {
+        if( !opts.routines.empty() &&
+            std::find( opts.routines.begin(), opts.routines.end(), r.name )
+                == opts.routines.end() )
+            continue;
+        for( int t = 0; t < 4; ++t ) {
+            if( r.run[t] && opts.types.find( types[t] ) != std::string::npos )
+                r.run[t]( ctx );
+        }
+    }
+
+    if( !opts.json.empty() ) {
+        if( !write_json( opts.json, ctx ) ) {
+            std::fprintf( stderr, "Could not write %s\n", opts.json.c_str() );
+            return 1;
+        }
+        if( opts.verbose )
+            std::printf( "Results written to %s\n", opts.json.c_str() );
+    }
+
+    return 0;
+}
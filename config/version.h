@@ -0,0 +1,16 @@
+// Copyright (c) 2021, University of Colorado Denver. All rights reserved.
+//
+// This file is part of <T>LAPACK.
+// <T>LAPACK is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef __TLAPACK_VERSION_H__
+#define __TLAPACK_VERSION_H__
+
+// the configured options and settings for <T>LAPACK
+#define TLAPACK_VERSION 0.1.1
+#define TLAPACK_VERSION_MAJOR 0
+#define TLAPACK_VERSION_MINOR 1
+#define TLAPACK_VERSION_PATCH 1
+
+#endif // __TLAPACK_VERSION_H__
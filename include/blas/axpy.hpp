@@ -9,9 +9,42 @@
 #define BLAS_AXPY_HH
 
 #include "blas/utils.hpp"
+#include "blas/dispatch.hpp"
+#include "blas/storage.hpp"
 
 namespace blas {
 
+namespace internal {
+
+/// y += alpha x on raw pointers if x and y have unit stride.
+/// Returns false, and does nothing, otherwise.
+template< class vectorX_t, class vectorY_t, class alpha_t,
+    enable_if_t<(
+        has_storage< vectorX_t >::value && has_storage< vectorY_t >::value
+    ), int > = 0 >
+inline bool axpy_contiguous(
+    const alpha_t& alpha,
+    const vectorX_t& x, vectorY_t& y )
+{
+    using idx_t = size_type< vectorY_t >;
+
+    if( storage_inc(x) != 1 || storage_inc(y) != 1 )
+        return false;
+
+    const idx_t n = size(y);
+    const auto* _x = storage_data(x);
+    auto* _y = storage_data(y);
+    for (idx_t i = 0; i < n; ++i)
+        _y[i] += alpha * _x[i];
+
+    return true;
+}
+
+template< class... Ts >
+inline constexpr bool axpy_contiguous( const Ts&... ) { return false; }
+
+} // namespace internal
+
 /**
  * Add scaled vector, $y = \alpha x + y$.
  *
@@ -52,6 +85,15 @@ void axpy(
     // check arguments
     blas_error_if( size(x) != n );
 
+    // call BLAS++ on large problems
+    #ifdef USE_BLASPP_WRAPPERS
+        if( internal::dispatch_axpy( alpha, x, y ) )
+            return;
+    #endif
+
+    if( internal::axpy_contiguous( alpha, x, y ) )
+        return;
+
     for (idx_t i = 0; i < n; ++i)
         y[i] += alpha * x[i];
 }
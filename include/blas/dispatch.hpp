@@ -0,0 +1,620 @@
+/// @file dispatch.hpp Runtime dispatch between the templates and BLAS++.
+//
+// Copyright (c) 2021, University of Colorado Denver. All rights reserved.
+//
+// This file is part of <T>LAPACK.
+// <T>LAPACK is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef BLAS_DISPATCH_HH
+#define BLAS_DISPATCH_HH
+
+#include "blas/types.hpp"
+#include "blas/storage.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <atomic>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+#ifndef TLAPACK_STATIC_TUNING
+    #include <cstdlib>
+    #include <fstream>
+    #include <sstream>
+    #include <string>
+#endif
+
+#ifdef USE_BLASPP_WRAPPERS
+    #ifndef BLAS_UTIL_HH
+        #define BLAS_UTIL_HH // So as not to include utils from BLAS++
+    #endif
+    #include "blas/wrappers.hh" // from BLAS++
+#endif
+
+namespace blas {
+
+namespace internal {
+
+/// Routines that may call BLAS++
+enum class dispatch_id {
+    axpy, dot, nrm2, scal,
+    gemv, ger, symv, trmv, trsv,
+    gemm, symm, syrk, syr2k, trmm, trsm,
+    count
+};
+
+constexpr std::size_t num_dispatch = std::size_t( dispatch_id::count );
+
+inline const char* dispatch_name( dispatch_id id ) {
+    static const char* names[ num_dispatch ] = {
+        "axpy", "dot", "nrm2", "scal",
+        "gemv", "ger", "symv", "trmv", "trsv",
+        "gemm", "symm", "syrk", "syr2k", "trmm", "trsm" };
+    return names[ std::size_t(id) ];
+}
+
+/// Threshold used when no other was set. The sizes are the ones printed by
+/// the BLAS++ testers: the product of the dimensions m, n and k of each
+/// routine, e.g., m*n*k for gemm, m*n for trsm and n for trsv.
+inline constexpr std::size_t default_dispatch_threshold( dispatch_id id ) {
+    return ( id <= dispatch_id::scal ) ? 8192           // Level 1
+         : ( id <= dispatch_id::ger  ) ? 128*128        // gemv, ger
+         : ( id <= dispatch_id::trsv ) ? 128            // symv, trmv, trsv
+         : ( id == dispatch_id::gemm ) ? 64*64*64
+         :                               64*64;         // other Level 3
+}
+
+/// Index of T in the registry, or -1 if T is not dispatched
+template< class T > constexpr int dispatch_type_index() { return -1; }
+template<> constexpr int dispatch_type_index< float >() { return 0; }
+template<> constexpr int dispatch_type_index< double >() { return 1; }
+
+struct dispatch_registry {
+    std::atomic< std::size_t > threshold[ num_dispatch ][ 2 ];
+
+    dispatch_registry() { reset(); }
+
+    void reset() {
+        for( std::size_t i = 0; i < num_dispatch; ++i )
+            for( int t = 0; t < 2; ++t )
+                threshold[i][t].store(
+                    default_dispatch_threshold( dispatch_id(i) ),
+                    std::memory_order_relaxed );
+    }
+
+    /// Sets the threshold of a routine ("*" for all) and type ('s', 'd' or
+    /// '*' for both). Returns false if the routine or the type is unknown.
+    bool set( const char* routine, char type, std::size_t size ) {
+        const int t0 = ( type == 'd' ) ? 1 : 0;
+        const int t1 = ( type == 's' ) ? 1 : 2;
+        if( type != 's' && type != 'd' && type != '*' )
+            return false;
+
+        bool found = false;
+        for( std::size_t i = 0; i < num_dispatch; ++i ) {
+            if( std::strcmp( routine, "*" ) != 0 &&
+                std::strcmp( routine, dispatch_name( dispatch_id(i) ) ) != 0 )
+                continue;
+            for( int t = t0; t < t1; ++t )
+                threshold[i][t].store( size, std::memory_order_relaxed );
+            found = true;
+        }
+        return found;
+    }
+};
+
+#ifndef TLAPACK_STATIC_TUNING
+
+/// Sets the thresholds in the file. Lines with an unknown routine or type are
+/// ignored. Returns false if the file could not be read or has such lines.
+inline bool read_dispatch_file( const char* path, dispatch_registry& registry )
+{
+    std::ifstream file( path );
+    if( !file )
+        return false;
+
+    bool ok = true;
+    std::string line;
+    while( std::getline( file, line ) ) {
+        const std::size_t c = line.find( '#' );
+        if( c != std::string::npos )
+            line.erase( c );
+        std::istringstream is( line );
+        std::string routine;
+        char type;
+        std::size_t size;
+        if( is >> routine >> type >> size &&
+            !registry.set( routine.c_str(), type, size ) )
+            ok = false;
+    }
+
+    return ok;
+}
+
+#endif // TLAPACK_STATIC_TUNING
+
+/// The registry. On first use, it reads the file TLAPACK_DISPATCH_FILE if
+/// this environment variable is set.
+inline dispatch_registry& get_dispatch_registry() {
+    static dispatch_registry* registry = []() {
+        dispatch_registry* r = new dispatch_registry;
+        #ifndef TLAPACK_STATIC_TUNING
+            if( const char* path = std::getenv( "TLAPACK_DISPATCH_FILE" ) )
+                read_dispatch_file( path, *r );
+        #endif
+        return r;
+    }();
+    return *registry;
+}
+
+/// True if a problem of the given size should go to BLAS++
+template< class T >
+inline bool use_blaspp( dispatch_id id, std::size_t size ) {
+    return size >= get_dispatch_registry()
+        .threshold[ std::size_t(id) ][ dispatch_type_index<T>() ]
+        .load( std::memory_order_relaxed );
+}
+
+} // namespace internal
+
+/** Size from which the generic routine calls BLAS++ for the type T.
+ *
+ * For float and double, when <T>LAPACK is built with USE_BLASPP_WRAPPERS,
+ * the generic Level 1, 2 and 3 routines axpy, dot, nrm2, scal, gemv, ger,
+ * symv, trmv, trsv, gemm, symm, syrk, syr2k, trmm and trsm forward the
+ * problems of size at least this threshold to BLAS++, provided all the
+ * arrays have strided storage with unit stride between rows, i.e.,
+ * column-major matrices and vectors with any increment. Smaller problems,
+ * and the others, are computed by the templates.
+ *
+ * The size of a problem is the product of its dimensions m, n and k, as
+ * printed by the BLAS++ testers, e.g., m*n*k for gemm, m*n for gemv and
+ * trsm, and n for trsv and axpy.
+ *
+ * The thresholds start with the defaults in
+ * internal::default_dispatch_threshold(), updated with the file named by
+ * the environment variable TLAPACK_DISPATCH_FILE, if any. Each line of the
+ * file has the format
+ *
+ *     routine type size
+ *
+ * where routine is one of the routines above or '*', type is 's', 'd' or
+ * '*', and '#' starts a comment. Lines with other routines or types are
+ * ignored; load_dispatch_file() reports them. The script
+ * test/compare_backends.py writes such a file from measurements. Define
+ * TLAPACK_STATIC_TUNING so that no file is read.
+ *
+ * @return the threshold, or the maximum of std::size_t if T is not float
+ *      or double or if routine has no dispatch.
+ *
+ * @ingroup utils
+ */
+template< class T >
+inline std::size_t get_dispatch_threshold( const char* routine )
+{
+    constexpr int t = internal::dispatch_type_index<T>();
+    if( t >= 0 ) {
+        auto& registry = internal::get_dispatch_registry();
+        for( std::size_t i = 0; i < internal::num_dispatch; ++i )
+            if( std::strcmp( routine,
+                    internal::dispatch_name( internal::dispatch_id(i) ) ) == 0 )
+                return registry.threshold[i][t].load( std::memory_order_relaxed );
+    }
+    return std::numeric_limits< std::size_t >::max();
+}
+
+/** Sets the size from which a routine calls BLAS++.
+ *
+ * @param[in] routine Name of the routine, or "*" for all.
+ * @param[in] type 's' for float, 'd' for double, or '*' for both.
+ * @param[in] size New threshold. 0 sends all problems to BLAS++, and the
+ *      maximum of std::size_t sends none.
+ *
+ * @return false if the routine or the type is unknown.
+ *
+ * @see get_dispatch_threshold()
+ *
+ * @ingroup utils
+ */
+inline bool set_dispatch_threshold(
+    const char* routine, char type, std::size_t size )
+{
+    return internal::get_dispatch_registry().set( routine, type, size );
+}
+
+/// Restores the default thresholds
+/// @see get_dispatch_threshold()
+inline void reset_dispatch_thresholds()
+{
+    internal::get_dispatch_registry().reset();
+}
+
+#ifndef TLAPACK_STATIC_TUNING
+
+/** Sets the thresholds in a file with lines "routine type size".
+ *
+ * The lines with an unknown routine or type are ignored, and the other
+ * lines are applied.
+ *
+ * @return false if the file could not be read, or if it has a line with an
+ *      unknown routine or type.
+ *
+ * @see get_dispatch_threshold()
+ *
+ * @ingroup utils
+ */
+inline bool load_dispatch_file( const char* path )
+{
+    return internal::read_dispatch_file( path, internal::get_dispatch_registry() );
+}
+
+#endif // TLAPACK_STATIC_TUNING
+
+#ifdef USE_BLASPP_WRAPPERS
+
+namespace internal {
+
+// -----------------------------------------------------------------------------
+// Arrays that can be passed to BLAS++
+
+/// True if T is float or double and all arrays have type T and strided storage
+template< class T >
+constexpr bool blaspp_arrays() {
+    return dispatch_type_index<T>() >= 0;
+}
+template< class T, class array_t, class... arrays_t >
+constexpr bool blaspp_arrays() {
+    return has_storage< array_t >::value
+        && std::is_same< T, std::remove_const_t< type_t<array_t> > >::value
+        && blaspp_arrays< T, arrays_t... >();
+}
+
+/// Leading dimension of a column-major matrix, or 0 if the matrix is not
+/// column major with unit stride between rows
+template< class matrix_t >
+inline std::int64_t blaspp_ld( const matrix_t& A ) {
+    const std::int64_t m  = nrows(A);
+    const std::int64_t n  = ncols(A);
+    const std::int64_t ld = ( n > 1 )
+        ? std::int64_t( storage_stride( A, 1 ) )
+        : ( ( m > 1 ) ? m : 1 );
+    if( m > 1 && std::int64_t( storage_stride( A, 0 ) ) != 1 )
+        return 0;
+    return ( ld >= m && ld >= 1 ) ? ld : 0;
+}
+
+/// Increment of a vector, or 0 if it has no positive increment
+template< class vector_t >
+inline std::int64_t blaspp_inc( const vector_t& x ) {
+    if( size(x) <= 1 )
+        return 1;
+    const std::int64_t inc = storage_stride( x, 0 );
+    return ( inc > 0 ) ? inc : 0;
+}
+
+/// BLAS++ has no Op::Conj, which is Op::NoTrans on real data
+inline Op blaspp_op( Op trans ) {
+    return ( trans == Op::Conj ) ? Op::NoTrans : trans;
+}
+
+/// Copies the upper triangle of C to the lower one, for Uplo::General
+template< class matrix_t >
+inline void symmetrize_upper( matrix_t& C ) {
+    using idx_t = size_type< matrix_t >;
+    const idx_t n = nrows(C);
+    for( idx_t j = 0; j < n; ++j )
+        for( idx_t i = j+1; i < n; ++i )
+            C(i,j) = C(j,i);
+}
+
+template< class T, class... arrays_t >
+using enable_blaspp_t = enable_if_t< blaspp_arrays< T, arrays_t... >(), int >;
+
+// -----------------------------------------------------------------------------
+// Each dispatch_<routine> calls BLAS++ and returns true if the problem is
+// large enough and all the arrays can be forwarded without a copy.
+// Otherwise, it returns false and the template computes the problem.
+
+// Level 1
+
+template< class vectorX_t, class vectorY_t, class alpha_t,
+    class T = std::remove_const_t< type_t<vectorY_t> >,
+    enable_blaspp_t< T, vectorX_t, vectorY_t > = 0 >
+inline bool dispatch_axpy(
+    const alpha_t& alpha, const vectorX_t& x, vectorY_t& y )
+{
+    const std::int64_t n = size(x);
+    const std::int64_t incx = blaspp_inc(x), incy = blaspp_inc(y);
+    if( !use_blaspp<T>( dispatch_id::axpy, n ) || !incx || !incy )
+        return false;
+    ::blas::axpy( n, T(alpha), storage_data(x), incx, storage_data(y), incy );
+    return true;
+}
+template< class... Ts >
+inline constexpr bool dispatch_axpy( const Ts&... ) { return false; }
+
+template< class vectorX_t, class vectorY_t, class result_t,
+    class T = std::remove_const_t< type_t<vectorX_t> >,
+    enable_blaspp_t< T, vectorX_t, vectorY_t > = 0 >
+inline bool dispatch_dot(
+    const vectorX_t& x, const vectorY_t& y, result_t& result )
+{
+    const std::int64_t n = size(x);
+    const std::int64_t incx = blaspp_inc(x), incy = blaspp_inc(y);
+    if( !use_blaspp<T>( dispatch_id::dot, n ) || !incx || !incy )
+        return false;
+    result = ::blas::dot( n, storage_data(x), incx, storage_data(y), incy );
+    return true;
+}
+template< class... Ts >
+inline constexpr bool dispatch_dot( const Ts&... ) { return false; }
+
+template< class vector_t, class result_t,
+    class T = std::remove_const_t< type_t<vector_t> >,
+    enable_blaspp_t< T, vector_t > = 0 >
+inline bool dispatch_nrm2( const vector_t& x, result_t& result )
+{
+    const std::int64_t n = size(x);
+    const std::int64_t incx = blaspp_inc(x);
+    if( !use_blaspp<T>( dispatch_id::nrm2, n ) || !incx )
+        return false;
+    result = ::blas::nrm2( n, storage_data(x), incx );
+    return true;
+}
+template< class... Ts >
+inline constexpr bool dispatch_nrm2( const Ts&... ) { return false; }
+
+template< class vector_t, class alpha_t,
+    class T = std::remove_const_t< type_t<vector_t> >,
+    enable_blaspp_t< T, vector_t > = 0 >
+inline bool dispatch_scal( const alpha_t& alpha, vector_t& x )
+{
+    const std::int64_t n = size(x);
+    const std::int64_t incx = blaspp_inc(x);
+    if( !use_blaspp<T>( dispatch_id::scal, n ) || !incx )
+        return false;
+    ::blas::scal( n, T(alpha), storage_data(x), incx );
+    return true;
+}
+template< class... Ts >
+inline constexpr bool dispatch_scal( const Ts&... ) { return false; }
+
+// Level 2
+
+template< class matrixA_t, class vectorX_t, class vectorY_t,
+    class alpha_t, class beta_t,
+    class T = std::remove_const_t< type_t<vectorY_t> >,
+    enable_blaspp_t< T, matrixA_t, vectorX_t, vectorY_t > = 0 >
+inline bool dispatch_gemv(
+    Op trans, const alpha_t& alpha, const matrixA_t& A, const vectorX_t& x,
+    const beta_t& beta, vectorY_t& y )
+{
+    const std::int64_t m = nrows(A), n = ncols(A);
+    const std::int64_t lda = blaspp_ld(A);
+    const std::int64_t incx = blaspp_inc(x), incy = blaspp_inc(y);
+    if( !use_blaspp<T>( dispatch_id::gemv, m*n ) || !lda || !incx || !incy )
+        return false;
+    ::blas::gemv( Layout::ColMajor, blaspp_op(trans), m, n,
+        T(alpha), storage_data(A), lda, storage_data(x), incx,
+        T(beta), storage_data(y), incy );
+    return true;
+}
+template< class... Ts >
+inline constexpr bool dispatch_gemv( const Ts&... ) { return false; }
+
+template< class matrixA_t, class vectorX_t, class vectorY_t, class alpha_t,
+    class T = std::remove_const_t< type_t<matrixA_t> >,
+    enable_blaspp_t< T, matrixA_t, vectorX_t, vectorY_t > = 0 >
+inline bool dispatch_ger(
+    const alpha_t& alpha, const vectorX_t& x, const vectorY_t& y, matrixA_t& A )
+{
+    const std::int64_t m = nrows(A), n = ncols(A);
+    const std::int64_t lda = blaspp_ld(A);
+    const std::int64_t incx = blaspp_inc(x), incy = blaspp_inc(y);
+    if( !use_blaspp<T>( dispatch_id::ger, m*n ) || !lda || !incx || !incy )
+        return false;
+    ::blas::ger( Layout::ColMajor, m, n,
+        T(alpha), storage_data(x), incx, storage_data(y), incy,
+        storage_data(A), lda );
+    return true;
+}
+template< class... Ts >
+inline constexpr bool dispatch_ger( const Ts&... ) { return false; }
+
+template< class matrixA_t, class vectorX_t, class vectorY_t,
+    class alpha_t, class beta_t,
+    class T = std::remove_const_t< type_t<vectorY_t> >,
+    enable_blaspp_t< T, matrixA_t, vectorX_t, vectorY_t > = 0 >
+inline bool dispatch_symv(
+    Uplo uplo, const alpha_t& alpha, const matrixA_t& A, const vectorX_t& x,
+    const beta_t& beta, vectorY_t& y )
+{
+    const std::int64_t n = nrows(A);
+    const std::int64_t lda = blaspp_ld(A);
+    const std::int64_t incx = blaspp_inc(x), incy = blaspp_inc(y);
+    if( !use_blaspp<T>( dispatch_id::symv, n ) || !lda || !incx || !incy )
+        return false;
+    ::blas::symv( Layout::ColMajor, uplo, n,
+        T(alpha), storage_data(A), lda, storage_data(x), incx,
+        T(beta), storage_data(y), incy );
+    return true;
+}
+template< class... Ts >
+inline constexpr bool dispatch_symv( const Ts&... ) { return false; }
+
+template< class matrixA_t, class vectorX_t,
+    class T = std::remove_const_t< type_t<vectorX_t> >,
+    enable_blaspp_t< T, matrixA_t, vectorX_t > = 0 >
+inline bool dispatch_trmv(
+    Uplo uplo, Op trans, Diag diag, const matrixA_t& A, vectorX_t& x )
+{
+    const std::int64_t n = nrows(A);
+    const std::int64_t lda = blaspp_ld(A);
+    const std::int64_t incx = blaspp_inc(x);
+    if( !use_blaspp<T>( dispatch_id::trmv, n ) || !lda || !incx )
+        return false;
+    ::blas::trmv( Layout::ColMajor, uplo, blaspp_op(trans), diag, n,
+        storage_data(A), lda, storage_data(x), incx );
+    return true;
+}
+template< class... Ts >
+inline constexpr bool dispatch_trmv( const Ts&... ) { return false; }
+
+template< class matrixA_t, class vectorX_t,
+    class T = std::remove_const_t< type_t<vectorX_t> >,
+    enable_blaspp_t< T, matrixA_t, vectorX_t > = 0 >
+inline bool dispatch_trsv(
+    Uplo uplo, Op trans, Diag diag, const matrixA_t& A, vectorX_t& x )
+{
+    const std::int64_t n = nrows(A);
+    const std::int64_t lda = blaspp_ld(A);
+    const std::int64_t incx = blaspp_inc(x);
+    if( !use_blaspp<T>( dispatch_id::trsv, n ) || !lda || !incx )
+        return false;
+    ::blas::trsv( Layout::ColMajor, uplo, blaspp_op(trans), diag, n,
+        storage_data(A), lda, storage_data(x), incx );
+    return true;
+}
+template< class... Ts >
+inline constexpr bool dispatch_trsv( const Ts&... ) { return false; }
+
+// Level 3
+
+template< class matrixA_t, class matrixB_t, class matrixC_t,
+    class alpha_t, class beta_t,
+    class T = std::remove_const_t< type_t<matrixC_t> >,
+    enable_blaspp_t< T, matrixA_t, matrixB_t, matrixC_t > = 0 >
+inline bool dispatch_gemm(
+    Op transA, Op transB,
+    const alpha_t& alpha, const matrixA_t& A, const matrixB_t& B,
+    const beta_t& beta, matrixC_t& C )
+{
+    const std::int64_t m = nrows(C), n = ncols(C);
+    const std::int64_t k = (transA == Op::NoTrans) ? ncols(A) : nrows(A);
+    const std::int64_t lda = blaspp_ld(A), ldb = blaspp_ld(B), ldc = blaspp_ld(C);
+    if( !use_blaspp<T>( dispatch_id::gemm, m*n*k ) || !lda || !ldb || !ldc )
+        return false;
+    ::blas::gemm( Layout::ColMajor, transA, transB, m, n, k,
+        T(alpha), storage_data(A), lda, storage_data(B), ldb,
+        T(beta), storage_data(C), ldc );
+    return true;
+}
+template< class... Ts >
+inline constexpr bool dispatch_gemm( const Ts&... ) { return false; }
+
+template< class matrixA_t, class matrixB_t, class matrixC_t,
+    class alpha_t, class beta_t,
+    class T = std::remove_const_t< type_t<matrixC_t> >,
+    enable_blaspp_t< T, matrixA_t, matrixB_t, matrixC_t > = 0 >
+inline bool dispatch_symm(
+    Side side, Uplo uplo,
+    const alpha_t& alpha, const matrixA_t& A, const matrixB_t& B,
+    const beta_t& beta, matrixC_t& C )
+{
+    const std::int64_t m = nrows(C), n = ncols(C);
+    const std::int64_t lda = blaspp_ld(A), ldb = blaspp_ld(B), ldc = blaspp_ld(C);
+    if( !use_blaspp<T>( dispatch_id::symm, m*n ) || !lda || !ldb || !ldc )
+        return false;
+    ::blas::symm( Layout::ColMajor, side,
+        ( uplo == Uplo::Lower ) ? Uplo::Lower : Uplo::Upper, m, n,
+        T(alpha), storage_data(A), lda, storage_data(B), ldb,
+        T(beta), storage_data(C), ldc );
+    return true;
+}
+template< class... Ts >
+inline constexpr bool dispatch_symm( const Ts&... ) { return false; }
+
+template< class matrixA_t, class matrixC_t, class alpha_t, class beta_t,
+    class T = std::remove_const_t< type_t<matrixC_t> >,
+    enable_blaspp_t< T, matrixA_t, matrixC_t > = 0 >
+inline bool dispatch_syrk(
+    Uplo uplo, Op trans,
+    const alpha_t& alpha, const matrixA_t& A,
+    const beta_t& beta, matrixC_t& C )
+{
+    const std::int64_t n = nrows(C);
+    const std::int64_t k = (trans == Op::NoTrans) ? ncols(A) : nrows(A);
+    const std::int64_t lda = blaspp_ld(A), ldc = blaspp_ld(C);
+    if( !use_blaspp<T>( dispatch_id::syrk, n*k ) || !lda || !ldc )
+        return false;
+    ::blas::syrk( Layout::ColMajor,
+        ( uplo == Uplo::Lower ) ? Uplo::Lower : Uplo::Upper, trans, n, k,
+        T(alpha), storage_data(A), lda, T(beta), storage_data(C), ldc );
+    if( uplo == Uplo::General )
+        symmetrize_upper( C );
+    return true;
+}
+template< class... Ts >
+inline constexpr bool dispatch_syrk( const Ts&... ) { return false; }
+
+template< class matrixA_t, class matrixB_t, class matrixC_t,
+    class alpha_t, class beta_t,
+    class T = std::remove_const_t< type_t<matrixC_t> >,
+    enable_blaspp_t< T, matrixA_t, matrixB_t, matrixC_t > = 0 >
+inline bool dispatch_syr2k(
+    Uplo uplo, Op trans,
+    const alpha_t& alpha, const matrixA_t& A, const matrixB_t& B,
+    const beta_t& beta, matrixC_t& C )
+{
+    const std::int64_t n = nrows(C);
+    const std::int64_t k = (trans == Op::NoTrans) ? ncols(A) : nrows(A);
+    const std::int64_t lda = blaspp_ld(A), ldb = blaspp_ld(B), ldc = blaspp_ld(C);
+    if( !use_blaspp<T>( dispatch_id::syr2k, n*k ) || !lda || !ldb || !ldc )
+        return false;
+    ::blas::syr2k( Layout::ColMajor,
+        ( uplo == Uplo::Lower ) ? Uplo::Lower : Uplo::Upper, trans, n, k,
+        T(alpha), storage_data(A), lda, storage_data(B), ldb,
+        T(beta), storage_data(C), ldc );
+    if( uplo == Uplo::General )
+        symmetrize_upper( C );
+    return true;
+}
+template< class... Ts >
+inline constexpr bool dispatch_syr2k( const Ts&... ) { return false; }
+
+template< class matrixA_t, class matrixB_t, class alpha_t,
+    class T = std::remove_const_t< type_t<matrixB_t> >,
+    enable_blaspp_t< T, matrixA_t, matrixB_t > = 0 >
+inline bool dispatch_trmm(
+    Side side, Uplo uplo, Op trans, Diag diag,
+    const alpha_t& alpha, const matrixA_t& A, matrixB_t& B )
+{
+    const std::int64_t m = nrows(B), n = ncols(B);
+    const std::int64_t lda = blaspp_ld(A), ldb = blaspp_ld(B);
+    if( !use_blaspp<T>( dispatch_id::trmm, m*n ) || !lda || !ldb )
+        return false;
+    ::blas::trmm( Layout::ColMajor, side, uplo, trans, diag, m, n,
+        T(alpha), storage_data(A), lda, storage_data(B), ldb );
+    return true;
+}
+template< class... Ts >
+inline constexpr bool dispatch_trmm( const Ts&... ) { return false; }
+
+template< class matrixA_t, class matrixB_t, class alpha_t,
+    class T = std::remove_const_t< type_t<matrixB_t> >,
+    enable_blaspp_t< T, matrixA_t, matrixB_t > = 0 >
+inline bool dispatch_trsm(
+    Side side, Uplo uplo, Op trans, Diag diag,
+    const alpha_t& alpha, const matrixA_t& A, matrixB_t& B )
+{
+    const std::int64_t m = nrows(B), n = ncols(B);
+    const std::int64_t lda = blaspp_ld(A), ldb = blaspp_ld(B);
+    if( !use_blaspp<T>( dispatch_id::trsm, m*n ) || !lda || !ldb )
+        return false;
+    ::blas::trsm( Layout::ColMajor, side, uplo, trans, diag, m, n,
+        T(alpha), storage_data(A), lda, storage_data(B), ldb );
+    return true;
+}
+template< class... Ts >
+inline constexpr bool dispatch_trsm( const Ts&... ) { return false; }
+
+} // namespace internal
+
+#endif // USE_BLASPP_WRAPPERS
+
+} // namespace blas
+
+#endif // BLAS_DISPATCH_HH
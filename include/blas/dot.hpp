@@ -9,9 +9,41 @@
 #define BLAS_DOT_HH
 
 #include "blas/utils.hpp"
+#include "blas/dispatch.hpp"
+#include "blas/storage.hpp"
 
 namespace blas {
 
+namespace internal {
+
+/// Adds x^H y to result on raw pointers if x and y have unit stride.
+/// Returns false, and does nothing, otherwise.
+template< class vectorX_t, class vectorY_t, class T,
+    enable_if_t<(
+        has_storage< vectorX_t >::value && has_storage< vectorY_t >::value
+    ), int > = 0 >
+inline bool dot_contiguous(
+    const vectorX_t& x, const vectorY_t& y, T& result )
+{
+    using idx_t = size_type< vectorX_t >;
+
+    if( storage_inc(x) != 1 || storage_inc(y) != 1 )
+        return false;
+
+    const idx_t n = size(x);
+    const auto* _x = storage_data(x);
+    const auto* _y = storage_data(y);
+    for (idx_t i = 0; i < n; ++i)
+        result += conj(_x[i]) * _y[i];
+
+    return true;
+}
+
+template< class... Ts >
+inline constexpr bool dot_contiguous( const Ts&... ) { return false; }
+
+} // namespace internal
+
 /**
  * @return dot product, $x^H y$.
  * @see dotu for unconjugated version, $x^T y$.
@@ -53,6 +85,16 @@ auto dot( const vectorX_t& x, const vectorY_t& y )
     blas_error_if( size(y) < n );
 
     T result( 0.0 );
+
+    // call BLAS++ on large problems
+    #ifdef USE_BLASPP_WRAPPERS
+        if( internal::dispatch_dot( x, y, result ) )
+            return result;
+    #endif
+
+    if( internal::dot_contiguous( x, y, result ) )
+        return result;
+
     for (idx_t i = 0; i < n; ++i)
         result += conj(x[i]) * y[i];
 
@@ -9,9 +9,132 @@
 #define BLAS_GEMM_HH
 
 #include "blas/utils.hpp"
+#include "blas/dispatch.hpp"
+#include "blas/gemm_blocked.hpp"
+#include "blas/storage.hpp"
 
 namespace blas {
 
+namespace internal {
+
+/**
+ * Unblocked gemm with loops along the rows of C, op(A) and op(B). This is
+ * the loop order for row-major matrices. The arguments are not checked.
+ *
+ * @ingroup gemm
+ */
+template<
+    class matrixA_t,
+    class matrixB_t, 
+    class matrixC_t, 
+    class alpha_t, 
+    class beta_t >
+void gemm_rowmajor(
+    Op transA,
+    Op transB,
+    const alpha_t& alpha,
+    const matrixA_t& A,
+    const matrixB_t& B,
+    const beta_t& beta,
+    matrixC_t& C )
+{
+    // data traits
+    using TA    = type_t< matrixA_t >;
+    using TB    = type_t< matrixB_t >;
+    using idx_t = size_type< matrixA_t >;
+
+    // using
+    using scalar_t = scalar_type<TA,TB>;
+
+    // constants
+    const idx_t m = nrows(C);
+    const idx_t n = ncols(C);
+    const idx_t k = (transA == Op::NoTrans) ? ncols(A) : nrows(A);
+
+    if (transB == Op::NoTrans) {
+        // C(i,:) = beta C(i,:) + sum_l alpha op(A)(i,l) B(l,:)
+        for(idx_t i = 0; i < m; ++i) {
+            for(idx_t j = 0; j < n; ++j)
+                C(i,j) *= beta;
+            for(idx_t l = 0; l < k; ++l) {
+                const auto alphaTimesail = alpha * (
+                    (transA == Op::NoTrans) ? A(i,l) :
+                    (transA == Op::Trans  ) ? A(l,i) : conj(A(l,i)) );
+                for(idx_t j = 0; j < n; ++j)
+                    C(i,j) += alphaTimesail*B(l,j);
+            }
+        }
+    }
+    else if (transA == Op::NoTrans) {
+        if (transB == Op::Trans) {
+            for(idx_t i = 0; i < m; ++i) {
+                for(idx_t j = 0; j < n; ++j) {
+                    scalar_t sum( 0 );
+                    for(idx_t l = 0; l < k; ++l)
+                        sum += A(i,l)*B(j,l);
+                    C(i,j) = alpha*sum + beta*C(i,j);
+                }
+            }
+        }
+        else { // transB == Op::ConjTrans
+            for(idx_t i = 0; i < m; ++i) {
+                for(idx_t j = 0; j < n; ++j) {
+                    scalar_t sum( 0 );
+                    for(idx_t l = 0; l < k; ++l)
+                        sum += A(i,l)*conj(B(j,l));
+                    C(i,j) = alpha*sum + beta*C(i,j);
+                }
+            }
+        }
+    }
+    else if (transA == Op::Trans) {
+        if (transB == Op::Trans) {
+            for(idx_t i = 0; i < m; ++i) {
+                for(idx_t j = 0; j < n; ++j) {
+                    scalar_t sum( 0 );
+                    for(idx_t l = 0; l < k; ++l)
+                        sum += A(l,i)*B(j,l);
+                    C(i,j) = alpha*sum + beta*C(i,j);
+                }
+            }
+        }
+        else { // transB == Op::ConjTrans
+            for(idx_t i = 0; i < m; ++i) {
+                for(idx_t j = 0; j < n; ++j) {
+                    scalar_t sum( 0 );
+                    for(idx_t l = 0; l < k; ++l)
+                        sum += A(l,i)*conj(B(j,l));
+                    C(i,j) = alpha*sum + beta*C(i,j);
+                }
+            }
+        }
+    }
+    else { // transA == Op::ConjTrans
+        if (transB == Op::Trans) {
+            for(idx_t i = 0; i < m; ++i) {
+                for(idx_t j = 0; j < n; ++j) {
+                    scalar_t sum( 0 );
+                    for(idx_t l = 0; l < k; ++l)
+                        sum += conj(A(l,i))*B(j,l);
+                    C(i,j) = alpha*sum + beta*C(i,j);
+                }
+            }
+        }
+        else { // transB == Op::ConjTrans
+            for(idx_t i = 0; i < m; ++i) {
+                for(idx_t j = 0; j < n; ++j) {
+                    scalar_t sum( 0 );
+                    for(idx_t l = 0; l < k; ++l)
+                        sum += A(l,i)*B(j,l);
+                    C(i,j) = alpha*conj(sum) + beta*C(i,j);
+                }
+            }
+        }
+    }
+}
+
+} // namespace internal
+
 /**
  * General matrix-matrix multiply:
  * \[
@@ -25,6 +148,9 @@ namespace blas {
  * $op(A)$ an m-by-k matrix, $op(B)$ a k-by-n matrix, and C an m-by-n matrix.
  *
  * Generic implementation for arbitrary data types.
+ * Large problems are computed by the cache-blocked, packed engine in
+ * blas/gemm_blocked.hpp. @see gemm_blocksize for the block sizes.
+ * The engine uses get_num_threads() threads.
  *
  * @param[in] transA
  *     The operation $op(A)$ to be used:
@@ -82,11 +208,52 @@ void gemm(
                    transB != Op::Trans &&
                    transB != Op::ConjTrans );
     blas_error_if(
-        m != ((transA == Op::NoTrans) ? nrows(A) : ncols(A)) );
+        m != idx_t( (transA == Op::NoTrans) ? nrows(A) : ncols(A) ) );
     blas_error_if(
-        n != ((transB == Op::NoTrans) ? ncols(B) : nrows(B)) );
+        n != idx_t( (transB == Op::NoTrans) ? ncols(B) : nrows(B) ) );
     blas_error_if(
-        ((transB == Op::NoTrans) ? nrows(B) : ncols(B)) != k );
+        idx_t( (transB == Op::NoTrans) ? nrows(B) : ncols(B) ) != k );
+
+    // quick return
+    if (m == 0 || n == 0)
+        return;
+
+    // call BLAS++ on large problems
+    #ifdef USE_BLASPP_WRAPPERS
+        if( internal::dispatch_gemm( transA, transB, alpha, A, B, beta, C ) )
+            return;
+    #endif
+
+    // Cache-blocked code for large problems
+    {
+        constexpr std::size_t nmin = gemm_blocksize< scalar_t >::min_size;
+        if( std::size_t(m)*std::size_t(n)*std::size_t(k) >= nmin*nmin*nmin ) {
+            // C := beta C
+            if( beta != beta_t(1) ) {
+                if( internal::rowmajor_loops( C ) ) {
+                    for(idx_t i = 0; i < m; ++i)
+                        for(idx_t j = 0; j < n; ++j)
+                            C(i,j) *= beta;
+                }
+                else {
+                    for(idx_t j = 0; j < n; ++j)
+                        for(idx_t i = 0; i < m; ++i)
+                            C(i,j) *= beta;
+                }
+            }
+            // C := alpha op(A) op(B) + C
+            if( alpha != alpha_t(0) )
+                internal::gemm_blocked< scalar_t >(
+                    transA, transB, alpha, A, B, C );
+            return;
+        }
+    }
+
+    // Loops along the rows of a row-major C
+    if( internal::rowmajor_loops( C ) ) {
+        internal::gemm_rowmajor( transA, transB, alpha, A, B, beta, C );
+        return;
+    }
 
     if (transA == Op::NoTrans) {
         if (transB == Op::NoTrans) {
@@ -189,6 +356,34 @@ void gemm(
     }
 }
 
+/**
+ * General matrix-matrix multiply with a given number of threads.
+ * @see gemm( Op, Op, const alpha_t&, const matrixA_t&, const matrixB_t&, const beta_t&, matrixC_t& )
+ *
+ * @param[in] policy Execution policy with the number of threads.
+ *
+ * @ingroup gemm
+ */
+template<
+    class matrixA_t,
+    class matrixB_t, 
+    class matrixC_t, 
+    class alpha_t, 
+    class beta_t >
+inline void gemm(
+    const parallel_policy& policy,
+    Op transA,
+    Op transB,
+    const alpha_t& alpha,
+    const matrixA_t& A,
+    const matrixB_t& B,
+    const beta_t& beta,
+    matrixC_t& C )
+{
+    internal::num_threads_scope scope( policy.num_threads );
+    gemm( transA, transB, alpha, A, B, beta, C );
+}
+
 }  // namespace blas
 
 #endif        //  #ifndef BLAS_GEMM_HH
@@ -0,0 +1,391 @@
+// Copyright (c) 2021, University of Colorado Denver. All rights reserved.
+//
+// This file is part of <T>LAPACK.
+// <T>LAPACK is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef BLAS_GEMM_BATCH_HH
+#define BLAS_GEMM_BATCH_HH
+
+#include "blas/utils.hpp"
+#include "blas/gemm.hpp"
+#include "blas/parallel.hpp"
+
+#include <vector>
+#include <cstddef>
+#include <type_traits>
+#include <algorithm>
+
+// Fully unroll the loops over the interleaved problems
+#ifdef __GNUC__
+    #define TBLAS_UNROLL_BATCH _Pragma("GCC unroll 16")
+#else
+    #define TBLAS_UNROLL_BATCH
+#endif
+
+namespace blas {
+
+/**
+ * Parameters of the compact layout used by the batched routines.
+ *
+ * Uniform batches of small real matrices are processed in groups of
+ * `width` problems. The entries of the matrices of a group are interleaved,
+ * so that entry (i,j) of the `width` problems is contiguous in memory and the
+ * innermost loop, over the problems, maps onto SIMD lanes.
+ *
+ * Specialize this class to tune the batched routines for a given data type.
+ *
+ * @tparam T Type of the entries in the compact buffers.
+ *
+ * @ingroup gemm
+ */
+template< typename T >
+struct batch_blocksize {
+    /// Number of problems interleaved in the compact layout.
+    static constexpr std::size_t width = 8;
+    /// Problems with a dimension larger than max_size are not interleaved.
+    /// It should be smaller than gemm_blocksize<T>::min_size.
+    static constexpr std::size_t max_size = 24;
+};
+
+template<>
+struct batch_blocksize< float > {
+    static constexpr std::size_t width = 16;
+    static constexpr std::size_t max_size = 24;
+};
+
+template<>
+struct batch_blocksize< double > {
+    static constexpr std::size_t width = 8;
+    static constexpr std::size_t max_size = 24;
+};
+
+namespace internal {
+
+    /// Type of the matrices in a range of matrices.
+    template< class range_t >
+    using range_value_t = typename std::decay<
+        decltype( std::declval<range_t&>()[0] ) >::type;
+
+    // -------------------------------------------------------------------------
+    /** Copies op(X_p), m-by-n, for p = 0, ..., np-1, where X_p = X[p0+p], to
+     * the compact buffer: buf[ (j*m + i)*width + p ] = op(X_p)(i,j).
+     *
+     * The lanes np, ..., width-1 are not modified.
+     */
+    template< std::size_t width, class T, class matrix_range, class idx_t >
+    void compact_pack(
+        Op trans, const matrix_range& X, std::size_t p0, std::size_t np,
+        idx_t m, idx_t n, T* buf )
+    {
+        if( trans == Op::NoTrans ) {
+            for(std::size_t p = 0; p < np; ++p) {
+                const auto& Xp = X[p0+p];
+                for(idx_t j = 0; j < n; ++j)
+                    for(idx_t i = 0; i < m; ++i)
+                        buf[ (j*m+i)*width + p ] = Xp(i,j);
+            }
+        }
+        else if( trans == Op::Trans ) {
+            for(std::size_t p = 0; p < np; ++p) {
+                const auto& Xp = X[p0+p];
+                for(idx_t i = 0; i < m; ++i)
+                    for(idx_t j = 0; j < n; ++j)
+                        buf[ (j*m+i)*width + p ] = Xp(j,i);
+            }
+        }
+        else {
+            for(std::size_t p = 0; p < np; ++p) {
+                const auto& Xp = X[p0+p];
+                for(idx_t i = 0; i < m; ++i)
+                    for(idx_t j = 0; j < n; ++j)
+                        buf[ (j*m+i)*width + p ] = conj( Xp(j,i) );
+            }
+        }
+    }
+
+    // -------------------------------------------------------------------------
+    /** Computes c += a b for width interleaved problems, where a is m-by-k,
+     * b is k-by-n and c is m-by-n, all in the compact layout.
+     *
+     * The loops over the problems have a fixed length, so that the compiler
+     * maps them onto SIMD registers. Each entry of c is accumulated in
+     * registers over the whole inner dimension.
+     */
+    template< std::size_t width, class T, class idx_t >
+    #ifdef TBLAS_SIMD_X86
+    __attribute__((always_inline))
+    #endif
+    inline void gemm_compact_kernel_generic(
+        idx_t m, idx_t n, idx_t k,
+        const T* a, const T* b, T* c )
+    {
+        for(idx_t j = 0; j < n; ++j) {
+            for(idx_t i = 0; i < m; ++i) {
+                T acc[ width ];
+                TBLAS_UNROLL_BATCH
+                for(std::size_t p = 0; p < width; ++p)
+                    acc[p] = T(0);
+                for(idx_t l = 0; l < k; ++l) {
+                    const T* ail = a + (l*m+i)*width;
+                    const T* blj = b + (j*k+l)*width;
+                    TBLAS_UNROLL_BATCH
+                    for(std::size_t p = 0; p < width; ++p)
+                        acc[p] += ail[p] * blj[p];
+                }
+                T* cij = c + (j*m+i)*width;
+                TBLAS_UNROLL_BATCH
+                for(std::size_t p = 0; p < width; ++p)
+                    cij[p] += acc[p];
+            }
+        }
+    }
+
+#ifdef TBLAS_SIMD_X86
+
+    // The generic kernel compiled for wider instruction sets
+    template< std::size_t width, class T, class idx_t >
+    __attribute__((target("avx2,fma")))
+    void gemm_compact_kernel_avx2(
+        idx_t m, idx_t n, idx_t k,
+        const T* a, const T* b, T* c )
+    {
+        gemm_compact_kernel_generic<width>( m, n, k, a, b, c );
+    }
+
+    template< std::size_t width, class T, class idx_t >
+    __attribute__((target("avx512f")))
+    void gemm_compact_kernel_avx512(
+        idx_t m, idx_t n, idx_t k,
+        const T* a, const T* b, T* c )
+    {
+        gemm_compact_kernel_generic<width>( m, n, k, a, b, c );
+    }
+
+#endif // TBLAS_SIMD_X86
+
+    /// Compact kernel for the instruction set of the running CPU.
+    template< std::size_t width, class T, class idx_t >
+    inline void gemm_compact_kernel(
+        idx_t m, idx_t n, idx_t k,
+        const T* a, const T* b, T* c )
+    {
+        #ifdef TBLAS_SIMD_X86
+            const simd_isa isa = cpu_simd_isa();
+            if( isa == simd_isa::avx512 )
+                return gemm_compact_kernel_avx512<width>( m, n, k, a, b, c );
+            else if( isa == simd_isa::avx2 )
+                return gemm_compact_kernel_avx2<width>( m, n, k, a, b, c );
+        #endif
+        gemm_compact_kernel_generic<width>( m, n, k, a, b, c );
+    }
+
+    // -------------------------------------------------------------------------
+    /** Uniform batch of small products computed in the compact layout.
+     *
+     * The problems are split in groups of batch_blocksize<T>::width, that are
+     * distributed among nt threads. The last group is padded with zeros.
+     */
+    template< class T,
+              class matrixA_range, class matrixB_range, class matrixC_range,
+              class alpha_t, class beta_t, class idx_t >
+    void gemm_batch_compact(
+        Op transA, Op transB,
+        idx_t m, idx_t n, idx_t k,
+        const alpha_t& alpha,
+        const matrixA_range& A, const matrixB_range& B,
+        const beta_t& beta,
+        matrixC_range& C, int nt )
+    {
+        constexpr std::size_t w = batch_blocksize<T>::width;
+        const std::size_t batch = C.size();
+        const std::size_t ngroups = (batch + w-1) / w;
+        if( nt > int(ngroups) ) nt = int(ngroups);
+
+        parallel_for( nt, nt, [&]( std::size_t t ) {
+            std::vector<T> a( m*k*w ), b( k*n*w ), c( m*n*w );
+            for(std::size_t g = t; g < ngroups; g += nt) {
+                const std::size_t b0 = g*w;
+                const std::size_t np = (batch-b0 < w) ? batch-b0 : w;
+
+                if( np < w ) {
+                    std::fill( a.begin(), a.end(), T(0) );
+                    std::fill( b.begin(), b.end(), T(0) );
+                }
+                std::fill( c.begin(), c.end(), T(0) );
+                compact_pack<w>( transA, A, b0, np, m, k, a.data() );
+                compact_pack<w>( transB, B, b0, np, k, n, b.data() );
+
+                gemm_compact_kernel<w>( m, n, k, a.data(), b.data(), c.data() );
+
+                for(std::size_t p = 0; p < np; ++p) {
+                    auto&& Cp = C[b0+p];
+                    for(idx_t j = 0; j < n; ++j)
+                        for(idx_t i = 0; i < m; ++i)
+                            Cp(i,j) = alpha * c[ (j*m+i)*w + p ] + beta * Cp(i,j);
+                }
+            }
+        } );
+    }
+
+} // namespace internal
+
+/**
+ * Batched general matrix-matrix multiply:
+ * \[
+ *     C_i = \alpha op(A_i) \times op(B_i) + \beta C_i,
+ * \]
+ * for i = 0, ..., batch-1, where $op(X)$ is one of
+ *     $op(X) = X$,
+ *     $op(X) = X^T$, or
+ *     $op(X) = X^H$,
+ * alpha and beta are scalars, and A_i, B_i, and C_i are matrices, with
+ * $op(A_i)$ an m_i-by-k_i matrix, $op(B_i)$ a k_i-by-n_i matrix, and C_i an
+ * m_i-by-n_i matrix.
+ *
+ * The sizes may vary from problem to problem. The problems are distributed
+ * among the threads (@see get_num_threads), and each one is solved by a
+ * serial call to gemm. If all the problems have the same sizes, and these are
+ * small (@see batch_blocksize), groups of problems of real type are
+ * interleaved in a compact layout and computed together, so that the SIMD
+ * lanes work on different problems. The arguments are only checked once per
+ * problem in this case.
+ *
+ * @param[in] transA
+ *     The operation $op(A_i)$ to be used:
+ *     - Op::NoTrans:   $op(A_i) = A_i$.
+ *     - Op::Trans:     $op(A_i) = A_i^T$.
+ *     - Op::ConjTrans: $op(A_i) = A_i^H$.
+ *
+ * @param[in] transB
+ *     The operation $op(B_i)$ to be used:
+ *     - Op::NoTrans:   $op(B_i) = B_i$.
+ *     - Op::Trans:     $op(B_i) = B_i^T$.
+ *     - Op::ConjTrans: $op(B_i) = B_i^H$.
+ *
+ * @param[in] alpha
+ *     Scalar alpha.
+ *
+ * @param[in] A
+ *     Range of matrices A_i, e.g., a std::vector of matrix views.
+ *     It must provide size() and operator[].
+ *
+ * @param[in] B
+ *     Range of matrices B_i, with the same size as A.
+ *
+ * @param[in] beta
+ *     Scalar beta.
+ *
+ * @param[in,out] C
+ *     Range of matrices C_i, with the same size as A.
+ *     On exit, overwritten by the results.
+ *
+ * @ingroup gemm
+ */
+template< class matrixA_range, class matrixB_range, class matrixC_range,
+          class alpha_t, class beta_t >
+void gemm_batch(
+    Op transA,
+    Op transB,
+    const alpha_t& alpha,
+    const matrixA_range& A,
+    const matrixB_range& B,
+    const beta_t& beta,
+    matrixC_range& C )
+{
+    using internal::range_value_t;
+
+    // data traits
+    using TA    = type_t< range_value_t< const matrixA_range > >;
+    using TB    = type_t< range_value_t< const matrixB_range > >;
+    using idx_t = size_type< range_value_t< matrixC_range > >;
+
+    // using
+    using scalar_t = scalar_type<TA,TB>;
+
+    // constants
+    const std::size_t batch = C.size();
+
+    // check arguments
+    blas_error_if( transA != Op::NoTrans &&
+                   transA != Op::Trans &&
+                   transA != Op::ConjTrans );
+    blas_error_if( transB != Op::NoTrans &&
+                   transB != Op::Trans &&
+                   transB != Op::ConjTrans );
+    blas_error_if( A.size() != batch );
+    blas_error_if( B.size() != batch );
+
+    // quick return
+    if( batch == 0 )
+        return;
+
+    // Check sizes, count flops and detect uniform batches
+    const idx_t m = nrows( C[0] );
+    const idx_t n = ncols( C[0] );
+    const idx_t k = (transA == Op::NoTrans) ? ncols( A[0] ) : nrows( A[0] );
+    bool uniform = true;
+    double flops = 0;
+    for(std::size_t i = 0; i < batch; ++i) {
+        const idx_t mi = nrows( C[i] );
+        const idx_t ni = ncols( C[i] );
+        const idx_t ki = (transA == Op::NoTrans) ? ncols( A[i] ) : nrows( A[i] );
+        blas_error_if(
+            mi != ((transA == Op::NoTrans) ? nrows( A[i] ) : ncols( A[i] )) );
+        blas_error_if(
+            ni != ((transB == Op::NoTrans) ? ncols( B[i] ) : nrows( B[i] )) );
+        blas_error_if(
+            ((transB == Op::NoTrans) ? nrows( B[i] ) : ncols( B[i] )) != ki );
+        uniform = uniform && mi == m && ni == n && ki == k;
+        flops += 2.0 * mi * ni * ki;
+    }
+
+    const int nt = internal::num_threads_for( flops );
+
+    // Compact layout for uniform batches of small real matrices
+    constexpr std::size_t wmax = batch_blocksize<scalar_t>::max_size;
+    if( uniform && !is_complex<scalar_t>::value &&
+        batch >= batch_blocksize<scalar_t>::width &&
+        m > 0 && n > 0 && k > 0 &&
+        std::size_t(m) <= wmax && std::size_t(n) <= wmax && std::size_t(k) <= wmax )
+    {
+        internal::gemm_batch_compact< scalar_t >(
+            transA, transB, m, n, k, alpha, A, B, beta, C, nt );
+        return;
+    }
+
+    internal::parallel_for( batch, nt, [&]( std::size_t i ) {
+        auto&& Ci = C[i];
+        gemm( transA, transB, alpha, A[i], B[i], beta, Ci );
+    } );
+}
+
+/**
+ * Batched general matrix-matrix multiply with a given number of threads.
+ * @see gemm_batch( Op, Op, const alpha_t&, const matrixA_range&, const matrixB_range&, const beta_t&, matrixC_range& )
+ *
+ * @param[in] policy Execution policy with the number of threads.
+ *
+ * @ingroup gemm
+ */
+template< class matrixA_range, class matrixB_range, class matrixC_range,
+          class alpha_t, class beta_t >
+inline void gemm_batch(
+    const parallel_policy& policy,
+    Op transA,
+    Op transB,
+    const alpha_t& alpha,
+    const matrixA_range& A,
+    const matrixB_range& B,
+    const beta_t& beta,
+    matrixC_range& C )
+{
+    internal::num_threads_scope scope( policy.num_threads );
+    gemm_batch( transA, transB, alpha, A, B, beta, C );
+}
+
+}  // namespace blas
+
+#undef TBLAS_UNROLL_BATCH
+
+#endif        //  #ifndef BLAS_GEMM_BATCH_HH
@@ -0,0 +1,469 @@
+// Copyright (c) 2021, University of Colorado Denver. All rights reserved.
+//
+// This file is part of <T>LAPACK.
+// <T>LAPACK is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef BLAS_GEMM_BLOCKED_HH
+#define BLAS_GEMM_BLOCKED_HH
+
+#include "blas/utils.hpp"
+#include "blas/gemm_kernels.hpp"
+#include "blas/storage.hpp"
+#include "blas/parallel.hpp"
+
+#include <vector>
+#include <cstddef>
+#include <limits>
+
+namespace blas {
+
+/**
+ * Block sizes used by the cache-blocked, packed gemm engine.
+ *
+ * The engine follows the GotoBLAS/BLIS organization:
+ *
+ * - nc columns of op(B) and kc rows of op(B) are packed into a buffer that
+ *   is meant to stay in the L3 cache;
+ * - mc rows of op(A) and kc columns of op(A) are packed into a buffer that
+ *   is meant to stay in the L2 cache;
+ * - the micro-kernel updates an mr-by-nr block of C that lives in registers,
+ *   streaming a kc-by-mr micro-panel of A and a kc-by-nr micro-panel of B.
+ *
+ * mc must be a multiple of mr and nc must be a multiple of nr.
+ * Specialize this class to tune the engine for a given data type. The SIMD
+ * micro-kernels in blas/gemm_kernels.hpp are only used with the default
+ * mr and nr; other values fall back to the generic micro-kernel.
+ *
+ * @tparam T Type of the entries in the packed buffers.
+ *
+ * @ingroup gemm
+ */
+template< typename T >
+struct gemm_blocksize {
+    static constexpr std::size_t mr = 4;
+    static constexpr std::size_t nr = 4;
+    static constexpr std::size_t mc = 64;
+    static constexpr std::size_t kc = 128;
+    static constexpr std::size_t nc = 1024;
+
+    /// Problems with m*n*k smaller than min_size^3 use the unblocked code.
+    static constexpr std::size_t min_size = 32;
+};
+
+template<>
+struct gemm_blocksize< float > {
+    static constexpr std::size_t mr = 16;
+    static constexpr std::size_t nr = 6;
+    static constexpr std::size_t mc = 128;
+    static constexpr std::size_t kc = 384;
+    static constexpr std::size_t nc = 4080;
+    static constexpr std::size_t min_size = 32;
+};
+
+template<>
+struct gemm_blocksize< double > {
+    static constexpr std::size_t mr = 8;
+    static constexpr std::size_t nr = 6;
+    static constexpr std::size_t mc = 96;
+    static constexpr std::size_t kc = 256;
+    static constexpr std::size_t nc = 4080;
+    static constexpr std::size_t min_size = 32;
+};
+
+template<>
+struct gemm_blocksize< std::complex<float> > {
+    static constexpr std::size_t mr = 8;
+    static constexpr std::size_t nr = 2;
+    static constexpr std::size_t mc = 96;
+    static constexpr std::size_t kc = 256;
+    static constexpr std::size_t nc = 4096;
+    static constexpr std::size_t min_size = 24;
+};
+
+template<>
+struct gemm_blocksize< std::complex<double> > {
+    static constexpr std::size_t mr = 4;
+    static constexpr std::size_t nr = 2;
+    static constexpr std::size_t mc = 64;
+    static constexpr std::size_t kc = 192;
+    static constexpr std::size_t nc = 4096;
+    static constexpr std::size_t min_size = 24;
+};
+
+/**
+ * Block size of the Level 3 BLAS routines built on top of gemm.
+ *
+ * trsm, trmm, syrk, herk, syr2k and her2k split their triangular operand
+ * in blocks of nb rows and columns. The diagonal blocks are handled by the
+ * unblocked code, and the off-diagonal blocks by gemm. Matrices of order up
+ * to nb only use the unblocked code.
+ *
+ * This is the default of get_blocksize<T>( "level3", ... ), so nb can be
+ * changed at runtime in the tuning registry.
+ *
+ * @tparam T Type of the entries of the matrices.
+ *
+ * @ingroup gemm
+ */
+template< typename T >
+struct level3_blocksize {
+    static constexpr std::size_t nb = 64;
+};
+
+namespace internal {
+
+    // -------------------------------------------------------------------------
+    /** Packs a mb-by-kb block of op(A), starting at op(A)(i0,l0), into
+     * micro-panels of mr rows.
+     *
+     * Micro-panel p holds rows [p*mr, (p+1)*mr) of the block, stored as
+     * buf[ p*mr*kb + l*mr + i ]. Rows beyond mb are padded with zeros so that
+     * the micro-kernel can always work on full mr-by-nr tiles.
+     *
+     * op(A) can be A, A^T or A^H. The conjugation is applied here, so the
+     * micro-kernel only sees the packed values.
+     */
+    template< std::size_t mr, class T, class matrixA_t, class idx_t >
+    void gemm_pack_A(
+        Op transA, const matrixA_t& A,
+        idx_t i0, idx_t mb, idx_t l0, idx_t kb,
+        T* buf )
+    {
+        const T zero( 0 );
+
+        // Read A along its rows if it is row major
+        const bool rowA = rowmajor_loops( A );
+        const bool alongRows = ( transA == Op::NoTrans ) == rowA;
+
+        for(idx_t ir = 0; ir < mb; ir += mr) {
+            const idx_t mr_ = (mb-ir < idx_t(mr)) ? mb-ir : idx_t(mr);
+            T* p = buf + ir*kb;
+
+            if (transA == Op::NoTrans) {
+                if (alongRows) {
+                    for(idx_t i = 0; i < mr_; ++i)
+                        for(idx_t l = 0; l < kb; ++l)
+                            p[l*mr+i] = A(i0+ir+i, l0+l);
+                }
+                else {
+                    for(idx_t l = 0; l < kb; ++l)
+                        for(idx_t i = 0; i < mr_; ++i)
+                            p[l*mr+i] = A(i0+ir+i, l0+l);
+                }
+            }
+            else if (alongRows) {
+                for(idx_t i = 0; i < mr_; ++i) {
+                    if (transA == Op::Trans)
+                        for(idx_t l = 0; l < kb; ++l)
+                            p[l*mr+i] = A(l0+l, i0+ir+i);
+                    else
+                        for(idx_t l = 0; l < kb; ++l)
+                            p[l*mr+i] = conj( A(l0+l, i0+ir+i) );
+                }
+            }
+            else {
+                for(idx_t l = 0; l < kb; ++l) {
+                    if (transA == Op::Trans)
+                        for(idx_t i = 0; i < mr_; ++i)
+                            p[l*mr+i] = A(l0+l, i0+ir+i);
+                    else
+                        for(idx_t i = 0; i < mr_; ++i)
+                            p[l*mr+i] = conj( A(l0+l, i0+ir+i) );
+                }
+            }
+            for(idx_t l = 0; l < kb; ++l)
+                for(idx_t i = mr_; i < idx_t(mr); ++i)
+                    p[l*mr+i] = zero;
+        }
+    }
+
+    // -------------------------------------------------------------------------
+    /** Packs a kb-by-nb block of op(B), starting at op(B)(l0,j0), into
+     * micro-panels of nr columns.
+     *
+     * Micro-panel p holds columns [p*nr, (p+1)*nr) of the block, stored as
+     * buf[ p*nr*kb + l*nr + j ]. Columns beyond nb are padded with zeros.
+     */
+    template< std::size_t nr, class T, class matrixB_t, class idx_t >
+    void gemm_pack_B(
+        Op transB, const matrixB_t& B,
+        idx_t l0, idx_t kb, idx_t j0, idx_t nb,
+        T* buf )
+    {
+        const T zero( 0 );
+
+        // Read B along its columns if it is column major
+        const bool rowB = rowmajor_loops( B );
+        const bool alongCols = ( transB == Op::NoTrans ) != rowB;
+
+        for(idx_t jr = 0; jr < nb; jr += nr) {
+            const idx_t nr_ = (nb-jr < idx_t(nr)) ? nb-jr : idx_t(nr);
+            T* p = buf + jr*kb;
+
+            if (transB == Op::NoTrans) {
+                if (alongCols) {
+                    for(idx_t j = 0; j < nr_; ++j)
+                        for(idx_t l = 0; l < kb; ++l)
+                            p[l*nr+j] = B(l0+l, j0+jr+j);
+                }
+                else {
+                    for(idx_t l = 0; l < kb; ++l)
+                        for(idx_t j = 0; j < nr_; ++j)
+                            p[l*nr+j] = B(l0+l, j0+jr+j);
+                }
+            }
+            else if (alongCols) {
+                for(idx_t l = 0; l < kb; ++l) {
+                    if (transB == Op::Trans)
+                        for(idx_t j = 0; j < nr_; ++j)
+                            p[l*nr+j] = B(j0+jr+j, l0+l);
+                    else
+                        for(idx_t j = 0; j < nr_; ++j)
+                            p[l*nr+j] = conj( B(j0+jr+j, l0+l) );
+                }
+            }
+            else {
+                for(idx_t j = 0; j < nr_; ++j) {
+                    if (transB == Op::Trans)
+                        for(idx_t l = 0; l < kb; ++l)
+                            p[l*nr+j] = B(j0+jr+j, l0+l);
+                    else
+                        for(idx_t l = 0; l < kb; ++l)
+                            p[l*nr+j] = conj( B(j0+jr+j, l0+l) );
+                }
+            }
+            for(idx_t l = 0; l < kb; ++l)
+                for(idx_t j = nr_; j < idx_t(nr); ++j)
+                    p[l*nr+j] = zero;
+        }
+    }
+
+    // -------------------------------------------------------------------------
+    /** Micro-kernel: computes the mr-by-nr product of a packed micro-panel of
+     * A and a packed micro-panel of B, and adds alpha times the leading
+     * mr_-by-nr_ part of the result to C(i0:i0+mr_, j0:j0+nr_).
+     *
+     * The product is computed by gemm_kernel, which has SIMD
+     * specializations for the standard floating-point types.
+     */
+    template< std::size_t mr, std::size_t nr,
+              class T, class matrixC_t, class alpha_t, class idx_t >
+    inline void gemm_micro_kernel(
+        idx_t kb, const alpha_t& alpha,
+        const T* a, const T* b,
+        matrixC_t& C, idx_t i0, idx_t j0, idx_t mr_, idx_t nr_ )
+    {
+        T ab[ mr*nr ];
+        gemm_kernel< mr, nr, T >::run( std::size_t(kb), a, b, ab );
+
+        if( rowmajor_loops( C ) ) {
+            for(idx_t i = 0; i < mr_; ++i)
+                for(idx_t j = 0; j < nr_; ++j)
+                    C(i0+i, j0+j) += alpha * ab[j*mr+i];
+        }
+        else {
+            for(idx_t j = 0; j < nr_; ++j)
+                for(idx_t i = 0; i < mr_; ++i)
+                    C(i0+i, j0+j) += alpha * ab[j*mr+i];
+        }
+    }
+
+    // -------------------------------------------------------------------------
+    /** Macro-kernel: multiplies a packed mb-by-kb block of op(A) by a packed
+     * kb-by-nb block of op(B) and adds the result, scaled by alpha, to
+     * C(i0:i0+mb, j0:j0+nb).
+     */
+    template< std::size_t mr, std::size_t nr,
+              class T, class matrixC_t, class alpha_t, class idx_t >
+    void gemm_macro_kernel(
+        idx_t mb, idx_t nb, idx_t kb, const alpha_t& alpha,
+        const T* Ap, const T* Bp,
+        matrixC_t& C, idx_t i0, idx_t j0 )
+    {
+        for(idx_t jr = 0; jr < nb; jr += nr) {
+            const idx_t nr_ = (nb-jr < idx_t(nr)) ? nb-jr : idx_t(nr);
+            for(idx_t ir = 0; ir < mb; ir += mr) {
+                const idx_t mr_ = (mb-ir < idx_t(mr)) ? mb-ir : idx_t(mr);
+                gemm_micro_kernel<mr,nr>(
+                    kb, alpha, Ap + ir*kb, Bp + jr*kb,
+                    C, i0+ir, j0+jr, mr_, nr_ );
+            }
+        }
+    }
+
+    // -------------------------------------------------------------------------
+    /** Access to the packed blocks of an operand of gemm_blocked.
+     *
+     * get_A returns the packed mb-by-kb block of op(A) that starts at
+     * op(A)(ic,pc), and get_B the packed kb-by-nb block of op(B) that starts
+     * at op(B)(pc,jc), both in the layout of gemm_pack_A and gemm_pack_B.
+     * The generic version packs into buf. Specializations for operands that
+     * are stored packed already (@see packed_matrix) return a pointer to
+     * their own data, and is_packed_A / is_packed_B tell the engine that no
+     * buffer is needed.
+     */
+    template< class matrix_t >
+    struct gemm_operand {
+
+        template< class T >
+        static constexpr bool is_packed_A( const matrix_t&, Op ) { return false; }
+
+        template< class T >
+        static constexpr bool is_packed_B( const matrix_t&, Op ) { return false; }
+
+        template< std::size_t mr, class T, class idx_t >
+        static const T* get_A(
+            Op transA, const matrix_t& A,
+            idx_t ic, idx_t mb, idx_t pc, idx_t kb, T* buf )
+        {
+            gemm_pack_A<mr>( transA, A, ic, mb, pc, kb, buf );
+            return buf;
+        }
+
+        template< std::size_t nr, class T, class idx_t >
+        static const T* get_B(
+            Op transB, const matrix_t& B,
+            idx_t pc, idx_t kb, idx_t jc, idx_t nb, T* buf )
+        {
+            gemm_pack_B<nr>( transB, B, pc, kb, jc, nb, buf );
+            return buf;
+        }
+    };
+
+    // -------------------------------------------------------------------------
+    /** Cache-blocked, packed computation of C := alpha op(A) op(B) + C.
+     *
+     * C must have been scaled by beta beforehand. Matrices are only accessed
+     * through A(i,j), B(i,j) and C(i,j), so any matrix type supported by
+     * <T>BLAS can be used. Packing makes the inner loops independent of the
+     * storage of A and B.
+     *
+     * With more than one thread (@see get_num_threads), the packing of op(B)
+     * is split among the threads, and so are the blocks of rows of C in the
+     * ic loop. If there are fewer row blocks than threads, the columns of
+     * each row block are split too. Every thread packs op(A) into its own
+     * buffer.
+     *
+     * Operands that are already packed (@see packed_matrix) are read in
+     * place, see gemm_operand.
+     *
+     * @tparam T Type of the entries in the packed buffers.
+     */
+    template< class T,
+              class matrixA_t, class matrixB_t, class matrixC_t,
+              class alpha_t >
+    void gemm_blocked(
+        Op transA, Op transB,
+        const alpha_t& alpha,
+        const matrixA_t& A, const matrixB_t& B,
+        matrixC_t& C )
+    {
+        using idx_t = size_type< matrixC_t >;
+        using blocksize = gemm_blocksize< T >;
+
+        constexpr std::size_t mr = blocksize::mr;
+        constexpr std::size_t nr = blocksize::nr;
+        static_assert( blocksize::mc % mr == 0, "mc must be a multiple of mr" );
+        static_assert( blocksize::nc % nr == 0, "nc must be a multiple of nr" );
+
+        // constants
+        const idx_t m = nrows(C);
+        const idx_t n = ncols(C);
+        const idx_t k = (transA == Op::NoTrans) ? ncols(A) : nrows(A);
+        const int nt = num_threads_for( 2.0 * m * n * k );
+
+        // Effective block sizes, so that buffers are not larger than needed.
+        // With several threads, the rows of C are split in at least nt blocks
+        // if possible.
+        const idx_t mt = (nt > 1) ? (m+nt-1)/nt : m;
+        const idx_t mc = min( idx_t(blocksize::mc), ((mt+idx_t(mr)-1)/idx_t(mr))*idx_t(mr) );
+        const idx_t nc = min( idx_t(blocksize::nc), ((n+idx_t(nr)-1)/idx_t(nr))*idx_t(nr) );
+        const idx_t kc = min( idx_t(blocksize::kc), k );
+
+        using operandA = gemm_operand< matrixA_t >;
+        using operandB = gemm_operand< matrixB_t >;
+        const bool packedA = operandA::template is_packed_A<T>( A, transA );
+        const bool packedB = operandB::template is_packed_B<T>( B, transB );
+
+        std::vector<T> Bbuf( packedB ? 0 : kc*nc );
+        std::vector< std::vector<T> > Abuf( nt, std::vector<T>( packedA ? 0 : mc*kc ) );
+
+        for(idx_t jc = 0; jc < n; jc += nc) {
+            const idx_t nb = min( nc, n-jc );
+            for(idx_t pc = 0; pc < k; pc += kc) {
+                const idx_t kb = min( kc, k-pc );
+
+                if( nt == 1 ) {
+                    const T* Bp = operandB::template get_B<nr>(
+                        transB, B, pc, kb, jc, nb, Bbuf.data() );
+
+                    for(idx_t ic = 0; ic < m; ic += mc) {
+                        const idx_t mb = min( mc, m-ic );
+
+                        const T* Ap = operandA::template get_A<mr>(
+                            transA, A, ic, mb, pc, kb, Abuf[0].data() );
+
+                        gemm_macro_kernel<mr,nr>(
+                            mb, nb, kb, alpha, Ap, Bp, C, ic, jc );
+                    }
+                    continue;
+                }
+
+                // Pack op(B), nt chunks of micro-panels in parallel
+                const idx_t npanels = (nb+idx_t(nr)-1)/idx_t(nr);
+                const T* Bp = Bbuf.data();
+                if( packedB ) {
+                    Bp = operandB::template get_B<nr>(
+                        transB, B, pc, kb, jc, nb, Bbuf.data() );
+                }
+                else {
+                    const idx_t nppt = (npanels+nt-1)/nt;
+                    parallel_for( nt, nt, [&]( std::size_t t ) {
+                        const idx_t j0 = min( idx_t(t)*nppt*idx_t(nr), nb );
+                        const idx_t j1 = min( j0 + nppt*idx_t(nr), nb );
+                        if( j0 < j1 )
+                            operandB::template get_B<nr>(
+                                transB, B, pc, kb, jc+j0, j1-j0, Bbuf.data() + j0*kb );
+                    } );
+                }
+
+                // Split the work in blocks of rows, and in blocks of columns
+                // if there are not enough blocks of rows
+                const idx_t nbi = (m+mc-1)/mc;
+                const idx_t nbj = min( (idx_t(nt)+nbi-1)/nbi, npanels );
+                const idx_t npj = (npanels+nbj-1)/nbj;
+                const idx_t ntasks = nbi*nbj;
+
+                parallel_for( nt, nt, [&]( std::size_t t ) {
+                    const T* Ap = nullptr;
+                    idx_t packed = std::numeric_limits<idx_t>::max();
+                    for(idx_t task = t; task < ntasks; task += nt) {
+                        const idx_t bi = task / nbj;
+                        const idx_t bj = task % nbj;
+                        const idx_t ic = bi*mc;
+                        const idx_t mb = min( mc, m-ic );
+                        const idx_t j0 = min( bj*npj*idx_t(nr), nb );
+                        const idx_t j1 = min( j0 + npj*idx_t(nr), nb );
+                        if( j0 >= j1 ) continue;
+
+                        if( packed != bi ) {
+                            Ap = operandA::template get_A<mr>(
+                                transA, A, ic, mb, pc, kb, Abuf[t].data() );
+                            packed = bi;
+                        }
+
+                        gemm_macro_kernel<mr,nr>(
+                            mb, j1-j0, kb, alpha,
+                            Ap, Bp + j0*kb, C, ic, jc+j0 );
+                    }
+                } );
+            }
+        }
+    }
+
+}  // namespace internal
+
+}  // namespace blas
+
+#endif        //  #ifndef BLAS_GEMM_BLOCKED_HH
@@ -0,0 +1,445 @@
+// Copyright (c) 2021, University of Colorado Denver. All rights reserved.
+//
+// This file is part of <T>LAPACK.
+// <T>LAPACK is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef BLAS_GEMM_KERNELS_HH
+#define BLAS_GEMM_KERNELS_HH
+
+#include "blas/types.hpp"
+
+#include <cstddef>
+#include <complex>
+
+// SIMD micro-kernels are available for x86 with GCC-compatible compilers.
+// Define TBLAS_NO_SIMD to use only the generic kernels.
+#if !defined(TBLAS_NO_SIMD) && defined(__GNUC__) && \
+    ( defined(__x86_64__) || defined(__i386__) )
+    #define TBLAS_SIMD_X86
+    #include <immintrin.h>
+#endif
+
+namespace blas {
+
+namespace internal {
+
+    // -------------------------------------------------------------------------
+    /** Generic gemm micro-kernel.
+     *
+     * Computes the mr-by-nr matrix ab = a b, where a is a packed kb-by-mr
+     * micro-panel of op(A) stored as a[l*mr+i] and b is a packed kb-by-nr
+     * micro-panel of op(B) stored as b[l*nr+j]. On exit, ab[j*mr+i] holds
+     * the (i,j) entry of the product.
+     *
+     * This is the fallback for any data type, e.g., mpfr::mpreal.
+     */
+    template< std::size_t mr, std::size_t nr, class T >
+    inline void gemm_kernel_generic(
+        std::size_t kb, const T* a, const T* b, T* ab )
+    {
+        for(std::size_t ij = 0; ij < mr*nr; ++ij)
+            ab[ij] = T( 0 );
+
+        for(std::size_t l = 0; l < kb; ++l) {
+            for(std::size_t j = 0; j < nr; ++j) {
+                const T blj = b[j];
+                for(std::size_t i = 0; i < mr; ++i)
+                    ab[j*mr+i] += a[i] * blj;
+            }
+            a += mr;
+            b += nr;
+        }
+    }
+
+    /** gemm micro-kernel used by the packed gemm engine.
+     *
+     * Specializations for float, double, std::complex<float> and
+     * std::complex<double>, with the register block sizes of
+     * blas::gemm_blocksize, use SIMD instructions selected at runtime.
+     * @see gemm_kernel_generic
+     */
+    template< std::size_t mr, std::size_t nr, class T >
+    struct gemm_kernel {
+        static inline void run(
+            std::size_t kb, const T* a, const T* b, T* ab )
+        {
+            gemm_kernel_generic<mr,nr>( kb, a, b, ab );
+        }
+    };
+
+#ifdef TBLAS_SIMD_X86
+
+    // Fully unroll the loops over the register block, so that the accumulators
+    // are kept in registers even without -O3
+    #define TBLAS_UNROLL _Pragma("GCC unroll 8")
+
+    // -------------------------------------------------------------------------
+    /// Instruction sets that have dedicated micro-kernels, for gemm and for
+    /// the sums of squares of nrm2 (@see sumsq_kernel).
+    enum class simd_isa { generic = 0, avx2 = 1, avx512 = 2 };
+
+    /// Instruction set used by the micro-kernels, detected once at runtime.
+    inline simd_isa cpu_simd_isa()
+    {
+        static const simd_isa isa = []() {
+            __builtin_cpu_init();
+            if( __builtin_cpu_supports("avx512f") )
+                return simd_isa::avx512;
+            else if( __builtin_cpu_supports("avx2") &&
+                     __builtin_cpu_supports("fma") )
+                return simd_isa::avx2;
+            else
+                return simd_isa::generic;
+        }();
+        return isa;
+    }
+
+    // -------------------------------------------------------------------------
+    // double: 8-by-6 micro-kernels
+
+    __attribute__((target("avx2,fma")))
+    inline void dgemm_kernel_8x6_avx2(
+        std::size_t kb, const double* a, const double* b, double* ab )
+    {
+        __m256d c[6][2];
+        TBLAS_UNROLL
+        for(int j = 0; j < 6; ++j)
+            c[j][0] = c[j][1] = _mm256_setzero_pd();
+
+        for(std::size_t l = 0; l < kb; ++l) {
+            const __m256d a0 = _mm256_loadu_pd( a );
+            const __m256d a1 = _mm256_loadu_pd( a+4 );
+            TBLAS_UNROLL
+            for(int j = 0; j < 6; ++j) {
+                const __m256d bj = _mm256_broadcast_sd( b+j );
+                c[j][0] = _mm256_fmadd_pd( a0, bj, c[j][0] );
+                c[j][1] = _mm256_fmadd_pd( a1, bj, c[j][1] );
+            }
+            a += 8;
+            b += 6;
+        }
+
+        TBLAS_UNROLL
+        for(int j = 0; j < 6; ++j) {
+            _mm256_storeu_pd( ab + 8*j,   c[j][0] );
+            _mm256_storeu_pd( ab + 8*j+4, c[j][1] );
+        }
+    }
+
+    __attribute__((target("avx512f")))
+    inline void dgemm_kernel_8x6_avx512(
+        std::size_t kb, const double* a, const double* b, double* ab )
+    {
+        __m512d c[6];
+        TBLAS_UNROLL
+        for(int j = 0; j < 6; ++j)
+            c[j] = _mm512_setzero_pd();
+
+        for(std::size_t l = 0; l < kb; ++l) {
+            const __m512d a0 = _mm512_loadu_pd( a );
+            TBLAS_UNROLL
+            for(int j = 0; j < 6; ++j)
+                c[j] = _mm512_fmadd_pd( a0, _mm512_set1_pd( b[j] ), c[j] );
+            a += 8;
+            b += 6;
+        }
+
+        TBLAS_UNROLL
+        for(int j = 0; j < 6; ++j)
+            _mm512_storeu_pd( ab + 8*j, c[j] );
+    }
+
+    template<>
+    struct gemm_kernel< 8, 6, double > {
+        static inline void run(
+            std::size_t kb, const double* a, const double* b, double* ab )
+        {
+            const simd_isa isa = cpu_simd_isa();
+            if( isa == simd_isa::avx512 )
+                dgemm_kernel_8x6_avx512( kb, a, b, ab );
+            else if( isa == simd_isa::avx2 )
+                dgemm_kernel_8x6_avx2( kb, a, b, ab );
+            else
+                gemm_kernel_generic<8,6>( kb, a, b, ab );
+        }
+    };
+
+    // -------------------------------------------------------------------------
+    // float: 16-by-6 micro-kernels
+
+    __attribute__((target("avx2,fma")))
+    inline void sgemm_kernel_16x6_avx2(
+        std::size_t kb, const float* a, const float* b, float* ab )
+    {
+        __m256 c[6][2];
+        TBLAS_UNROLL
+        for(int j = 0; j < 6; ++j)
+            c[j][0] = c[j][1] = _mm256_setzero_ps();
+
+        for(std::size_t l = 0; l < kb; ++l) {
+            const __m256 a0 = _mm256_loadu_ps( a );
+            const __m256 a1 = _mm256_loadu_ps( a+8 );
+            TBLAS_UNROLL
+            for(int j = 0; j < 6; ++j) {
+                const __m256 bj = _mm256_broadcast_ss( b+j );
+                c[j][0] = _mm256_fmadd_ps( a0, bj, c[j][0] );
+                c[j][1] = _mm256_fmadd_ps( a1, bj, c[j][1] );
+            }
+            a += 16;
+            b += 6;
+        }
+
+        TBLAS_UNROLL
+        for(int j = 0; j < 6; ++j) {
+            _mm256_storeu_ps( ab + 16*j,   c[j][0] );
+            _mm256_storeu_ps( ab + 16*j+8, c[j][1] );
+        }
+    }
+
+    __attribute__((target("avx512f")))
+    inline void sgemm_kernel_16x6_avx512(
+        std::size_t kb, const float* a, const float* b, float* ab )
+    {
+        __m512 c[6];
+        TBLAS_UNROLL
+        for(int j = 0; j < 6; ++j)
+            c[j] = _mm512_setzero_ps();
+
+        for(std::size_t l = 0; l < kb; ++l) {
+            const __m512 a0 = _mm512_loadu_ps( a );
+            TBLAS_UNROLL
+            for(int j = 0; j < 6; ++j)
+                c[j] = _mm512_fmadd_ps( a0, _mm512_set1_ps( b[j] ), c[j] );
+            a += 16;
+            b += 6;
+        }
+
+        TBLAS_UNROLL
+        for(int j = 0; j < 6; ++j)
+            _mm512_storeu_ps( ab + 16*j, c[j] );
+    }
+
+    template<>
+    struct gemm_kernel< 16, 6, float > {
+        static inline void run(
+            std::size_t kb, const float* a, const float* b, float* ab )
+        {
+            const simd_isa isa = cpu_simd_isa();
+            if( isa == simd_isa::avx512 )
+                sgemm_kernel_16x6_avx512( kb, a, b, ab );
+            else if( isa == simd_isa::avx2 )
+                sgemm_kernel_16x6_avx2( kb, a, b, ab );
+            else
+                gemm_kernel_generic<16,6>( kb, a, b, ab );
+        }
+    };
+
+    // -------------------------------------------------------------------------
+    // Complex micro-kernels
+    //
+    // For each column j, two accumulators are kept:
+    //     c_re += a * Re(b_j)   and   c_im += a * Im(b_j),
+    // with a holding interleaved (re,im) pairs. At the end,
+    //     a b_j = c_re + [-1,+1] .* swap(c_im),
+    // which is computed with an addsub instruction.
+
+    // std::complex<double>: 4-by-2 micro-kernels
+
+    __attribute__((target("avx2,fma")))
+    inline void zgemm_kernel_4x2_avx2(
+        std::size_t kb,
+        const std::complex<double>* a_,
+        const std::complex<double>* b_,
+        std::complex<double>* ab_ )
+    {
+        const double* a = reinterpret_cast<const double*>( a_ );
+        const double* b = reinterpret_cast<const double*>( b_ );
+        double* ab = reinterpret_cast<double*>( ab_ );
+
+        __m256d cr[2][2], ci[2][2];
+        TBLAS_UNROLL
+        for(int j = 0; j < 2; ++j)
+            cr[j][0] = cr[j][1] = ci[j][0] = ci[j][1] = _mm256_setzero_pd();
+
+        for(std::size_t l = 0; l < kb; ++l) {
+            const __m256d a0 = _mm256_loadu_pd( a );
+            const __m256d a1 = _mm256_loadu_pd( a+4 );
+            TBLAS_UNROLL
+            for(int j = 0; j < 2; ++j) {
+                const __m256d br = _mm256_broadcast_sd( b+2*j );
+                const __m256d bi = _mm256_broadcast_sd( b+2*j+1 );
+                cr[j][0] = _mm256_fmadd_pd( a0, br, cr[j][0] );
+                cr[j][1] = _mm256_fmadd_pd( a1, br, cr[j][1] );
+                ci[j][0] = _mm256_fmadd_pd( a0, bi, ci[j][0] );
+                ci[j][1] = _mm256_fmadd_pd( a1, bi, ci[j][1] );
+            }
+            a += 8;
+            b += 4;
+        }
+
+        TBLAS_UNROLL
+        for(int j = 0; j < 2; ++j)
+            TBLAS_UNROLL
+            for(int h = 0; h < 2; ++h)
+                _mm256_storeu_pd( ab + 8*j + 4*h, _mm256_addsub_pd(
+                    cr[j][h], _mm256_permute_pd( ci[j][h], 0x5 ) ) );
+    }
+
+    __attribute__((target("avx512f")))
+    inline void zgemm_kernel_4x2_avx512(
+        std::size_t kb,
+        const std::complex<double>* a_,
+        const std::complex<double>* b_,
+        std::complex<double>* ab_ )
+    {
+        const double* a = reinterpret_cast<const double*>( a_ );
+        const double* b = reinterpret_cast<const double*>( b_ );
+        double* ab = reinterpret_cast<double*>( ab_ );
+
+        __m512d cr[2], ci[2];
+        TBLAS_UNROLL
+        for(int j = 0; j < 2; ++j)
+            cr[j] = ci[j] = _mm512_setzero_pd();
+
+        for(std::size_t l = 0; l < kb; ++l) {
+            const __m512d a0 = _mm512_loadu_pd( a );
+            TBLAS_UNROLL
+            for(int j = 0; j < 2; ++j) {
+                cr[j] = _mm512_fmadd_pd( a0, _mm512_set1_pd( b[2*j]   ), cr[j] );
+                ci[j] = _mm512_fmadd_pd( a0, _mm512_set1_pd( b[2*j+1] ), ci[j] );
+            }
+            a += 8;
+            b += 4;
+        }
+
+        // a b_j = cr + [-1,+1] .* swap(ci) = fmaddsub( 1, cr, swap(ci) )
+        const __m512d one = _mm512_set1_pd( 1.0 );
+        TBLAS_UNROLL
+        for(int j = 0; j < 2; ++j)
+            _mm512_storeu_pd( ab + 8*j, _mm512_fmaddsub_pd(
+                one, cr[j], _mm512_shuffle_pd( ci[j], ci[j], 0x55 ) ) );
+    }
+
+    template<>
+    struct gemm_kernel< 4, 2, std::complex<double> > {
+        static inline void run(
+            std::size_t kb,
+            const std::complex<double>* a,
+            const std::complex<double>* b,
+            std::complex<double>* ab )
+        {
+            const simd_isa isa = cpu_simd_isa();
+            if( isa == simd_isa::avx512 )
+                zgemm_kernel_4x2_avx512( kb, a, b, ab );
+            else if( isa == simd_isa::avx2 )
+                zgemm_kernel_4x2_avx2( kb, a, b, ab );
+            else
+                gemm_kernel_generic<4,2>( kb, a, b, ab );
+        }
+    };
+
+    // std::complex<float>: 8-by-2 micro-kernels
+
+    __attribute__((target("avx2,fma")))
+    inline void cgemm_kernel_8x2_avx2(
+        std::size_t kb,
+        const std::complex<float>* a_,
+        const std::complex<float>* b_,
+        std::complex<float>* ab_ )
+    {
+        const float* a = reinterpret_cast<const float*>( a_ );
+        const float* b = reinterpret_cast<const float*>( b_ );
+        float* ab = reinterpret_cast<float*>( ab_ );
+
+        __m256 cr[2][2], ci[2][2];
+        TBLAS_UNROLL
+        for(int j = 0; j < 2; ++j)
+            cr[j][0] = cr[j][1] = ci[j][0] = ci[j][1] = _mm256_setzero_ps();
+
+        for(std::size_t l = 0; l < kb; ++l) {
+            const __m256 a0 = _mm256_loadu_ps( a );
+            const __m256 a1 = _mm256_loadu_ps( a+8 );
+            TBLAS_UNROLL
+            for(int j = 0; j < 2; ++j) {
+                const __m256 br = _mm256_broadcast_ss( b+2*j );
+                const __m256 bi = _mm256_broadcast_ss( b+2*j+1 );
+                cr[j][0] = _mm256_fmadd_ps( a0, br, cr[j][0] );
+                cr[j][1] = _mm256_fmadd_ps( a1, br, cr[j][1] );
+                ci[j][0] = _mm256_fmadd_ps( a0, bi, ci[j][0] );
+                ci[j][1] = _mm256_fmadd_ps( a1, bi, ci[j][1] );
+            }
+            a += 16;
+            b += 4;
+        }
+
+        TBLAS_UNROLL
+        for(int j = 0; j < 2; ++j)
+            TBLAS_UNROLL
+            for(int h = 0; h < 2; ++h)
+                _mm256_storeu_ps( ab + 16*j + 8*h, _mm256_addsub_ps(
+                    cr[j][h], _mm256_permute_ps( ci[j][h], 0xB1 ) ) );
+    }
+
+    __attribute__((target("avx512f")))
+    inline void cgemm_kernel_8x2_avx512(
+        std::size_t kb,
+        const std::complex<float>* a_,
+        const std::complex<float>* b_,
+        std::complex<float>* ab_ )
+    {
+        const float* a = reinterpret_cast<const float*>( a_ );
+        const float* b = reinterpret_cast<const float*>( b_ );
+        float* ab = reinterpret_cast<float*>( ab_ );
+
+        __m512 cr[2], ci[2];
+        TBLAS_UNROLL
+        for(int j = 0; j < 2; ++j)
+            cr[j] = ci[j] = _mm512_setzero_ps();
+
+        for(std::size_t l = 0; l < kb; ++l) {
+            const __m512 a0 = _mm512_loadu_ps( a );
+            TBLAS_UNROLL
+            for(int j = 0; j < 2; ++j) {
+                cr[j] = _mm512_fmadd_ps( a0, _mm512_set1_ps( b[2*j]   ), cr[j] );
+                ci[j] = _mm512_fmadd_ps( a0, _mm512_set1_ps( b[2*j+1] ), ci[j] );
+            }
+            a += 16;
+            b += 4;
+        }
+
+        // a b_j = cr + [-1,+1] .* swap(ci) = fmaddsub( 1, cr, swap(ci) )
+        const __m512 one = _mm512_set1_ps( 1.0f );
+        TBLAS_UNROLL
+        for(int j = 0; j < 2; ++j)
+            _mm512_storeu_ps( ab + 16*j, _mm512_fmaddsub_ps(
+                one, cr[j], _mm512_shuffle_ps( ci[j], ci[j], 0xB1 ) ) );
+    }
+
+    template<>
+    struct gemm_kernel< 8, 2, std::complex<float> > {
+        static inline void run(
+            std::size_t kb,
+            const std::complex<float>* a,
+            const std::complex<float>* b,
+            std::complex<float>* ab )
+        {
+            const simd_isa isa = cpu_simd_isa();
+            if( isa == simd_isa::avx512 )
+                cgemm_kernel_8x2_avx512( kb, a, b, ab );
+            else if( isa == simd_isa::avx2 )
+                cgemm_kernel_8x2_avx2( kb, a, b, ab );
+            else
+                gemm_kernel_generic<8,2>( kb, a, b, ab );
+        }
+    };
+
+    #undef TBLAS_UNROLL
+
+#endif // TBLAS_SIMD_X86
+
+}  // namespace internal
+
+}  // namespace blas
+
+#endif        //  #ifndef BLAS_GEMM_KERNELS_HH
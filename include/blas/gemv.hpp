@@ -9,9 +9,117 @@
 #define BLAS_GEMV_HH
 
 #include "blas/utils.hpp"
+#include "blas/dispatch.hpp"
+#include "blas/storage.hpp"
 
 namespace blas {
 
+namespace internal {
+
+/** y += alpha op(A) x on raw pointers, where A is m-by-n and column major.
+ * The vector traversed by the inner loop, y for NoTrans and Conj, and x
+ * otherwise, must have unit stride.
+ *
+ * @ingroup gemv
+ */
+template< class idx_t, class TA, class TX, class TY, class alpha_t >
+void gemv_colmajor(
+    Op trans, idx_t m, idx_t n,
+    const alpha_t& alpha, const TA* A, idx_t lda,
+    const TX* x, idx_t incx,
+    TY* y, idx_t incy )
+{
+    if (trans == Op::NoTrans) {
+        // form y += alpha * A * x
+        for (idx_t j = 0; j < n; ++j) {
+            const TA* Aj = A + j*lda;
+            auto tmp = alpha*x[j*incx];
+            for (idx_t i = 0; i < m; ++i)
+                y[i] += tmp * Aj[i];
+        }
+    }
+    else if (trans == Op::Conj) {
+        // form y += alpha * conj( A ) * x
+        for (idx_t j = 0; j < n; ++j) {
+            const TA* Aj = A + j*lda;
+            auto tmp = alpha*x[j*incx];
+            for (idx_t i = 0; i < m; ++i)
+                y[i] += tmp * conj(Aj[i]);
+        }
+    }
+    else if (trans == Op::Trans) {
+        // form y += alpha * A^T * x
+        for (idx_t j = 0; j < n; ++j) {
+            const TA* Aj = A + j*lda;
+            scalar_type<TA,TX> tmp( 0 );
+            for (idx_t i = 0; i < m; ++i)
+                tmp += Aj[i] * x[i];
+            y[j*incy] += alpha*tmp;
+        }
+    }
+    else {
+        // form y += alpha * A^H * x
+        for (idx_t j = 0; j < n; ++j) {
+            const TA* Aj = A + j*lda;
+            scalar_type<TA,TX> tmp( 0 );
+            for (idx_t i = 0; i < m; ++i)
+                tmp += conj(Aj[i]) * x[i];
+            y[j*incy] += alpha*tmp;
+        }
+    }
+}
+
+/** y += alpha op(A) x on raw pointers if A is column or row major and the
+ * vector traversed by the inner loop has unit stride. A row-major A is
+ * the column-major storage of A^T, so op is transposed in that case.
+ * Returns false, and does nothing, otherwise.
+ *
+ * @ingroup gemv
+ */
+template< class matrixA_t, class vectorX_t, class vectorY_t, class alpha_t,
+    enable_if_t<(
+        has_storage< matrixA_t >::value &&
+        has_storage< vectorX_t >::value &&
+        has_storage< vectorY_t >::value
+    ), int > = 0 >
+bool gemv_strided(
+    Op trans,
+    const alpha_t& alpha, const matrixA_t& A, const vectorX_t& x,
+    vectorY_t& y )
+{
+    using idx_t = size_type< matrixA_t >;
+
+    const storage_kind kind = storage_of(A);
+    if( kind == storage_kind::general )
+        return false;
+
+    idx_t m = nrows(A);
+    idx_t n = ncols(A);
+    if( kind == storage_kind::rowmajor ) {
+        std::swap( m, n );
+        trans = ( trans == Op::NoTrans ) ? Op::Trans
+              : ( trans == Op::Trans   ) ? Op::NoTrans
+              : ( trans == Op::Conj    ) ? Op::ConjTrans
+              :                            Op::Conj;
+    }
+
+    const idx_t incx = storage_inc(x);
+    const idx_t incy = storage_inc(y);
+    if( ( trans == Op::NoTrans || trans == Op::Conj ) ? ( incy != 1 ) : ( incx != 1 ) )
+        return false;
+
+    gemv_colmajor( trans, m, n,
+        alpha, storage_data(A), idx_t( storage_ld( A, kind ) ),
+        storage_data(x), incx, storage_data(y), incy );
+
+    return true;
+}
+
+template< class... Ts >
+inline constexpr bool gemv_strided( const Ts&... ) { return false; }
+
+} // namespace internal
+
 /**
  * General matrix-vector multiply:
  * \[
@@ -82,6 +190,12 @@ void gemv(
     if (m == 0 || n == 0 || (alpha == alpha_t(0) && beta == beta_t(1)))
         return;
 
+    // call BLAS++ on large problems
+    #ifdef USE_BLASPP_WRAPPERS
+        if( internal::dispatch_gemv( trans, alpha, A, x, beta, y ) )
+            return;
+    #endif
+
     // ----------
     // form y = beta*y
     if (beta != beta_t(1)) {
@@ -97,8 +211,40 @@ void gemv(
     if (alpha == alpha_t(0))
         return;
 
+    // raw pointers on column- or row-major storage
+    if( internal::gemv_strided( trans, alpha, A, x, y ) )
+        return;
+
     // ----------
-    if (trans == Op::NoTrans ) {
+    if( internal::rowmajor_loops( A ) ) {
+        // loops along the rows of a row-major A
+        if (trans == Op::NoTrans || trans == Op::Conj) {
+            // form y += alpha * A * x or y += alpha * conj( A ) * x
+            for (idx_t i = 0; i < m; ++i) {
+                scalar_type<TA,TX> tmp( 0 );
+                if (trans == Op::NoTrans)
+                    for (idx_t j = 0; j < n; ++j)
+                        tmp += A(i, j) * x[j];
+                else
+                    for (idx_t j = 0; j < n; ++j)
+                        tmp += conj(A(i, j)) * x[j];
+                y[i] += alpha*tmp;
+            }
+        }
+        else {
+            // form y += alpha * A^T * x or y += alpha * A^H * x
+            for (idx_t i = 0; i < m; ++i) {
+                auto tmp = alpha*x[i];
+                if (trans == Op::Trans)
+                    for (idx_t j = 0; j < n; ++j)
+                        y[j] += tmp * A(i, j);
+                else
+                    for (idx_t j = 0; j < n; ++j)
+                        y[j] += tmp * conj(A(i, j));
+            }
+        }
+    }
+    else if (trans == Op::NoTrans ) {
         // form y += alpha * A * x
         for (idx_t j = 0; j < n; ++j) {
             auto tmp = alpha*x[j];
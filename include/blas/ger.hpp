@@ -9,6 +9,8 @@
 #define BLAS_GER_HH
 
 #include "blas/utils.hpp"
+#include "blas/dispatch.hpp"
+#include "blas/storage.hpp"
 
 namespace blas {
 
@@ -52,10 +54,26 @@ void ger(
     const idx_t m = nrows(A);
     const idx_t n = ncols(A);
 
-    for (idx_t j = 0; j < n; ++j) {
-        auto tmp = alpha * conj( y[j] );
-        for (idx_t i = 0; i < m; ++i)
-            A(i,j) += x[i] * tmp;
+    // call BLAS++ on large problems
+    #ifdef USE_BLASPP_WRAPPERS
+        if( internal::dispatch_ger( alpha, x, y, A ) )
+            return;
+    #endif
+
+    if( internal::rowmajor_loops( A ) ) {
+        // loops along the rows of a row-major A
+        for (idx_t i = 0; i < m; ++i) {
+            auto tmp = alpha * x[i];
+            for (idx_t j = 0; j < n; ++j)
+                A(i,j) += tmp * conj( y[j] );
+        }
+    }
+    else {
+        for (idx_t j = 0; j < n; ++j) {
+            auto tmp = alpha * conj( y[j] );
+            for (idx_t i = 0; i < m; ++i)
+                A(i,j) += x[i] * tmp;
+        }
     }
 }
 
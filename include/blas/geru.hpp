@@ -9,6 +9,7 @@
 #define BLAS_GERU_HH
 
 #include "blas/utils.hpp"
+#include "blas/storage.hpp"
 #include "blas/ger.hpp"
 
 namespace blas {
@@ -73,10 +74,20 @@ void geru(
     const idx_t m = nrows(A);
     const idx_t n = ncols(A);
 
-    for (idx_t j = 0; j < n; ++j) {
-        auto tmp = alpha * y[j];
-        for (idx_t i = 0; i < m; ++i)
-            A(i,j) += x[i] * tmp;
+    if( internal::rowmajor_loops( A ) ) {
+        // loops along the rows of a row-major A
+        for (idx_t i = 0; i < m; ++i) {
+            auto tmp = alpha * x[i];
+            for (idx_t j = 0; j < n; ++j)
+                A(i,j) += tmp * y[j];
+        }
+    }
+    else {
+        for (idx_t j = 0; j < n; ++j) {
+            auto tmp = alpha * y[j];
+            for (idx_t i = 0; i < m; ++i)
+                A(i,j) += x[i] * tmp;
+        }
     }
 }
 
@@ -9,9 +9,87 @@
 #define BLAS_HEMM_HH
 
 #include "blas/utils.hpp"
+#include "blas/storage.hpp"
 
 namespace blas {
 
+namespace internal {
+
+/**
+ * Hermitian matrix-matrix multiply with loops along the rows of B and C, for
+ * row-major matrices. Uplo::General is handled as Uplo::Upper. The
+ * arguments are not checked.
+ *
+ * @ingroup hemm
+ */
+template<
+    class matrixA_t, class matrixB_t, class matrixC_t, 
+    class alpha_t, class beta_t >
+void hemm_rowmajor(
+    blas::Side side,
+    blas::Uplo uplo,
+    const alpha_t& alpha, const matrixA_t& A, const matrixB_t& B,
+    const beta_t& beta, matrixC_t& C )
+{
+    // data traits
+    using TA    = type_t< matrixA_t >;
+    using TB    = type_t< matrixB_t >;
+    using idx_t = size_type< matrixC_t >;
+
+    // using
+    using scalar_t = scalar_type<alpha_t,TA,TB>;
+
+    // constants
+    const idx_t m = nrows(C);
+    const idx_t n = ncols(C);
+    const bool upper = (uplo != Uplo::Lower);
+
+    if (side == Side::Left) {
+        // C(i,:) = beta C(i,:) + sum_k alpha A(i,k) B(k,:)
+        for(idx_t i = 0; i < m; ++i) {
+            for(idx_t j = 0; j < n; ++j)
+                C(i,j) *= beta;
+            for(idx_t k = 0; k < m; ++k) {
+                const bool stored = upper ? (k > i) : (k < i);
+                const scalar_t alphaTimesAik = alpha * (
+                    (k == i) ? scalar_t( real( A(i,i) ) ) :
+                    stored   ? scalar_t( A(i,k) ) : scalar_t( conj( A(k,i) ) ) );
+                for(idx_t j = 0; j < n; ++j)
+                    C(i,j) += alphaTimesAik * B(k,j);
+            }
+        }
+    }
+    else { // side == Side::Right
+        // C(i,:) = beta C(i,:) + sum_k alpha B(i,k) A(k,:)
+        for(idx_t i = 0; i < m; ++i) {
+            for(idx_t j = 0; j < n; ++j)
+                C(i,j) *= beta;
+
+            // A(k,j) in the stored triangle, along row k of A
+            for(idx_t k = 0; k < n; ++k) {
+                const auto alphaTimesBik = alpha*B(i,k);
+                const idx_t j0 = upper ? k+1 : 0;
+                const idx_t j1 = upper ? n   : k;
+                C(i,k) += alphaTimesBik * real( A(k,k) );
+                for(idx_t j = j0; j < j1; ++j)
+                    C(i,j) += alphaTimesBik * A(k,j);
+            }
+
+            // A(k,j) = conj( A(j,k) ) in the other triangle, along row j of A
+            for(idx_t j = 0; j < n; ++j) {
+                scalar_t sum( 0 );
+                const idx_t k0 = upper ? j+1 : 0;
+                const idx_t k1 = upper ? n   : j;
+                for(idx_t k = k0; k < k1; ++k)
+                    sum += B(i,k) * conj( A(j,k) );
+                C(i,j) += alpha * sum;
+            }
+        }
+    }
+}
+
+} // namespace internal
+
 /**
  * Hermitian matrix-matrix multiply:
  * \[
@@ -111,6 +189,12 @@ void hemm(
     blas_error_if( nrows(A) != ((side == Side::Left) ? m : n) );
     blas_error_if( nrows(B) != m || ncols(B) != n );
 
+    // Loops along the rows of row-major B and C
+    if( internal::rowmajor_loops( C ) ) {
+        internal::hemm_rowmajor( side, uplo, alpha, A, B, beta, C );
+        return;
+    }
+
     if (side == Side::Left) {
         if (uplo != Uplo::Lower) {
             // uplo == Uplo::Upper or uplo == Uplo::General
@@ -9,6 +9,7 @@
 #define BLAS_HEMV_HH
 
 #include "blas/utils.hpp"
+#include "blas/storage.hpp"
 #include "blas/symv.hpp"
 
 namespace blas {
@@ -88,9 +89,9 @@ void hemv(
     // check arguments
     blas_error_if( uplo != Uplo::Lower &&
                    uplo != Uplo::Upper );
-    blas_error_if( ncols(A) == n );
-    blas_error_if( size(x)  == n );
-    blas_error_if( size(y)  == n );
+    blas_error_if( ncols(A) != n );
+    blas_error_if( size(x)  != n );
+    blas_error_if( size(y)  != n );
 
     // form y = beta*y
     if (beta != beta_t(1)) {
@@ -104,7 +105,22 @@ void hemv(
         }
     }
 
-    if (uplo == Uplo::Upper) {
+    if( internal::rowmajor_loops( A ) ) {
+        // loops along the rows of a row-major A
+        // form y += alpha * A * x
+        for (idx_t i = 0; i < n; ++i) {
+            auto tmp1 = alpha*x[i];
+            auto tmp2 = scalar_t(0);
+            const idx_t j0 = (uplo == Uplo::Upper) ? i+1 : 0;
+            const idx_t j1 = (uplo == Uplo::Upper) ? n   : i;
+            for (idx_t j = j0; j < j1; ++j) {
+                y[j] += tmp1 * conj( A(i,j) );
+                tmp2 += A(i,j) * x[j];
+            }
+            y[i] += tmp1 * real( A(i,i) ) + alpha * tmp2;
+        }
+    }
+    else if (uplo == Uplo::Upper) {
         // A is stored in upper triangle
         // form y += alpha * A * x
         for (idx_t j = 0; j < n; ++j) {
@@ -9,6 +9,7 @@
 #define BLAS_HER_HH
 
 #include "blas/utils.hpp"
+#include "blas/storage.hpp"
 #include "blas/syr.hpp"
 
 namespace blas {
@@ -79,7 +80,26 @@ void her(
     blas_error_if( nrows(A) != ncols(A) ||
                    nrows(A) != n );
 
-    if (uplo == Uplo::Upper) {
+    if( internal::rowmajor_loops( A ) ) {
+        // loops along the rows of a row-major A
+        if (uplo == Uplo::Upper) {
+            for (idx_t i = 0; i < n; ++i) {
+                auto tmp = alpha * x[i];
+                A(i,i) = real( A(i,i) ) + real( tmp * conj( x[i] ) );
+                for (idx_t j = i+1; j < n; ++j)
+                    A(i,j) += tmp * conj( x[j] );
+            }
+        }
+        else {
+            for (idx_t i = 0; i < n; ++i) {
+                auto tmp = alpha * x[i];
+                for (idx_t j = 0; j < i; ++j)
+                    A(i,j) += tmp * conj( x[j] );
+                A(i,i) = real( A(i,i) ) + real( tmp * conj( x[i] ) );
+            }
+        }
+    }
+    else if (uplo == Uplo::Upper) {
         for (idx_t j = 0; j < n; ++j) {
             auto tmp = alpha * conj( x[j] );
             for (idx_t i = 0; i < j; ++i)
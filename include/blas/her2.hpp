@@ -9,6 +9,7 @@
 #define BLAS_HER2_HH
 
 #include "blas/utils.hpp"
+#include "blas/storage.hpp"
 
 namespace blas {
 
@@ -69,7 +70,7 @@ void her2(
     blas::Uplo  uplo,
     const alpha_t& alpha,
     const vectorX_t& x, const vectorY_t& y,
-    const matrixA_t& A )
+    matrixA_t& A )
 {
     // data traits
     using idx_t = size_type< matrixA_t >;
@@ -84,7 +85,28 @@ void her2(
     blas_error_if( nrows(A) != ncols(A) ||
                    nrows(A) != n );
 
-    if (uplo == Uplo::Upper) {
+    if( internal::rowmajor_loops( A ) ) {
+        // loops along the rows of a row-major A
+        if (uplo == Uplo::Upper) {
+            for (idx_t i = 0; i < n; ++i) {
+                auto tmp1 = alpha * x[i];
+                auto tmp2 = conj( alpha ) * y[i];
+                A(i,i) = real( A(i,i) ) + real( tmp1*conj( y[i] ) + tmp2*conj( x[i] ) );
+                for (idx_t j = i+1; j < n; ++j)
+                    A(i,j) += tmp1*conj( y[j] ) + tmp2*conj( x[j] );
+            }
+        }
+        else {
+            for (idx_t i = 0; i < n; ++i) {
+                auto tmp1 = alpha * x[i];
+                auto tmp2 = conj( alpha ) * y[i];
+                for (idx_t j = 0; j < i; ++j)
+                    A(i,j) += tmp1*conj( y[j] ) + tmp2*conj( x[j] );
+                A(i,i) = real( A(i,i) ) + real( tmp1*conj( y[i] ) + tmp2*conj( x[i] ) );
+            }
+        }
+    }
+    else if (uplo == Uplo::Upper) {
         for (idx_t j = 0; j < n; ++j) {
             auto tmp1 = alpha * conj( y[j] );
             auto tmp2 = conj( alpha * x[j] );
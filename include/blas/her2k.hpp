@@ -9,10 +9,203 @@
 #define BLAS_HER2K_HH
 
 #include "blas/utils.hpp"
+#include "blas/gemm.hpp"
+#include "blas/tuning.hpp"
+#include "blas/parallel.hpp"
 #include "blas/syr2k.hpp"
 
 namespace blas {
 
+namespace internal {
+
+    // -------------------------------------------------------------------------
+    /** Unblocked Hermitian rank-2k update of the triangle uplo of C.
+     *
+     * Level 2 BLAS loops, used for the diagonal blocks of her2k_blocked.
+     * Uplo::General is handled as Uplo::Upper. The arguments are not checked.
+     */
+    template< class matrixA_t, class matrixB_t, class matrixC_t,
+              class alpha_t, class beta_t >
+    void her2k_unblocked(
+        Uplo uplo, Op trans,
+        const alpha_t& alpha, const matrixA_t& A, const matrixB_t& B,
+        const beta_t& beta, matrixC_t& C )
+    {
+        // data traits
+        using TA    = type_t< matrixA_t >;
+        using TB    = type_t< matrixB_t >;
+        using idx_t = size_type< matrixC_t >;
+
+        // constants
+        const idx_t n = (trans == Op::NoTrans) ? nrows(A) : ncols(A);
+        const idx_t k = (trans == Op::NoTrans) ? ncols(A) : nrows(A);
+
+        if (trans == Op::NoTrans) {
+            if (uplo != Uplo::Lower) {
+            // uplo == Uplo::Upper or uplo == Uplo::General
+                for(idx_t j = 0; j < n; ++j) {
+
+                    for(idx_t i = 0; i < j; ++i)
+                        C(i,j) *= beta;
+                    C(j,j) = beta * real( C(j,j) );
+
+                    for(idx_t l = 0; l < k; ++l) {
+
+                        auto alphaConjBjl = alpha*conj( B(j,l) );
+                        auto conjAlphaAjl = conj( alpha*A(j,l) );
+
+                        for(idx_t i = 0; i < j; ++i) {
+                            C(i,j) += A(i,l)*alphaConjBjl
+                                    + B(i,l)*conjAlphaAjl;
+                        }
+                        C(j,j) += 2 * real( A(j,l) * alphaConjBjl );
+                    }
+                }
+            }
+            else { // uplo == Uplo::Lower
+                for(idx_t j = 0; j < n; ++j) {
+
+                    C(j,j) = beta * real( C(j,j) );
+                    for(idx_t i = j+1; i < n; ++i)
+                        C(i,j) *= beta;
+
+                    for(idx_t l = 0; l < k; ++l) {
+
+                        auto alphaConjBjl = alpha*conj( B(j,l) );
+                        auto conjAlphaAjl = conj( alpha*A(j,l) );
+
+                        C(j,j) += 2 * real( A(j,l) * alphaConjBjl );
+                        for(idx_t i = j+1; i < n; ++i) {
+                            C(i,j) += A(i,l) * alphaConjBjl
+                                    + B(i,l) * conjAlphaAjl;
+                        }
+                    }
+                }
+            }
+        }
+        else { // trans == Op::ConjTrans
+            using scalar_t = scalar_type<TA,TB>;
+        
+            if (uplo != Uplo::Lower) {
+            // uplo == Uplo::Upper or uplo == Uplo::General
+                for(idx_t j = 0; j < n; ++j) {
+                    for(idx_t i = 0; i <= j; ++i) {
+
+                        scalar_t sum1 = 0;
+                        scalar_t sum2 = 0;
+                        for(idx_t l = 0; l < k; ++l) {
+                            sum1 += conj( A(l,i) ) * B(l,j);
+                            sum2 += conj( B(l,i) ) * A(l,j);
+                        }
+
+                        C(i,j) = (i < j)
+                            ? alpha*sum1 + conj(alpha)*sum2 + beta*C(i,j)
+                            : real( alpha*sum1 + conj(alpha)*sum2 )
+                                + beta*real( C(i,j) );
+                    }
+
+                }
+            }
+            else {
+                // uplo == Uplo::Lower
+                for(idx_t j = 0; j < n; ++j) {
+                    for(idx_t i = j; i < n; ++i) {
+
+                        scalar_t sum1 = 0;
+                        scalar_t sum2 = 0;
+                        for(idx_t l = 0; l < k; ++l) {
+                            sum1 += conj( A(l,i) ) * B(l,j);
+                            sum2 += conj( B(l,i) ) * A(l,j);
+                        }
+
+                        C(i,j) = (i > j)
+                            ? alpha*sum1 + conj(alpha)*sum2 + beta*C(i,j)
+                            : real( alpha*sum1 + conj(alpha)*sum2 )
+                                + beta*real( C(i,j) );
+                    }
+
+                }
+            }
+        }
+    }
+
+    // -------------------------------------------------------------------------
+    /** Blocked Hermitian rank-2k update of the triangle uplo of C.
+     *
+     * C is split in slabs of at most nb = get_blocksize<T>( "level3", ... )
+     * columns.
+     * The diagonal block of each slab is updated by her2k_unblocked, and the
+     * off-diagonal block by two calls to gemm. With more than one thread,
+     * the slabs are updated concurrently, the largest off-diagonal blocks
+     * first.
+     *
+     * Uplo::General is handled as Uplo::Upper. The arguments are not checked.
+     */
+    template< class matrixA_t, class matrixB_t, class matrixC_t,
+              class alpha_t, class beta_t >
+    void her2k_blocked(
+        Uplo uplo, Op trans,
+        const alpha_t& alpha, const matrixA_t& A, const matrixB_t& B,
+        const beta_t& beta, matrixC_t& C )
+    {
+        // data traits
+        using TA    = type_t< matrixA_t >;
+        using TB    = type_t< matrixB_t >;
+        using idx_t = size_type< matrixC_t >;
+        using pair  = std::pair<idx_t,idx_t>;
+
+        // using
+        using scalar_t = scalar_type<TA,TB>;
+
+        // constants
+        const idx_t n = (trans == Op::NoTrans) ? nrows(A) : ncols(A);
+        const idx_t k = (trans == Op::NoTrans) ? ncols(A) : nrows(A);
+        const idx_t nb = get_blocksize< scalar_t >( "level3", n, n, k );
+        const beta_t one( 1 );
+
+        if( n <= nb ) {
+            her2k_unblocked( uplo, trans, alpha, A, B, beta, C );
+            return;
+        }
+
+        const int nt = num_threads_for( 2.0 * n * n * k );
+        const idx_t ns = (nt > 1) ? idx_t(4*nt) : idx_t(1);
+        const idx_t sb = ((n + ns-1) / ns < nb) ? (n + ns-1) / ns : nb;
+        const idx_t nslabs = (n + sb-1) / sb;
+        const Op transA = (trans == Op::NoTrans) ? Op::NoTrans : Op::ConjTrans;
+        const Op transB = (trans == Op::NoTrans) ? Op::ConjTrans : Op::NoTrans;
+
+        // op(X)(i0:i1,:) as a submatrix of X to be used with transA
+        auto slice = [&]( const auto& X, idx_t i0, idx_t i1 ) {
+            return (trans == Op::NoTrans)
+                ? submatrix( X, pair{i0,i1}, pair{0,k} )
+                : submatrix( X, pair{0,k}, pair{i0,i1} );
+        };
+
+        parallel_for( nslabs, nt, [&]( std::size_t s ) {
+            // Largest off-diagonal blocks first
+            const idx_t j0 = ((uplo == Uplo::Lower) ? s : nslabs-1-s) * sb;
+            const idx_t j1 = (j0+sb < n) ? j0+sb : n;
+            const idx_t i0 = (uplo == Uplo::Lower) ? j1 : 0;
+            const idx_t i1 = (uplo == Uplo::Lower) ? n  : j0;
+
+            const auto Aj = slice( A, j0, j1 );
+            const auto Bj = slice( B, j0, j1 );
+            auto Cjj = submatrix( C, pair{j0,j1}, pair{j0,j1} );
+            her2k_unblocked( uplo, trans, alpha, Aj, Bj, beta, Cjj );
+
+            if( i0 < i1 ) {
+                const auto Ai = slice( A, i0, i1 );
+                const auto Bi = slice( B, i0, i1 );
+                auto Cij = submatrix( C, pair{i0,i1}, pair{j0,j1} );
+                gemm( transA, transB, alpha, Ai, Bj, beta, Cij );
+                gemm( transA, transB, conj( alpha ), Bi, Aj, one, Cij );
+            }
+        } );
+    }
+
+} // namespace internal
+
 /**
  * Hermitian rank-k update:
  * \[
@@ -26,6 +219,8 @@ namespace blas {
  * and A and B are n-by-k or k-by-n matrices.
  *
  * Generic implementation for arbitrary data types.
+ * C is updated in blocks of get_blocksize<T>( "level3", ... ) columns, and
+ * the off-diagonal blocks are computed with gemm.
  *
  * @param[in] layout
  *     Matrix storage, Layout::ColMajor or Layout::RowMajor.
@@ -102,13 +297,10 @@ void her2k(
     const beta_t& beta, matrixC_t& C )
 {
     // data traits
-    using TA    = type_t< matrixA_t >;
-    using TB    = type_t< matrixB_t >;
     using idx_t = size_type< matrixC_t >;
 
     // constants
     const idx_t n = (trans == Op::NoTrans) ? nrows(A) : ncols(A);
-    const idx_t k = (trans == Op::NoTrans) ? ncols(A) : nrows(A);
 
     // check arguments
     blas_error_if( uplo != Uplo::Lower &&
@@ -121,93 +313,7 @@ void her2k(
     blas_error_if( nrows(C) != ncols(C) ||
                    nrows(C) != n );
 
-    if (trans == Op::NoTrans) {
-        if (uplo != Uplo::Lower) {
-        // uplo == Uplo::Upper or uplo == Uplo::General
-            for(idx_t j = 0; j < n; ++j) {
-
-                for(idx_t i = 0; i < j; ++i)
-                    C(i,j) *= beta;
-                C(j,j) = beta * real( C(j,j) );
-
-                for(idx_t l = 0; l < k; ++l) {
-
-                    auto alphaConjBjl = alpha*conj( B(j,l) );
-                    auto conjAlphaAjl = conj( alpha*A(j,l) );
-
-                    for(idx_t i = 0; i < j; ++i) {
-                        C(i,j) += A(i,l)*alphaConjBjl
-                                + B(i,l)*conjAlphaAjl;
-                    }
-                    C(j,j) += 2 * real( A(j,l) * alphaConjBjl );
-                }
-            }
-        }
-        else { // uplo == Uplo::Lower
-            for(idx_t j = 0; j < n; ++j) {
-
-                C(j,j) = beta * real( C(j,j) );
-                for(idx_t i = j+1; i < n; ++i)
-                    C(i,j) *= beta;
-
-                for(idx_t l = 0; l < k; ++l) {
-
-                    auto alphaConjBjl = alpha*conj( B(j,l) );
-                    auto conjAlphaAjl = conj( alpha*A(j,l) );
-
-                    C(j,j) += 2 * real( A(j,l) * alphaConjBjl );
-                    for(idx_t i = j+1; i < n; ++i) {
-                        C(i,j) += A(i,l) * alphaConjBjl
-                                + B(i,l) * conjAlphaAjl;
-                    }
-                }
-            }
-        }
-    }
-    else { // trans == Op::ConjTrans
-        using scalar_t = scalar_type<TA,TB>;
-        
-        if (uplo != Uplo::Lower) {
-        // uplo == Uplo::Upper or uplo == Uplo::General
-            for(idx_t j = 0; j < n; ++j) {
-                for(idx_t i = 0; i <= j; ++i) {
-
-                    scalar_t sum1 = 0;
-                    scalar_t sum2 = 0;
-                    for(idx_t l = 0; l < k; ++l) {
-                        sum1 += conj( A(l,i) ) * B(l,j);
-                        sum2 += conj( B(l,i) ) * A(l,j);
-                    }
-
-                    C(i,j) = (i < j)
-                        ? alpha*sum1 + conj(alpha)*sum2 + beta*C(i,j)
-                        : real( alpha*sum1 + conj(alpha)*sum2 )
-                            + beta*real( C(i,j) );
-                }
-
-            }
-        }
-        else {
-            // uplo == Uplo::Lower
-            for(idx_t j = 0; j < n; ++j) {
-                for(idx_t i = j; i < n; ++i) {
-
-                    scalar_t sum1 = 0;
-                    scalar_t sum2 = 0;
-                    for(idx_t l = 0; l < k; ++l) {
-                        sum1 += conj( A(l,i) ) * B(l,j);
-                        sum2 += conj( B(l,i) ) * A(l,j);
-                    }
-
-                    C(i,j) = (i > j)
-                        ? alpha*sum1 + conj(alpha)*sum2 + beta*C(i,j)
-                        : real( alpha*sum1 + conj(alpha)*sum2 )
-                            + beta*real( C(i,j) );
-                }
-
-            }
-        }
-    }
+    internal::her2k_blocked( uplo, trans, alpha, A, B, beta, C );
 
     if (uplo == Uplo::General) {
         for(idx_t j = 0; j < n; ++j) {
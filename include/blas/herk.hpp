@@ -9,9 +9,172 @@
 #define BLAS_HERK_HH
 
 #include "blas/utils.hpp"
+#include "blas/gemm.hpp"
+#include "blas/tuning.hpp"
+#include "blas/parallel.hpp"
 
 namespace blas {
 
+namespace internal {
+
+    // -------------------------------------------------------------------------
+    /** Unblocked Hermitian rank-k update of the triangle uplo of C.
+     *
+     * Level 2 BLAS loops, used for the diagonal blocks of herk_blocked.
+     * Uplo::General is handled as Uplo::Upper. The arguments are not checked.
+     */
+    template< class matrixA_t, class matrixC_t, class alpha_t, class beta_t >
+    void herk_unblocked(
+        Uplo uplo, Op trans,
+        const alpha_t& alpha, const matrixA_t& A,
+        const beta_t& beta, matrixC_t& C )
+    {
+        // data traits
+        using TA    = type_t< matrixA_t >;
+        using idx_t = size_type< matrixC_t >;
+
+        // constants
+        const idx_t n = (trans == Op::NoTrans) ? nrows(A) : ncols(A);
+        const idx_t k = (trans == Op::NoTrans) ? ncols(A) : nrows(A);
+
+        if (trans == Op::NoTrans) {
+            if (uplo != Uplo::Lower) {
+            // uplo == Uplo::Upper or uplo == Uplo::General
+                for(idx_t j = 0; j < n; ++j) {
+
+                    for(idx_t i = 0; i < j; ++i)
+                        C(i,j) *= beta;
+                    C(j,j) = beta * real( C(j,j) );
+
+                    for(idx_t l = 0; l < k; ++l) {
+
+                        auto alphaConjAjl = alpha*conj( A(j,l) );
+
+                        for(idx_t i = 0; i < j; ++i)
+                            C(i,j) += A(i,l)*alphaConjAjl;
+                        C(j,j) += real( A(j,l) * alphaConjAjl );
+                    }
+                }
+            }
+            else { // uplo == Uplo::Lower
+                for(idx_t j = 0; j < n; ++j) {
+
+                    C(j,j) = beta * real( C(j,j) );
+                    for(idx_t i = j+1; i < n; ++i)
+                        C(i,j) *= beta;
+
+                    for(idx_t l = 0; l < k; ++l) {
+
+                        auto alphaConjAjl = alpha*conj( A(j,l) );
+
+                        C(j,j) += real( A(j,l) * alphaConjAjl );
+                        for(idx_t i = j+1; i < n; ++i) {
+                            C(i,j) += A(i,l) * alphaConjAjl;
+                        }
+                    }
+                }
+            }
+        }
+        else { // trans == Op::ConjTrans
+            if (uplo != Uplo::Lower) {
+            // uplo == Uplo::Upper or uplo == Uplo::General
+                for(idx_t j = 0; j < n; ++j) {
+                    for(idx_t i = 0; i < j; ++i) {
+                        TA sum = 0;
+                        for(idx_t l = 0; l < k; ++l)
+                            sum += conj( A(l,i) ) * A(l,j);
+                        C(i,j) = alpha*sum + beta*C(i,j);
+                    }
+                    real_type<TA> sum = 0;
+                    for(idx_t l = 0; l < k; ++l)
+                        sum += real(A(l,j)) * real(A(l,j))
+                             + imag(A(l,j)) * imag(A(l,j));
+                    C(j,j) = alpha*sum + beta*real( C(j,j) );
+                }
+            }
+            else {
+                // uplo == Uplo::Lower
+                for(idx_t j = 0; j < n; ++j) {
+                    for(idx_t i = j+1; i < n; ++i) {
+                        TA sum = 0;
+                        for(idx_t l = 0; l < k; ++l)
+                            sum += conj( A(l,i) ) * A(l,j);
+                        C(i,j) = alpha*sum + beta*C(i,j);
+                    }
+                    real_type<TA> sum = 0;
+                    for(idx_t l = 0; l < k; ++l)
+                        sum += real(A(l,j)) * real(A(l,j))
+                             + imag(A(l,j)) * imag(A(l,j));
+                    C(j,j) = alpha*sum + beta*real( C(j,j) );
+                }
+            }
+        }
+    }
+
+    // -------------------------------------------------------------------------
+    /** Blocked Hermitian rank-k update of the triangle uplo of C.
+     *
+     * C is split in slabs of at most nb = get_blocksize<T>( "level3", ... )
+     * columns.
+     * The diagonal block of each slab is updated by herk_unblocked, and the
+     * off-diagonal block by gemm. With more than one thread, the slabs are
+     * updated concurrently, the largest off-diagonal blocks first.
+     *
+     * Uplo::General is handled as Uplo::Upper. The arguments are not checked.
+     */
+    template< class matrixA_t, class matrixC_t, class alpha_t, class beta_t >
+    void herk_blocked(
+        Uplo uplo, Op trans,
+        const alpha_t& alpha, const matrixA_t& A,
+        const beta_t& beta, matrixC_t& C )
+    {
+        // data traits
+        using TA    = type_t< matrixA_t >;
+        using idx_t = size_type< matrixC_t >;
+        using pair  = std::pair<idx_t,idx_t>;
+
+        // constants
+        const idx_t n = (trans == Op::NoTrans) ? nrows(A) : ncols(A);
+        const idx_t k = (trans == Op::NoTrans) ? ncols(A) : nrows(A);
+        const idx_t nb = get_blocksize< TA >( "level3", n, n, k );
+
+        if( n <= nb ) {
+            herk_unblocked( uplo, trans, alpha, A, beta, C );
+            return;
+        }
+
+        const int nt = num_threads_for( double(n) * n * k );
+        const idx_t ns = (nt > 1) ? idx_t(4*nt) : idx_t(1);
+        const idx_t sb = ((n + ns-1) / ns < nb) ? (n + ns-1) / ns : nb;
+        const idx_t nslabs = (n + sb-1) / sb;
+        const Op transA = (trans == Op::NoTrans) ? Op::NoTrans : Op::ConjTrans;
+        const Op transB = (trans == Op::NoTrans) ? Op::ConjTrans : Op::NoTrans;
+
+        parallel_for( nslabs, nt, [&]( std::size_t s ) {
+            // Largest off-diagonal blocks first
+            const idx_t j0 = ((uplo == Uplo::Lower) ? s : nslabs-1-s) * sb;
+            const idx_t j1 = (j0+sb < n) ? j0+sb : n;
+            const idx_t i0 = (uplo == Uplo::Lower) ? j1 : 0;
+            const idx_t i1 = (uplo == Uplo::Lower) ? n  : j0;
+
+            const auto Aj = (trans == Op::NoTrans)
+                ? submatrix( A, pair{j0,j1}, pair{0,k} )
+                : submatrix( A, pair{0,k}, pair{j0,j1} );
+            auto Cjj = submatrix( C, pair{j0,j1}, pair{j0,j1} );
+            herk_unblocked( uplo, trans, alpha, Aj, beta, Cjj );
+
+            if( i0 < i1 ) {
+                const auto Ai = (trans == Op::NoTrans)
+                    ? submatrix( A, pair{i0,i1}, pair{0,k} )
+                    : submatrix( A, pair{0,k}, pair{i0,i1} );
+                auto Cij = submatrix( C, pair{i0,i1}, pair{j0,j1} );
+                gemm( transA, transB, alpha, Ai, Aj, beta, Cij );
+            }
+        } );
+    }
+
+} // namespace internal
+
 /**
  * Hermitian rank-k update:
  * \[
@@ -25,6 +188,8 @@ namespace blas {
  * and A is an n-by-k or k-by-n matrix.
  *
  * Generic implementation for arbitrary data types.
+ * C is updated in blocks of get_blocksize<T>( "level3", ... ) columns, and
+ * the off-diagonal blocks are computed with gemm.
  *
  * @param[in] layout
  *     Matrix storage, Layout::ColMajor or Layout::RowMajor.
@@ -91,12 +256,10 @@ void herk(
     const beta_t& beta, matrixC_t& C )
 {
     // data traits
-    using TA    = type_t< matrixA_t >;
     using idx_t = size_type< matrixC_t >;
 
     // constants
     const idx_t n = (trans == Op::NoTrans) ? nrows(A) : ncols(A);
-    const idx_t k = (trans == Op::NoTrans) ? ncols(A) : nrows(A);
 
     // check arguments
     blas_error_if( uplo != Uplo::Lower &&
@@ -107,78 +270,7 @@ void herk(
     blas_error_if( nrows(C) != ncols(C) ||
                    nrows(C) != n );
 
-    if (trans == Op::NoTrans) {
-        if (uplo != Uplo::Lower) {
-        // uplo == Uplo::Upper or uplo == Uplo::General
-            for(idx_t j = 0; j < n; ++j) {
-
-                for(idx_t i = 0; i < j; ++i)
-                    C(i,j) *= beta;
-                C(j,j) = beta * real( C(j,j) );
-
-                for(idx_t l = 0; l < k; ++l) {
-
-                    auto alphaConjAjl = alpha*conj( A(j,l) );
-
-                    for(idx_t i = 0; i < j; ++i)
-                        C(i,j) += A(i,l)*alphaConjAjl;
-                    C(j,j) += real( A(j,l) * alphaConjAjl );
-                }
-            }
-        }
-        else { // uplo == Uplo::Lower
-            for(idx_t j = 0; j < n; ++j) {
-
-                C(j,j) = beta * real( C(j,j) );
-                for(idx_t i = j+1; i < n; ++i)
-                    C(i,j) *= beta;
-
-                for(idx_t l = 0; l < k; ++l) {
-
-                    auto alphaConjAjl = alpha*conj( A(j,l) );
-
-                    C(j,j) += real( A(j,l) * alphaConjAjl );
-                    for(idx_t i = j+1; i < n; ++i) {
-                        C(i,j) += A(i,l) * alphaConjAjl;
-                    }
-                }
-            }
-        }
-    }
-    else { // trans == Op::ConjTrans
-        if (uplo != Uplo::Lower) {
-        // uplo == Uplo::Upper or uplo == Uplo::General
-            for(idx_t j = 0; j < n; ++j) {
-                for(idx_t i = 0; i < j; ++i) {
-                    TA sum = 0;
-                    for(idx_t l = 0; l < k; ++l)
-                        sum += conj( A(l,i) ) * A(l,j);
-                    C(i,j) = alpha*sum + beta*C(i,j);
-                }
-                real_type<TA> sum = 0;
-                for(idx_t l = 0; l < k; ++l)
-                    sum += real(A(l,j)) * real(A(l,j))
-                         + imag(A(l,j)) * imag(A(l,j));
-                C(j,j) = alpha*sum + beta*real( C(j,j) );
-            }
-        }
-        else {
-            // uplo == Uplo::Lower
-            for(idx_t j = 0; j < n; ++j) {
-                for(idx_t i = j+1; i < n; ++i) {
-                    TA sum = 0;
-                    for(idx_t l = 0; l < k; ++l)
-                        sum += conj( A(l,i) ) * A(l,j);
-                    C(i,j) = alpha*sum + beta*C(i,j);
-                }
-                real_type<TA> sum = 0;
-                for(idx_t l = 0; l < k; ++l)
-                    sum += real(A(l,j)) * real(A(l,j))
-                         + imag(A(l,j)) * imag(A(l,j));
-                C(j,j) = alpha*sum + beta*real( C(j,j) );
-            }
-        }
-    }
+    internal::herk_blocked( uplo, trans, alpha, A, beta, C );
 
     if (uplo == Uplo::General) {
         for(idx_t j = 0; j < n; ++j) {
@@ -188,6 +280,34 @@ void herk(
     }
 }
 
+/**
+ * Hermitian rank-k update with a given number of threads.
+ * @see herk( blas::Uplo, blas::Op, const alpha_t&, const matrixA_t&, const beta_t&, matrixC_t& )
+ *
+ * @param[in] policy Execution policy with the number of threads.
+ *
+ * @ingroup herk
+ */
+template<
+    class matrixA_t, class matrixC_t, 
+    class alpha_t, class beta_t,
+    enable_if_t<(
+    /* Requires: */
+        !is_complex<alpha_t>::value &&
+        !is_complex<beta_t> ::value
+    ), int > = 0
+>
+inline void herk(
+    const parallel_policy& policy,
+    blas::Uplo uplo,
+    blas::Op trans,
+    const alpha_t& alpha, const matrixA_t& A,
+    const beta_t& beta, matrixC_t& C )
+{
+    internal::num_threads_scope scope( policy.num_threads );
+    herk( uplo, trans, alpha, A, beta, C );
+}
+
 }  // namespace blas
 
 #endif        //  #ifndef BLAS_HERK_HH
@@ -17,7 +17,9 @@
 #define BLAS_NRM2_HH
 
 #include "blas/utils.hpp"
+#include "blas/dispatch.hpp"
 #include "blas/constants.hpp"
+#include "blas/sumsq.hpp"
 
 namespace blas {
 
@@ -26,6 +28,9 @@ namespace blas {
  *     $|| x ||_2 = (\sum_{i=0}^{n-1} |x_i|^2)^{1/2}$.
  *
  * Generic implementation for arbitrary data types.
+ * Contiguous vectors of float and double use a vectorized kernel, which
+ * may give a result that differs in the last bits.
+ * @see internal::sumsq_contiguous
  *
  * @param[in] n
  *     Number of elements in x. n >= 0.
@@ -63,6 +68,13 @@ nrm2( const vector_t& x )
     // quick return
     if( n <= 0 ) return zero;
 
+    // call BLAS++ on large problems
+    #ifdef USE_BLASPP_WRAPPERS
+        real_t result( zero );
+        if( internal::dispatch_nrm2( x, result ) )
+            return result;
+    #endif
+
     // Compute the sum of squares in 3 accumulators:
     //    abig -- sums of squares scaled down to avoid overflow
     //    asml -- sums of squares scaled up to avoid underflow
@@ -74,56 +86,20 @@ nrm2( const vector_t& x )
     real_t amed = zero;
     real_t abig = zero;
 
-    for (idx_t i = 0; i < n; ++i)
-    {
-        real_t ax = blas::abs( x[i] );
-        if( ax > tbig )
-            abig += (ax*sbig) * (ax*sbig);
-        else if( ax < tsml ) {
-            if( abig == zero ) asml += (ax*ssml) * (ax*ssml);
-        } else
-            amed += ax * ax;
-    }
-
-    // Combine abig and amed or amed and asml if
-    // more than one accumulator was used.
-
-    if( abig > zero ) {
-        // Combine abig and amed if abig > 0
-        if( amed > zero || isnan(amed) )
-            abig += (amed*sbig)*sbig;
-        scl = one / sbig;
-        sumsq = abig;
-    }
-    else if( asml > zero ) {
-        // Combine amed and asml if asml > 0
-        if( amed > zero || isnan(amed) ) {
-            
-            amed = sqrt(amed);
-            asml = sqrt(asml) / ssml;
-            
-            real_t ymin, ymax;
-            if( asml > amed ) {
-                ymin = amed;
-                ymax = asml;
-            } else {
-                ymin = asml;
-                ymax = amed;
-            }
-
-            scl = one;
-            sumsq = (ymax * ymax) * ( one + (ymin/ymax) * (ymin/ymax) );
-        }
-        else {
-            scl = one / ssml;
-            sumsq = asml;
+    if( !internal::sumsq_contiguous( x, asml, amed, abig ) ) {
+        for (idx_t i = 0; i < n; ++i)
+        {
+            real_t ax = blas::abs( x[i] );
+            if( ax > tbig )
+                abig += (ax*sbig) * (ax*sbig);
+            else if( ax < tsml ) {
+                if( abig == zero ) asml += (ax*ssml) * (ax*ssml);
+            } else
+                amed += ax * ax;
         }
     }
-    else {
-        // Otherwise all values are mid-range or zero
-        scl = one;
-        sumsq = amed;
-    }
+
+    internal::sumsq_combine( asml, amed, abig, scl, sumsq );
 
     return scl * sqrt( sumsq );
 }
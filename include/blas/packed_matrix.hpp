@@ -0,0 +1,272 @@
+// Copyright (c) 2021, University of Colorado Denver. All rights reserved.
+//
+// This file is part of <T>LAPACK.
+// <T>LAPACK is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef BLAS_PACKED_MATRIX_HH
+#define BLAS_PACKED_MATRIX_HH
+
+#include "blas/utils.hpp"
+#include "blas/gemm_blocked.hpp"
+
+#include <vector>
+#include <cstddef>
+
+namespace blas {
+
+/**
+ * Role of a pre-packed matrix in gemm.
+ *
+ * - PackedOperand::A: the matrix is packed to be used as A,
+ *      i.e., in row micro-panels of op(A).
+ * - PackedOperand::B: the matrix is packed to be used as B,
+ *      i.e., in column micro-panels of op(B).
+ *
+ * @ingroup gemm
+ */
+enum class PackedOperand { A = 'A', B = 'B' };
+
+/**
+ * Matrix stored in the packed format of the gemm engine.
+ *
+ * Packing a matrix costs about as much as reading it, which is small
+ * compared to a large gemm but is paid again on every call. When the same
+ * A or B is used in many calls to gemm, it may be packed once and the
+ * packed_matrix passed to gemm in place of the original matrix:
+ *
+ *     auto Ap = blas::gemm_pack( PackedOperand::A, Op::NoTrans, A );
+ *     for( ... )
+ *         blas::gemm( Op::NoTrans, Op::NoTrans, alpha, Ap, B[i], beta, C[i] );
+ *
+ * The packed_matrix behaves like a read-only copy of the original matrix X:
+ * nrows, ncols and X(i,j) refer to X. op(X) is applied while packing, so gemm
+ * reads the packed data in place only if the operation passed to gemm is the
+ * one used in the packing, the role of the matrix in gemm is the packed one,
+ * and the scalar type of gemm is T. Otherwise, the result is still correct,
+ * but the data is repacked.
+ *
+ * Storage: op(X) is split into slabs of gemm_blocksize<T>::kc along the
+ * inner dimension k of the product. Each slab is packed by gemm_pack_A or
+ * gemm_pack_B as a whole, so that any block of mr rows of op(A) (resp. nr
+ * columns of op(B)) of the slab is contiguous.
+ *
+ * @tparam T Type of the entries.
+ * @tparam idx_type Type of the sizes and indices, usually the size_type of
+ *      the original matrix.
+ *
+ * @ingroup gemm
+ */
+template< typename T, typename idx_type = std::size_t >
+class packed_matrix {
+public:
+    using value_type = T;
+    using idx_t = idx_type;
+
+    /** Packs op(X).
+     *
+     * @param[in] operand
+     *     Role of X in gemm: PackedOperand::A or PackedOperand::B.
+     * @param[in] trans
+     *     The operation that gemm will apply to X.
+     * @param[in] X
+     *     The matrix to be packed. It is not referenced afterwards.
+     */
+    template< class matrix_t >
+    packed_matrix( PackedOperand operand, Op trans, const matrix_t& X )
+        : operand_( operand )
+        , op_( trans )
+        , m_( blas::nrows(X) )
+        , n_( blas::ncols(X) )
+    {
+        blas_error_if( operand != PackedOperand::A &&
+                       operand != PackedOperand::B );
+        blas_error_if( trans != Op::NoTrans &&
+                       trans != Op::Trans &&
+                       trans != Op::ConjTrans );
+
+        // op(A) is outer-by-k and op(B) is k-by-outer
+        const bool isA = (operand == PackedOperand::A);
+        const idx_t opm = (trans == Op::NoTrans) ? m_ : n_;
+        const idx_t opn = (trans == Op::NoTrans) ? n_ : m_;
+        outer_ = isA ? opm : opn;
+        k_     = isA ? opn : opm;
+
+        const idx_t w = width();
+        ld_ = ((outer_ + w - 1) / w) * w;
+        data_.resize( ld_ * k_ );
+
+        const idx_t kc = gemm_blocksize<T>::kc;
+        for(idx_t pc = 0; pc < k_; pc += kc) {
+            const idx_t kb = min( kc, k_-pc );
+            if( isA )
+                internal::gemm_pack_A< gemm_blocksize<T>::mr >(
+                    trans, X, idx_t(0), outer_, pc, kb, &data_[ pc*ld_ ] );
+            else
+                internal::gemm_pack_B< gemm_blocksize<T>::nr >(
+                    trans, X, pc, kb, idx_t(0), outer_, &data_[ pc*ld_ ] );
+        }
+    }
+
+    /// Role of the matrix in gemm
+    PackedOperand operand() const { return operand_; }
+    /// Operation applied to the matrix when it was packed
+    Op op() const { return op_; }
+    /// Number of rows of the original matrix
+    idx_t nrows() const { return m_; }
+    /// Number of columns of the original matrix
+    idx_t ncols() const { return n_; }
+
+    /// Entry (i,j) of the original matrix
+    T operator()( idx_t i, idx_t j ) const
+    {
+        // (r,l): index of the entry in op(X) as outer and inner indices
+        const bool isA = (operand_ == PackedOperand::A);
+        idx_t r = i, l = j;
+        if( (op_ == Op::NoTrans) != isA ) {
+            r = j;
+            l = i;
+        }
+        const T& x = data_[ offset( r, l ) ];
+        return (op_ == Op::ConjTrans) ? T( conj(x) ) : x;
+    }
+
+    /** Packed block that starts at entry (r0,l0) of op(X), where r0 is an
+     * outer index, multiple of the micro-panel width, and l0 is the first
+     * index of a slab.
+     */
+    const T* block( idx_t r0, idx_t l0 ) const
+    {
+        const idx_t kb = min( idx_t(gemm_blocksize<T>::kc), k_-l0 );
+        return &data_[ l0*ld_ + r0*kb ];
+    }
+
+private:
+    /// Width of the micro-panels
+    idx_t width() const {
+        return ( operand_ == PackedOperand::A )
+            ? idx_t(gemm_blocksize<T>::mr)
+            : idx_t(gemm_blocksize<T>::nr);
+    }
+
+    /// Position of entry (r,l) of op(X) in data_
+    idx_t offset( idx_t r, idx_t l ) const
+    {
+        const idx_t kc = gemm_blocksize<T>::kc;
+        const idx_t w = width();
+        const idx_t l0 = (l / kc) * kc;
+        const idx_t kb = min( kc, k_-l0 );
+        return l0*ld_ + (r/w)*w*kb + (l-l0)*w + r%w;
+    }
+
+    PackedOperand operand_;
+    Op op_;
+    idx_t m_, n_;       ///< Sizes of the original matrix
+    idx_t outer_, k_;   ///< Sizes of op(X) as outer and inner dimensions
+    idx_t ld_;          ///< outer_ rounded up to a multiple of width()
+    std::vector<T> data_;
+};
+
+/** Packs op(X) for repeated use as the operand A or B of gemm.
+ *
+ * @see packed_matrix
+ *
+ * @ingroup gemm
+ */
+template< class matrix_t >
+inline packed_matrix< std::remove_const_t< type_t<matrix_t> >, size_type<matrix_t> >
+gemm_pack( PackedOperand operand, Op trans, const matrix_t& X )
+{
+    return packed_matrix< std::remove_const_t< type_t<matrix_t> >, size_type<matrix_t> >(
+        operand, trans, X );
+}
+
+// -----------------------------------------------------------------------------
+// Traits and size functions for packed_matrix
+
+template< class T, class idx_t >
+struct type_trait< packed_matrix<T,idx_t> > {
+    using type = T;
+};
+
+template< class T, class idx_t >
+struct sizet_trait< packed_matrix<T,idx_t> > {
+    using type = idx_t;
+};
+
+template< class T, class idx_t >
+inline constexpr auto nrows( const packed_matrix<T,idx_t>& X ) { return X.nrows(); }
+
+template< class T, class idx_t >
+inline constexpr auto ncols( const packed_matrix<T,idx_t>& X ) { return X.ncols(); }
+
+template< class T, class idx_t >
+inline constexpr auto size( const packed_matrix<T,idx_t>& X ) { return X.nrows() * X.ncols(); }
+
+namespace internal {
+
+    // -------------------------------------------------------------------------
+    /// gemm_blocked reads pre-packed operands in place when possible.
+    template< class TP, class IP >
+    struct gemm_operand< packed_matrix<TP,IP> > {
+
+        using matrix_t = packed_matrix<TP,IP>;
+
+        template< class T >
+        static bool is_packed_A( const matrix_t& A, Op transA ) {
+            return is_same_v< T, TP >
+                && A.operand() == PackedOperand::A && A.op() == transA;
+        }
+
+        template< class T >
+        static bool is_packed_B( const matrix_t& B, Op transB ) {
+            return is_same_v< T, TP >
+                && B.operand() == PackedOperand::B && B.op() == transB;
+        }
+
+        template< std::size_t mr, class T, class idx_t >
+        static const T* get_A(
+            Op transA, const matrix_t& A,
+            idx_t ic, idx_t mb, idx_t pc, idx_t kb, T* buf )
+        {
+            gemm_pack_A<mr>( transA, A, ic, mb, pc, kb, buf );
+            return buf;
+        }
+
+        template< std::size_t mr, class idx_t >
+        static const TP* get_A(
+            Op transA, const matrix_t& A,
+            idx_t ic, idx_t mb, idx_t pc, idx_t kb, TP* buf )
+        {
+            if( is_packed_A<TP>( A, transA ) )
+                return A.block( ic, pc );
+            gemm_pack_A<mr>( transA, A, ic, mb, pc, kb, buf );
+            return buf;
+        }
+
+        template< std::size_t nr, class T, class idx_t >
+        static const T* get_B(
+            Op transB, const matrix_t& B,
+            idx_t pc, idx_t kb, idx_t jc, idx_t nb, T* buf )
+        {
+            gemm_pack_B<nr>( transB, B, pc, kb, jc, nb, buf );
+            return buf;
+        }
+
+        template< std::size_t nr, class idx_t >
+        static const TP* get_B(
+            Op transB, const matrix_t& B,
+            idx_t pc, idx_t kb, idx_t jc, idx_t nb, TP* buf )
+        {
+            if( is_packed_B<TP>( B, transB ) )
+                return B.block( jc, pc );
+            gemm_pack_B<nr>( transB, B, pc, kb, jc, nb, buf );
+            return buf;
+        }
+    };
+
+} // namespace internal
+
+} // namespace blas
+
+#endif        //  #ifndef BLAS_PACKED_MATRIX_HH
@@ -0,0 +1,336 @@
+// Copyright (c) 2021, University of Colorado Denver. All rights reserved.
+//
+// This file is part of <T>LAPACK.
+// <T>LAPACK is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef BLAS_PARALLEL_HH
+#define BLAS_PARALLEL_HH
+
+#include <cstddef>
+#include <atomic>
+#include <exception>
+
+#ifdef TBLAS_USE_THREADS
+    #include <vector>
+    #include <thread>
+    #include <mutex>
+    #include <condition_variable>
+    #include <functional>
+#endif
+
+#ifdef _OPENMP
+    #include <omp.h>
+#endif
+
+namespace blas {
+
+// -----------------------------------------------------------------------------
+/** Backends for the multithreaded Level 3 BLAS.
+ *
+ * - ParallelBackend::Serial:  no threads are created.
+ * - ParallelBackend::Threads: persistent pool of std::thread workers.
+ *   Requires the macro TBLAS_USE_THREADS.
+ * - ParallelBackend::OpenMP:  OpenMP parallel loops.
+ *   Requires compiling with OpenMP support.
+ *
+ * @ingroup utils
+ */
+enum class ParallelBackend { Serial = 'S', Threads = 'T', OpenMP = 'O' };
+
+// -----------------------------------------------------------------------------
+/** Execution policy that sets the number of threads of a single call.
+ *
+ * @usage:
+ *     blas::gemm( blas::parallel_policy{8}, Op::NoTrans, Op::NoTrans,
+ *                 alpha, A, B, beta, C );
+ *
+ * @ingroup utils
+ */
+struct parallel_policy {
+    int num_threads;
+};
+
+namespace internal {
+
+    // -------------------------------------------------------------------------
+    /// Global settings of the multithreaded code
+    struct parallel_settings {
+        std::atomic<int> num_threads;
+        std::atomic<ParallelBackend> backend;
+
+        parallel_settings()
+            : num_threads( 1 )
+        #if defined(_OPENMP)
+            , backend( ParallelBackend::OpenMP )
+        #elif defined(TBLAS_USE_THREADS)
+            , backend( ParallelBackend::Threads )
+        #else
+            , backend( ParallelBackend::Serial )
+        #endif
+        {}
+    };
+
+    inline parallel_settings& global_parallel_settings() {
+        static parallel_settings settings;
+        return settings;
+    }
+
+    /// Number of threads set for the current call. 0 means not set.
+    inline int& local_num_threads() {
+        thread_local int nt = 0;
+        return nt;
+    }
+
+    /// True if the current thread is running a task of a parallel region.
+    inline bool& in_parallel_region() {
+        thread_local bool flag = false;
+        return flag;
+    }
+
+    // -------------------------------------------------------------------------
+    /// Sets the number of threads of the current thread until destruction.
+    class num_threads_scope {
+    public:
+        explicit num_threads_scope( int nt )
+            : old_( local_num_threads() )
+        { local_num_threads() = nt; }
+
+        ~num_threads_scope()
+        { local_num_threads() = old_; }
+
+        num_threads_scope( const num_threads_scope& ) = delete;
+        num_threads_scope& operator=( const num_threads_scope& ) = delete;
+
+    private:
+        int old_;
+    };
+
+} // namespace internal
+
+// -----------------------------------------------------------------------------
+/** Sets the default number of threads used by the Level 3 BLAS.
+ *
+ * The default is 1, i.e., the serial code is used.
+ *
+ * @ingroup utils
+ */
+inline void set_num_threads( int nt ) {
+    internal::global_parallel_settings().num_threads = (nt > 1) ? nt : 1;
+}
+
+/** Number of threads that a Level 3 BLAS routine would use if called now.
+ *
+ * Returns 1 inside tasks of a parallel region, so that nested calls run
+ * serially, and when the backend is ParallelBackend::Serial.
+ *
+ * @ingroup utils
+ */
+inline int get_num_threads() {
+    if( internal::in_parallel_region() ||
+        internal::global_parallel_settings().backend == ParallelBackend::Serial )
+        return 1;
+    const int nt = internal::local_num_threads();
+    return (nt > 0) ? nt : internal::global_parallel_settings().num_threads.load();
+}
+
+/** Sets the backend used by the multithreaded code.
+ *
+ * Backends that were not compiled in are replaced by the serial backend.
+ *
+ * @ingroup utils
+ */
+inline void set_parallel_backend( ParallelBackend backend ) {
+    #ifndef _OPENMP
+        if( backend == ParallelBackend::OpenMP )
+            backend = ParallelBackend::Serial;
+    #endif
+    #ifndef TBLAS_USE_THREADS
+        if( backend == ParallelBackend::Threads )
+            backend = ParallelBackend::Serial;
+    #endif
+    internal::global_parallel_settings().backend = backend;
+}
+
+/// @return the backend used by the multithreaded code.
+/// @ingroup utils
+inline ParallelBackend get_parallel_backend() {
+    return internal::global_parallel_settings().backend;
+}
+
+namespace internal {
+
+    // -------------------------------------------------------------------------
+    /** Number of threads to use in a problem with the given number of flops.
+     *
+     * Each thread gets at least min_flops flops, so that small problems are
+     * not slowed down by the synchronization.
+     */
+    inline int num_threads_for( double flops, double min_flops = 4.0e6 ) {
+        const int nt = get_num_threads();
+        if( nt <= 1 || flops < 2*min_flops )
+            return 1;
+        const double ntmax = flops / min_flops;
+        return ( ntmax < nt ) ? int(ntmax) : nt;
+    }
+
+#ifdef TBLAS_USE_THREADS
+
+    // -------------------------------------------------------------------------
+    /** Pool of persistent worker threads.
+     *
+     * run() executes a job on a given number of workers and on the calling
+     * thread, and returns when all of them finish. Concurrent calls to run()
+     * from different threads are serialized.
+     */
+    class thread_pool {
+    public:
+        static thread_pool& instance() {
+            static thread_pool pool;
+            return pool;
+        }
+
+        void run( std::size_t nworkers, const std::function<void()>& job )
+        {
+            std::lock_guard<std::mutex> submit_lock( submit_mtx_ );
+            {
+                std::lock_guard<std::mutex> lock( mtx_ );
+                while( workers_.size() < nworkers )
+                    workers_.emplace_back( &thread_pool::worker, this, workers_.size() );
+                job_ = &job;
+                active_ = nworkers;
+                pending_ = nworkers;
+                ++generation_;
+            }
+            cv_.notify_all();
+
+            job();
+
+            std::unique_lock<std::mutex> lock( mtx_ );
+            done_cv_.wait( lock, [this]() { return pending_ == 0; } );
+            job_ = nullptr;
+        }
+
+        ~thread_pool() {
+            {
+                std::lock_guard<std::mutex> lock( mtx_ );
+                stop_ = true;
+            }
+            cv_.notify_all();
+            for( auto& w : workers_ )
+                w.join();
+        }
+
+    private:
+        thread_pool() = default;
+        thread_pool( const thread_pool& ) = delete;
+        thread_pool& operator=( const thread_pool& ) = delete;
+
+        void worker( std::size_t id )
+        {
+            std::size_t seen = 0;
+            for(;;) {
+                const std::function<void()>* job;
+                {
+                    std::unique_lock<std::mutex> lock( mtx_ );
+                    cv_.wait( lock, [&]() { return stop_ || generation_ != seen; } );
+                    if( stop_ ) return;
+                    seen = generation_;
+                    if( id >= active_ ) continue;
+                    job = job_;
+                }
+                (*job)();
+                {
+                    std::lock_guard<std::mutex> lock( mtx_ );
+                    if( --pending_ == 0 )
+                        done_cv_.notify_one();
+                }
+            }
+        }
+
+        std::vector<std::thread> workers_;
+        std::mutex submit_mtx_;
+        std::mutex mtx_;
+        std::condition_variable cv_;
+        std::condition_variable done_cv_;
+        const std::function<void()>* job_ = nullptr;
+        std::size_t generation_ = 0;
+        std::size_t active_ = 0;
+        std::size_t pending_ = 0;
+        bool stop_ = false;
+    };
+
+#endif // TBLAS_USE_THREADS
+
+    // -------------------------------------------------------------------------
+    /** Runs body(i) for i = 0, ..., n-1 using up to nt threads.
+     *
+     * Iterations are distributed dynamically. Inside body, get_num_threads()
+     * returns 1. The first exception thrown by body is rethrown on the
+     * calling thread.
+     */
+    template< class body_t >
+    void parallel_for( std::size_t n, int nt, const body_t& body )
+    {
+        if( nt > int(n) ) nt = int(n);
+        if( nt <= 1 ) {
+            for(std::size_t i = 0; i < n; ++i)
+                body( i );
+            return;
+        }
+
+        std::atomic<std::size_t> next( 0 );
+        std::exception_ptr eptr = nullptr;
+        std::atomic<bool> failed( false );
+
+        auto task = [&]() {
+            bool& flag = in_parallel_region();
+            const bool old = flag;
+            flag = true;
+            try {
+                for( std::size_t i = next++; i < n; i = next++ )
+                    body( i );
+            }
+            catch(...) {
+                if( !failed.exchange( true ) )
+                    eptr = std::current_exception();
+                next = n;
+            }
+            flag = old;
+        };
+
+        switch( get_parallel_backend() ) {
+        #ifdef _OPENMP
+            case ParallelBackend::OpenMP:
+            {
+                #pragma omp parallel num_threads(nt)
+                task();
+                break;
+            }
+        #endif
+        #ifdef TBLAS_USE_THREADS
+            case ParallelBackend::Threads:
+            {
+                const std::function<void()> job( task );
+                thread_pool::instance().run( std::size_t(nt-1), job );
+                break;
+            }
+        #endif
+            default:
+                task();
+        }
+
+        if( failed )
+            std::rethrow_exception( eptr );
+    }
+
+    template< class body_t >
+    inline void parallel_for( std::size_t n, const body_t& body ) {
+        parallel_for( n, get_num_threads(), body );
+    }
+
+} // namespace internal
+
+} // namespace blas
+
+#endif        //  #ifndef BLAS_PARALLEL_HH
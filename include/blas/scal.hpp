@@ -9,6 +9,7 @@
 #define BLAS_SCAL_HH
 
 #include "blas/utils.hpp"
+#include "blas/dispatch.hpp"
 
 namespace blas {
 
@@ -39,6 +40,12 @@ void scal( const alpha_t& alpha, vector_t& x )
     // constants
     const idx_t n = size(x);
 
+    // call BLAS++ on large problems
+    #ifdef USE_BLASPP_WRAPPERS
+        if( internal::dispatch_scal( alpha, x ) )
+            return;
+    #endif
+
     for (idx_t i = 0; i < n; ++i)
         x[i] *= alpha;
 }
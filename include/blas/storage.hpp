@@ -0,0 +1,131 @@
+/// @file storage.hpp Classification of the storage of arrays.
+//
+// Copyright (c) 2021, University of Colorado Denver. All rights reserved.
+//
+// This file is part of <T>LAPACK.
+// <T>LAPACK is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef BLAS_STORAGE_HH
+#define BLAS_STORAGE_HH
+
+#include "blas/types.hpp"
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace blas {
+
+namespace internal {
+
+// -----------------------------------------------------------------------------
+/** True if the array type has strided storage, i.e., if storage_trait
+ * gives a pointer to its data and its strides. This is decided at compile
+ * time, e.g., from `is_always_strided()` in the mdspan plugin.
+ *
+ * @ingroup utils
+ */
+template< class array_t, class Enable = int >
+struct has_storage : std::false_type {};
+
+template< class array_t >
+struct has_storage< array_t, enable_if_t< std::is_pointer<
+    decltype( storage_trait<array_t>::data( std::declval<const array_t&>() ) )
+>::value, int > > : std::true_type {};
+
+/** Storage of a matrix view:
+ * - colmajor: the entries of each column are contiguous.
+ * - rowmajor: the entries of each row are contiguous.
+ * - general:  any other storage, or no strided storage.
+ *
+ * @ingroup utils
+ */
+enum class storage_kind { general, colmajor, rowmajor };
+
+/// Pointer to the first entry of an array with strided storage
+template< class array_t >
+inline auto storage_data( const array_t& A ) {
+    using T = std::remove_const_t< type_t<array_t> >;
+    return const_cast< T* >( storage_trait<array_t>::data( A ) );
+}
+
+/// Distance between consecutive entries along the dimension r of an array
+/// with strided storage. For vectors, r = 0.
+template< class array_t >
+inline std::ptrdiff_t storage_stride( const array_t& A, std::size_t r ) {
+    return std::ptrdiff_t( storage_trait<array_t>::stride( A, r ) );
+}
+
+/** Classifies the storage of a matrix at runtime. Matrices with a single
+ * row or column are classified by the stride of their other dimension.
+ *
+ * @ingroup utils
+ */
+template< class matrix_t,
+    enable_if_t< has_storage< matrix_t >::value, int > = 0 >
+inline storage_kind storage_of( const matrix_t& A ) {
+    const bool unit0 = ( nrows(A) <= 1 || storage_stride( A, 0 ) == 1 );
+    const bool unit1 = ( ncols(A) <= 1 || storage_stride( A, 1 ) == 1 );
+    return ( unit0 && ( ncols(A) <= 1 || storage_stride( A, 1 ) >= std::ptrdiff_t(nrows(A)) ) )
+            ? storage_kind::colmajor
+         : ( unit1 && ( nrows(A) <= 1 || storage_stride( A, 0 ) >= std::ptrdiff_t(ncols(A)) ) )
+            ? storage_kind::rowmajor
+         : storage_kind::general;
+}
+
+template< class matrix_t,
+    enable_if_t< !has_storage< matrix_t >::value, int > = 0 >
+inline constexpr storage_kind storage_of( const matrix_t& ) {
+    return storage_kind::general;
+}
+
+/** True if the matrix type is always stored row major, e.g., mdspan with
+ * layout_right or Eigen matrices with the RowMajor option. This is the
+ * member is_rowmajor of storage_trait, if any.
+ *
+ * @ingroup utils
+ */
+template< class matrix_t, class Enable = int >
+struct is_rowmajor : std::false_type {};
+
+template< class matrix_t >
+struct is_rowmajor< matrix_t,
+    enable_if_t< storage_trait<matrix_t>::is_rowmajor, int > > : std::true_type {};
+
+/** True if the loops on A should run along its rows, i.e., if A is row
+ * major. This is known at compile time from is_rowmajor. Otherwise, A is
+ * classified at runtime with storage_of.
+ *
+ * @ingroup utils
+ */
+template< class matrix_t >
+inline bool rowmajor_loops( const matrix_t& A ) {
+    return is_rowmajor< matrix_t >::value
+        || storage_of( A ) == storage_kind::rowmajor;
+}
+
+/// Leading dimension of a matrix classified as colmajor or rowmajor
+template< class matrix_t >
+inline std::ptrdiff_t storage_ld( const matrix_t& A, storage_kind kind ) {
+    const std::size_t r = ( kind == storage_kind::colmajor ) ? 1 : 0;
+    const std::ptrdiff_t len = ( kind == storage_kind::colmajor )
+        ? std::ptrdiff_t( nrows(A) )
+        : std::ptrdiff_t( ncols(A) );
+    const std::ptrdiff_t other = ( kind == storage_kind::colmajor )
+        ? std::ptrdiff_t( ncols(A) )
+        : std::ptrdiff_t( nrows(A) );
+    return ( other > 1 ) ? storage_stride( A, r ) : ( ( len > 1 ) ? len : 1 );
+}
+
+/// Increment of a vector with strided storage
+template< class vector_t >
+inline std::ptrdiff_t storage_inc( const vector_t& x ) {
+    return ( size(x) > 1 ) ? storage_stride( x, 0 ) : 1;
+}
+
+} // namespace internal
+
+} // namespace blas
+
+#endif // BLAS_STORAGE_HH
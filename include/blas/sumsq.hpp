@@ -0,0 +1,480 @@
+/// @file sumsq.hpp Sums of squares with Blue's accumulators.
+///
+/// Anderson E. (2017)
+/// Algorithm 978: Safe Scaling in the Level 1 BLAS
+/// ACM Trans Math Softw 44:1--28
+/// @see https://doi.org/10.1145/3061665
+//
+// Copyright (c) 2021, University of Colorado Denver. All rights reserved.
+//
+// This file is part of <T>LAPACK.
+// <T>LAPACK is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef BLAS_SUMSQ_HH
+#define BLAS_SUMSQ_HH
+
+#include "blas/utils.hpp"
+#include "blas/constants.hpp"
+#include "blas/storage.hpp"
+#include "blas/parallel.hpp"
+#include "blas/gemm_kernels.hpp"
+
+#include <cstddef>
+#include <vector>
+
+namespace blas {
+
+namespace internal {
+
+// -----------------------------------------------------------------------------
+/** Number of independent accumulators of sumsq_kernel_generic.
+ *
+ * Each lane has its own abig, amed and asml, so that the loop has no
+ * dependencies between consecutive entries and can be vectorized.
+ * May be defined at compile time. The SIMD kernels use the width of their
+ * registers instead.
+ *
+ * @ingroup utils
+ */
+#ifndef TBLAS_SUMSQ_LANES
+    #define TBLAS_SUMSQ_LANES 8
+#endif
+
+/// Minimum number of entries per thread in sumsq_contiguous
+#ifndef TBLAS_SUMSQ_MIN_CHUNK
+    #define TBLAS_SUMSQ_MIN_CHUNK 262144
+#endif
+
+/** Adds the squares of the n real entries of x to Blue's accumulators:
+ *    abig -- sums of squares scaled down to avoid overflow
+ *    asml -- sums of squares scaled up to avoid underflow
+ *    amed -- sums of squares that do not require scaling
+ *
+ * Each entry is added to exactly one accumulator of its lane, selected by
+ * masks instead of branches. Thus, asml is updated even if abig > 0. The
+ * final value is the same, since asml is not used when abig > 0.
+ * NaNs go to amed, and infinities to abig, as in the loop of nrm2.
+ *
+ * This is the fallback of sumsq_kernel for any real type.
+ *
+ * @ingroup utils
+ */
+template< class real_t, class idx_t >
+void sumsq_kernel_generic(
+    const real_t* x, idx_t n,
+    real_t& asml, real_t& amed, real_t& abig )
+{
+    constexpr int L = TBLAS_SUMSQ_LANES;
+
+    // constants
+    const real_t zero( 0 );
+    const real_t tsml = blas::blue_min<real_t>();
+    const real_t tbig = blas::blue_max<real_t>();
+    const real_t ssml = blas::blue_scalingMin<real_t>();
+    const real_t sbig = blas::blue_scalingMax<real_t>();
+
+    real_t sml[L], med[L], big[L];
+    for (int l = 0; l < L; ++l) {
+        sml[l] = zero;
+        med[l] = zero;
+        big[l] = zero;
+    }
+
+    auto accumulate = [&]( int l, real_t ax ) {
+        const bool isbig = ( ax > tbig );
+        const bool issml = ( ax < tsml );
+        const real_t axbig = ax * sbig;
+        const real_t axsml = ax * ssml;
+        big[l] += isbig ? axbig * axbig : zero;
+        sml[l] += issml ? axsml * axsml : zero;
+        med[l] += ( isbig || issml ) ? zero : ax * ax;
+    };
+
+    idx_t i = 0;
+    for (; i + L <= n; i += L)
+        for (int l = 0; l < L; ++l)
+            accumulate( l, std::abs( x[i+l] ) );
+    for (int l = 0; i < n; ++i, ++l)
+        accumulate( l, std::abs( x[i] ) );
+
+    for (int l = 0; l < L; ++l) {
+        asml += sml[l];
+        amed += med[l];
+        abig += big[l];
+    }
+}
+
+/** Kernel used by sumsq_contiguous. @see sumsq_kernel_generic
+ *
+ * The specializations for float and double use AVX2 or AVX-512 kernels,
+ * selected at runtime as the gemm micro-kernels (@see cpu_simd_isa).
+ *
+ * @ingroup utils
+ */
+template< class real_t >
+struct sumsq_kernel {
+    static inline void run(
+        const real_t* x, std::size_t n,
+        real_t& asml, real_t& amed, real_t& abig )
+    {
+        sumsq_kernel_generic( x, n, asml, amed, abig );
+    }
+};
+
+#ifdef TBLAS_SIMD_X86
+
+// -----------------------------------------------------------------------------
+// SIMD kernels. Each register holds one lane per entry. The square of each
+// entry is added to the accumulator of its class with a mask, so that the
+// lanes of the other accumulators are left unchanged. The entries of the
+// other classes are zeroed before they are scaled and squared: otherwise,
+// their products may be subnormal, which is very slow on x86. The entries
+// that do not fill two registers are added by sumsq_kernel_generic.
+
+__attribute__((target("avx2")))
+inline void dsumsq_kernel_avx2(
+    const double* x, std::size_t n,
+    double& asml, double& amed, double& abig )
+{
+    const __m256d sign = _mm256_set1_pd( -0.0 );
+    const __m256d tsml = _mm256_set1_pd( blue_min<double>() );
+    const __m256d tbig = _mm256_set1_pd( blue_max<double>() );
+    const __m256d ssml = _mm256_set1_pd( blue_scalingMin<double>() );
+    const __m256d sbig = _mm256_set1_pd( blue_scalingMax<double>() );
+
+    __m256d sml[2], med[2], big[2];
+    for(int v = 0; v < 2; ++v)
+        sml[v] = med[v] = big[v] = _mm256_setzero_pd();
+
+    std::size_t i = 0;
+    for(; i + 8 <= n; i += 8) {
+        for(int v = 0; v < 2; ++v) {
+            const __m256d ax = _mm256_andnot_pd( sign, _mm256_loadu_pd( x+i+4*v ) );
+            const __m256d isbig = _mm256_cmp_pd( ax, tbig, _CMP_GT_OQ );
+            const __m256d issml = _mm256_cmp_pd( ax, tsml, _CMP_LT_OQ );
+            const __m256d axbig = _mm256_mul_pd( _mm256_and_pd( isbig, ax ), sbig );
+            const __m256d axsml = _mm256_mul_pd( _mm256_and_pd( issml, ax ), ssml );
+            const __m256d axmed = _mm256_andnot_pd( _mm256_or_pd( isbig, issml ), ax );
+            big[v] = _mm256_add_pd( big[v], _mm256_mul_pd( axbig, axbig ) );
+            sml[v] = _mm256_add_pd( sml[v], _mm256_mul_pd( axsml, axsml ) );
+            med[v] = _mm256_add_pd( med[v], _mm256_mul_pd( axmed, axmed ) );
+        }
+    }
+
+    alignas(32) double lanes[3][8];
+    for(int v = 0; v < 2; ++v) {
+        _mm256_store_pd( lanes[0] + 4*v, sml[v] );
+        _mm256_store_pd( lanes[1] + 4*v, med[v] );
+        _mm256_store_pd( lanes[2] + 4*v, big[v] );
+    }
+    for(int l = 0; l < 8; ++l) {
+        asml += lanes[0][l];
+        amed += lanes[1][l];
+        abig += lanes[2][l];
+    }
+    sumsq_kernel_generic( x+i, n-i, asml, amed, abig );
+}
+
+__attribute__((target("avx512f")))
+inline void dsumsq_kernel_avx512(
+    const double* x, std::size_t n,
+    double& asml, double& amed, double& abig )
+{
+    const __m512d tsml = _mm512_set1_pd( blue_min<double>() );
+    const __m512d tbig = _mm512_set1_pd( blue_max<double>() );
+    const __m512d ssml = _mm512_set1_pd( blue_scalingMin<double>() );
+    const __m512d sbig = _mm512_set1_pd( blue_scalingMax<double>() );
+
+    __m512d sml[2], med[2], big[2];
+    for(int v = 0; v < 2; ++v)
+        sml[v] = med[v] = big[v] = _mm512_setzero_pd();
+
+    std::size_t i = 0;
+    for(; i + 16 <= n; i += 16) {
+        for(int v = 0; v < 2; ++v) {
+            const __m512d ax = _mm512_abs_pd( _mm512_loadu_pd( x+i+8*v ) );
+            const __mmask8 isbig = _mm512_cmp_pd_mask( ax, tbig, _CMP_GT_OQ );
+            const __mmask8 issml = _mm512_cmp_pd_mask( ax, tsml, _CMP_LT_OQ );
+            const __mmask8 ismed = __mmask8( ~(isbig | issml) );
+            const __m512d axbig = _mm512_maskz_mul_pd( isbig, ax, sbig );
+            const __m512d axsml = _mm512_maskz_mul_pd( issml, ax, ssml );
+            const __m512d axmed = _mm512_maskz_mov_pd( ismed, ax );
+            big[v] = _mm512_mask_add_pd( big[v], isbig,
+                big[v], _mm512_mul_pd( axbig, axbig ) );
+            sml[v] = _mm512_mask_add_pd( sml[v], issml,
+                sml[v], _mm512_mul_pd( axsml, axsml ) );
+            med[v] = _mm512_mask_add_pd( med[v], ismed,
+                med[v], _mm512_mul_pd( axmed, axmed ) );
+        }
+    }
+
+    alignas(64) double lanes[3][16];
+    for(int v = 0; v < 2; ++v) {
+        _mm512_store_pd( lanes[0] + 8*v, sml[v] );
+        _mm512_store_pd( lanes[1] + 8*v, med[v] );
+        _mm512_store_pd( lanes[2] + 8*v, big[v] );
+    }
+    for(int l = 0; l < 16; ++l) {
+        asml += lanes[0][l];
+        amed += lanes[1][l];
+        abig += lanes[2][l];
+    }
+    sumsq_kernel_generic( x+i, n-i, asml, amed, abig );
+}
+
+__attribute__((target("avx2")))
+inline void ssumsq_kernel_avx2(
+    const float* x, std::size_t n,
+    float& asml, float& amed, float& abig )
+{
+    const __m256 sign = _mm256_set1_ps( -0.0f );
+    const __m256 tsml = _mm256_set1_ps( blue_min<float>() );
+    const __m256 tbig = _mm256_set1_ps( blue_max<float>() );
+    const __m256 ssml = _mm256_set1_ps( blue_scalingMin<float>() );
+    const __m256 sbig = _mm256_set1_ps( blue_scalingMax<float>() );
+
+    __m256 sml[2], med[2], big[2];
+    for(int v = 0; v < 2; ++v)
+        sml[v] = med[v] = big[v] = _mm256_setzero_ps();
+
+    std::size_t i = 0;
+    for(; i + 16 <= n; i += 16) {
+        for(int v = 0; v < 2; ++v) {
+            const __m256 ax = _mm256_andnot_ps( sign, _mm256_loadu_ps( x+i+8*v ) );
+            const __m256 isbig = _mm256_cmp_ps( ax, tbig, _CMP_GT_OQ );
+            const __m256 issml = _mm256_cmp_ps( ax, tsml, _CMP_LT_OQ );
+            const __m256 axbig = _mm256_mul_ps( _mm256_and_ps( isbig, ax ), sbig );
+            const __m256 axsml = _mm256_mul_ps( _mm256_and_ps( issml, ax ), ssml );
+            const __m256 axmed = _mm256_andnot_ps( _mm256_or_ps( isbig, issml ), ax );
+            big[v] = _mm256_add_ps( big[v], _mm256_mul_ps( axbig, axbig ) );
+            sml[v] = _mm256_add_ps( sml[v], _mm256_mul_ps( axsml, axsml ) );
+            med[v] = _mm256_add_ps( med[v], _mm256_mul_ps( axmed, axmed ) );
+        }
+    }
+
+    alignas(32) float lanes[3][16];
+    for(int v = 0; v < 2; ++v) {
+        _mm256_store_ps( lanes[0] + 8*v, sml[v] );
+        _mm256_store_ps( lanes[1] + 8*v, med[v] );
+        _mm256_store_ps( lanes[2] + 8*v, big[v] );
+    }
+    for(int l = 0; l < 16; ++l) {
+        asml += lanes[0][l];
+        amed += lanes[1][l];
+        abig += lanes[2][l];
+    }
+    sumsq_kernel_generic( x+i, n-i, asml, amed, abig );
+}
+
+__attribute__((target("avx512f")))
+inline void ssumsq_kernel_avx512(
+    const float* x, std::size_t n,
+    float& asml, float& amed, float& abig )
+{
+    const __m512 tsml = _mm512_set1_ps( blue_min<float>() );
+    const __m512 tbig = _mm512_set1_ps( blue_max<float>() );
+    const __m512 ssml = _mm512_set1_ps( blue_scalingMin<float>() );
+    const __m512 sbig = _mm512_set1_ps( blue_scalingMax<float>() );
+
+    __m512 sml[2], med[2], big[2];
+    for(int v = 0; v < 2; ++v)
+        sml[v] = med[v] = big[v] = _mm512_setzero_ps();
+
+    std::size_t i = 0;
+    for(; i + 32 <= n; i += 32) {
+        for(int v = 0; v < 2; ++v) {
+            const __m512 ax = _mm512_abs_ps( _mm512_loadu_ps( x+i+16*v ) );
+            const __mmask16 isbig = _mm512_cmp_ps_mask( ax, tbig, _CMP_GT_OQ );
+            const __mmask16 issml = _mm512_cmp_ps_mask( ax, tsml, _CMP_LT_OQ );
+            const __mmask16 ismed = __mmask16( ~(isbig | issml) );
+            const __m512 axbig = _mm512_maskz_mul_ps( isbig, ax, sbig );
+            const __m512 axsml = _mm512_maskz_mul_ps( issml, ax, ssml );
+            const __m512 axmed = _mm512_maskz_mov_ps( ismed, ax );
+            big[v] = _mm512_mask_add_ps( big[v], isbig,
+                big[v], _mm512_mul_ps( axbig, axbig ) );
+            sml[v] = _mm512_mask_add_ps( sml[v], issml,
+                sml[v], _mm512_mul_ps( axsml, axsml ) );
+            med[v] = _mm512_mask_add_ps( med[v], ismed,
+                med[v], _mm512_mul_ps( axmed, axmed ) );
+        }
+    }
+
+    alignas(64) float lanes[3][32];
+    for(int v = 0; v < 2; ++v) {
+        _mm512_store_ps( lanes[0] + 16*v, sml[v] );
+        _mm512_store_ps( lanes[1] + 16*v, med[v] );
+        _mm512_store_ps( lanes[2] + 16*v, big[v] );
+    }
+    for(int l = 0; l < 32; ++l) {
+        asml += lanes[0][l];
+        amed += lanes[1][l];
+        abig += lanes[2][l];
+    }
+    sumsq_kernel_generic( x+i, n-i, asml, amed, abig );
+}
+
+template<>
+struct sumsq_kernel< double > {
+    static inline void run(
+        const double* x, std::size_t n,
+        double& asml, double& amed, double& abig )
+    {
+        const simd_isa isa = cpu_simd_isa();
+        if( isa == simd_isa::avx512 )
+            dsumsq_kernel_avx512( x, n, asml, amed, abig );
+        else if( isa == simd_isa::avx2 )
+            dsumsq_kernel_avx2( x, n, asml, amed, abig );
+        else
+            sumsq_kernel_generic( x, n, asml, amed, abig );
+    }
+};
+
+template<>
+struct sumsq_kernel< float > {
+    static inline void run(
+        const float* x, std::size_t n,
+        float& asml, float& amed, float& abig )
+    {
+        const simd_isa isa = cpu_simd_isa();
+        if( isa == simd_isa::avx512 )
+            ssumsq_kernel_avx512( x, n, asml, amed, abig );
+        else if( isa == simd_isa::avx2 )
+            ssumsq_kernel_avx2( x, n, asml, amed, abig );
+        else
+            sumsq_kernel_generic( x, n, asml, amed, abig );
+    }
+};
+
+#endif // TBLAS_SIMD_X86
+
+/** Adds the squares of the entries of x to Blue's accumulators on raw
+ * pointers if x has unit stride and real or complex float or double entries.
+ * The real and imaginary parts of complex entries are classified
+ * separately. Long vectors are split into chunks that may run on
+ * different threads (@see get_num_threads). The accumulators of the chunks
+ * are added in the order of the chunks.
+ *
+ * The entries are summed in a different order than in the loop of nrm2, so
+ * the result may differ in the last bits. The error bound of the sum of
+ * squares is the same.
+ *
+ * Returns false, and does nothing, otherwise.
+ *
+ * @ingroup utils
+ */
+template< class vector_t, class real_t,
+    enable_if_t<(
+        has_storage< vector_t >::value &&
+        std::is_floating_point< real_t >::value &&
+        std::is_same< real_type< type_t<vector_t> >, real_t >::value
+    ), int > = 0 >
+bool sumsq_contiguous(
+    const vector_t& x,
+    real_t& asml, real_t& amed, real_t& abig )
+{
+    using T = std::remove_const_t< type_t<vector_t> >;
+
+    if( storage_inc(x) != 1 )
+        return false;
+
+    // std::complex<real_t> is an array of two real_t
+    constexpr std::size_t ncomp = is_complex<T>::value ? 2 : 1;
+    const std::size_t n = ncomp * std::size_t( size(x) );
+    const real_t* _x = reinterpret_cast< const real_t* >( storage_data(x) );
+
+    std::size_t nchunks = n / TBLAS_SUMSQ_MIN_CHUNK;
+    const int nt = ( nchunks > 1 ) ? get_num_threads() : 1;
+    if( nchunks > std::size_t(nt) )
+        nchunks = nt;
+
+    if( nchunks <= 1 ) {
+        sumsq_kernel< real_t >::run( _x, n, asml, amed, abig );
+        return true;
+    }
+
+    // Partial accumulators of each chunk
+    const real_t zero( 0 );
+    std::vector< real_t > partial( 3*nchunks, zero );
+    const std::size_t chunk = ( n + nchunks-1 ) / nchunks;
+    parallel_for( nchunks, nt, [&]( std::size_t s ) {
+        const std::size_t i0 = s * chunk;
+        const std::size_t i1 = std::min( n, i0 + chunk );
+        sumsq_kernel< real_t >::run( _x + i0, i1 - i0,
+            partial[3*s], partial[3*s+1], partial[3*s+2] );
+    });
+
+    for (std::size_t s = 0; s < nchunks; ++s) {
+        asml += partial[3*s];
+        amed += partial[3*s+1];
+        abig += partial[3*s+2];
+    }
+
+    return true;
+}
+
+template< class... Ts >
+inline constexpr bool sumsq_contiguous( const Ts&... ) { return false; }
+
+/** Combines Blue's accumulators into the scaled sum of squares
+ * scl^2 sumsq = abig / sbig^2 + amed + asml / ssml^2.
+ *
+ * @ingroup utils
+ */
+template< class real_t >
+void sumsq_combine(
+    real_t asml, real_t amed, real_t abig,
+    real_t& scl, real_t& sumsq )
+{
+    // constants
+    const real_t zero( 0 );
+    const real_t one( 1 );
+    const real_t ssml = blas::blue_scalingMin<real_t>();
+    const real_t sbig = blas::blue_scalingMax<real_t>();
+
+    // Combine abig and amed or amed and asml if
+    // more than one accumulator was used.
+
+    if( abig > zero ) {
+        // Combine abig and amed if abig > 0
+        if( amed > zero || isnan(amed) )
+            abig += (amed*sbig)*sbig;
+        scl = one / sbig;
+        sumsq = abig;
+    }
+    else if( asml > zero ) {
+        // Combine amed and asml if asml > 0
+        if( amed > zero || isnan(amed) ) {
+
+            amed = sqrt(amed);
+            asml = sqrt(asml) / ssml;
+
+            real_t ymin, ymax;
+            if( asml > amed ) {
+                ymin = amed;
+                ymax = asml;
+            } else {
+                ymin = asml;
+                ymax = amed;
+            }
+
+            scl = one;
+            sumsq = (ymax * ymax) * ( one + (ymin/ymax) * (ymin/ymax) );
+        }
+        else {
+            scl = one / ssml;
+            sumsq = asml;
+        }
+    }
+    else {
+        // Otherwise all values are mid-range or zero
+        scl = one;
+        sumsq = amed;
+    }
+}
+
+} // namespace internal
+
+} // namespace blas
+
+#endif        //  #ifndef BLAS_SUMSQ_HH
@@ -20,7 +20,7 @@ namespace blas {
  * @param[in] n
  *     Number of elements in x and y. n >= 0.
  *
- * @param[in] x
+ * @param[in,out] x
  *     The n-element vector x, in an array of length (n-1)*abs(incx) + 1.
  *
  * @param[in] incx
@@ -37,7 +37,7 @@ namespace blas {
  * @ingroup swap
  */
 template< class vectorX_t, class vectorY_t >
-void swap( const vectorX_t& x, vectorY_t& y )
+void swap( vectorX_t& x, vectorY_t& y )
 {
     using idx_t = size_type< vectorY_t >;
 
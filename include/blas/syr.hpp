@@ -9,6 +9,7 @@
 #define BLAS_SYR_HH
 
 #include "blas/utils.hpp"
+#include "blas/storage.hpp"
 
 namespace blas {
 
@@ -71,7 +72,24 @@ void syr(
     blas_error_if( nrows(A) != ncols(A) ||
                    nrows(A) != n );
 
-    if (uplo == Uplo::Upper) {
+    if( internal::rowmajor_loops( A ) ) {
+        // loops along the rows of a row-major A
+        if (uplo == Uplo::Upper) {
+            for (idx_t i = 0; i < n; ++i) {
+                auto tmp = alpha * x[i];
+                for (idx_t j = i; j < n; ++j)
+                    A(i,j) += tmp * x[j];
+            }
+        }
+        else {
+            for (idx_t i = 0; i < n; ++i) {
+                auto tmp = alpha * x[i];
+                for (idx_t j = 0; j <= i; ++j)
+                    A(i,j) += tmp * x[j];
+            }
+        }
+    }
+    else if (uplo == Uplo::Upper) {
         for (idx_t j = 0; j < n; ++j) {
             auto tmp = alpha * x[j];
             for (idx_t i = 0; i <= j; ++i)
@@ -9,6 +9,7 @@
 #define BLAS_SYR2_HH
 
 #include "blas/utils.hpp"
+#include "blas/storage.hpp"
 
 namespace blas {
 
@@ -67,7 +68,7 @@ void syr2(
     blas::Uplo  uplo,
     const alpha_t& alpha,
     const vectorX_t& x, const vectorY_t& y,
-    const matrixA_t& A )
+    matrixA_t& A )
 {
     // data traits
     using idx_t = size_type< matrixA_t >;
@@ -82,7 +83,26 @@ void syr2(
     blas_error_if( nrows(A) != ncols(A) ||
                    nrows(A) != n );
 
-    if (uplo == Uplo::Upper) {
+    if( internal::rowmajor_loops( A ) ) {
+        // loops along the rows of a row-major A
+        if (uplo == Uplo::Upper) {
+            for (idx_t i = 0; i < n; ++i) {
+                auto tmp1 = alpha * x[i];
+                auto tmp2 = alpha * y[i];
+                for (idx_t j = i; j < n; ++j)
+                    A(i,j) += tmp1*y[j] + tmp2*x[j];
+            }
+        }
+        else {
+            for (idx_t i = 0; i < n; ++i) {
+                auto tmp1 = alpha * x[i];
+                auto tmp2 = alpha * y[i];
+                for (idx_t j = 0; j <= i; ++j)
+                    A(i,j) += tmp1*y[j] + tmp2*x[j];
+            }
+        }
+    }
+    else if (uplo == Uplo::Upper) {
             for (idx_t j = 0; j < n; ++j) {
                 auto tmp1 = alpha * y[j];
                 auto tmp2 = alpha * x[j];
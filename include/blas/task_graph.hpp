@@ -0,0 +1,205 @@
+// Copyright (c) 2021, University of Colorado Denver. All rights reserved.
+//
+// This file is part of <T>LAPACK.
+// <T>LAPACK is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef BLAS_TASK_GRAPH_HH
+#define BLAS_TASK_GRAPH_HH
+
+#include "blas/parallel.hpp"
+
+#include <vector>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <algorithm>
+
+namespace blas {
+namespace internal {
+
+// -----------------------------------------------------------------------------
+/** Directed acyclic graph of tasks executed by a work-stealing scheduler.
+ *
+ * Tasks are added with add_task() and ordered with add_dependency(). run()
+ * executes the graph on up to nt threads of the current parallel backend:
+ * each thread keeps a deque of ready tasks, takes from its back, and steals
+ * from the front of the deques of the other threads when its own is empty.
+ * When a task finishes, the successors that become ready are pushed to the
+ * deque of the thread that ran it, highest priority last, so that the
+ * critical path is followed depth-first while the data is still in cache.
+ * Threads that find no task block on a condition variable until a successor
+ * is enqueued or the last task completes.
+ *
+ * Inside a task, get_num_threads() returns 1.
+ */
+class task_graph {
+public:
+    using task_id = std::size_t;
+
+    /// Adds a task with the given priority (higher runs first)
+    task_id add_task( std::function<void()> f, int priority = 0 )
+    {
+        tasks_.emplace_back( new task( std::move(f), priority ) );
+        return tasks_.size() - 1;
+    }
+
+    /// Task `after` can only start when task `before` is finished
+    void add_dependency( task_id before, task_id after )
+    {
+        tasks_[before]->successors.push_back( after );
+        ++tasks_[after]->npreds;
+    }
+
+    /// Number of tasks in the graph
+    std::size_t size() const { return tasks_.size(); }
+
+    /** Executes all tasks using up to nt threads. The graph is consumed.
+     * The first exception thrown by a task is rethrown on the calling thread
+     * after the running tasks finish; the remaining tasks are skipped.
+     */
+    void run( int nt )
+    {
+        const std::size_t ntasks = tasks_.size();
+        if( ntasks == 0 ) return;
+        if( nt < 1 ) nt = 1;
+
+        std::vector< worker_queue > queues( nt );
+        std::atomic<std::size_t> remaining( ntasks );
+        std::atomic<bool> failed( false );
+        std::exception_ptr eptr = nullptr;
+
+        // Distribute the initially ready tasks
+        {
+            std::size_t w = 0;
+            for(task_id t = 0; t < ntasks; ++t)
+                if( tasks_[t]->npreds == 0 ) {
+                    queues[w].tasks.push_back( t );
+                    w = (w+1) % nt;
+                }
+        }
+
+        // Idle threads wait on `idle` until `events` changes. `events` is
+        // incremented under `idle_mtx` after tasks are enqueued and when the
+        // last task completes, so a thread that reads it before looking for
+        // a task cannot miss the wake-up.
+        std::mutex idle_mtx;
+        std::condition_variable idle;
+        std::atomic<std::size_t> events( 0 );
+        auto signal = [&]( bool all ) {
+            {
+                std::lock_guard<std::mutex> lock( idle_mtx );
+                ++events;
+            }
+            if( all ) idle.notify_all();
+            else      idle.notify_one();
+        };
+
+        std::atomic<int> next_worker( 0 );
+        parallel_for( std::size_t(nt), nt, [&]( std::size_t ) {
+            const int w = next_worker++;
+            std::vector< task_id > ready;
+
+            while( remaining > 0 ) {
+                const std::size_t seen = events;
+                task_id t;
+                if( !pop( queues, w, t ) ) {
+                    std::unique_lock<std::mutex> lock( idle_mtx );
+                    idle.wait( lock, [&]() {
+                        return events != seen || remaining == 0;
+                    } );
+                    continue;
+                }
+
+                task& tk = *tasks_[t];
+                if( !failed ) {
+                    try {
+                        tk.f();
+                    }
+                    catch(...) {
+                        if( !failed.exchange( true ) )
+                            eptr = std::current_exception();
+                    }
+                }
+
+                // Release the successors
+                ready.clear();
+                for( task_id s : tk.successors )
+                    if( --tasks_[s]->npreds == 0 )
+                        ready.push_back( s );
+                std::sort( ready.begin(), ready.end(),
+                    [&]( task_id a, task_id b ) {
+                        return tasks_[a]->priority < tasks_[b]->priority;
+                    } );
+                if( !ready.empty() ) {
+                    {
+                        std::lock_guard<std::mutex> lock( queues[w].mtx );
+                        for( task_id s : ready )
+                            queues[w].tasks.push_back( s );
+                    }
+                    // This thread takes one of them itself
+                    if( ready.size() > 1 )
+                        signal( ready.size() > 2 );
+                }
+
+                if( --remaining == 0 )
+                    signal( true );
+            }
+        });
+
+        tasks_.clear();
+        if( failed )
+            std::rethrow_exception( eptr );
+    }
+
+private:
+    struct task {
+        std::function<void()> f;
+        int priority;
+        std::atomic<int> npreds;
+        std::vector< task_id > successors;
+
+        task( std::function<void()>&& f_, int p )
+            : f( std::move(f_) ), priority( p ), npreds( 0 ) {}
+    };
+
+    struct worker_queue {
+        std::mutex mtx;
+        std::deque< task_id > tasks;
+    };
+
+    /// Takes a task from the back of queue w or steals one from another queue
+    static bool pop( std::vector< worker_queue >& queues, int w, task_id& t )
+    {
+        {
+            std::lock_guard<std::mutex> lock( queues[w].mtx );
+            if( !queues[w].tasks.empty() ) {
+                t = queues[w].tasks.back();
+                queues[w].tasks.pop_back();
+                return true;
+            }
+        }
+        const int nq = int( queues.size() );
+        for(int i = 1; i < nq; ++i) {
+            worker_queue& q = queues[ (w+i) % nq ];
+            std::lock_guard<std::mutex> lock( q.mtx );
+            if( !q.tasks.empty() ) {
+                t = q.tasks.front();
+                q.tasks.pop_front();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    std::vector< std::unique_ptr<task> > tasks_;
+};
+
+} // namespace internal
+} // namespace blas
+
+#endif        //  #ifndef BLAS_TASK_GRAPH_HH
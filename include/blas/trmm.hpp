@@ -9,9 +9,308 @@
 #define BLAS_TRMM_HH
 
 #include "blas/utils.hpp"
+#include "blas/dispatch.hpp"
+#include "blas/gemm.hpp"
+#include "blas/tuning.hpp"
 
 namespace blas {
 
+namespace internal {
+
+    // -------------------------------------------------------------------------
+    /** Unblocked triangular matrix-matrix multiply,
+     * B = alpha op(A) B or B = alpha B op(A).
+     *
+     * Level 2 BLAS loops, used for the diagonal blocks of trmm_blocked.
+     * The arguments are not checked.
+     */
+    template< class matrixA_t, class matrixB_t, class alpha_t >
+    void trmm_unblocked(
+        Side side, Uplo uplo, Op trans, Diag diag,
+        const alpha_t& alpha,
+        const matrixA_t& A,
+        matrixB_t& B )
+    {
+        // data traits
+        using TA    = type_t< matrixA_t >;
+        using TB    = type_t< matrixB_t >;
+        using idx_t = size_type< matrixB_t >;
+
+        // using
+        using scalar_t = scalar_type<alpha_t,TA,TB>;
+
+        // constants
+        const idx_t m = nrows(B);
+        const idx_t n = ncols(B);
+
+        if (side == Side::Left) {
+            if (trans == Op::NoTrans) {
+                if (uplo == Uplo::Upper) {
+                    for(idx_t j = 0; j < n; ++j) {
+                        for(idx_t k = 0; k < m; ++k) {
+                            const auto alphaBkj = alpha*B(k,j);
+                            for(idx_t i = 0; i < k; ++i)
+                                B(i,j) += A(i,k)*alphaBkj;
+                            B(k,j) = (diag == Diag::NonUnit)
+                                    ? A(k,k)*alphaBkj
+                                    : alphaBkj;
+                        }
+                    }
+                }
+                else { // uplo == Uplo::Lower
+                    for(idx_t j = 0; j < n; ++j) {
+                        for(idx_t k = m-1; k != idx_t(-1); --k) {
+                            const auto alphaBkj = alpha*B(k,j);
+                            B(k,j) = (diag == Diag::NonUnit)
+                                    ? A(k,k)*alphaBkj
+                                    : alphaBkj;
+                            for(idx_t i = k+1; i < m; ++i)
+                                B(i,j) += A(i,k)*alphaBkj;
+                        }
+                    }
+                }
+            }
+            else if (trans == Op::Trans) {
+                if (uplo == Uplo::Upper) {
+                    for(idx_t j = 0; j < n; ++j) {
+                        for(idx_t i = m-1; i != idx_t(-1); --i) {
+                            scalar_t sum = (diag == Diag::NonUnit)
+                                        ? A(i,i)*B(i,j)
+                                        : B(i,j);
+                            for(idx_t k = 0; k < i; ++k)
+                                sum += A(k,i)*B(k,j);
+                            B(i,j) = alpha * sum;
+                        }
+                    }
+                }
+                else { // uplo == Uplo::Lower
+                    for(idx_t j = 0; j < n; ++j) {
+                        for(idx_t i = 0; i < m; ++i) {
+                            scalar_t sum = (diag == Diag::NonUnit)
+                                        ? A(i,i)*B(i,j)
+                                        : B(i,j);
+                            for(idx_t k = i+1; k < m; ++k)
+                                sum += A(k,i)*B(k,j);
+                            B(i,j) = alpha * sum;
+                        }
+                    }
+                }
+            }
+            else { // trans == Op::ConjTrans
+                if (uplo == Uplo::Upper) {
+                    for(idx_t j = 0; j < n; ++j) {
+                        for(idx_t i = m-1; i != idx_t(-1); --i) {
+                            scalar_t sum = (diag == Diag::NonUnit)
+                                        ? conj(A(i,i))*B(i,j)
+                                        : B(i,j);
+                            for(idx_t k = 0; k < i; ++k)
+                                sum += conj(A(k,i))*B(k,j);
+                            B(i,j) = alpha * sum;
+                        }
+                    }
+                }
+                else { // uplo == Uplo::Lower
+                    for(idx_t j = 0; j < n; ++j) {
+                        for(idx_t i = 0; i < m; ++i) {
+                            scalar_t sum = (diag == Diag::NonUnit)
+                                        ? conj(A(i,i))*B(i,j)
+                                        : B(i,j);
+                            for(idx_t k = i+1; k < m; ++k)
+                                sum += conj(A(k,i))*B(k,j);
+                            B(i,j) = alpha * sum;
+                        }
+                    }
+                }
+            }
+        }
+        else { // side == Side::Right
+            if (trans == Op::NoTrans) {
+                if (uplo == Uplo::Upper) {
+                    for(idx_t j = n-1; j != idx_t(-1); --j) {
+
+                        scalar_t alphaAkj = (diag == Diag::NonUnit)
+                                        ? alpha*A(j,j)
+                                        : alpha;
+                        for(idx_t i = 0; i < m; ++i)
+                            B(i,j) *= alphaAkj;
+
+                        for(idx_t k = 0; k < j; ++k) {
+                            alphaAkj = alpha*A(k,j);
+                            for(idx_t i = 0; i < m; ++i)
+                                B(i,j) += B(i,k)*alphaAkj;
+                        }
+                    }
+                }
+                else { // uplo == Uplo::Lower
+                    for(idx_t j = 0; j < n; ++j) {
+
+                        scalar_t alphaAkj = (diag == Diag::NonUnit)
+                                        ? alpha*A(j,j)
+                                        : alpha;
+                        for(idx_t i = 0; i < m; ++i)
+                            B(i,j) *= alphaAkj;
+
+                        for(idx_t k = j+1; k < n; ++k) {
+                            alphaAkj = alpha*A(k,j);
+                            for(idx_t i = 0; i < m; ++i)
+                                B(i,j) += B(i,k)*alphaAkj;
+                        }
+                    }
+                }
+            }
+            else if (trans == Op::Trans) {
+                if (uplo == Uplo::Upper) {
+                    for(idx_t k = 0; k < n; ++k) {
+                        for(idx_t j = 0; j < k; ++j) {
+                            const auto alphaAjk = alpha*A(j,k);
+                            for(idx_t i = 0; i < m; ++i)
+                                B(i,j) += B(i,k)*alphaAjk;
+                        }
+
+                        const scalar_t alphaAkk = (diag == Diag::NonUnit)
+                                                ? alpha*A(k,k)
+                                                : alpha;
+                        for(idx_t i = 0; i < m; ++i)
+                            B(i,k) *= alphaAkk;
+                    }
+                }
+                else { // uplo == Uplo::Lower
+                    for(idx_t k = n-1; k != idx_t(-1); --k) {
+                        for(idx_t j = k+1; j < n; ++j) {
+                            const auto alphaAjk = alpha*A(j,k);
+                            for(idx_t i = 0; i < m; ++i)
+                                B(i,j) += B(i,k)*alphaAjk;
+                        }
+
+                        const scalar_t alphaAkk = (diag == Diag::NonUnit)
+                                                ? alpha*A(k,k)
+                                                : alpha;
+                        for(idx_t i = 0; i < m; ++i)
+                            B(i,k) *= alphaAkk;
+                    }
+                }
+            }
+            else { // trans == Op::ConjTrans
+                if (uplo == Uplo::Upper) {
+                    for(idx_t k = 0; k < n; ++k) {
+                        for(idx_t j = 0; j < k; ++j) {
+                            const auto alphaAjk = alpha*conj(A(j,k));
+                            for(idx_t i = 0; i < m; ++i)
+                                B(i,j) += B(i,k)*alphaAjk;
+                        }
+
+                        const scalar_t alphaAkk = (diag == Diag::NonUnit)
+                                                ? alpha*conj(A(k,k))
+                                                : alpha;
+                        for(idx_t i = 0; i < m; ++i)
+                            B(i,k) *= alphaAkk;
+                    }
+                }
+                else { // uplo == Uplo::Lower
+                    for(idx_t k = n-1; k != idx_t(-1); --k) {
+                        for(idx_t j = k+1; j < n; ++j) {
+                            const auto alphaAjk = alpha*conj(A(j,k));
+                            for(idx_t i = 0; i < m; ++i)
+                                B(i,j) += B(i,k)*alphaAjk;
+                        }
+
+                        const scalar_t alphaAkk = (diag == Diag::NonUnit)
+                                                ? alpha*conj(A(k,k))
+                                                : alpha;
+                        for(idx_t i = 0; i < m; ++i)
+                            B(i,k) *= alphaAkk;
+                    }
+                }
+            }
+        }
+    }
+
+    // -------------------------------------------------------------------------
+    /** Blocked triangular matrix-matrix multiply,
+     * B = alpha op(A) B or B = alpha B op(A).
+     *
+     * op(A) is split in blocks of nb = get_blocksize<T>( "level3", ... ) rows
+     * and columns.
+     * Each block of B is multiplied by the diagonal block of op(A) with
+     * trmm_unblocked, and then receives the contribution of the blocks of B
+     * that were not overwritten yet through gemm.
+     *
+     * The arguments are not checked.
+     */
+    template< class matrixA_t, class matrixB_t, class alpha_t >
+    void trmm_blocked(
+        Side side, Uplo uplo, Op trans, Diag diag,
+        const alpha_t& alpha,
+        const matrixA_t& A,
+        matrixB_t& B )
+    {
+        // data traits
+        using TA    = type_t< matrixA_t >;
+        using TB    = type_t< matrixB_t >;
+        using idx_t = size_type< matrixB_t >;
+        using pair  = std::pair<idx_t,idx_t>;
+
+        // using
+        using scalar_t = scalar_type<TA,TB>;
+
+        // constants
+        const idx_t m = nrows(B);
+        const idx_t n = ncols(B);
+        const idx_t nA = nrows(A);
+        const idx_t nb = get_blocksize< scalar_t >( "level3", m, n, nA );
+        const alpha_t one( 1 );
+
+        if( nA <= nb || m == 0 || n == 0 ) {
+            trmm_unblocked( side, uplo, trans, diag, alpha, A, B );
+            return;
+        }
+
+        // op(A) is lower triangular
+        const bool lower = ( (uplo == Uplo::Lower) == (trans == Op::NoTrans) );
+        // The blocks of B are overwritten from the first to the last one
+        const bool forward = (side == Side::Left) ? !lower : lower;
+
+        // op(A)(r0:r1,c0:c1) as a submatrix of A to be used with trans
+        auto opA = [&]( idx_t r0, idx_t r1, idx_t c0, idx_t c1 ) {
+            return (trans == Op::NoTrans)
+                ? submatrix( A, pair{r0,r1}, pair{c0,c1} )
+                : submatrix( A, pair{c0,c1}, pair{r0,r1} );
+        };
+
+        for(idx_t s = 0; s < nA; s += nb) {
+            // current block k0:k1 and the blocks that are still to be used
+            const idx_t k0 = forward ? s : ((nA-s > nb) ? nA-s-nb : 0);
+            const idx_t k1 = forward ? ((s+nb < nA) ? s+nb : nA) : nA-s;
+            const idx_t r0 = forward ? k1 : 0;
+            const idx_t r1 = forward ? nA : k0;
+
+            const auto Akk = submatrix( A, pair{k0,k1}, pair{k0,k1} );
+
+            if( side == Side::Left ) {
+                auto Bk = submatrix( B, pair{k0,k1}, pair{0,n} );
+                trmm_unblocked( side, uplo, trans, diag, alpha, Akk, Bk );
+                if( r0 < r1 ) {
+                    // B_k += alpha op(A)_kr B_r
+                    const auto Br = submatrix( B, pair{r0,r1}, pair{0,n} );
+                    gemm( trans, Op::NoTrans,
+                          alpha, opA( k0, k1, r0, r1 ), Br, one, Bk );
+                }
+            }
+            else {
+                auto Bk = submatrix( B, pair{0,m}, pair{k0,k1} );
+                trmm_unblocked( side, uplo, trans, diag, alpha, Akk, Bk );
+                if( r0 < r1 ) {
+                    // B_k += alpha B_r op(A)_rk
+                    const auto Br = submatrix( B, pair{0,m}, pair{r0,r1} );
+                    gemm( Op::NoTrans, trans,
+                          alpha, Br, opA( r0, r1, k0, k1 ), one, Bk );
+                }
+            }
+        }
+    }
+
+} // namespace internal
+
 /**
  * Triangular matrix-matrix multiply:
  * \[
@@ -29,6 +328,8 @@ namespace blas {
  * upper or lower triangular matrix.
  *
  * Generic implementation for arbitrary data types.
+ * Triangular matrices larger than get_blocksize<T>( "level3", ... ) are split
+ * in blocks, and the off-diagonal blocks are applied with gemm.
  *
  * @param[in] layout
  *     Matrix storage, Layout::ColMajor or Layout::RowMajor.
@@ -94,18 +395,6 @@ void trmm(
     const matrixA_t& A,
     matrixB_t& B )
 {    
-    // data traits
-    using TA    = type_t< matrixA_t >;
-    using TB    = type_t< matrixB_t >;
-    using idx_t = size_type< matrixA_t >;
-
-    // using
-    using scalar_t = scalar_type<alpha_t,TA,TB>;
-
-    // constants
-    const idx_t m = nrows(B);
-    const idx_t n = ncols(B);
-
     // check arguments
     blas_error_if( side != Side::Left &&
                    side != Side::Right );
@@ -117,188 +406,15 @@ void trmm(
     blas_error_if( diag != Diag::NonUnit &&
                    diag != Diag::Unit );
     blas_error_if( nrows(A) != ncols(A) );
-    blas_error_if( nrows(A) != ((side == Side::Left) ? m : n) );
-    
-    if (side == Side::Left) {
-        if (trans == Op::NoTrans) {
-            if (uplo == Uplo::Upper) {
-                for(idx_t j = 0; j < n; ++j) {
-                    for(idx_t k = 0; k < m; ++k) {
-                        const auto alphaBkj = alpha*B(k,j);
-                        for(idx_t i = 0; i < k; ++i)
-                            B(i,j) += A(i,k)*alphaBkj;
-                        B(k,j) = (diag == Diag::NonUnit)
-                                ? A(k,k)*alphaBkj
-                                : alphaBkj;
-                    }
-                }
-            }
-            else { // uplo == Uplo::Lower
-                for(idx_t j = 0; j < n; ++j) {
-                    for(idx_t k = m-1; k != idx_t(-1); --k) {
-                        const auto alphaBkj = alpha*B(k,j);
-                        B(k,j) = (diag == Diag::NonUnit)
-                                ? A(k,k)*alphaBkj
-                                : alphaBkj;
-                        for(idx_t i = k+1; i < m; ++i)
-                            B(i,j) += A(i,k)*alphaBkj;
-                    }
-                }
-            }
-        }
-        else if (trans == Op::Trans) {
-            if (uplo == Uplo::Upper) {
-                for(idx_t j = 0; j < n; ++j) {
-                    for(idx_t i = m-1; i != idx_t(-1); --i) {
-                        scalar_t sum = (diag == Diag::NonUnit)
-                                    ? A(i,i)*B(i,j)
-                                    : B(i,j);
-                        for(idx_t k = 0; k < i; ++k)
-                            sum += A(k,i)*B(k,j);
-                        B(i,j) = alpha * sum;
-                    }
-                }
-            }
-            else { // uplo == Uplo::Lower
-                for(idx_t j = 0; j < n; ++j) {
-                    for(idx_t i = 0; i < m; ++i) {
-                        scalar_t sum = (diag == Diag::NonUnit)
-                                    ? A(i,i)*B(i,j)
-                                    : B(i,j);
-                        for(idx_t k = i+1; k < m; ++k)
-                            sum += A(k,i)*B(k,j);
-                        B(i,j) = alpha * sum;
-                    }
-                }
-            }
-        }
-        else { // trans == Op::ConjTrans
-            if (uplo == Uplo::Upper) {
-                for(idx_t j = 0; j < n; ++j) {
-                    for(idx_t i = m-1; i != idx_t(-1); --i) {
-                        scalar_t sum = (diag == Diag::NonUnit)
-                                    ? conj(A(i,i))*B(i,j)
-                                    : B(i,j);
-                        for(idx_t k = 0; k < i; ++k)
-                            sum += conj(A(k,i))*B(k,j);
-                        B(i,j) = alpha * sum;
-                    }
-                }
-            }
-            else { // uplo == Uplo::Lower
-                for(idx_t j = 0; j < n; ++j) {
-                    for(idx_t i = 0; i < m; ++i) {
-                        scalar_t sum = (diag == Diag::NonUnit)
-                                    ? conj(A(i,i))*B(i,j)
-                                    : B(i,j);
-                        for(idx_t k = i+1; k < m; ++k)
-                            sum += conj(A(k,i))*B(k,j);
-                        B(i,j) = alpha * sum;
-                    }
-                }
-            }
-        }
-    }
-    else { // side == Side::Right
-        if (trans == Op::NoTrans) {
-            if (uplo == Uplo::Upper) {
-                for(idx_t j = n-1; j != idx_t(-1); --j) {
-
-                    scalar_t alphaAkj = (diag == Diag::NonUnit)
-                                    ? alpha*A(j,j)
-                                    : alpha;
-                    for(idx_t i = 0; i < m; ++i)
-                        B(i,j) *= alphaAkj;
-
-                    for(idx_t k = 0; k < j; ++k) {
-                        alphaAkj = alpha*A(k,j);
-                        for(idx_t i = 0; i < m; ++i)
-                            B(i,j) += B(i,k)*alphaAkj;
-                    }
-                }
-            }
-            else { // uplo == Uplo::Lower
-                for(idx_t j = 0; j < n; ++j) {
-
-                    scalar_t alphaAkj = (diag == Diag::NonUnit)
-                                    ? alpha*A(j,j)
-                                    : alpha;
-                    for(idx_t i = 0; i < m; ++i)
-                        B(i,j) *= alphaAkj;
-
-                    for(idx_t k = j+1; k < n; ++k) {
-                        alphaAkj = alpha*A(k,j);
-                        for(idx_t i = 0; i < m; ++i)
-                            B(i,j) += B(i,k)*alphaAkj;
-                    }
-                }
-            }
-        }
-        else if (trans == Op::Trans) {
-            if (uplo == Uplo::Upper) {
-                for(idx_t k = 0; k < n; ++k) {
-                    for(idx_t j = 0; j < k; ++j) {
-                        const auto alphaAjk = alpha*A(j,k);
-                        for(idx_t i = 0; i < m; ++i)
-                            B(i,j) += B(i,k)*alphaAjk;
-                    }
-
-                    const scalar_t alphaAkk = (diag == Diag::NonUnit)
-                                            ? alpha*A(k,k)
-                                            : alpha;
-                    for(idx_t i = 0; i < m; ++i)
-                        B(i,k) *= alphaAkk;
-                }
-            }
-            else { // uplo == Uplo::Lower
-                for(idx_t k = n-1; k != idx_t(-1); --k) {
-                    for(idx_t j = k+1; j < n; ++j) {
-                        const auto alphaAjk = alpha*A(j,k);
-                        for(idx_t i = 0; i < m; ++i)
-                            B(i,j) += B(i,k)*alphaAjk;
-                    }
-
-                    const scalar_t alphaAkk = (diag == Diag::NonUnit)
-                                            ? alpha*A(k,k)
-                                            : alpha;
-                    for(idx_t i = 0; i < m; ++i)
-                        B(i,k) *= alphaAkk;
-                }
-            }
-        }
-        else { // trans == Op::ConjTrans
-            if (uplo == Uplo::Upper) {
-                for(idx_t k = 0; k < n; ++k) {
-                    for(idx_t j = 0; j < k; ++j) {
-                        const auto alphaAjk = alpha*conj(A(j,k));
-                        for(idx_t i = 0; i < m; ++i)
-                            B(i,j) += B(i,k)*alphaAjk;
-                    }
+    blas_error_if( nrows(A) != ((side == Side::Left) ? nrows(B) : ncols(B)) );
 
-                    const scalar_t alphaAkk = (diag == Diag::NonUnit)
-                                            ? alpha*conj(A(k,k))
-                                            : alpha;
-                    for(idx_t i = 0; i < m; ++i)
-                        B(i,k) *= alphaAkk;
-                }
-            }
-            else { // uplo == Uplo::Lower
-                for(idx_t k = n-1; k != idx_t(-1); --k) {
-                    for(idx_t j = k+1; j < n; ++j) {
-                        const auto alphaAjk = alpha*conj(A(j,k));
-                        for(idx_t i = 0; i < m; ++i)
-                            B(i,j) += B(i,k)*alphaAjk;
-                    }
+    // call BLAS++ on large problems
+    #ifdef USE_BLASPP_WRAPPERS
+        if( internal::dispatch_trmm( side, uplo, trans, diag, alpha, A, B ) )
+            return;
+    #endif
 
-                    const scalar_t alphaAkk = (diag == Diag::NonUnit)
-                                            ? alpha*conj(A(k,k))
-                                            : alpha;
-                    for(idx_t i = 0; i < m; ++i)
-                        B(i,k) *= alphaAkk;
-                }
-            }
-        }
-    }
+    internal::trmm_blocked( side, uplo, trans, diag, alpha, A, B );
 }
 
 }  // namespace blas
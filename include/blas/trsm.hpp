@@ -9,9 +9,298 @@
 #define BLAS_TRSM_HH
 
 #include "blas/utils.hpp"
+#include "blas/dispatch.hpp"
+#include "blas/gemm.hpp"
+#include "blas/tuning.hpp"
+#include "blas/parallel.hpp"
 
 namespace blas {
 
+namespace internal {
+
+    // -------------------------------------------------------------------------
+    /** Unblocked triangular solve, op(A) X = alpha B or X op(A) = alpha B.
+     *
+     * Level 2 BLAS loops, used for the diagonal blocks of trsm_blocked.
+     * The arguments are not checked.
+     */
+    template< class matrixA_t, class matrixB_t, class alpha_t >
+    void trsm_unblocked(
+        Side side, Uplo uplo, Op trans, Diag diag,
+        const alpha_t& alpha,
+        const matrixA_t& A,
+        matrixB_t& B )
+    {
+        // data traits
+        using idx_t = size_type< matrixB_t >;
+
+        // constants
+        const idx_t m = nrows(B);
+        const idx_t n = ncols(B);
+
+        if (side == Side::Left) {
+            if (trans == Op::NoTrans) {
+                if (uplo == Uplo::Upper) {
+                    for(idx_t j = 0; j < n; ++j) {
+                        for(idx_t i = 0; i < m; ++i)
+                            B(i,j) *= alpha;
+                        for(idx_t k = m-1; k != idx_t(-1); --k) {
+                            if (diag == Diag::NonUnit)
+                                B(k,j) /= A(k,k);
+                            for(idx_t i = 0; i < k; ++i)
+                                B(i,j) -= A(i,k)*B(k,j);
+                        }
+                    }
+                }
+                else { // uplo == Uplo::Lower
+                    for(idx_t j = 0; j < n; ++j) {
+                        for(idx_t i = 0; i < m; ++i)
+                            B(i,j) *= alpha;
+                        for(idx_t k = 0; k < m; ++k) {
+                            if (diag == Diag::NonUnit)
+                                B(k,j) /= A(k,k);
+                            for(idx_t i = k+1; i < m; ++i)
+                                B(i,j) -= A(i,k)*B(k,j);
+                        }
+                    }
+                }
+            }
+            else if (trans == Op::Trans) {
+                if (uplo == Uplo::Upper) {
+                    for(idx_t j = 0; j < n; ++j) {
+                        for(idx_t i = 0; i < m; ++i) {
+                            auto sum = alpha*B(i,j);
+                            for(idx_t k = 0; k < i; ++k)
+                                sum -= A(k,i)*B(k,j);
+                            B(i,j) = (diag == Diag::NonUnit)
+                                ? sum / A(i,i)
+                                : sum;
+                        }
+                    }
+                }
+                else { // uplo == Uplo::Lower
+                    for(idx_t j = 0; j < n; ++j) {
+                        for(idx_t i = m-1; i != idx_t(-1); --i) {
+                            auto sum = alpha*B(i,j);
+                            for(idx_t k = i+1; k < m; ++k)
+                                sum -= A(k,i)*B(k,j);
+                            B(i,j) = (diag == Diag::NonUnit)
+                                ? sum / A(i,i)
+                                : sum;
+                        }
+                    }
+                }
+            }
+            else { // trans == Op::ConjTrans
+                if (uplo == Uplo::Upper) {
+                    for(idx_t j = 0; j < n; ++j) {
+                        for(idx_t i = 0; i < m; ++i) {
+                            auto sum = alpha*B(i,j);
+                            for(idx_t k = 0; k < i; ++k)
+                                sum -= conj(A(k,i))*B(k,j);
+                            B(i,j) = (diag == Diag::NonUnit)
+                                ? sum / conj(A(i,i))
+                                : sum;
+                        }
+                    }
+                }
+                else { // uplo == Uplo::Lower
+                    for(idx_t j = 0; j < n; ++j) {
+                        for(idx_t i = m-1; i != idx_t(-1); --i) {
+                            auto sum = alpha*B(i,j);
+                            for(idx_t k = i+1; k < m; ++k)
+                                sum -= conj(A(k,i))*B(k,j);
+                            B(i,j) = (diag == Diag::NonUnit)
+                                ? sum / conj(A(i,i))
+                                : sum;
+                        }
+                    }
+                }
+            }
+        }
+        else { // side == Side::Right
+            if (trans == Op::NoTrans) {
+                if (uplo == Uplo::Upper) {
+                    for(idx_t j = 0; j < n; ++j) {
+                        for(idx_t i = 0; i < m; ++i)
+                            B(i,j) *= alpha;
+                        for(idx_t k = 0; k < j; ++k) {
+                            for(idx_t i = 0; i < m; ++i)
+                                B(i,j) -= B(i,k)*A(k,j);
+                        }
+                        if (diag == Diag::NonUnit) {
+                            for(idx_t i = 0; i < m; ++i)
+                                B(i,j) /= A(j,j);
+                        }
+                    }
+                }
+                else { // uplo == Uplo::Lower
+                    for(idx_t j = n-1; j != idx_t(-1); --j) {
+                        for(idx_t i = 0; i < m; ++i)
+                            B(i,j) *= alpha;
+                        for(idx_t k = j+1; k < n; ++k) {
+                            for(idx_t i = 0; i < m; ++i)
+                                B(i,j) -= B(i,k)*A(k,j);
+                        }
+                        if (diag == Diag::NonUnit) {
+                            for(idx_t i = 0; i < m; ++i)
+                                B(i,j) /= A(j,j);
+                        }
+                    }
+                }
+            }
+            else if (trans == Op::Trans) {
+                if (uplo == Uplo::Upper) {
+                    for(idx_t k = n-1; k != idx_t(-1); --k) {
+                        if (diag == Diag::NonUnit) {
+                            for(idx_t i = 0; i < m; ++i)
+                                B(i,k) /= A(k,k);
+                        }
+                        for(idx_t j = 0; j < k; ++j) {
+                            for(idx_t i = 0; i < m; ++i)
+                                B(i,j) -= B(i,k)*A(j,k);
+                        }
+                        for(idx_t i = 0; i < m; ++i)
+                            B(i,k) *= alpha;
+                    }
+                }
+                else { // uplo == Uplo::Lower
+                    for(idx_t k = 0; k < n; ++k) {
+                        if (diag == Diag::NonUnit) {
+                            for(idx_t i = 0; i < m; ++i)
+                                B(i,k) /= A(k,k);
+                        }
+                        for(idx_t j = k+1; j < n; ++j) {
+                            for(idx_t i = 0; i < m; ++i)
+                                B(i,j) -= B(i,k)*A(j,k);
+                        }
+                        for(idx_t i = 0; i < m; ++i)
+                            B(i,k) *= alpha;
+                    }
+                }
+            }
+            else { // trans == Op::ConjTrans
+                if (uplo == Uplo::Upper) {
+                    for(idx_t k = n-1; k != idx_t(-1); --k) {
+                        if (diag == Diag::NonUnit) {
+                            for(idx_t i = 0; i < m; ++i)
+                                B(i,k) /= conj(A(k,k));
+                        }
+                        for(idx_t j = 0; j < k; ++j) {
+                            for(idx_t i = 0; i < m; ++i)
+                                B(i,j) -= B(i,k)*conj(A(j,k));
+                        }
+                        for(idx_t i = 0; i < m; ++i)
+                            B(i,k) *= alpha;
+                    }
+                }
+                else { // uplo == Uplo::Lower
+                    for(idx_t k = 0; k < n; ++k) {
+                        if (diag == Diag::NonUnit) {
+                            for(idx_t i = 0; i < m; ++i)
+                                B(i,k) /= conj(A(k,k));
+                        }
+                        for(idx_t j = k+1; j < n; ++j) {
+                            for(idx_t i = 0; i < m; ++i)
+                                B(i,j) -= B(i,k)*conj(A(j,k));
+                        }
+                        for(idx_t i = 0; i < m; ++i)
+                            B(i,k) *= alpha;
+                    }
+                }
+            }
+        }
+    }
+
+    // -------------------------------------------------------------------------
+    /** Blocked triangular solve, op(A) X = alpha B or X op(A) = alpha B.
+     *
+     * op(A) is split in blocks of nb = get_blocksize<T>( "level3", ... ) rows
+     * and columns.
+     * The diagonal blocks are solved by trsm_unblocked and the off-diagonal
+     * blocks update the remaining part of B with gemm, so that almost all
+     * flops go through the gemm engine.
+     *
+     * The algorithm is blocked rather than recursive, so that it only works
+     * with submatrices of A and B, and not with submatrices of submatrices.
+     * The arguments are not checked.
+     */
+    template< class matrixA_t, class matrixB_t, class alpha_t >
+    void trsm_blocked(
+        Side side, Uplo uplo, Op trans, Diag diag,
+        const alpha_t& alpha,
+        const matrixA_t& A,
+        matrixB_t& B )
+    {
+        // data traits
+        using TA    = type_t< matrixA_t >;
+        using TB    = type_t< matrixB_t >;
+        using idx_t = size_type< matrixB_t >;
+        using pair  = std::pair<idx_t,idx_t>;
+
+        // using
+        using scalar_t = scalar_type<TA,TB>;
+
+        // constants
+        const idx_t m = nrows(B);
+        const idx_t n = ncols(B);
+        const idx_t nA = nrows(A);
+        const idx_t nb = get_blocksize< scalar_t >( "level3", m, n, nA );
+        const alpha_t one( 1 );
+
+        if( nA <= nb || m == 0 || n == 0 ) {
+            trsm_unblocked( side, uplo, trans, diag, alpha, A, B );
+            return;
+        }
+
+        // op(A) is lower triangular
+        const bool lower = ( (uplo == Uplo::Lower) == (trans == Op::NoTrans) );
+        // The blocks of X are computed from the first to the last one
+        const bool forward = (side == Side::Left) ? lower : !lower;
+
+        // op(A)(r0:r1,c0:c1) as a submatrix of A to be used with trans
+        auto opA = [&]( idx_t r0, idx_t r1, idx_t c0, idx_t c1 ) {
+            return (trans == Op::NoTrans)
+                ? submatrix( A, pair{r0,r1}, pair{c0,c1} )
+                : submatrix( A, pair{c0,c1}, pair{r0,r1} );
+        };
+
+        alpha_t alpha_k = alpha;
+        for(idx_t s = 0; s < nA; s += nb) {
+            // current block k0:k1 and the blocks that are still to be solved
+            const idx_t k0 = forward ? s : ((nA-s > nb) ? nA-s-nb : 0);
+            const idx_t k1 = forward ? ((s+nb < nA) ? s+nb : nA) : nA-s;
+            const idx_t r0 = forward ? k1 : 0;
+            const idx_t r1 = forward ? nA : k0;
+
+            const auto Akk = submatrix( A, pair{k0,k1}, pair{k0,k1} );
+
+            if( side == Side::Left ) {
+                auto Bk = submatrix( B, pair{k0,k1}, pair{0,n} );
+                trsm_unblocked( side, uplo, trans, diag, alpha_k, Akk, Bk );
+                if( r0 < r1 ) {
+                    // B_r := alpha_k B_r - op(A)_rk X_k
+                    auto Br = submatrix( B, pair{r0,r1}, pair{0,n} );
+                    gemm( trans, Op::NoTrans,
+                          -one, opA( r0, r1, k0, k1 ), Bk, alpha_k, Br );
+                }
+            }
+            else {
+                auto Bk = submatrix( B, pair{0,m}, pair{k0,k1} );
+                trsm_unblocked( side, uplo, trans, diag, alpha_k, Akk, Bk );
+                if( r0 < r1 ) {
+                    // B_r := alpha_k B_r - X_k op(A)_kr
+                    auto Br = submatrix( B, pair{0,m}, pair{r0,r1} );
+                    gemm( Op::NoTrans, trans,
+                          -one, Bk, opA( k0, k1, r0, r1 ), alpha_k, Br );
+                }
+            }
+            alpha_k = one;
+        }
+    }
+
+} // namespace internal
+
 /**
  * Solve the triangular matrix-vector equation
  * \[
@@ -33,6 +322,8 @@ namespace blas {
  * @see latrs for a more numerically robust implementation.
  *
  * Generic implementation for arbitrary data types.
+ * Triangular matrices larger than get_blocksize<T>( "level3", ... ) are split
+ * in blocks, and the off-diagonal blocks are applied with gemm.
  *
  * @param[in] layout
  *     Matrix storage, Layout::ColMajor or Layout::RowMajor.
@@ -119,178 +410,58 @@ void trsm(
     blas_error_if( nrows(A) != ncols(A) );
     blas_error_if( nrows(A) != ((side == Side::Left) ? m : n) );
 
-    if (side == Side::Left) {
-        if (trans == Op::NoTrans) {
-            if (uplo == Uplo::Upper) {
-                for(idx_t j = 0; j < n; ++j) {
-                    for(idx_t i = 0; i < m; ++i)
-                        B(i,j) *= alpha;
-                    for(idx_t k = m-1; k != idx_t(-1); --k) {
-                        if (diag == Diag::NonUnit)
-                            B(k,j) /= A(k,k);
-                        for(idx_t i = 0; i < k; ++i)
-                            B(i,j) -= A(i,k)*B(k,j);
-                    }
-                }
-            }
-            else { // uplo == Uplo::Lower
-                for(idx_t j = 0; j < n; ++j) {
-                    for(idx_t i = 0; i < m; ++i)
-                        B(i,j) *= alpha;
-                    for(idx_t k = 0; k < m; ++k) {
-                        if (diag == Diag::NonUnit)
-                            B(k,j) /= A(k,k);
-                        for(idx_t i = k+1; i < m; ++i)
-                            B(i,j) -= A(i,k)*B(k,j);
-                    }
-                }
-            }
-        }
-        else if (trans == Op::Trans) {
-            if (uplo == Uplo::Upper) {
-                for(idx_t j = 0; j < n; ++j) {
-                    for(idx_t i = 0; i < m; ++i) {
-                        auto sum = alpha*B(i,j);
-                        for(idx_t k = 0; k < i; ++k)
-                            sum -= A(k,i)*B(k,j);
-                        B(i,j) = (diag == Diag::NonUnit)
-                            ? sum / A(i,i)
-                            : sum;
-                    }
-                }
-            }
-            else { // uplo == Uplo::Lower
-                for(idx_t j = 0; j < n; ++j) {
-                    for(idx_t i = m-1; i != idx_t(-1); --i) {
-                        auto sum = alpha*B(i,j);
-                        for(idx_t k = i+1; k < m; ++k)
-                            sum -= A(k,i)*B(k,j);
-                        B(i,j) = (diag == Diag::NonUnit)
-                            ? sum / A(i,i)
-                            : sum;
-                    }
-                }
-            }
-        }
-        else { // trans == Op::ConjTrans
-            if (uplo == Uplo::Upper) {
-                for(idx_t j = 0; j < n; ++j) {
-                    for(idx_t i = 0; i < m; ++i) {
-                        auto sum = alpha*B(i,j);
-                        for(idx_t k = 0; k < i; ++k)
-                            sum -= conj(A(k,i))*B(k,j);
-                        B(i,j) = (diag == Diag::NonUnit)
-                            ? sum / conj(A(i,i))
-                            : sum;
-                    }
-                }
-            }
-            else { // uplo == Uplo::Lower
-                for(idx_t j = 0; j < n; ++j) {
-                    for(idx_t i = m-1; i != idx_t(-1); --i) {
-                        auto sum = alpha*B(i,j);
-                        for(idx_t k = i+1; k < m; ++k)
-                            sum -= conj(A(k,i))*B(k,j);
-                        B(i,j) = (diag == Diag::NonUnit)
-                            ? sum / conj(A(i,i))
-                            : sum;
-                    }
-                }
-            }
-        }
-    }
-    else { // side == Side::Right
-        if (trans == Op::NoTrans) {
-            if (uplo == Uplo::Upper) {
-                for(idx_t j = 0; j < n; ++j) {
-                    for(idx_t i = 0; i < m; ++i)
-                        B(i,j) *= alpha;
-                    for(idx_t k = 0; k < j; ++k) {
-                        for(idx_t i = 0; i < m; ++i)
-                            B(i,j) -= B(i,k)*A(k,j);
-                    }
-                    if (diag == Diag::NonUnit) {
-                        for(idx_t i = 0; i < m; ++i)
-                            B(i,j) /= A(j,j);
-                    }
-                }
-            }
-            else { // uplo == Uplo::Lower
-                for(idx_t j = n-1; j != idx_t(-1); --j) {
-                    for(idx_t i = 0; i < m; ++i)
-                        B(i,j) *= alpha;
-                    for(idx_t k = j+1; k < n; ++k) {
-                        for(idx_t i = 0; i < m; ++i)
-                            B(i,j) -= B(i,k)*A(k,j);
-                    }
-                    if (diag == Diag::NonUnit) {
-                        for(idx_t i = 0; i < m; ++i)
-                            B(i,j) /= A(j,j);
-                    }
-                }
-            }
-        }
-        else if (trans == Op::Trans) {
-            if (uplo == Uplo::Upper) {
-                for(idx_t k = n-1; k != idx_t(-1); --k) {
-                    if (diag == Diag::NonUnit) {
-                        for(idx_t i = 0; i < m; ++i)
-                            B(i,k) /= A(k,k);
-                    }
-                    for(idx_t j = 0; j < k; ++j) {
-                        for(idx_t i = 0; i < m; ++i)
-                            B(i,j) -= B(i,k)*A(j,k);
-                    }
-                    for(idx_t i = 0; i < m; ++i)
-                        B(i,k) *= alpha;
-                }
-            }
-            else { // uplo == Uplo::Lower
-                for(idx_t k = 0; k < n; ++k) {
-                    if (diag == Diag::NonUnit) {
-                        for(idx_t i = 0; i < m; ++i)
-                            B(i,k) /= A(k,k);
-                    }
-                    for(idx_t j = k+1; j < n; ++j) {
-                        for(idx_t i = 0; i < m; ++i)
-                            B(i,j) -= B(i,k)*A(j,k);
-                    }
-                    for(idx_t i = 0; i < m; ++i)
-                        B(i,k) *= alpha;
-                }
-            }
-        }
-        else { // trans == Op::ConjTrans
-            if (uplo == Uplo::Upper) {
-                for(idx_t k = n-1; k != idx_t(-1); --k) {
-                    if (diag == Diag::NonUnit) {
-                        for(idx_t i = 0; i < m; ++i)
-                            B(i,k) /= conj(A(k,k));
-                    }
-                    for(idx_t j = 0; j < k; ++j) {
-                        for(idx_t i = 0; i < m; ++i)
-                            B(i,j) -= B(i,k)*conj(A(j,k));
-                    }
-                    for(idx_t i = 0; i < m; ++i)
-                        B(i,k) *= alpha;
-                }
-            }
-            else { // uplo == Uplo::Lower
-                for(idx_t k = 0; k < n; ++k) {
-                    if (diag == Diag::NonUnit) {
-                        for(idx_t i = 0; i < m; ++i)
-                            B(i,k) /= conj(A(k,k));
-                    }
-                    for(idx_t j = k+1; j < n; ++j) {
-                        for(idx_t i = 0; i < m; ++i)
-                            B(i,j) -= B(i,k)*conj(A(j,k));
-                    }
-                    for(idx_t i = 0; i < m; ++i)
-                        B(i,k) *= alpha;
-                }
-            }
+    // call BLAS++ on large problems
+    #ifdef USE_BLASPP_WRAPPERS
+        if( internal::dispatch_trsm( side, uplo, trans, diag, alpha, A, B ) )
+            return;
+    #endif
+
+    // Parallel code: the columns of B (rows of B if side == Side::Right) are
+    // independent, so B is split in slabs that are solved concurrently
+    {
+        using pair = std::pair<idx_t,idx_t>;
+        const idx_t nA = nrows(A);
+        const int nt = internal::num_threads_for( double(m) * n * nA );
+        if( nt > 1 ) {
+            const idx_t nB = (side == Side::Left) ? n : m;
+            const idx_t ns = (idx_t(4*nt) < nB) ? idx_t(4*nt) : nB;
+            const idx_t sb = (nB + ns-1) / ns;
+            internal::parallel_for( (nB + sb-1) / sb, nt, [&]( std::size_t s ) {
+                const idx_t j0 = s*sb;
+                const idx_t j1 = (j0+sb < nB) ? j0+sb : nB;
+                auto Bs = (side == Side::Left)
+                    ? submatrix( B, pair{0,m}, pair{j0,j1} )
+                    : submatrix( B, pair{j0,j1}, pair{0,n} );
+                internal::trsm_blocked( side, uplo, trans, diag, alpha, A, Bs );
+            } );
+            return;
         }
     }
+
+    internal::trsm_blocked( side, uplo, trans, diag, alpha, A, B );
+}
+
+/**
+ * Triangular solve with a given number of threads.
+ * @see trsm( blas::Side, blas::Uplo, blas::Op, blas::Diag, const alpha_t, const matrixA_t&, matrixB_t& )
+ *
+ * @param[in] policy Execution policy with the number of threads.
+ *
+ * @ingroup trsm
+ */
+template< class matrixA_t, class matrixB_t, class alpha_t >
+inline void trsm(
+    const parallel_policy& policy,
+    blas::Side side,
+    blas::Uplo uplo,
+    blas::Op trans,
+    blas::Diag diag,
+    const alpha_t alpha,
+    const matrixA_t& A,
+    matrixB_t& B )
+{
+    internal::num_threads_scope scope( policy.num_threads );
+    trsm( side, uplo, trans, diag, alpha, A, B );
 }
 
 }  // namespace blas
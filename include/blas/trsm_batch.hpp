@@ -0,0 +1,348 @@
+// Copyright (c) 2021, University of Colorado Denver. All rights reserved.
+//
+// This file is part of <T>LAPACK.
+// <T>LAPACK is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef BLAS_TRSM_BATCH_HH
+#define BLAS_TRSM_BATCH_HH
+
+#include "blas/utils.hpp"
+#include "blas/trsm.hpp"
+#include "blas/gemm_batch.hpp"
+#include "blas/parallel.hpp"
+
+#include <vector>
+#include <cstddef>
+#include <algorithm>
+
+// Fully unroll the loops over the interleaved problems
+#ifdef __GNUC__
+    #define TBLAS_UNROLL_BATCH _Pragma("GCC unroll 16")
+#else
+    #define TBLAS_UNROLL_BATCH
+#endif
+
+namespace blas {
+
+namespace internal {
+
+    // -------------------------------------------------------------------------
+    /** Solves T X = B (side = Left) or X T = B (side = Right) for width
+     * interleaved problems in the compact layout, where T is triangular and
+     * B, m-by-n, is overwritten by X.
+     *
+     * @param[in] lower True if T is lower triangular.
+     */
+    template< std::size_t width, class T, class idx_t >
+    #ifdef TBLAS_SIMD_X86
+    __attribute__((always_inline))
+    #endif
+    inline void trsm_compact_kernel_generic(
+        Side side, bool lower, Diag diag,
+        idx_t m, idx_t n, const T* a, T* b )
+    {
+        const idx_t nA = (side == Side::Left) ? m : n;
+        auto tt = [&]( idx_t i, idx_t j ) { return a + (j*nA+i)*width; };
+        auto xx = [&]( idx_t i, idx_t j ) { return b + (j*m+i)*width; };
+
+        if( side == Side::Left ) {
+            for(idx_t j = 0; j < n; ++j) {
+                for(idx_t s = 0; s < m; ++s) {
+                    const idx_t l = lower ? s : m-1-s;
+                    T* xl = xx(l,j);
+                    if( diag == Diag::NonUnit ) {
+                        const T* tll = tt(l,l);
+                        TBLAS_UNROLL_BATCH
+                        for(std::size_t p = 0; p < width; ++p)
+                            xl[p] /= tll[p];
+                    }
+                    const idx_t i0 = lower ? l+1 : 0;
+                    const idx_t i1 = lower ? m : l;
+                    for(idx_t i = i0; i < i1; ++i) {
+                        const T* til = tt(i,l);
+                        T* xi = xx(i,j);
+                        TBLAS_UNROLL_BATCH
+                        for(std::size_t p = 0; p < width; ++p)
+                            xi[p] -= til[p] * xl[p];
+                    }
+                }
+            }
+        }
+        else {
+            for(idx_t s = 0; s < n; ++s) {
+                const idx_t j = lower ? n-1-s : s;
+                const idx_t l0 = lower ? j+1 : 0;
+                const idx_t l1 = lower ? n : j;
+                for(idx_t l = l0; l < l1; ++l) {
+                    const T* tlj = tt(l,j);
+                    for(idx_t i = 0; i < m; ++i) {
+                        const T* xil = xx(i,l);
+                        T* xij = xx(i,j);
+                        TBLAS_UNROLL_BATCH
+                        for(std::size_t p = 0; p < width; ++p)
+                            xij[p] -= xil[p] * tlj[p];
+                    }
+                }
+                if( diag == Diag::NonUnit ) {
+                    const T* tjj = tt(j,j);
+                    for(idx_t i = 0; i < m; ++i) {
+                        T* xij = xx(i,j);
+                        TBLAS_UNROLL_BATCH
+                        for(std::size_t p = 0; p < width; ++p)
+                            xij[p] /= tjj[p];
+                    }
+                }
+            }
+        }
+    }
+
+#ifdef TBLAS_SIMD_X86
+
+    // The generic kernel compiled for wider instruction sets
+    template< std::size_t width, class T, class idx_t >
+    __attribute__((target("avx2,fma")))
+    void trsm_compact_kernel_avx2(
+        Side side, bool lower, Diag diag,
+        idx_t m, idx_t n, const T* a, T* b )
+    {
+        trsm_compact_kernel_generic<width>( side, lower, diag, m, n, a, b );
+    }
+
+    template< std::size_t width, class T, class idx_t >
+    __attribute__((target("avx512f")))
+    void trsm_compact_kernel_avx512(
+        Side side, bool lower, Diag diag,
+        idx_t m, idx_t n, const T* a, T* b )
+    {
+        trsm_compact_kernel_generic<width>( side, lower, diag, m, n, a, b );
+    }
+
+#endif // TBLAS_SIMD_X86
+
+    /// Compact kernel for the instruction set of the running CPU.
+    template< std::size_t width, class T, class idx_t >
+    inline void trsm_compact_kernel(
+        Side side, bool lower, Diag diag,
+        idx_t m, idx_t n, const T* a, T* b )
+    {
+        #ifdef TBLAS_SIMD_X86
+            const simd_isa isa = cpu_simd_isa();
+            if( isa == simd_isa::avx512 )
+                return trsm_compact_kernel_avx512<width>( side, lower, diag, m, n, a, b );
+            else if( isa == simd_isa::avx2 )
+                return trsm_compact_kernel_avx2<width>( side, lower, diag, m, n, a, b );
+        #endif
+        trsm_compact_kernel_generic<width>( side, lower, diag, m, n, a, b );
+    }
+
+    // -------------------------------------------------------------------------
+    /** Uniform batch of small triangular solves computed in the compact
+     * layout. op(A_i) is packed explicitly, so the kernel only deals with
+     * lower and upper triangular matrices. Padding lanes solve with the
+     * identity.
+     */
+    template< class T,
+              class matrixA_range, class matrixB_range,
+              class alpha_t, class idx_t >
+    void trsm_batch_compact(
+        Side side, Uplo uplo, Op trans, Diag diag,
+        idx_t m, idx_t n,
+        const alpha_t& alpha,
+        const matrixA_range& A, matrixB_range& B, int nt )
+    {
+        constexpr std::size_t w = batch_blocksize<T>::width;
+        const std::size_t batch = B.size();
+        const std::size_t ngroups = (batch + w-1) / w;
+        const idx_t nA = (side == Side::Left) ? m : n;
+        const bool lower = ( (uplo == Uplo::Lower) == (trans == Op::NoTrans) );
+        if( nt > int(ngroups) ) nt = int(ngroups);
+
+        parallel_for( nt, nt, [&]( std::size_t t ) {
+            std::vector<T> a( nA*nA*w ), b( m*n*w );
+            for(std::size_t g = t; g < ngroups; g += nt) {
+                const std::size_t b0 = g*w;
+                const std::size_t np = (batch-b0 < w) ? batch-b0 : w;
+
+                if( np < w ) {
+                    std::fill( a.begin(), a.end(), T(1) );
+                    std::fill( b.begin(), b.end(), T(0) );
+                }
+                compact_pack<w>( trans, A, b0, np, nA, nA, a.data() );
+                compact_pack<w>( Op::NoTrans, B, b0, np, m, n, b.data() );
+
+                trsm_compact_kernel<w>( side, lower, diag, m, n, a.data(), b.data() );
+
+                for(std::size_t p = 0; p < np; ++p) {
+                    auto&& Bp = B[b0+p];
+                    for(idx_t j = 0; j < n; ++j)
+                        for(idx_t i = 0; i < m; ++i)
+                            Bp(i,j) = alpha * b[ (j*m+i)*w + p ];
+                }
+            }
+        } );
+    }
+
+} // namespace internal
+
+/**
+ * Batched triangular solve:
+ * \[
+ *     op(A_i) X_i = \alpha B_i,
+ * \]
+ * or
+ * \[
+ *     X_i op(A_i) = \alpha B_i,
+ * \]
+ * for i = 0, ..., batch-1, where $op(A_i)$ is one of
+ *     $op(A_i) = A_i$,
+ *     $op(A_i) = A_i^T$, or
+ *     $op(A_i) = A_i^H$,
+ * X_i and B_i are m_i-by-n_i matrices, and A_i is an m_i-by-m_i or
+ * n_i-by-n_i, unit or non-unit, upper or lower triangular matrix.
+ *
+ * The sizes may vary from problem to problem. The problems are distributed
+ * among the threads (@see get_num_threads), and each one is solved by a
+ * serial call to trsm. If all the problems have the same sizes, and these are
+ * small (@see batch_blocksize), groups of problems of real type are
+ * interleaved in a compact layout and solved together.
+ *
+ * No test for singularity or near-singularity is included in this
+ * routine. Such tests must be performed before calling this routine.
+ *
+ * @param[in] side
+ *     Whether $op(A_i)$ is on the left or right of X_i:
+ *     - Side::Left:  $op(A_i) X_i = B_i$.
+ *     - Side::Right: $X_i op(A_i) = B_i$.
+ *
+ * @param[in] uplo
+ *     What part of the matrices A_i is referenced,
+ *     the opposite triangle being assumed to be zero:
+ *     - Uplo::Lower: A_i is lower triangular.
+ *     - Uplo::Upper: A_i is upper triangular.
+ *
+ * @param[in] trans
+ *     The form of $op(A_i)$:
+ *     - Op::NoTrans:   $op(A_i) = A_i$.
+ *     - Op::Trans:     $op(A_i) = A_i^T$.
+ *     - Op::ConjTrans: $op(A_i) = A_i^H$.
+ *
+ * @param[in] diag
+ *     Whether A_i has a unit or non-unit diagonal:
+ *     - Diag::Unit:    A_i is assumed to be unit triangular.
+ *     - Diag::NonUnit: A_i is not assumed to be unit triangular.
+ *
+ * @param[in] alpha
+ *     Scalar alpha.
+ *
+ * @param[in] A
+ *     Range of matrices A_i, e.g., a std::vector of matrix views.
+ *     It must provide size() and operator[].
+ *
+ * @param[in,out] B
+ *     Range of matrices B_i, with the same size as A.
+ *     On exit, overwritten by the solutions X_i.
+ *
+ * @ingroup trsm
+ */
+template< class matrixA_range, class matrixB_range, class alpha_t >
+void trsm_batch(
+    blas::Side side,
+    blas::Uplo uplo,
+    blas::Op trans,
+    blas::Diag diag,
+    const alpha_t& alpha,
+    const matrixA_range& A,
+    matrixB_range& B )
+{
+    using internal::range_value_t;
+
+    // data traits
+    using TA    = type_t< range_value_t< const matrixA_range > >;
+    using TB    = type_t< range_value_t< matrixB_range > >;
+    using idx_t = size_type< range_value_t< matrixB_range > >;
+
+    // using
+    using scalar_t = scalar_type<TA,TB>;
+
+    // constants
+    const std::size_t batch = B.size();
+
+    // check arguments
+    blas_error_if( side != Side::Left &&
+                   side != Side::Right );
+    blas_error_if( uplo != Uplo::Lower &&
+                   uplo != Uplo::Upper );
+    blas_error_if( trans != Op::NoTrans &&
+                   trans != Op::Trans &&
+                   trans != Op::ConjTrans );
+    blas_error_if( diag != Diag::NonUnit &&
+                   diag != Diag::Unit );
+    blas_error_if( A.size() != batch );
+
+    // quick return
+    if( batch == 0 )
+        return;
+
+    // Check sizes, count flops and detect uniform batches
+    const idx_t m = nrows( B[0] );
+    const idx_t n = ncols( B[0] );
+    bool uniform = true;
+    double flops = 0;
+    for(std::size_t i = 0; i < batch; ++i) {
+        const idx_t mi = nrows( B[i] );
+        const idx_t ni = ncols( B[i] );
+        blas_error_if( nrows( A[i] ) != ncols( A[i] ) );
+        blas_error_if( nrows( A[i] ) != ((side == Side::Left) ? mi : ni) );
+        uniform = uniform && mi == m && ni == n;
+        flops += double(mi) * ni * nrows( A[i] );
+    }
+
+    const int nt = internal::num_threads_for( flops );
+
+    // Compact layout for uniform batches of small real matrices
+    constexpr std::size_t wmax = batch_blocksize<scalar_t>::max_size;
+    if( uniform && !is_complex<scalar_t>::value &&
+        batch >= batch_blocksize<scalar_t>::width &&
+        m > 0 && n > 0 &&
+        std::size_t(m) <= wmax && std::size_t(n) <= wmax )
+    {
+        internal::trsm_batch_compact< scalar_t >(
+            side, uplo, trans, diag, m, n, alpha, A, B, nt );
+        return;
+    }
+
+    internal::parallel_for( batch, nt, [&]( std::size_t i ) {
+        auto&& Bi = B[i];
+        trsm( side, uplo, trans, diag, alpha, A[i], Bi );
+    } );
+}
+
+/**
+ * Batched triangular solve with a given number of threads.
+ * @see trsm_batch( blas::Side, blas::Uplo, blas::Op, blas::Diag, const alpha_t&, const matrixA_range&, matrixB_range& )
+ *
+ * @param[in] policy Execution policy with the number of threads.
+ *
+ * @ingroup trsm
+ */
+template< class matrixA_range, class matrixB_range, class alpha_t >
+inline void trsm_batch(
+    const parallel_policy& policy,
+    blas::Side side,
+    blas::Uplo uplo,
+    blas::Op trans,
+    blas::Diag diag,
+    const alpha_t& alpha,
+    const matrixA_range& A,
+    matrixB_range& B )
+{
+    internal::num_threads_scope scope( policy.num_threads );
+    trsm_batch( side, uplo, trans, diag, alpha, A, B );
+}
+
+}  // namespace blas
+
+#undef TBLAS_UNROLL_BATCH
+
+#endif        //  #ifndef BLAS_TRSM_BATCH_HH
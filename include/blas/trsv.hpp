@@ -9,9 +9,132 @@
 #define BLAS_TRSV_HH
 
 #include "blas/utils.hpp"
+#include "blas/dispatch.hpp"
+#include "blas/storage.hpp"
 
 namespace blas {
 
+namespace internal {
+
+/**
+ * Triangular solve with loops along the rows of A, for row-major matrices.
+ * The arguments are not checked.
+ *
+ * @ingroup trsv
+ */
+template< class matrixA_t, class vectorX_t >
+void trsv_rowmajor(
+    Uplo uplo,
+    Op trans,
+    Diag diag,
+    const matrixA_t& A,
+    vectorX_t& x )
+{
+    // data traits
+    using TA    = type_t< matrixA_t >;
+    using TX    = type_t< vectorX_t >;
+    using idx_t = size_type< matrixA_t >;
+
+    // using
+    using scalar_t = scalar_type<TA,TX>;
+
+    // constants
+    const idx_t n = nrows(A);
+    const bool nonunit = (diag == Diag::NonUnit);
+
+    if (trans == Op::NoTrans) {
+        // Form x := A^{-1} * x, x[i] uses row i of A and the solved x[j]
+        if (uplo == Uplo::Upper) {
+            for (idx_t i = n-1; i != idx_t(-1); --i) {
+                scalar_t tmp = x[i];
+                for (idx_t j = i+1; j < n; ++j)
+                    tmp -= A(i,j) * x[j];
+                if (nonunit)
+                    tmp /= A(i,i);
+                x[i] = tmp;
+            }
+        }
+        else {
+            for (idx_t i = 0; i < n; ++i) {
+                scalar_t tmp = x[i];
+                for (idx_t j = 0; j < i; ++j)
+                    tmp -= A(i,j) * x[j];
+                if (nonunit)
+                    tmp /= A(i,i);
+                x[i] = tmp;
+            }
+        }
+    }
+    else if (trans == Op::Conj) {
+        // Form x := conj(A)^{-1} * x
+        if (uplo == Uplo::Upper) {
+            for (idx_t i = n-1; i != idx_t(-1); --i) {
+                scalar_t tmp = x[i];
+                for (idx_t j = i+1; j < n; ++j)
+                    tmp -= conj( A(i,j) ) * x[j];
+                if (nonunit)
+                    tmp /= conj( A(i,i) );
+                x[i] = tmp;
+            }
+        }
+        else {
+            for (idx_t i = 0; i < n; ++i) {
+                scalar_t tmp = x[i];
+                for (idx_t j = 0; j < i; ++j)
+                    tmp -= conj( A(i,j) ) * x[j];
+                if (nonunit)
+                    tmp /= conj( A(i,i) );
+                x[i] = tmp;
+            }
+        }
+    }
+    else if (trans == Op::Trans) {
+        // Form x := A^{-T} * x, row i of A is subtracted from x once x[i] is solved
+        if (uplo == Uplo::Upper) {
+            for (idx_t i = 0; i < n; ++i) {
+                // note: NOT skipping if x[i] is zero, for consistent NAN handling
+                if (nonunit)
+                    x[i] /= A(i,i);
+                scalar_t tmp = x[i];
+                for (idx_t j = i+1; j < n; ++j)
+                    x[j] -= tmp * A(i,j);
+            }
+        }
+        else {
+            for (idx_t i = n-1; i != idx_t(-1); --i) {
+                if (nonunit)
+                    x[i] /= A(i,i);
+                scalar_t tmp = x[i];
+                for (idx_t j = 0; j < i; ++j)
+                    x[j] -= tmp * A(i,j);
+            }
+        }
+    }
+    else {
+        // Form x := A^{-H} * x
+        if (uplo == Uplo::Upper) {
+            for (idx_t i = 0; i < n; ++i) {
+                if (nonunit)
+                    x[i] /= conj( A(i,i) );
+                scalar_t tmp = x[i];
+                for (idx_t j = i+1; j < n; ++j)
+                    x[j] -= tmp * conj( A(i,j) );
+            }
+        }
+        else {
+            for (idx_t i = n-1; i != idx_t(-1); --i) {
+                if (nonunit)
+                    x[i] /= conj( A(i,i) );
+                scalar_t tmp = x[i];
+                for (idx_t j = 0; j < i; ++j)
+                    x[j] -= tmp * conj( A(i,j) );
+            }
+        }
+    }
+}
+
+} // namespace internal
+
 /**
  * Solve the triangular matrix-vector equation
  * \[
@@ -101,6 +224,18 @@ void trsv(
     blas_error_if( nrows(A) != ncols(A) );
     blas_error_if( size(x) != n );
 
+    // call BLAS++ on large problems
+    #ifdef USE_BLASPP_WRAPPERS
+        if( internal::dispatch_trsv( uplo, trans, diag, A, x ) )
+            return;
+    #endif
+
+    // Loops along the rows of a row-major A
+    if( internal::rowmajor_loops( A ) ) {
+        internal::trsv_rowmajor( uplo, trans, diag, A, x );
+        return;
+    }
+
     if (trans == Op::NoTrans) {
         // Form x := A^{-1} * x
         if (uplo == Uplo::Upper) {
@@ -0,0 +1,348 @@
+/// @file tuning.hpp Registry of the block sizes of the blocked routines.
+//
+// Copyright (c) 2021, University of Colorado Denver. All rights reserved.
+//
+// This file is part of <T>LAPACK.
+// <T>LAPACK is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef BLAS_TUNING_HH
+#define BLAS_TUNING_HH
+
+#include "blas/gemm_blocked.hpp"
+
+#include <cstddef>
+#include <complex>
+
+#ifndef TLAPACK_STATIC_TUNING
+    #include <cstdlib>
+    #include <fstream>
+    #include <sstream>
+    #include <string>
+    #include <vector>
+    #include <atomic>
+    #include <memory>
+    #include <mutex>
+#endif
+
+// -----------------------------------------------------------------------------
+// Default block sizes. Define these macros to change the defaults at compile
+// time, e.g., -DTLAPACK_NB_UNMQR=64. The default of the blocked Level 3 BLAS
+// is level3_blocksize<T>::nb.
+
+#ifndef TLAPACK_NB_GEQRF
+    #define TLAPACK_NB_GEQRF 32
+#endif
+#ifndef TLAPACK_NB_UNGQR
+    #define TLAPACK_NB_UNGQR 32
+#endif
+#ifndef TLAPACK_NB_UNMQR
+    #define TLAPACK_NB_UNMQR 32
+#endif
+#ifndef TLAPACK_NB_POTRF
+    #define TLAPACK_NB_POTRF 64
+#endif
+
+namespace blas {
+
+/** Character that identifies the type T in the tuning registry:
+ * 's', 'd', 'c' and 'z' for float, double, std::complex<float> and
+ * std::complex<double>, and '*' for the other types.
+ *
+ * @ingroup utils
+ */
+template< class T > constexpr char tuning_type() { return '*'; }
+template<> constexpr char tuning_type< float >() { return 's'; }
+template<> constexpr char tuning_type< double >() { return 'd'; }
+template<> constexpr char tuning_type< std::complex<float> >() { return 'c'; }
+template<> constexpr char tuning_type< std::complex<double> >() { return 'z'; }
+
+namespace internal {
+
+/// True if the strings a and b are equal
+inline constexpr bool same_name( const char* a, const char* b ) {
+    while( *a != '\0' && *a == *b ) {
+        ++a;
+        ++b;
+    }
+    return *a == *b;
+}
+
+/** Block size used when the registry has no entry for the routine.
+ *
+ * Routine     | Default block size
+ * ----------- | ------------------------------
+ * "geqrf"     | TLAPACK_NB_GEQRF
+ * "ungqr"     | TLAPACK_NB_UNGQR
+ * "unmqr"     | TLAPACK_NB_UNMQR
+ * "potrf"     | TLAPACK_NB_POTRF
+ * "level3"    | level3_blocksize<T>::nb, used by trsm, trmm, syrk, herk,
+ *             | syr2k and her2k
+ * other       | 32
+ */
+template< class T >
+inline constexpr std::size_t default_blocksize( const char* routine )
+{
+    struct entry {
+        const char* routine;
+        std::size_t nb;
+    };
+    const entry table[] = {
+        { "geqrf",  TLAPACK_NB_GEQRF },
+        { "ungqr",  TLAPACK_NB_UNGQR },
+        { "unmqr",  TLAPACK_NB_UNMQR },
+        { "potrf",  TLAPACK_NB_POTRF },
+        { "level3", level3_blocksize<T>::nb },
+    };
+    for( const entry& e : table )
+        if( same_name( routine, e.routine ) )
+            return e.nb;
+    return 32;
+}
+
+} // namespace internal
+
+#ifdef TLAPACK_STATIC_TUNING
+
+// Embedded builds: the block sizes are the compile-time defaults
+
+template< class T >
+inline constexpr std::size_t get_blocksize(
+    const char* routine, std::size_t, std::size_t, std::size_t )
+{
+    return internal::default_blocksize<T>( routine );
+}
+
+#else
+
+/** Entry of the tuning registry.
+ *
+ * The block size nb is used by the routine for the type identified by type
+ * (see `tuning_type()`; '*' matches all types) on problems of size at
+ * least m, n and k.
+ *
+ * @ingroup utils
+ */
+struct tuning_entry {
+    std::string routine;
+    char type;
+    std::size_t m, n, k;
+    std::size_t nb;
+};
+
+namespace internal {
+
+/** Entries of the registry.
+ *
+ * The entries are never modified once they are published: writers copy the
+ * current table, change the copy and publish it, so that get_blocksize()
+ * reads without taking a lock.
+ */
+using tuning_table = std::vector< tuning_entry >;
+
+struct tuning_registry {
+    /// Serializes the writers
+    std::mutex mutex;
+    /// Current table, read without the mutex
+    std::atomic< const tuning_table* > table{ nullptr };
+    /// All the published tables. Readers may still use a replaced table, so
+    /// they are kept for the lifetime of the registry.
+    std::vector< std::unique_ptr< const tuning_table > > tables;
+
+    /// Copy of the current table. Must be called with the mutex held.
+    tuning_table copy() const {
+        const tuning_table* t = table.load( std::memory_order_relaxed );
+        return ( t ) ? *t : tuning_table();
+    }
+
+    /// Publishes t. Must be called with the mutex held.
+    void publish( tuning_table&& t ) {
+        tables.emplace_back( new tuning_table( std::move( t ) ) );
+        table.store( tables.back().get(), std::memory_order_release );
+    }
+};
+
+/// Adds e to the table t. An entry with the same routine, type and sizes is
+/// replaced.
+inline void merge_tuning_entry( tuning_table& t, const tuning_entry& e )
+{
+    for( auto& x : t ) {
+        if( x.routine == e.routine && x.type == e.type &&
+            x.m == e.m && x.n == e.n && x.k == e.k ) {
+            x.nb = e.nb;
+            return;
+        }
+    }
+    t.push_back( e );
+}
+
+inline bool read_tuning_file( const char* path, tuning_table& entries )
+{
+    std::ifstream file( path );
+    if( !file )
+        return false;
+
+    std::string line;
+    while( std::getline( file, line ) ) {
+        const std::size_t c = line.find( '#' );
+        if( c != std::string::npos )
+            line.erase( c );
+        std::istringstream is( line );
+        tuning_entry e;
+        if( is >> e.routine >> e.type >> e.m >> e.n >> e.k >> e.nb && e.nb > 0 )
+            merge_tuning_entry( entries, e );
+    }
+
+    return true;
+}
+
+/// The registry. On first use, it reads the file TLAPACK_TUNING_FILE if
+/// this environment variable is set.
+inline tuning_registry& get_tuning_registry() {
+    static tuning_registry* registry = []() {
+        tuning_registry* r = new tuning_registry;
+        tuning_table t;
+        if( const char* path = std::getenv( "TLAPACK_TUNING_FILE" ) )
+            read_tuning_file( path, t );
+        if( !t.empty() )
+            r->publish( std::move( t ) );
+        return r;
+    }();
+    return *registry;
+}
+
+} // namespace internal
+
+/** Block size of a routine for the type T on a problem of size (m,n,k).
+ *
+ * This is the equivalent of LAPACK's ILAENV. The registry is searched for
+ * the entries of the routine that match T and whose sizes are not larger
+ * than (m,n,k). Entries for T are preferred over entries for all types,
+ * and, among those, the entry with the largest m+n+k is used. If there is
+ * no such entry, the compile-time default is returned, see
+ * internal::default_blocksize().
+ *
+ * The registry starts with the entries from the file named by the
+ * environment variable TLAPACK_TUNING_FILE, if any. The file can be written
+ * by the autotuner in tools/autotune. The registry is read without locks,
+ * so this function can be called from many threads at once.
+ *
+ * Define TLAPACK_STATIC_TUNING to remove the registry: then the block sizes
+ * are the compile-time defaults and no file is read.
+ *
+ * @param[in] routine Name of the routine, e.g., "unmqr", or "level3" for the
+ *      blocked Level 3 BLAS.
+ * @param[in] m, n, k Sizes of the problem, as defined by the routine.
+ *
+ * @ingroup utils
+ */
+template< class T >
+inline std::size_t get_blocksize(
+    const char* routine, std::size_t m, std::size_t n, std::size_t k )
+{
+    constexpr char t = tuning_type<T>();
+    const internal::tuning_table* table = internal::get_tuning_registry()
+        .table.load( std::memory_order_acquire );
+    if( !table )
+        return internal::default_blocksize<T>( routine );
+
+    const tuning_entry* best = nullptr;
+    for( const auto& e : *table ) {
+        if( (e.type != t && e.type != '*') ||
+            e.m > m || e.n > n || e.k > k || e.routine != routine )
+            continue;
+        if( !best ||
+            ( e.type == t && best->type != t ) ||
+            ( (e.type == t) == (best->type == t) &&
+              e.m + e.n + e.k >= best->m + best->n + best->k ) )
+            best = &e;
+    }
+
+    return ( best ) ? best->nb : internal::default_blocksize<T>( routine );
+}
+
+/** Adds an entry to the tuning registry. An entry with the same routine,
+ * type and sizes is replaced. nb must be positive.
+ *
+ * @see get_blocksize()
+ *
+ * @ingroup utils
+ */
+inline void set_blocksize(
+    const char* routine, char type,
+    std::size_t m, std::size_t n, std::size_t k, std::size_t nb )
+{
+    blas_error_if( nb == 0 );
+
+    auto& registry = internal::get_tuning_registry();
+    std::lock_guard< std::mutex > lock( registry.mutex );
+
+    internal::tuning_table t = registry.copy();
+    internal::merge_tuning_entry( t, tuning_entry{ routine, type, m, n, k, nb } );
+    registry.publish( std::move( t ) );
+}
+
+/** Adds the entries of a tuning file to the registry.
+ *
+ * Each line of the file has the format
+ *
+ *     routine type m n k nb
+ *
+ * and '#' starts a comment.
+ *
+ * @return false if the file could not be read.
+ *
+ * @ingroup utils
+ */
+inline bool load_tuning_file( const char* path )
+{
+    internal::tuning_table entries;
+    if( !internal::read_tuning_file( path, entries ) )
+        return false;
+
+    auto& registry = internal::get_tuning_registry();
+    std::lock_guard< std::mutex > lock( registry.mutex );
+
+    internal::tuning_table t = registry.copy();
+    for( const auto& e : entries )
+        internal::merge_tuning_entry( t, e );
+    registry.publish( std::move( t ) );
+    return true;
+}
+
+/** Writes the registry to a tuning file.
+ *
+ * @return false if the file could not be written.
+ *
+ * @ingroup utils
+ */
+inline bool save_tuning_file( const char* path )
+{
+    auto& registry = internal::get_tuning_registry();
+    const internal::tuning_table* table =
+        registry.table.load( std::memory_order_acquire );
+
+    std::ofstream file( path );
+    if( !file )
+        return false;
+    file << "# routine type m n k nb\n";
+    if( table )
+        for( const auto& e : *table )
+            file << e.routine << ' ' << e.type << ' '
+                 << e.m << ' ' << e.n << ' ' << e.k << ' ' << e.nb << '\n';
+    return bool( file );
+}
+
+/// Removes all the entries of the tuning registry
+inline void clear_tuning()
+{
+    auto& registry = internal::get_tuning_registry();
+    std::lock_guard< std::mutex > lock( registry.mutex );
+    registry.table.store( nullptr, std::memory_order_release );
+}
+
+#endif // TLAPACK_STATIC_TUNING
+
+} // namespace blas
+
+#endif // BLAS_TUNING_HH
@@ -203,6 +203,9 @@ struct real_type_traits< T1, Types... >
     template< class T > struct sizet_trait {};
     template< class T >
     using size_type = typename sizet_trait< T >::type;
+    // Strided storage: pointer to the first entry and distance between
+    // entries along each dimension. Only for arrays with such storage.
+    template< class T, class Enable = int > struct storage_trait {};
 
 #endif // TBLAS_ARRAY_TRAITS
 
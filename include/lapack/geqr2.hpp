@@ -61,6 +61,7 @@ int geqr2( matrix_t& A, vector_t &tau, work_t &work )
     using TA    = type_t< matrix_t >;
     using idx_t = size_type< matrix_t >;
     using pair  = std::pair<idx_t,idx_t>;
+    using blas::conj;
 
     // constants
     const TA one( 1 );
@@ -91,8 +92,9 @@ int geqr2( matrix_t& A, vector_t &tau, work_t &work )
               auto C = submatrix( A, pair{i,m}, pair{i+1,n} );
               auto w = subvector( work, pair{i,n-1} );
 
-        // C := I - tau_i v v^H
-        larf( left_side, v, tau[i], C, w );
+        // C := ( I - tau_i v v^H )^H C
+        const TA tauH = conj( tau[i] );
+        larf( left_side, v, tauH, C, w );
 
         A(i,i) = alpha;
 	}
@@ -106,6 +108,21 @@ int geqr2( matrix_t& A, vector_t &tau, work_t &work )
     return 0;
 }
 
+/** Workspace query for `lapack::geqr2`.
+ *
+ * @return A vector of length n-1, where A is m-by-n.
+ *
+ * @see geqr2( matrix_t& A, vector_t &tau, work_t &work )
+ *
+ * @ingroup geqrf
+ */
+template< class matrix_t, class vector_t >
+inline workinfo_t geqr2_worksize( const matrix_t& A, const vector_t& )
+{
+    const std::size_t n = ncols(A);
+    return make_workinfo< type_t<matrix_t> >( (n > 0) ? n-1 : 0 );
+}
+
 } // lapack
 
 #endif // __GEQR2_HH__
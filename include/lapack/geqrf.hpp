@@ -0,0 +1,130 @@
+/// @file geqrf.hpp Computes a QR factorization of a matrix A using a blocked code.
+//
+// Copyright (c) 2021, University of Colorado Denver. All rights reserved.
+//
+// This file is part of <T>LAPACK.
+// <T>LAPACK is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef __GEQRF_HH__
+#define __GEQRF_HH__
+
+#include "lapack/utils.hpp"
+#include "lapack/types.hpp"
+#include "lapack/geqr2.hpp"
+#include "lapack/geqrt3.hpp"
+#include "lapack/larfb.hpp"
+#include "lapack/tuning.hpp"
+
+namespace lapack {
+
+/** Computes a QR factorization of a matrix A using a blocked code.
+ *
+ * The output is the same as the one of `lapack::geqr2`: the matrix Q is
+ * represented as a product of elementary reflectors
+ * \[
+ *          Q = H_1 H_2 ... H_k,
+ * \]
+ * where k = min(m,n), stored below the diagonal of A and in tau.
+ *
+ * The matrix is factored in panels of nb columns. Each panel and the
+ * triangular factor T of its block reflector are computed by the recursive
+ * `lapack::geqrt3`, and the block reflector is applied to the trailing
+ * matrix by `lapack::larfb`, so that most flops are done in gemm.
+ *
+ * @return  0 if success
+ * @return -i if the ith argument is invalid
+ *
+ * @param[in,out] A m-by-n matrix.
+ *      On exit, the elements on and above the diagonal of the array
+ *      contain the min(m,n)-by-n upper trapezoidal matrix R
+ *      (R is upper triangular if m >= n); the elements below the diagonal,
+ *      with the array tau, represent the unitary matrix Q as a
+ *      product of elementary reflectors.
+ * @param[out] tau Vector of length min(m,n).
+ *      The scalar factors of the elementary reflectors.
+ * @param W nb-by-n workspace.
+ *      The number of rows of W defines the block size nb.
+ *      If nb <= 1, the unblocked code is used.
+ *
+ * @see geqr2( matrix_t& A, vector_t &tau, work_t &work )
+ *
+ * @ingroup geqrf
+ */
+template< class matrix_t, class vector_t, class matrixW_t >
+int geqrf( matrix_t& A, vector_t &tau, matrixW_t& W )
+{
+    using idx_t = size_type< matrix_t >;
+    using pair  = std::pair<idx_t,idx_t>;
+    using std::min;
+
+    // constants
+    const idx_t m = nrows(A);
+    const idx_t n = ncols(A);
+    const idx_t k = min<idx_t>( m, n );
+    const idx_t nb = min<idx_t>( nrows(W), k );
+
+    // check arguments
+    lapack_error_if( size(tau) < k, -2 );
+    lapack_error_if( nrows(W) < 1 || ncols(W) < n, -3 );
+
+    // quick return
+    if (n <= 0) return 0;
+
+    // Use the unblocked code
+    if( nb <= 1 ) {
+        auto w = subvector( row( W, 0 ), pair{0,n-1} );
+        return geqr2( A, tau, w );
+    }
+
+    for(idx_t i = 0; i < k; i += nb) {
+
+        const idx_t ib = min<idx_t>( nb, k-i );
+
+        // Factor the panel A[i:m,i:i+ib] and form the triangular factor
+        // of the block reflector $H = H(i) H(i+1) ... H(i+ib-1)$
+        auto Ai   = submatrix( A, pair{i,m}, pair{i,i+ib} );
+        auto taui = subvector( tau, pair{i,i+ib} );
+        auto T    = submatrix( W, pair{0,ib}, pair{0,ib} );
+        geqrt3( Ai, taui, T );
+
+        if( i+ib < n ) {
+
+            // Apply H^H to A[i:m,i+ib:n] from the left
+            auto C  = submatrix( A, pair{i,m}, pair{i+ib,n} );
+            auto W0 = submatrix( W, pair{0,ib}, pair{ib,n-i} );
+            larfb(
+                left_side, conjTranspose, forward, columnwise_storage,
+                Ai, T, C, W0
+            );
+        }
+    }
+
+    return 0;
+}
+
+/** Workspace query for `lapack::geqrf`.
+ *
+ * @param[in] nb Block size.
+ *      If nb = 0, the block size is taken from `get_blocksize()`.
+ *
+ * @return A nb-by-n matrix, where A is m-by-n.
+ *
+ * @see geqrf( matrix_t& A, vector_t &tau, matrixW_t& W )
+ *
+ * @ingroup geqrf
+ */
+template< class matrix_t, class vector_t >
+inline workinfo_t geqrf_worksize(
+    const matrix_t& A, const vector_t&, size_type< matrix_t > nb = 0 )
+{
+    using std::min;
+    if( nb == 0 )
+        nb = get_blocksize< type_t<matrix_t> >(
+            "geqrf", nrows(A), ncols(A), min( nrows(A), ncols(A) ) );
+    return make_workinfo< type_t<matrix_t> >( (nb > 1) ? nb : 1, ncols(A) );
+}
+
+} // lapack
+
+#endif // __GEQRF_HH__
@@ -0,0 +1,255 @@
+/// @file geqrf_tiled.hpp Computes a QR factorization of a matrix A using tile tasks.
+//
+// Copyright (c) 2021, University of Colorado Denver. All rights reserved.
+//
+// This file is part of <T>LAPACK.
+// <T>LAPACK is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef __GEQRF_TILED_HH__
+#define __GEQRF_TILED_HH__
+
+#include "lapack/types.hpp"
+#include "lapack/utils.hpp"
+#include "lapack/mdspan.hpp"
+#include "tblas.hpp"
+#include "lapack/geqrt.hpp"
+#include "lapack/unmqrt.hpp"
+#include "lapack/tsqrt.hpp"
+#include "lapack/tsmqrt.hpp"
+#include "blas/task_graph.hpp"
+
+#include <vector>
+
+namespace lapack {
+
+namespace internal {
+
+/** Tiled QR factorization on a mt-by-nt grid of nb-by-nb tiles.
+ *
+ * tileA(i,j) returns a view of the tile (i,j) of A, and tileT(i,j) a
+ * nb-by-ncols(tileA(i,j)) view of the tile (i,j) of T. Each GEQRT, UNMQRT,
+ * TSQRT and TSMQRT on a tile is a task of a blas::internal::task_graph,
+ * whose dependencies come from the last task that wrote each tile of A.
+ *
+ * @see geqrf_tiled( matrix_t& A, matrixT_t& T, size_type< matrix_t > nb )
+ */
+template< class idx_t, class tileA_t, class tileT_t >
+void geqrf_tiled( idx_t mt, idx_t nt, const tileA_t& tileA, const tileT_t& tileT )
+{
+    using pair    = std::pair<idx_t,idx_t>;
+    using task_id = blas::internal::task_graph::task_id;
+
+    // Constants
+    const idx_t kt = (mt < nt) ? mt : nt;
+    const task_id none = task_id(-1);
+
+    blas::internal::task_graph graph;
+    std::vector< task_id > last( mt*nt, none );
+
+    // Adds a task that writes the tiles (i1,j) and (i2,j) of A and depends
+    // on the given task
+    auto add = [&]( idx_t i1, idx_t i2, idx_t j, int kind,
+                    std::function<void()> f, task_id dep )
+    {
+        // Tasks that unlock the next panels first
+        const task_id t = graph.add_task( std::move(f), int( 4*(nt-j) + kind ) );
+        task_id& w1 = last[i1+j*mt];
+        task_id& w2 = last[i2+j*mt];
+        if( w1 != none ) graph.add_dependency( w1, t );
+        if( i2 != i1 && w2 != none ) graph.add_dependency( w2, t );
+        if( dep != none ) graph.add_dependency( dep, t );
+        w1 = t;
+        w2 = t;
+        return t;
+    };
+
+    for(idx_t k = 0; k < kt; ++k) {
+
+        // GEQRT
+        const task_id tkk = add( k, k, k, 3, [&,k]() {
+            auto Akk = tileA( k, k );
+            auto Tkk = tileT( k, k );
+            const idx_t mk = nrows(Akk);
+            const idx_t nk = ncols(Akk);
+            const idx_t r  = (mk < nk) ? mk : nk;
+            auto T0 = submatrix( Tkk, pair{0,r}, pair{0,r} );
+            auto W0 = submatrix( Tkk, pair{0,r}, pair{r,nk} );
+            geqrt( Akk, T0, W0 );
+        }, none );
+
+        // UNMQRT, using the tile T(k,j) as workspace
+        for(idx_t j = k+1; j < nt; ++j)
+            add( k, k, j, 1, [&,k,j]() {
+                const auto Akk = tileA( k, k );
+                const auto Tkk = tileT( k, k );
+                auto Akj = tileA( k, j );
+                auto Wkj = tileT( k, j );
+                const idx_t r = (nrows(Akk) < ncols(Akk)) ? nrows(Akk) : ncols(Akk);
+                unmqrt( conjTranspose,
+                    submatrix( Akk, pair{0,nrows(Akk)}, pair{0,r} ),
+                    submatrix( Tkk, pair{0,r}, pair{0,r} ), Akj, Wkj );
+            }, tkk );
+
+        for(idx_t i = k+1; i < mt; ++i) {
+
+            // TSQRT
+            const task_id tik = add( k, i, k, 2, [&,k,i]() {
+                auto Akk = tileA( k, k );
+                auto Aik = tileA( i, k );
+                auto Tik = tileT( i, k );
+                const idx_t nk = ncols(Akk);
+                auto R = submatrix( Akk, pair{0,nk}, pair{0,nk} );
+                tsqrt( R, Aik, Tik );
+            }, none );
+
+            // TSMQRT, using the tile T(k,j) as workspace
+            for(idx_t j = k+1; j < nt; ++j)
+                add( k, i, j, 0, [&,k,i,j]() {
+                    const auto Aik = tileA( i, k );
+                    const auto Tik = tileT( i, k );
+                    auto Akj = tileA( k, j );
+                    auto Aij = tileA( i, j );
+                    auto Wkj = tileT( k, j );
+                    const idx_t nk = ncols(Aik);
+                    auto C1 = submatrix( Akj, pair{0,nk}, pair{0,ncols(Akj)} );
+                    tsmqrt( conjTranspose, Aik, Tik, C1, Aij, Wkj );
+                }, tik );
+        }
+    }
+
+    graph.run( blas::get_num_threads() );
+}
+
+} // namespace internal
+
+/** Computes a QR factorization of a m-by-n matrix A using tile tasks
+ * (tile CAQR with a flat reduction tree).
+ *
+ * A is split in nb-by-nb tiles. At step k, the diagonal tile is factored
+ * by `lapack::geqrt` and its reflectors are applied to the tiles on its
+ * right by `lapack::unmqrt`. Then each tile below the diagonal is
+ * annihilated against the R factor of the diagonal tile by `lapack::tsqrt`,
+ * and the tiles on its row are updated by `lapack::tsmqrt`. Each of these
+ * kernels is a task of a dependency graph executed by a work-stealing
+ * scheduler on blas::get_num_threads() threads. Thus, the panel of step k+1
+ * starts as soon as its tiles are updated, while the trailing update of
+ * step k is still running.
+ *
+ * @return  0 if success
+ * @return -i if the ith argument is invalid
+ *
+ * @param[in,out] A m-by-n matrix.
+ *      On exit, the elements on and above the diagonal of the array
+ *      contain the min(m,n)-by-n upper trapezoidal matrix R. The elements
+ *      below the diagonal of each diagonal tile contain the vectors of
+ *      `lapack::geqrt`, and the tiles below the diagonal tiles contain the
+ *      vectors of `lapack::tsqrt`.
+ * @param[out] T (mt nb)-by-n matrix, where mt = ceil(m/nb).
+ *      On exit, the tile (i,k), i >= k, holds the triangular factor of the
+ *      kernel that factored the tile (i,k) of A. The tiles above the
+ *      diagonal are used as workspace.
+ * @param[in] nb Tile size.
+ *
+ * @ingroup geqrf
+ */
+template< class matrix_t, class matrixT_t >
+int geqrf_tiled( matrix_t& A, matrixT_t& T, size_type< matrix_t > nb )
+{
+    using idx_t = size_type< matrix_t >;
+    using pair  = std::pair<idx_t,idx_t>;
+
+    // Constants
+    const idx_t m = nrows(A);
+    const idx_t n = ncols(A);
+
+    // Check arguments
+    lapack_error_if( nb <= 0, -3 );
+
+    const idx_t mt = (m + nb-1) / nb;
+    const idx_t nt = (n + nb-1) / nb;
+    lapack_error_if( nrows(T) < mt*nb || ncols(T) < n, -2 );
+
+    // Quick return
+    if (m == 0 || n == 0)
+        return 0;
+
+    auto cols_of = [&]( idx_t j ) {
+        return pair{ j*nb, (j*nb+nb < n) ? j*nb+nb : n };
+    };
+    auto tileA = [&]( idx_t i, idx_t j ) {
+        return submatrix( A, pair{ i*nb, (i*nb+nb < m) ? i*nb+nb : m }, cols_of( j ) );
+    };
+    auto tileT = [&]( idx_t i, idx_t j ) {
+        return submatrix( T, pair{ i*nb, i*nb+nb }, cols_of( j ) );
+    };
+
+    internal::geqrf_tiled( mt, nt, tileA, tileT );
+
+    return 0;
+}
+
+/** Computes a QR factorization of a matrix A stored in a tiled layout.
+ *
+ * The tiles of the layout are the tiles of the factorization. Each task
+ * works on contiguous column-major tiles.
+ *
+ * @return  0 if success
+ * @return -i if the ith argument is invalid
+ *
+ * @param[in,out] A Matrix with TiledLayout and square tiles.
+ * @param[out] T Matrix with the same extents and layout as A.
+ *
+ * @see geqrf_tiled( matrix_t& A, matrixT_t& T, size_type< matrix_t > nb )
+ *
+ * @ingroup geqrf
+ */
+template< class TA, class Exts >
+int geqrf_tiled(
+    mdspan< TA, Exts, TiledLayout >& A,
+    mdspan< TA, Exts, TiledLayout >& T )
+{
+    using idx_t = typename Exts::size_type;
+
+    // Constants
+    const auto& map  = A.mapping();
+    const auto& mapT = T.mapping();
+    const idx_t m  = A.extent(0);
+    const idx_t n  = A.extent(1);
+    const idx_t nb = map.row_tile_size();
+
+    // Check arguments
+    lapack_error_if( map.row_tile_size() != map.col_tile_size(), -1 );
+    lapack_error_if( T.extent(0) != m || T.extent(1) != n ||
+                     mapT.row_tile_size() != nb ||
+                     mapT.col_tile_size() != nb, -2 );
+
+    // Quick return
+    if (m == 0 || n == 0)
+        return 0;
+
+    auto tile = [&]( TA* data, const auto& mp, idx_t i, idx_t j, idx_t mi ) {
+        return Matrix<TA>(
+            data + mp.tile_offset( i*nb, j*nb ),
+            StridedMapping(
+                matrix_extents( mi, (j*nb+nb < n) ? nb : n-j*nb ),
+                std::array<idx_t,2>{ 1, nb } ) );
+    };
+
+    // Tiles of T always have nb rows of storage
+    auto tileA = [&]( idx_t i, idx_t j ) {
+        return tile( A.data(), map, i, j, (i*nb+nb < m) ? nb : m-i*nb );
+    };
+    auto tileT = [&]( idx_t i, idx_t j ) {
+        return tile( T.data(), mapT, i, j, nb );
+    };
+
+    internal::geqrf_tiled(
+        idx_t( map.n_row_tiles() ), idx_t( map.n_column_tiles() ), tileA, tileT );
+
+    return 0;
+}
+
+} // lapack
+
+#endif // __GEQRF_TILED_HH__
@@ -0,0 +1,107 @@
+/// @file geqrt.hpp Computes a QR factorization of a tile and the triangular factor of its block reflector.
+//
+// Copyright (c) 2021, University of Colorado Denver. All rights reserved.
+//
+// This file is part of <T>LAPACK.
+// <T>LAPACK is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef __GEQRT_HH__
+#define __GEQRT_HH__
+
+#include "lapack/utils.hpp"
+#include "lapack/types.hpp"
+#include "lapack/geqrt3.hpp"
+#include "lapack/larfb.hpp"
+
+namespace lapack {
+
+/** Computes a QR factorization of a m-by-n tile A and the triangular
+ * factor T of the compact WY representation
+ * \[
+ *          Q = H_1 H_2 ... H_k = I - V T V^H,
+ * \]
+ * where k = min(m,n).
+ *
+ * The first k columns are factored by `lapack::geqrt3`. If n > k, the
+ * block reflector is applied to the remaining columns by `lapack::larfb`.
+ *
+ * This is the kernel that factors the diagonal tiles of
+ * `lapack::geqrf_tiled`.
+ *
+ * @return  0 if success
+ * @return -i if the ith argument is invalid
+ *
+ * @param[in,out] A m-by-n matrix.
+ *      On exit, the elements on and above the diagonal of the array
+ *      contain the min(m,n)-by-n upper trapezoidal matrix R; the elements
+ *      below the diagonal are the Householder vectors V.
+ * @param[out] T k-by-k matrix.
+ *      On exit, the upper triangular factor of the block reflector. Its
+ *      diagonal holds the scalar factors of the elementary reflectors.
+ *      The strictly lower part of T is not referenced.
+ * @param W k-by-(n-k) workspace. Not referenced if n <= m.
+ *
+ * @see geqrt3( matrix_t& A, vector_t &tau, matrixT_t& T )
+ * @see unmqrt( trans_t trans, const matrixV_t& V, const matrixT_t& T, matrixC_t& C, matrixW_t& W )
+ *
+ * @ingroup geqrf
+ */
+template< class matrix_t, class matrixT_t, class matrixW_t >
+int geqrt( matrix_t& A, matrixT_t& T, matrixW_t& W )
+{
+    using idx_t = size_type< matrix_t >;
+    using pair  = std::pair<idx_t,idx_t>;
+    using std::min;
+
+    // constants
+    const idx_t m = nrows(A);
+    const idx_t n = ncols(A);
+    const idx_t k = min<idx_t>( m, n );
+
+    // check arguments
+    lapack_error_if( nrows(T) < k || ncols(T) < k, -2 );
+    lapack_error_if( n > k && (nrows(W) < k || ncols(W) < n-k), -3 );
+
+    // quick return
+    if (k <= 0) return 0;
+
+    auto V   = submatrix( A, pair{0,m}, pair{0,k} );
+    auto Tk  = submatrix( T, pair{0,k}, pair{0,k} );
+    auto tau = diag( Tk );
+    geqrt3( V, tau, Tk );
+
+    if( n > k ) {
+        auto C  = submatrix( A, pair{0,m}, pair{k,n} );
+        auto Wk = submatrix( W, pair{0,k}, pair{0,n-k} );
+        larfb(
+            left_side, conjTranspose, forward, columnwise_storage,
+            V, Tk, C, Wk
+        );
+    }
+
+    return 0;
+}
+
+/** Workspace query for `lapack::geqrt`.
+ *
+ * @return A k-by-(n-k) matrix, where A is m-by-n and k = min(m,n).
+ *         Empty if n <= m.
+ *
+ * @see geqrt( matrix_t& A, matrixT_t& T, matrixW_t& W )
+ *
+ * @ingroup geqrf
+ */
+template< class matrix_t, class matrixT_t >
+inline workinfo_t geqrt_worksize( const matrix_t& A, const matrixT_t& )
+{
+    const std::size_t m = nrows(A);
+    const std::size_t n = ncols(A);
+    return ( n > m )
+        ? make_workinfo< type_t<matrix_t> >( m, n-m )
+        : make_workinfo< type_t<matrix_t> >( 0 );
+}
+
+} // lapack
+
+#endif // __GEQRT_HH__
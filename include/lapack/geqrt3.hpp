@@ -0,0 +1,179 @@
+/// @file geqrt3.hpp Computes a QR factorization of a matrix A using the recursive algorithm.
+//
+// Copyright (c) 2021, University of Colorado Denver. All rights reserved.
+//
+// This file is part of <T>LAPACK.
+// <T>LAPACK is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef __GEQRT3_HH__
+#define __GEQRT3_HH__
+
+#include "lapack/utils.hpp"
+#include "lapack/types.hpp"
+#include "lapack/geqr2.hpp"
+#include "lapack/larft.hpp"
+#include "lapack/larfb.hpp"
+
+namespace lapack {
+
+namespace internal {
+
+/** Factors the block A[j0:m,j0:j0+n] and forms the block T[j0:j0+n,j0:j0+n]
+ * of the triangular factor.
+ *
+ * The recursion is done on the indices so that A, tau and T keep their
+ * types across the recursive calls.
+ *
+ * @see geqrt3( matrix_t& A, vector_t &tau, matrixT_t& T )
+ */
+template< class matrix_t, class vector_t, class matrixT_t >
+void geqrt3_recursive(
+    matrix_t& A, vector_t &tau, matrixT_t& T,
+    size_type< matrix_t > j0, size_type< matrix_t > n )
+{
+    using TA    = type_t< matrix_t >;
+    using idx_t = size_type< matrix_t >;
+    using pair  = std::pair<idx_t,idx_t>;
+    using blas::conj;
+    using blas::gemm;
+    using blas::trmm;
+
+    // constants
+    const TA one( 1 );
+    const idx_t nbmin = 8; // size of the base case
+    const idx_t m  = nrows(A);
+    const idx_t j2 = j0 + n;
+
+    // Stop recursion
+    if( n <= nbmin ) {
+        auto Ak   = submatrix( A, pair{j0,m}, pair{j0,j2} );
+        auto tauk = subvector( tau, pair{j0,j2} );
+        auto Tk   = submatrix( T, pair{j0,j2}, pair{j0,j2} );
+        // The strictly upper part of Tk is not used by geqr2
+        auto w = subvector( row( T, j0 ), pair{j0+1,j2} );
+
+        geqr2( Ak, tauk, w );
+        larft( forward, columnwise_storage, Ak, tauk, Tk );
+        return;
+    }
+
+    const idx_t n1 = n/2;
+    const idx_t j1 = j0 + n1;
+
+    // Factor [ A11; A21 ]
+    geqrt3_recursive( A, tau, T, j0, n1 );
+
+    // Apply H1^H to [ A12; A22 ] using T12 as workspace
+    {
+        const auto V1  = submatrix( A, pair{j0,m}, pair{j0,j1} );
+        const auto T11 = submatrix( T, pair{j0,j1}, pair{j0,j1} );
+        auto A2  = submatrix( A, pair{j0,m}, pair{j1,j2} );
+        auto T12 = submatrix( T, pair{j0,j1}, pair{j1,j2} );
+        larfb(
+            left_side, conjTranspose, forward, columnwise_storage,
+            V1, T11, A2, T12
+        );
+    }
+
+    // Factor A22
+    geqrt3_recursive( A, tau, T, j1, n-n1 );
+
+    // T12 := - T11 ( V1^H V2 ) T22
+    {
+        const auto T11 = submatrix( T, pair{j0,j1}, pair{j0,j1} );
+        const auto T22 = submatrix( T, pair{j1,j2}, pair{j1,j2} );
+        auto T12 = submatrix( T, pair{j0,j1}, pair{j1,j2} );
+
+        // T12 := V1[j1:j2,:]^H
+        for( idx_t j = 0; j < n-n1; ++j )
+            for( idx_t i = 0; i < n1; ++i )
+                T12(i,j) = conj( A(j1+j,j0+i) );
+
+        // T12 := T12 V2[j1:j2,:], where V2[j1:j2,:] is unit lower triangular
+        trmm(
+            Side::Right, Uplo::Lower,
+            Op::NoTrans, Diag::Unit,
+            one, submatrix( A, pair{j1,j2}, pair{j1,j2} ), T12 );
+
+        // T12 := T12 + V1[j2:m,:]^H V2[j2:m,:]
+        if( m > j2 )
+            gemm(
+                Op::ConjTrans, Op::NoTrans,
+                one, submatrix( A, pair{j2,m}, pair{j0,j1} ),
+                     submatrix( A, pair{j2,m}, pair{j1,j2} ),
+                one, T12 );
+
+        // T12 := - T11 T12 T22
+        trmm(
+            Side::Left, Uplo::Upper,
+            Op::NoTrans, Diag::NonUnit,
+            -one, T11, T12 );
+        trmm(
+            Side::Right, Uplo::Upper,
+            Op::NoTrans, Diag::NonUnit,
+            one, T22, T12 );
+    }
+}
+
+} // namespace internal
+
+/** Computes a QR factorization of a m-by-n matrix A, m >= n, using the
+ * recursive algorithm of Elmroth and Gustavson.
+ *
+ * The columns of A are split in halves down to a small base case,
+ * factored by `lapack::geqr2` and `lapack::larft`. The left half is applied
+ * to the right half with `lapack::larfb` and the triangular factor T of the
+ * compact WY representation
+ * \[
+ *          Q = H_1 H_2 ... H_n = I - V T V^H
+ * \]
+ * is assembled from the factors of both halves. Thus, almost all flops are
+ * done in trmm and gemm, including those of the panel of a tall matrix.
+ *
+ * The output in A and tau is the same as the one of `lapack::geqr2`, so it
+ * can be used by `lapack::org2r` and `lapack::unmqr`.
+ *
+ * @return  0 if success
+ * @return -i if the ith argument is invalid
+ *
+ * @param[in,out] A m-by-n matrix, m >= n.
+ *      On exit, the elements on and above the diagonal of the array
+ *      contain the n-by-n upper triangular matrix R; the elements below
+ *      the diagonal, with the array tau, represent the unitary matrix Q as a
+ *      product of elementary reflectors.
+ * @param[out] tau Vector of length n.
+ *      The scalar factors of the elementary reflectors.
+ * @param[out] T n-by-n matrix.
+ *      On exit, the upper triangular factor T of the block reflector.
+ *      The strictly lower part of T is not referenced.
+ *
+ * @see geqr2( matrix_t& A, vector_t &tau, work_t &work )
+ *
+ * @ingroup geqrf
+ */
+template< class matrix_t, class vector_t, class matrixT_t >
+int geqrt3( matrix_t& A, vector_t &tau, matrixT_t& T )
+{
+    using idx_t = size_type< matrix_t >;
+
+    // constants
+    const idx_t m = nrows(A);
+    const idx_t n = ncols(A);
+
+    // check arguments
+    lapack_error_if( m < n, -1 );
+    lapack_error_if( idx_t(size(tau)) < n, -2 );
+    lapack_error_if( nrows(T) < n || ncols(T) < n, -3 );
+
+    // quick return
+    if (n <= 0) return 0;
+
+    internal::geqrt3_recursive( A, tau, T, idx_t(0), n );
+
+    return 0;
+}
+
+} // lapack
+
+#endif // __GEQRT3_HH__
@@ -0,0 +1,197 @@
+/// @file getrf.hpp Computes an LU factorization of a general matrix A using partial pivoting with row interchanges.
+//
+// Copyright (c) 2021, University of Colorado Denver. All rights reserved.
+//
+// This file is part of <T>LAPACK.
+// <T>LAPACK is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef __GETRF_HH__
+#define __GETRF_HH__
+
+#include "lapack/types.hpp"
+#include "lapack/utils.hpp"
+#include "lapack/laswp.hpp"
+#include "tblas.hpp"
+
+namespace lapack {
+
+namespace internal {
+
+/** Factors the panel A[j0:m,j0:j0+n] using the recursive algorithm.
+ *
+ * On exit, piv[j0:j0+min(m-j0,n)] holds the pivots relative to the row j0.
+ * The recursion is done on the indices so that A and piv keep their types
+ * across the recursive calls.
+ *
+ * @see getrf( matrix_t& A, vector_t& piv )
+ */
+template< class matrix_t, class vector_t >
+int getrf_recursive(
+    matrix_t& A, vector_t& piv,
+    size_type< matrix_t > j0, size_type< matrix_t > n )
+{
+    using T      = type_t< matrix_t >;
+    using real_t = blas::real_type<T>;
+    using idx_t  = size_type< matrix_t >;
+    using pair   = std::pair<idx_t,idx_t>;
+
+    using blas::trsm;
+    using blas::gemm;
+    using blas::iamax;
+    using blas::scal;
+    using blas::abs;
+    using blas::safe_min;
+    using std::swap;
+
+    // Constants
+    const T one( 1.0 );
+    const T zero( 0.0 );
+    const real_t sfmin = safe_min<real_t>();
+    const idx_t m  = nrows(A);
+    const idx_t mp = m - j0;
+    const idx_t j2 = j0 + n;
+
+    // Stop recursion: one row
+    if (mp == 1) {
+        piv[j0] = 0;
+        return ( A(j0,j0) == zero ) ? 1 : 0;
+    }
+
+    // Stop recursion: one column
+    if (n == 1) {
+        auto x = subvector( col( A, j0 ), pair{j0,m} );
+        const idx_t i = iamax( x );
+        piv[j0] = i;
+        if( x[i] == zero )
+            return 1;
+
+        if( i != 0 )
+            swap( x[0], x[i] );
+
+        // Compute the elements of L
+        auto l = subvector( x, pair{1,mp} );
+        if( abs( x[0] ) >= sfmin )
+            scal( one / x[0], l );
+        else
+            for(idx_t k = 0; k < mp-1; ++k)
+                l[k] /= x[0];
+
+        return 0;
+    }
+
+    // Recursive code
+    const idx_t n1 = ( (mp < n) ? mp : n ) / 2;
+    const idx_t n2 = n - n1;
+    const idx_t j1 = j0 + n1;
+
+    // Factor [ A11; A21 ]
+    int info = getrf_recursive( A, piv, j0, n1 );
+
+    // Apply the interchanges to [ A12; A22 ]
+    {
+        auto A2 = submatrix( A, pair{j0,m}, pair{j1,j2} );
+        laswp( forward, A2, subvector( piv, pair{j0,j1} ) );
+    }
+
+    // A12 := L11^{-1} A12 and A22 := A22 - A21 A12
+    const auto A11 = submatrix( A, pair{j0,j1}, pair{j0,j1} );
+    const auto A21 = submatrix( A, pair{j1,m}, pair{j0,j1} );
+    auto A12 = submatrix( A, pair{j0,j1}, pair{j1,j2} );
+    auto A22 = submatrix( A, pair{j1,m}, pair{j1,j2} );
+    trsm(
+        Side::Left, Uplo::Lower,
+        Op::NoTrans, Diag::Unit,
+        one, A11, A12 );
+    gemm(
+        Op::NoTrans, Op::NoTrans,
+        -one, A21, A12, one, A22 );
+
+    // Factor A22
+    const int info2 = getrf_recursive( A, piv, j1, n2 );
+    if( info == 0 && info2 > 0 )
+        info = info2 + n1;
+
+    // Apply the interchanges to A21 and make the pivots relative to j0
+    {
+        const idx_t k2 = ( (m-j1 < n2) ? m-j1 : n2 );
+        auto piv2 = subvector( piv, pair{j1,j1+k2} );
+        auto A1 = submatrix( A, pair{j1,m}, pair{j0,j1} );
+        laswp( forward, A1, piv2 );
+        for(idx_t i = 0; i < k2; ++i)
+            piv2[i] += n1;
+    }
+
+    return info;
+}
+
+} // namespace internal
+
+/** Computes an LU factorization of a general m-by-n matrix A using partial
+ * pivoting with row interchanges.
+ *
+ * The factorization has the form
+ * \[
+ *     A = P L U
+ * \]
+ * where P is a permutation matrix, L is lower triangular with unit diagonal
+ * elements (lower trapezoidal if m > n), and U is upper triangular (upper
+ * trapezoidal if m < n).
+ *
+ * This is the recursive version of the algorithm. It divides the matrix
+ * into four submatrices:
+ * \[
+ *     A = \begin{bmatrix}
+ *             A_{11}  &  A_{12}
+ *         \\  A_{21}  &  A_{22}
+ *     \end{bmatrix}
+ * \]
+ * where $A_{11}$ is n1-by-n1 and $A_{22}$ is (m-n1)-by-n2,
+ * with n1 = min(m,n)/2 and n2 = n-n1.
+ * The subroutine calls itself to factor $[ A_{11}; A_{21} ],$
+ * applies the interchanges and solves for $A_{12}$ with trsm,
+ * updates $A_{22}$ with gemm,
+ * calls itself to factor $A_{22}$
+ * and applies its interchanges to $A_{21}.$
+ *
+ * @return = 0: successful exit
+ * @return > 0: if return value = i, U(i-1,i-1) is exactly zero. The
+ *     factorization has been completed, but the factor U is exactly
+ *     singular, and division by zero will occur if it is used to solve a
+ *     system of equations.
+ *
+ * @param[in,out] A m-by-n matrix.
+ *      On entry, the matrix A to be factored.
+ *      On exit, the factors L and U from the factorization $A = P L U$;
+ *      the unit diagonal elements of L are not stored.
+ * @param[out] piv Vector of length min(m,n).
+ *      The pivot indices: for 0 <= i < min(m,n), the row i of the matrix
+ *      was interchanged with the row piv[i].
+ *
+ * @see laswp( direction_t direction, matrix_t& A, const vector_t& piv )
+ * @see getrs( trans_t trans, const matrix_t& A, const vector_t& piv, matrixB_t& B )
+ *
+ * @ingroup gesv_computational
+ */
+template< class matrix_t, class vector_t >
+int getrf( matrix_t& A, vector_t& piv )
+{
+    using idx_t = size_type< matrix_t >;
+
+    // Constants
+    const idx_t m = nrows(A);
+    const idx_t n = ncols(A);
+
+    // Check arguments
+    lapack_error_if( idx_t(size(piv)) < ( (m < n) ? m : n ), -2 );
+
+    // Quick return
+    if (m == 0 || n == 0)
+        return 0;
+
+    return internal::getrf_recursive( A, piv, idx_t(0), n );
+}
+
+} // lapack
+
+#endif // __GETRF_HH__
@@ -0,0 +1,268 @@
+/// @file getrf_calu.hpp Computes an LU factorization of a tall matrix using tournament pivoting.
+//
+// Copyright (c) 2021, University of Colorado Denver. All rights reserved.
+//
+// This file is part of <T>LAPACK.
+// <T>LAPACK is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef __GETRF_CALU_HH__
+#define __GETRF_CALU_HH__
+
+#include "lapack/types.hpp"
+#include "lapack/utils.hpp"
+#include "lapack/lacpy.hpp"
+#include "lapack/laswp.hpp"
+#include "lapack/getrf.hpp"
+#include "blas/parallel.hpp"
+#include "tblas.hpp"
+
+#include <vector>
+
+namespace lapack {
+
+namespace internal {
+
+/// Vector of pivot indices over memory owned by the caller
+template< class idx_t >
+struct pivot_vector {
+    idx_t* ptr;
+    idx_t  n;
+    idx_t& operator[]( idx_t i ) const { return ptr[i]; }
+};
+
+template< class idx_t >
+inline idx_t size( const pivot_vector<idx_t>& v ) { return v.n; }
+
+template< class idx_t, class SliceSpec >
+inline pivot_vector<idx_t> subvector( const pivot_vector<idx_t>& v, SliceSpec&& rows )
+{
+    return pivot_vector<idx_t>{ v.ptr + rows.first, idx_t( rows.second - rows.first ) };
+}
+
+} // namespace internal
+
+/** Computes an LU factorization of a tall m-by-n matrix A, m >= n, using
+ * tournament pivoting (CALU).
+ *
+ * The factorization has the same form as the one of `lapack::getrf`,
+ * $A = P L U$, but the n pivot rows are chosen by a reduction tree instead
+ * of column by column:
+ *
+ * 1. The rows of A are split in P row-blocks, where P = ncols(W)/n. Each
+ *    row-block selects n candidate rows with `lapack::getrf`, in chunks
+ *    that fit in its part of W. The row-blocks are processed in parallel.
+ * 2. The candidates are merged pairwise in a binary tree: at each node,
+ *    `lapack::getrf` on the 2n candidates of two row-blocks selects n of
+ *    them. The nodes of each level are processed in parallel.
+ * 3. The n selected rows are moved to the top of A and factored, and the
+ *    rest of L is computed with trsm.
+ *
+ * Thus, the panel synchronizes O(log P) times instead of once per column,
+ * and every selection is done by the recursive `lapack::getrf`, which uses
+ * `blas::iamax` at its leaves. The factorization is as stable as partial
+ * pivoting in practice, but not identical to it.
+ *
+ * The rows of A are never copied except for the candidate rows, which are
+ * gathered in W. If P <= 1, `lapack::getrf` is called.
+ *
+ * @return = 0: successful exit
+ * @return -i if the ith argument is invalid
+ * @return > 0: if return value = i, U(i-1,i-1) is exactly zero.
+ *
+ * @param[in,out] A m-by-n matrix, m >= n.
+ *      On exit, the factors L and U from the factorization $A = P L U$;
+ *      the unit diagonal elements of L are not stored.
+ * @param[out] piv Vector of length n.
+ *      The pivot indices: for 0 <= i < n, the row i of the matrix was
+ *      interchanged with the row piv[i].
+ * @param W mw-by-(P*n) workspace, mw >= 2n.
+ *      The number of columns of W defines the number of row-blocks P.
+ *      Each row-block factors up to mw rows at once.
+ *
+ * @see getrf( matrix_t& A, vector_t& piv )
+ *
+ * @ingroup gesv_computational
+ */
+template< class matrix_t, class vector_t, class matrixW_t >
+int getrf_calu( matrix_t& A, vector_t& piv, matrixW_t& W )
+{
+    using T     = type_t< matrix_t >;
+    using idx_t = size_type< matrix_t >;
+    using pair  = std::pair<idx_t,idx_t>;
+    using blas::internal::parallel_for;
+    using blas::internal::num_threads_for;
+    using blas::trsm;
+    using std::min;
+    using std::swap;
+
+    // Constants
+    const T one( 1.0 );
+    const idx_t m = nrows(A);
+    const idx_t n = ncols(A);
+
+    // Check arguments
+    lapack_error_if( m < n, -1 );
+    lapack_error_if( idx_t(size(piv)) < n, -2 );
+    lapack_error_if( n > 0 && idx_t(nrows(W)) < 2*n, -3 );
+
+    // Quick return
+    if (n == 0)
+        return 0;
+
+    // Each row-block must have at least n rows
+    const idx_t mw = nrows(W);
+    const idx_t P  = min<idx_t>( ncols(W) / n, m / n );
+    if( P <= 1 )
+        return getrf( A, piv );
+
+    const int nt = num_threads_for( 2.0 * m * n * n );
+
+    // Row indices of the candidates of each row-block, and pivots of the
+    // selections of each row-block
+    std::vector< idx_t > cand( P*mw );
+    std::vector< idx_t > pivots( P*n );
+
+    // Selects the best rows among the k candidates of row-block b using the
+    // LU factorization of a copy of them. On exit, the winners are the first
+    // min(k,n) candidates, in pivot order.
+    auto select = [&]( idx_t b, idx_t k ) {
+        idx_t* idx = &cand[b*mw];
+        auto Wb = submatrix( W, pair{0,k}, pair{b*n,(b+1)*n} );
+        for(idx_t j = 0; j < n; ++j)
+            for(idx_t i = 0; i < k; ++i)
+                Wb(i,j) = A(idx[i],j);
+
+        internal::pivot_vector<idx_t> pv{ &pivots[b*n], min<idx_t>( k, n ) };
+        getrf( Wb, pv );
+        for(idx_t i = 0; i < size(pv); ++i)
+            swap( idx[i], idx[ pv[i] ] );
+
+        return size(pv);
+    };
+
+    // Leaves: each row-block reduces its rows to n candidates, mw rows at
+    // a time
+    parallel_for( P, nt, [&]( std::size_t s ) {
+        const idx_t b  = idx_t(s);
+        const idx_t mb = m / P;
+        const idx_t r1 = ( b+1 < P ) ? (b+1)*mb : m;
+        idx_t* idx = &cand[b*mw];
+        idx_t ncand = 0;
+        for(idx_t r = b*mb; r < r1; ) {
+            const idx_t c = min<idx_t>( mw - ncand, r1 - r );
+            for(idx_t i = 0; i < c; ++i)
+                idx[ncand+i] = r+i;
+            ncand = select( b, ncand + c );
+            r += c;
+        }
+    });
+
+    // Tournament: at each level, the candidates of row-block b+step play
+    // against the ones of b
+    for(idx_t step = 1; step < P; step *= 2) {
+        const idx_t nnodes = (P - step + 2*step-1) / (2*step);
+        parallel_for( nnodes, nt, [&]( std::size_t p ) {
+            const idx_t b = 2*step*idx_t(p);
+            for(idx_t i = 0; i < n; ++i)
+                cand[b*mw + n+i] = cand[(b+step)*mw + i];
+            select( b, 2*n );
+        });
+    }
+
+    // Factor the winners. The pivots of this factorization reorder them.
+    const auto U11 = submatrix( W, pair{0,n}, pair{0,n} );
+    {
+        auto W0 = submatrix( W, pair{0,n}, pair{0,n} );
+        for(idx_t j = 0; j < n; ++j)
+            for(idx_t i = 0; i < n; ++i)
+                W0(i,j) = A(cand[i],j);
+        internal::pivot_vector<idx_t> pv{ &pivots[0], n };
+        if( getrf( W0, pv ) != 0 ) {
+            // An exact zero pivot was found among the best rows
+            return getrf( A, piv );
+        }
+        for(idx_t i = 0; i < n; ++i)
+            swap( cand[i], cand[ pv[i] ] );
+    }
+
+    // Interchanges that bring the winners to the top, in order. top[i] is
+    // the row of A currently at the position i < n, and moved holds the
+    // positions >= n that received a row from the top.
+    {
+        std::vector< idx_t > top( n );
+        std::vector< pair > moved;
+        for(idx_t i = 0; i < n; ++i)
+            top[i] = i;
+
+        for(idx_t i = 0; i < n; ++i) {
+            // Find the current position p of the row w
+            const idx_t w = cand[i];
+            idx_t p = n;
+            for(idx_t k = i; k < n; ++k)
+                if( top[k] == w ) { p = k; break; }
+            if( p == n ) {
+                p = w;
+                for( auto& e : moved )
+                    if( e.second == w ) { p = e.first; break; }
+            }
+
+            piv[i] = p;
+            if( p < n )
+                swap( top[i], top[p] );
+            else {
+                bool found = false;
+                for( auto& e : moved )
+                    if( e.first == p ) { e.second = top[i]; found = true; break; }
+                if( !found )
+                    moved.push_back( pair{ p, top[i] } );
+                top[i] = w;
+            }
+        }
+    }
+    laswp( forward, A, subvector( piv, pair{0,n} ) );
+
+    // A11 := L11 \ U11, and A21 := A21 U11^{-1} by row-blocks of mb rows,
+    // so that each solve works on a block that stays in cache
+    {
+        auto A11 = submatrix( A, pair{0,n}, pair{0,n} );
+        lacpy( general_matrix, U11, A11 );
+    }
+    const idx_t mb = 256;
+    parallel_for( (m-n + mb-1) / mb, nt, [&]( std::size_t s ) {
+        const idx_t r0 = n + idx_t(s) * mb;
+        auto A21 = submatrix( A, pair{ r0, min<idx_t>( r0+mb, m ) }, pair{0,n} );
+        trsm(
+            Side::Right, Uplo::Upper,
+            Op::NoTrans, Diag::NonUnit,
+            one, U11, A21 );
+    });
+
+    return 0;
+}
+
+/** Workspace query for `lapack::getrf_calu`.
+ *
+ * @param[in] P Number of row-blocks.
+ * @param[in] mw Number of rows each row-block factors at once, mw >= 2n.
+ *
+ * @return A mw-by-(P*n) matrix, where A is m-by-n.
+ *
+ * @see getrf_calu( matrix_t& A, vector_t& piv, matrixW_t& W )
+ *
+ * @ingroup gesv_computational
+ */
+template< class matrix_t, class vector_t >
+inline workinfo_t getrf_calu_worksize(
+    const matrix_t& A, const vector_t&,
+    size_type< matrix_t > P, size_type< matrix_t > mw = 0 )
+{
+    using idx_t = size_type< matrix_t >;
+    const idx_t n = ncols(A);
+    return make_workinfo< type_t<matrix_t> >(
+        ( mw > 2*n ) ? mw : 2*n, P*n );
+}
+
+} // lapack
+
+#endif // __GETRF_CALU_HH__
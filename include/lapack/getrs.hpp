@@ -0,0 +1,111 @@
+/// @file getrs.hpp Solves a system of linear equations using the LU factorization computed by getrf.
+//
+// Copyright (c) 2021, University of Colorado Denver. All rights reserved.
+//
+// This file is part of <T>LAPACK.
+// <T>LAPACK is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef __GETRS_HH__
+#define __GETRS_HH__
+
+#include "lapack/types.hpp"
+#include "lapack/utils.hpp"
+#include "lapack/laswp.hpp"
+#include "tblas.hpp"
+
+namespace lapack {
+
+/** Solves a system of linear equations
+ * \[
+ *     op(A) X = B,
+ * \]
+ * with a general n-by-n matrix A using the LU factorization computed by
+ * `lapack::getrf`. The nrhs right-hand sides are solved at once with
+ * Level 3 BLAS.
+ *
+ * @return  0 if success
+ * @return -i if the ith argument is invalid
+ *
+ * @param[in] trans
+ *     - lapack::noTranspose:   $A X = B$;
+ *     - lapack::transpose:     $A^T X = B$;
+ *     - lapack::conjTranspose: $A^H X = B$.
+ * @param[in] A n-by-n matrix.
+ *      The factors L and U from the factorization $A = P L U$ as computed
+ *      by `lapack::getrf`.
+ * @param[in] piv Vector of length n.
+ *      The pivot indices from `lapack::getrf`.
+ * @param[in,out] B n-by-nrhs matrix.
+ *      On entry, the right hand side matrix B.
+ *      On exit, the solution matrix X.
+ *
+ * @see getrf( matrix_t& A, vector_t& piv )
+ *
+ * @ingroup gesv_computational
+ */
+template< class trans_t, class matrix_t, class vector_t, class matrixB_t,
+    enable_if_t<(
+    /* Requires: */
+        is_same_v< trans_t, noTranspose_t > ||
+        is_same_v< trans_t, transpose_t > ||
+        is_same_v< trans_t, conjTranspose_t >
+    ), int > = 0
+>
+int getrs( trans_t trans, const matrix_t& A, const vector_t& piv, matrixB_t& B )
+{
+    using T     = type_t< matrixB_t >;
+    using idx_t = size_type< matrix_t >;
+
+    using blas::trsm;
+
+    // Constants
+    const T one( 1.0 );
+    const idx_t n = nrows(A);
+
+    // Check arguments
+    lapack_error_if( ncols(A) != n, -2 );
+    lapack_error_if( idx_t(size(piv)) < n, -3 );
+    lapack_error_if( idx_t(nrows(B)) != n, -4 );
+
+    // Quick return
+    if (n == 0 || ncols(B) == 0)
+        return 0;
+
+    if( is_same_v< trans_t, noTranspose_t > ) {
+
+        // B := P^T B
+        laswp( forward, B, subvector( piv, std::pair<idx_t,idx_t>{0,n} ) );
+
+        // B := L^{-1} B and B := U^{-1} B
+        trsm(
+            Side::Left, Uplo::Lower,
+            Op::NoTrans, Diag::Unit,
+            one, A, B );
+        trsm(
+            Side::Left, Uplo::Upper,
+            Op::NoTrans, Diag::NonUnit,
+            one, A, B );
+    }
+    else {
+
+        // B := U^{-T} B and B := L^{-T} B
+        trsm(
+            Side::Left, Uplo::Upper,
+            trans, Diag::NonUnit,
+            one, A, B );
+        trsm(
+            Side::Left, Uplo::Lower,
+            trans, Diag::Unit,
+            one, A, B );
+
+        // B := P B
+        laswp( backward, B, subvector( piv, std::pair<idx_t,idx_t>{0,n} ) );
+    }
+
+    return 0;
+}
+
+} // lapack
+
+#endif // __GETRS_HH__
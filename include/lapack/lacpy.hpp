@@ -12,9 +12,72 @@
 #define __LACPY_HH__
 
 #include "lapack/types.hpp"
+#include "blas/storage.hpp"
 
 namespace lapack {
 
+namespace internal {
+
+using blas::internal::storage_kind;
+
+/// Copies the part uplo of the m-by-n column-major matrix A to B
+template< class idx_t, class TA, class TB >
+void lacpy_colmajor(
+    Uplo uplo, idx_t m, idx_t n,
+    const TA* A, idx_t lda, TB* B, idx_t ldb )
+{
+    for (idx_t j = 0; j < n; ++j) {
+        const idx_t i0 = ( uplo == Uplo::Lower ) ? std::min( m, j ) : 0;
+        const idx_t i1 = ( uplo == Uplo::Upper ) ? std::min( m, j+1 ) : m;
+        const TA* Aj = A + j*lda;
+        TB* Bj = B + j*ldb;
+        for (idx_t i = i0; i < i1; ++i)
+            Bj[i] = Aj[i];
+    }
+}
+
+/** Copies A to B on raw pointers if both are column major or both are row
+ * major. A row-major matrix is the column-major storage of its transpose,
+ * whose upper part is the lower part of the matrix.
+ * Returns false, and does nothing, otherwise.
+ */
+template< class matrixA_t, class matrixB_t,
+    enable_if_t<(
+        blas::internal::has_storage< matrixA_t >::value &&
+        blas::internal::has_storage< matrixB_t >::value
+    ), int > = 0 >
+bool lacpy_strided( Uplo uplo, const matrixA_t& A, matrixB_t& B )
+{
+    using blas::internal::storage_of;
+    using blas::internal::storage_data;
+    using blas::internal::storage_ld;
+    using idx_t = size_type< matrixA_t >;
+
+    const storage_kind kind = storage_of(A);
+    if( kind == storage_kind::general || storage_of(B) != kind )
+        return false;
+
+    idx_t m = nrows(A);
+    idx_t n = ncols(A);
+    if( kind == storage_kind::rowmajor ) {
+        std::swap( m, n );
+        uplo = ( uplo == Uplo::Upper ) ? Uplo::Lower
+             : ( uplo == Uplo::Lower ) ? Uplo::Upper
+             :                           uplo;
+    }
+
+    lacpy_colmajor( uplo, m, n,
+        storage_data(A), idx_t( storage_ld( A, kind ) ),
+        storage_data(B), idx_t( storage_ld( B, kind ) ) );
+
+    return true;
+}
+
+template< class... Ts >
+inline constexpr bool lacpy_strided( const Ts&... ) { return false; }
+
+} // namespace internal
+
 /** Copies a real matrix from A to B where A is either a full, upper triangular or lower triangular matrix.
  *
  * @param[in] uplo Specifies whether the matrix A is upper or lower triangular:
@@ -48,6 +111,10 @@ void lacpy( uplo_t uplo, const matrixA_t& A, matrixB_t& B )
     const idx_t m = nrows(A);
     const idx_t n = ncols(A);
 
+    // raw pointers on column- or row-major storage
+    if( internal::lacpy_strided( Uplo(uplo), A, B ) )
+        return;
+
     if( is_same_v< uplo_t, upper_triangle_t > ) {
         // Set the strictly upper triangular or trapezoidal part of B
         for (idx_t j = 0; j < n; ++j) {
@@ -89,6 +89,23 @@ inline void larf(
     }
 }
 
+/** Workspace query for `lapack::larf`.
+ *
+ * @return A vector of length n if side = left_side, and of length m
+ *         otherwise, where C is m-by-n.
+ *
+ * @see larf( side_t side, vector_t const& v, tau_t& tau, matrix_t& C, work_t& work )
+ *
+ * @ingroup auxiliary
+ */
+template< class side_t, class vector_t, class tau_t, class matrix_t >
+inline workinfo_t larf_worksize(
+    side_t, vector_t const&, const tau_t&, const matrix_t& C )
+{
+    return make_workinfo< type_t<matrix_t> >(
+        is_same_v<side_t,left_side_t> ? ncols(C) : nrows(C) );
+}
+
 } // lapack
 
 #endif // __LARF_HH__
@@ -525,6 +525,29 @@ int larfb(
     return 0;
 }
 
+/** Workspace query for `lapack::larfb`.
+ *
+ * @return A k-by-n matrix if side = left_side, and an m-by-k matrix
+ *         otherwise, where C is m-by-n and T is k-by-k.
+ *
+ * @see larfb( side_t side, trans_t trans, direction_t direction, storage_t storeMode, const matrixV_t& V, const matrixT_t& T, matrixC_t& C, matrixW_t& W )
+ *
+ * @ingroup auxiliary
+ */
+template<
+    class matrixV_t, class matrixT_t, class matrixC_t,
+    class side_t, class trans_t, class direction_t, class storage_t >
+inline workinfo_t larfb_worksize(
+    side_t, trans_t, direction_t, storage_t,
+    const matrixV_t&, const matrixT_t& T, const matrixC_t& C )
+{
+    using W_t = type_t< matrixC_t >;
+    const std::size_t k = nrows(T);
+    return is_same_v< side_t, left_side_t >
+        ? make_workinfo<W_t>( k, ncols(C) )
+        : make_workinfo<W_t>( nrows(C), k );
+}
+
 }
 
 #endif // __LARFB_HH__
@@ -13,9 +13,196 @@
 
 #include "lapack/types.hpp"
 #include "lapack/utils.hpp"
+#include "blas/storage.hpp"
 
 namespace lapack {
 
+namespace internal {
+
+using blas::internal::storage_kind;
+
+/// Multiplies the entries A(i,j), j-ku <= i <= j+kl, of the m-by-n
+/// column-major matrix A by c
+template< class idx_t, class T, class real_t >
+void lascl_colmajor(
+    idx_t m, idx_t n, idx_t kl, idx_t ku,
+    const real_t& c, T* A, idx_t lda )
+{
+    for (idx_t j = 0; j < n; ++j) {
+        const idx_t i0 = ( j > ku ) ? j - ku : 0;
+        const idx_t i1 = std::min( m, j + kl + 1 );
+        T* Aj = A + j*lda;
+        for (idx_t i = i0; i < i1; ++i)
+            Aj[i] *= c;
+    }
+}
+
+/** Multiplies the entries A(i,j), j-ku <= i <= j+kl, by c on raw pointers
+ * if A is column or row major. The transpose of a row-major matrix is column
+ * major, and its bandwidths are swapped.
+ * Returns false, and does nothing, otherwise.
+ */
+template< class matrix_t, class idx_t, class real_t,
+    enable_if_t< blas::internal::has_storage< matrix_t >::value, int > = 0 >
+bool lascl_strided( idx_t kl, idx_t ku, const real_t& c, matrix_t& A )
+{
+    using blas::internal::storage_of;
+    using blas::internal::storage_data;
+    using blas::internal::storage_ld;
+
+    const storage_kind kind = storage_of(A);
+    if( kind == storage_kind::general )
+        return false;
+
+    idx_t m = nrows(A);
+    idx_t n = ncols(A);
+    if( kind == storage_kind::rowmajor ) {
+        std::swap( m, n );
+        std::swap( kl, ku );
+    }
+
+    lascl_colmajor( m, n, kl, ku,
+        c, storage_data(A), idx_t( storage_ld( A, kind ) ) );
+
+    return true;
+}
+
+template< class... Ts >
+inline constexpr bool lascl_strided( const Ts&... ) { return false; }
+
+/// Multiplies the entries A(i,j), j-ku <= i <= j+kl, of A by c
+template< class matrix_t, class real_t >
+void lascl_band(
+    size_type< matrix_t > kl, size_type< matrix_t > ku,
+    const real_t& c, matrix_t& A )
+{
+    using idx_t = size_type< matrix_t >;
+
+    if( lascl_strided( kl, ku, c, A ) )
+        return;
+
+    const idx_t m = nrows(A);
+    const idx_t n = ncols(A);
+    for (idx_t j = 0; j < n; ++j) {
+        const idx_t i0 = ( j > ku ) ? j - ku : 0;
+        const idx_t i1 = std::min( m, j + kl + 1 );
+        for (idx_t i = i0; i < i1; ++i)
+            A(i,j) *= c;
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Scaling by c of each type of matrix
+
+template< class matrix_t, class real_t >
+inline void lascl_scale(
+    general_matrix_t, const real_t& c, matrix_t& A )
+{
+    lascl_band( nrows(A), ncols(A), c, A );
+}
+
+template< class matrix_t, class real_t >
+inline void lascl_scale(
+    lower_triangle_t, const real_t& c, matrix_t& A )
+{
+    lascl_band( nrows(A), 0, c, A );
+}
+
+template< class matrix_t, class real_t >
+inline void lascl_scale(
+    upper_triangle_t, const real_t& c, matrix_t& A )
+{
+    lascl_band( 0, ncols(A), c, A );
+}
+
+template< class matrix_t, class real_t >
+inline void lascl_scale(
+    hessenberg_matrix_t, const real_t& c, matrix_t& A )
+{
+    lascl_band( 1, ncols(A), c, A );
+}
+
+template< class matrix_t, class real_t >
+void lascl_scale(
+    symmetric_lowerband_t matrixtype, const real_t& c, matrix_t& A )
+{
+    using idx_t = size_type< matrix_t >;
+
+    const idx_t n = ncols(A);
+    const idx_t k = matrixtype.bandwidth;
+    for (idx_t j = 0; j < n; ++j)
+        for (idx_t i = 0; (i <= k) && (i < n - j); ++i)
+            A(i,j) *= c;
+}
+
+template< class matrix_t, class real_t >
+void lascl_scale(
+    symmetric_upperband_t matrixtype, const real_t& c, matrix_t& A )
+{
+    using idx_t = size_type< matrix_t >;
+
+    const idx_t n = ncols(A);
+    const idx_t k = matrixtype.bandwidth;
+    for (idx_t j = 0; j < n; ++j)
+        for (idx_t i = ( j < k ) ? k - j : 0; i <= k; ++i)
+            A(i,j) *= c;
+}
+
+template< class matrix_t, class real_t >
+void lascl_scale(
+    band_matrix_t matrixtype, const real_t& c, matrix_t& A )
+{
+    using idx_t = size_type< matrix_t >;
+
+    const idx_t m = nrows(A);
+    const idx_t n = ncols(A);
+    const idx_t kl = matrixtype.lower_bandwidth;
+    const idx_t ku = matrixtype.upper_bandwidth;
+
+    // Row kl+ku+i-j of the band storage has the entry (i,j) of the matrix
+    for (idx_t j = 0; j < n; ++j) {
+        const idx_t i0 = ( j < ku ) ? kl + ku - j : kl;
+        const idx_t i1 = ( j < kl + ku + m )
+            ? std::min( 2*kl + ku + 1, kl + ku + m - j )
+            : 0;
+        for (idx_t i = i0; i < i1; ++i)
+            A(i,j) *= c;
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Invalid bandwidths of each type of matrix
+
+template< class sparse_t, class idx_t >
+inline constexpr bool lascl_invalid_bandwidth(
+    const sparse_t&, idx_t, idx_t ) { return false; }
+
+template< class idx_t >
+inline bool lascl_invalid_bandwidth(
+    const symmetric_lowerband_t& matrixtype, idx_t m, idx_t n )
+{
+    return (matrixtype.bandwidth + 1 > m && m > 0) ||
+           (matrixtype.bandwidth + 1 > n && n > 0);
+}
+
+template< class idx_t >
+inline bool lascl_invalid_bandwidth(
+    const symmetric_upperband_t& matrixtype, idx_t m, idx_t n )
+{
+    return (matrixtype.bandwidth + 1 > m && m > 0) ||
+           (matrixtype.bandwidth + 1 > n && n > 0);
+}
+
+template< class idx_t >
+inline bool lascl_invalid_bandwidth(
+    const band_matrix_t& matrixtype, idx_t m, idx_t n )
+{
+    return (matrixtype.lower_bandwidth + 1 > m && m > 0) ||
+           (matrixtype.upper_bandwidth + 1 > n && n > 0);
+}
+
+} // namespace internal
+
 /** @brief  Multiplies a matrix A by the real scalar a/b.
  *
  * Multiplication of a matrix A by scalar a/b is done without over/underflow as long as the final
@@ -72,8 +259,8 @@ template< class matrix_t, class a_type, class b_type, class sparse_t,
 >
 int lascl(
     sparse_t matrixtype,
-    const b_type& b, const a_type& a,
-    const matrix_t& A )
+    b_type b, a_type a,
+    matrix_t& A )
 {
     // data traits
     using idx_t  = size_type< matrix_t >;
@@ -90,31 +277,16 @@ int lascl(
     const idx_t n = ncols(A);
 
     // constants
-    const idx_t izero = 0;
-    const real_t zero = 0.0;
-    const real_t one(1.0);
     const real_t small = safe_min<real_t>();
     const real_t big   = safe_max<real_t>();
     
     // check arguments
-    if( is_same_v< sparse_t, symmetric_lowerband_t > ||
-        is_same_v< sparse_t, symmetric_upperband_t > )
-    {
-        lapack_error_if((matrixtype.bandwidth + 1 > m && m > 0) ||
-                        (matrixtype.bandwidth + 1 > n && n > 0), -1 );
-    }
-    else if( is_same_v< sparse_t, band_matrix_t > )
-    {
-        lapack_error_if((matrixtype.lower_bandwidth + 1 > m && m > 0) ||
-                        (matrixtype.upper_bandwidth + 1 > n && n > 0), -1 );
-    }
+    lapack_error_if( internal::lascl_invalid_bandwidth( matrixtype, m, n ), -1 );
     lapack_error_if( (b == b_type(0)) || isnan(b), -2 );
     lapack_error_if( isnan(a), -3 );
-    if( is_same_v< sparse_t, symmetric_lowerband_t > ||
-        is_same_v< sparse_t, symmetric_upperband_t > )
-    {
-        lapack_error_if( m != n, -4 );
-    }
+    lapack_error_if( (
+        is_same_v< sparse_t, symmetric_lowerband_t > ||
+        is_same_v< sparse_t, symmetric_upperband_t > ) && (m != n), -4 );
 
     // quick return
     if( m <= 0 || n <= 0 )
@@ -165,52 +337,7 @@ int lascl(
             }
         }
 
-        if ( is_same_v< sparse_t, general_matrix_t > )
-        {
-            for (idx_t j = 0; j < n; ++j)
-                for (idx_t i = 0; i < m; ++i)
-                    A(i,j) *= c;
-        }
-        else if ( is_same_v< sparse_t, lower_triangle_t > )
-        {
-            for (idx_t j = 0; j < n; ++j)
-                for (idx_t i = j; i < m; ++i)
-                    A(i,j) *= c;
-        }
-        else if ( is_same_v< sparse_t, general_matrix_t > )
-        {
-            for (idx_t j = 0; j < n; ++j)
-                for (idx_t i = 0; (i < m) && (i <= j); ++i)
-                    A(i,j) *= c;
-        }
-        else if ( is_same_v< sparse_t, hessenberg_matrix_t > )
-        {
-            for (idx_t j = 0; j < n; ++j)
-                for (idx_t i = 0; (i < m) && (i <= j + 1); ++i)
-                    A(i,j) *= c;
-        }
-        else if ( is_same_v< sparse_t, symmetric_lowerband_t > )
-        {
-            const idx_t k = matrixtype.bandwidth;
-            for (idx_t j = 0; j < n; ++j)
-                for (idx_t i = 0; (i <= k) && (i < n - j); ++i)
-                    A(i,j) *= c;
-        }
-        else if ( is_same_v< sparse_t, symmetric_upperband_t > )
-        {
-            const idx_t k = matrixtype.bandwidth;
-            for (idx_t j = 0; j < n; ++j)
-                for (idx_t i = max(k - j, izero); i <= k; ++i)
-                    A(i,j) *= c;
-        }
-        else if ( is_same_v< sparse_t, band_matrix_t > )
-        {
-            const idx_t kl = matrixtype.lower_bandwidth;
-            const idx_t ku = matrixtype.upper_bandwidth;
-            for (idx_t j = 0; j < n; ++j)
-                for (idx_t i = max(kl + ku - j, kl); i <= min(2 * kl + ku, kl + ku + m - j); ++i)
-                    A(i,j) *= c;
-        }
+        internal::lascl_scale( matrixtype, c, A );
     }
 
     return 0;
@@ -17,6 +17,7 @@
 
 #include "lapack/types.hpp"
 #include "lapack/utils.hpp"
+#include "blas/sumsq.hpp"
 
 namespace lapack {
 
@@ -39,6 +40,10 @@ namespace lapack {
  *    TINY*EPS -- tiniest representable number;
  *    HUGE     -- biggest representable number.
  * 
+ * Contiguous vectors of float and double use a vectorized kernel, which
+ * may give a result that differs in the last bits.
+ * @see blas::internal::sumsq_contiguous
+ * 
  * @param[in] n The number of elements to be used from the vector x.
  * @param[in] x Array of dimension $(1+(n-1)*\abs(incx))$.
  * @param[in] incx. The increment between successive values of the vector x.
@@ -98,15 +103,17 @@ void lassq(
     real_t amed = zero;
     real_t abig = zero;
 
-    for (idx_t i = 0; i < n; ++i)
-    {
-        real_t ax = blas::abs( x[i] );
-        if( ax > tbig )
-            abig += (ax*sbig) * (ax*sbig);
-        else if( ax < tsml ) {
-            if( abig == zero ) asml += (ax*ssml) * (ax*ssml);
-        } else
-            amed += ax * ax;
+    if( !blas::internal::sumsq_contiguous( x, asml, amed, abig ) ) {
+        for (idx_t i = 0; i < n; ++i)
+        {
+            real_t ax = blas::abs( x[i] );
+            if( ax > tbig )
+                abig += (ax*sbig) * (ax*sbig);
+            else if( ax < tsml ) {
+                if( abig == zero ) asml += (ax*ssml) * (ax*ssml);
+            } else
+                amed += ax * ax;
+        }
     }
 
     // Put the existing sum of squares into one of the accumulators
@@ -120,45 +127,7 @@ void lassq(
             amed += (scl * scl) * sumsq;
     }
 
-    // Combine abig and amed or amed and asml if
-    // more than one accumulator was used.
-
-    if( abig > zero ) {
-        // Combine abig and amed if abig > 0
-        if( amed > zero || isnan(amed) )
-            abig += (amed*sbig)*sbig;
-        scl = one / sbig;
-        sumsq = abig;
-    }
-    else if( asml > zero ) {
-        // Combine amed and asml if asml > 0
-        if( amed > zero || isnan(amed) ) {
-            
-            amed = sqrt(amed);
-            asml = sqrt(asml) / ssml;
-            
-            real_t ymin, ymax;
-            if( asml > amed ) {
-                ymin = amed;
-                ymax = asml;
-            } else {
-                ymin = asml;
-                ymax = amed;
-            }
-
-            scl = one;
-            sumsq = (ymax * ymax) * ( one + (ymin/ymax) * (ymin/ymax) );
-        }
-        else {
-            scl = one / ssml;
-            sumsq = asml;
-        }
-    }
-    else {
-        // Otherwise all values are mid-range or zero
-        scl = one;
-        sumsq = amed;
-    }
+    blas::internal::sumsq_combine( asml, amed, abig, scl, sumsq );
 }
 
 } // lapack
@@ -0,0 +1,82 @@
+/// @file laswp.hpp Performs a series of row interchanges on a matrix.
+//
+// Copyright (c) 2021, University of Colorado Denver. All rights reserved.
+//
+// This file is part of <T>LAPACK.
+// <T>LAPACK is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef __LASWP_HH__
+#define __LASWP_HH__
+
+#include "lapack/types.hpp"
+#include "lapack/utils.hpp"
+
+namespace lapack {
+
+/** Performs a series of row interchanges on a matrix A.
+ *
+ * For i = 0, 1, ..., k-1, where k = size(piv), the row i of A is
+ * interchanged with the row piv[i]. The interchanges are applied in
+ * increasing order of i if direction = forward, and in decreasing order
+ * if direction = backward.
+ *
+ * The columns of A are processed in blocks of 32, so that the rows being
+ * interchanged stay in cache while all the interchanges are applied to the
+ * block.
+ *
+ * @return  0 if success
+ * @return -i if the ith argument is invalid
+ *
+ * @param[in] direction
+ *     - lapack::forward:  apply the interchanges for i = 0, 1, ..., k-1;
+ *     - lapack::backward: apply the interchanges for i = k-1, ..., 1, 0.
+ * @param[in,out] A m-by-n matrix.
+ *      On exit, the permuted matrix.
+ * @param[in] piv Vector of length k <= m.
+ *      The row indices, with 0 <= piv[i] < m.
+ *
+ * @ingroup auxiliary
+ */
+template< class direction_t, class matrix_t, class vector_t,
+    enable_if_t<(
+    /* Requires: */
+        is_same_v< direction_t, forward_t > ||
+        is_same_v< direction_t, backward_t >
+    ), int > = 0
+>
+int laswp( direction_t /*direction*/, matrix_t& A, const vector_t& piv )
+{
+    using idx_t = size_type< matrix_t >;
+    using std::swap;
+
+    // constants
+    const idx_t nb = 32; // number of columns in a block
+    const idx_t m = nrows(A);
+    const idx_t n = ncols(A);
+    const idx_t k = size(piv);
+
+    // check arguments
+    lapack_error_if( k > m, -3 );
+
+    // quick return
+    if (n <= 0 || k <= 0) return 0;
+
+    for(idx_t j0 = 0; j0 < n; j0 += nb) {
+        const idx_t j1 = ( j0+nb < n ) ? j0+nb : n;
+        for(idx_t s = 0; s < k; ++s) {
+            const idx_t i = is_same_v< direction_t, forward_t > ? s : k-1-s;
+            const idx_t p = idx_t( piv[i] );
+            if( p != i ) {
+                for(idx_t j = j0; j < j1; ++j)
+                    swap( A(i,j), A(p,j) );
+            }
+        }
+    }
+
+    return 0;
+}
+
+} // lapack
+
+#endif // __LASWP_HH__
@@ -4,13 +4,18 @@
 // <T>LAPACK is free software: you can redistribute it and/or modify it under
 // the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
 
-#ifndef __TLAPACK_MDSPAN_HH__
-#define __TLAPACK_MDSPAN_HH__
+#ifndef __LAPACK_MDSPAN_HH__
+#define __LAPACK_MDSPAN_HH__
 
-#include <plugin/tlapack_mdspan> // Use mdspan for multidimensional arrays
+#include "plugins/tlapack_mdspan.hpp" // Use mdspan for multidimensional arrays
+#include "lapack/types.hpp"
 
 namespace lapack {
 
+using std::experimental::layout_stride;
+using std::experimental::default_accessor;
+using blas::is_convertible_v;
+
 // -----------------------------------------------------------------------------
 /** TiledLayout Tiled layout for mdspan.
  * 
@@ -83,6 +88,16 @@ struct TiledLayout {
             return extents_.extent(1) / col_tile_size_ + size_type((extents_.extent(1) % col_tile_size_) != 0);
         }
 
+        constexpr size_type
+        row_tile_size() const noexcept {
+            return row_tile_size_;
+        }
+
+        constexpr size_type
+        col_tile_size() const noexcept {
+            return col_tile_size_;
+        }
+
         constexpr size_type
         tile_size() const noexcept {
             return row_tile_size_ * col_tile_size_;
@@ -252,50 +267,6 @@ constexpr auto scale(
     );
 }
 
-template<
-    class scalar_t, class T, std::size_t... Exts, class LP, class AP, class otherScalar_t,
-    enable_if_t< is_same_v< AP, scaled_accessor<T,otherScalar_t> >
-    , bool > = true
->
-constexpr auto scale(
-    const scalar_t& alpha, 
-    const mdspan<T, std::experimental::extents<Exts...>, LP, AP>& A )
-{
-    const auto beta = alpha * A.accessor().scale();
-    using newAP = scaled_accessor<T,decltype(beta)>;
-    return mdspan<T, std::experimental::extents<Exts...>, LP, newAP>(
-        A.data(), A.mapping(), newAP( beta )
-    );
-}
-
-
-// -----------------------------------------------------------------------------
-/** Returns a submatrix from the input matrix
- * 
- * The submatrix uses the same data from the matrix A.
- * 
- * It uses the function `std::experimental::submdspan` from https://github.com/kokkos/mdspan
- * Currently, it only allows for contiguous ranges
- * 
- * @param[in] A             Matrix
- * @param[in] rows          Rows used from A.
- *      It accepts values that can be converted to
- *          - a size_t integer: reprents the index of the row to be used.
- *          - a std::pair(a,b): uses rows from a to b-1
- *          - a std::experimental::full_extent: uses all rows
- * @param[in] cols          Columns used from A.
- *      It accepts values that can be converted to
- *          - a size_t integer: reprents the index of the column to be used.
- *          - a std::pair(a,b): uses columns from a to b-1
- *          - a std::experimental::full_extent: uses all columns
- * 
- * @return Matrix<T>        submatrix
- */
-template< typename matrix_t, typename SliceSpecRow, typename SliceSpecCol >
-constexpr auto submatrix( const matrix_t& A, SliceSpecRow rows, SliceSpecCol cols ) noexcept {
-    return std::experimental::submdspan( A, rows, cols );
-}
-
 } // namespace lapack
 
-#endif // __TLAPACK_MDSPAN_HH__
\ No newline at end of file
+#endif // __LAPACK_MDSPAN_HH__
\ No newline at end of file
@@ -45,7 +45,7 @@ int org2r(
     const idx_t n = ncols(A);
 
     // check arguments
-    lapack_error_if( size(tau)  < std::min<idx_t>( m, n ), -2 );
+    lapack_error_if( size(tau)  < k, -2 );
     lapack_error_if( size(work) < n-1, -3 );
 
     // quick return
@@ -85,6 +85,22 @@ int org2r(
     return 0;
 }
 
+/** Workspace query for `lapack::org2r`.
+ *
+ * @return A vector of length n-1, where A is m-by-n.
+ *
+ * @see org2r( size_type< matrix_t > k, matrix_t& A, vector_t &tau, work_t &work )
+ *
+ * @ingroup geqrf
+ */
+template< class matrix_t, class vector_t >
+inline workinfo_t org2r_worksize(
+    size_type< matrix_t >, const matrix_t& A, const vector_t& )
+{
+    const std::size_t n = ncols(A);
+    return make_workinfo< type_t<matrix_t> >( (n > 0) ? n-1 : 0 );
+}
+
 }
 
 #endif // __ORG2R_HH__
@@ -86,6 +86,24 @@ int orm2r(
     return 0;
 }
 
+/** Workspace query for `lapack::orm2r`.
+ *
+ * @return A vector of length n if side = left_side, and of length m
+ *         otherwise, where C is m-by-n.
+ *
+ * @ingroup geqrf
+ */
+template<
+    class matrixA_t, class matrixC_t, class tau_t,
+    class side_t, class trans_t >
+inline workinfo_t orm2r_worksize(
+    side_t, trans_t,
+    const matrixA_t&, const tau_t&, const matrixC_t& C )
+{
+    return make_workinfo< type_t<matrixC_t> >(
+        is_same_v< side_t, left_side_t > ? ncols(C) : nrows(C) );
+}
+
 }
 
 #endif // __ORM2R_HH__
@@ -0,0 +1,143 @@
+/// @file potrf.hpp Computes the Cholesky factorization of a Hermitian positive definite matrix A using a blocked algorithm.
+//
+// Copyright (c) 2021, University of Colorado Denver. All rights reserved.
+//
+// This file is part of <T>LAPACK.
+// <T>LAPACK is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef __POTRF_HH__
+#define __POTRF_HH__
+
+#include "lapack/types.hpp"
+#include "lapack/utils.hpp"
+#include "lapack/potrf2.hpp"
+#include "lapack/tuning.hpp"
+#include "tblas.hpp"
+
+namespace lapack {
+
+/** Computes the Cholesky factorization of a Hermitian
+ * positive definite matrix A using a blocked algorithm.
+ *
+ * The factorization has the form
+ *     $A = U^H U,$ if uplo = Upper, or
+ *     $A = L L^H,$ if uplo = Lower,
+ * where U is an upper triangular matrix and L is lower triangular.
+ *
+ * This is the right-looking blocked version of the algorithm. At each step,
+ * the nb-by-nb diagonal block is factored by `lapack::potrf2`, the panel
+ * below (or to the right of) it is scaled with trsm and the trailing matrix
+ * is updated with herk, so that most flops are done in Level 3 BLAS.
+ *
+ * @param[in] uplo
+ *     - lapack::upper_triangle_t: Upper triangle of A is stored;
+ *     - lapack::lower_triangle_t: Lower triangle of A is stored.
+ *
+ * @param[in,out] A
+ *     On entry, the Hermitian matrix A.
+ *     - If uplo = upper_triangle_t, the strictly lower
+ *     triangular part of A is not referenced.
+ *
+ *     - If uplo = lower_triangle_t, the strictly upper
+ *     triangular part of A is not referenced.
+ *
+ *     - On successful exit, the factor U or L from the Cholesky
+ *     factorization $A = U^H U$ or $A = L L^H.$
+ *
+ * @param[in] nb
+ *     Block size. If nb = 0, the block size is taken from `get_blocksize()`.
+ *     If nb = 1 or nb >= n, `lapack::potrf2` is used on the whole matrix.
+ *
+ * @return = 0: successful exit
+ * @return > 0: if return value = i, the leading minor of order i is not
+ *     positive definite, and the factorization could not be completed.
+ *
+ * @ingroup posv_computational
+ */
+template< class uplo_t, class matrix_t,
+    enable_if_t<(
+    /* Requires: */
+        is_same_v< uplo_t, upper_triangle_t > ||
+        is_same_v< uplo_t, lower_triangle_t >
+    ), int > = 0
+>
+int potrf( uplo_t uplo, matrix_t& A, size_type< matrix_t > nb = 0 )
+{
+    using T      = type_t< matrix_t >;
+    using real_t = blas::real_type<T>;
+    using idx_t  = size_type< matrix_t >;
+    using pair   = std::pair<idx_t,idx_t>;
+
+    using blas::trsm;
+
+    // Constants
+    const T one( 1.0 );
+    const real_t rone( 1.0 );
+    const idx_t n = nrows(A);
+
+    // Check arguments
+    lapack_error_if( nrows(A) != ncols(A), -2 );
+
+    // Quick return
+    if (n == 0)
+        return 0;
+
+    if( nb == 0 )
+        nb = get_blocksize< T >( "potrf", n, n, n );
+
+    // Use the recursive code
+    if( nb <= 1 || nb >= n )
+        return potrf2( uplo, A );
+
+    for(idx_t j = 0; j < n; j += nb) {
+
+        const idx_t jb = ( nb < n-j ) ? nb : n-j;
+
+        // Factor the diagonal block
+        auto A11 = submatrix( A, pair{j,j+jb}, pair{j,j+jb} );
+        int info = potrf2( uplo, A11 );
+        if( info != 0 )
+            return info + j;
+
+        if( j+jb < n ) {
+
+            auto A22 = submatrix( A, pair{j+jb,n}, pair{j+jb,n} );
+
+            if( is_same_v< uplo_t, upper_triangle_t > ) {
+
+                // Scale the row panel A12
+                auto A12 = submatrix( A, pair{j,j+jb}, pair{j+jb,n} );
+                trsm(
+                    Side::Left, Uplo::Upper,
+                    Op::ConjTrans, Diag::NonUnit,
+                    one, A11, A12 );
+
+                // Update the trailing matrix
+                herk(
+                    uplo, Op::ConjTrans,
+                    -rone, A12, rone, A22 );
+            }
+            else {
+
+                // Scale the column panel A21
+                auto A21 = submatrix( A, pair{j+jb,n}, pair{j,j+jb} );
+                trsm(
+                    Side::Right, Uplo::Lower,
+                    Op::ConjTrans, Diag::NonUnit,
+                    one, A11, A21 );
+
+                // Update the trailing matrix
+                herk(
+                    uplo, Op::NoTrans,
+                    -rone, A21, rone, A22 );
+            }
+        }
+    }
+
+    return 0;
+}
+
+} // lapack
+
+#endif // __POTRF_HH__
@@ -16,58 +16,20 @@
 
 namespace lapack {
 
-/** Computes the Cholesky factorization of a Hermitian
- * positive definite matrix A using the recursive algorithm.
- *
- * The factorization has the form
- *     $A = U^H U,$ if uplo = Upper, or
- *     $A = L L^H,$ if uplo = Lower,
- * where U is an upper triangular matrix and L is lower triangular.
- *
- * This is the recursive version of the algorithm. It divides
- * the matrix into four submatrices:
- * \[
- *     A = \begin{bmatrix}
- *             A_{11}  &  A_{12}
- *         \\  A_{21}  &  A_{22}
- *     \end{bmatrix}
- * \]
- * where $A_{11}$ is n1-by-n1 and $A_{22}$ is n2-by-n2,
- * with n1 = n/2 and n2 = n-n1, where n is the order of the matrix A.
- * The subroutine calls itself to factor $A_{11},$
- * updates and scales $A_{21}$ or $A_{12},$
- * updates $A_{22},$
- * and calls itself to factor $A_{22}.$
- *
- * @param[in] uplo
- *     - lapack::upper_triangle_t: Upper triangle of A is stored;
- *     - lapack::lower_triangle_t: Lower triangle of A is stored.
- *
- * @param[in,out] A
- *     On entry, the Hermitian matrix A.
- *     - If uplo = upper_triangle_t, the strictly lower
- *     triangular part of A is not referenced.
- *
- *     - If uplo = lower_triangle_t, the strictly upper
- *     triangular part of A is not referenced.
- *
- *     - On successful exit, the factor U or L from the Cholesky
- *     factorization $A = U^H U$ or $A = L L^H.$
+namespace internal {
+
+/** Factors the diagonal block A[j0:j0+n,j0:j0+n] using the recursive
+ * algorithm.
  *
- * @return = 0: successful exit
- * @return > 0: if return value = i, the leading minor of order i is not
- *     positive definite, and the factorization could not be completed.
+ * The recursion is done on the indices so that A keeps its type across the
+ * recursive calls.
  *
- * @ingroup posv_computational
+ * @see potrf2( uplo_t uplo, matrix_t& A )
  */
-template< class uplo_t, class matrix_t,
-    enable_if_t<(
-    /* Requires: */
-        is_same_v< uplo_t, upper_triangle_t > || 
-        is_same_v< uplo_t, lower_triangle_t >
-    ), int > = 0
->
-int potrf2( uplo_t uplo, matrix_t& A )
+template< class uplo_t, class matrix_t >
+int potrf2_recursive(
+    uplo_t uplo, matrix_t& A,
+    size_type< matrix_t > j0, size_type< matrix_t > n )
 {
     using T      = type_t< matrix_t >;
     using real_t = blas::real_type<T>;
@@ -75,27 +37,19 @@ int potrf2( uplo_t uplo, matrix_t& A )
     using pair   = std::pair<idx_t,idx_t>;
     
     using blas::trsm;
-    using blas::syrk;
     using blas::sqrt;
     using blas::real;
 
     // Constants
     const T one( 1.0 );
+    const real_t rone( 1.0 );
     const real_t rzero( 0.0 );
-    const auto& n = nrows(A);
-
-    // Check arguments
-    lapack_error_if( nrows(A) != ncols(A), -2 );
-
-    // Quick return
-    if (n == 0)
-        return 0;
 
     // Stop recursion
     if (n == 1) {
-        const real_t a00 = real( A(0,0) );
+        const real_t a00 = real( A(j0,j0) );
         if( a00 > rzero ) {
-            A(0,0) = sqrt( a00 );
+            A(j0,j0) = sqrt( a00 );
             return 0;
         }
         else
@@ -105,41 +59,36 @@ int potrf2( uplo_t uplo, matrix_t& A )
     // Recursive code
     {
         const idx_t n1 = n/2;
+        const idx_t j1 = j0 + n1;
+        const idx_t j2 = j0 + n;
 
-        // Define A11 and A22
-        auto A11 = submatrix( A, pair{0,n1}, pair{0,n1} );
-        auto A22 = submatrix( A, pair{n1,n}, pair{n1,n} );
-        
         // Factor A11
-        int info = potrf2( uplo, A11 );
+        int info = potrf2_recursive( uplo, A, j0, n1 );
         if( info != 0 )
             return info;
 
+        // Define A11 and A22
+        const auto A11 = submatrix( A, pair{j0,j1}, pair{j0,j1} );
+        auto A22 = submatrix( A, pair{j1,j2}, pair{j1,j2} );
+
         if( is_same_v< uplo_t, upper_triangle_t > ) {
 
             // Update and scale A12
-            auto A12 = submatrix( A, pair{0,n1}, pair{n1,n} );
+            auto A12 = submatrix( A, pair{j0,j1}, pair{j1,j2} );
             trsm(
                 Side::Left, Uplo::Upper,
                 Op::ConjTrans, Diag::NonUnit,
                 one, A11, A12 );
-            // trsm(
-            //     Layout::ColMajor, Side::Left, Uplo::Upper,
-            //     Op::ConjTrans, Diag::NonUnit,
-            //     n1, n-n1, one, &A11(0,0), A11.stride(1), &A12(0,0), A12.stride(1) );
 
             // Update A22
             herk(
                 uplo, Op::ConjTrans,
-                -one, A12, one, A22 );
-            // herk(
-            //     Layout::ColMajor, uplo, Op::ConjTrans, n-n1, n1,
-            //     -one, &A12(0,0), A12.stride(1), one, &A22(0,0), A22.stride(1) );
+                -rone, A12, rone, A22 );
         }
         else {
 
             // Update and scale A21
-            auto A21 = submatrix( A, pair{n1,n}, pair{0,n1} );
+            auto A21 = submatrix( A, pair{j1,j2}, pair{j0,j1} );
             trsm(
                 Side::Right, Uplo::Lower,
                 Op::ConjTrans, Diag::NonUnit,
@@ -148,11 +97,11 @@ int potrf2( uplo_t uplo, matrix_t& A )
             // Update A22
             herk(
                 uplo, Op::NoTrans,
-                -one, A21, one, A22 );
+                -rone, A21, rone, A22 );
         }
         
         // Factor A22
-        info = potrf2( uplo, A22 );
+        info = potrf2_recursive( uplo, A, j1, n-n1 );
         if( info == 0 )
             return 0;
         else
@@ -160,6 +109,76 @@ int potrf2( uplo_t uplo, matrix_t& A )
     }
 }
 
+} // namespace internal
+
+/** Computes the Cholesky factorization of a Hermitian
+ * positive definite matrix A using the recursive algorithm.
+ *
+ * The factorization has the form
+ *     $A = U^H U,$ if uplo = Upper, or
+ *     $A = L L^H,$ if uplo = Lower,
+ * where U is an upper triangular matrix and L is lower triangular.
+ *
+ * This is the recursive version of the algorithm. It divides
+ * the matrix into four submatrices:
+ * \[
+ *     A = \begin{bmatrix}
+ *             A_{11}  &  A_{12}
+ *         \\  A_{21}  &  A_{22}
+ *     \end{bmatrix}
+ * \]
+ * where $A_{11}$ is n1-by-n1 and $A_{22}$ is n2-by-n2,
+ * with n1 = n/2 and n2 = n-n1, where n is the order of the matrix A.
+ * The subroutine calls itself to factor $A_{11},$
+ * updates and scales $A_{21}$ or $A_{12},$
+ * updates $A_{22},$
+ * and calls itself to factor $A_{22}.$
+ *
+ * @param[in] uplo
+ *     - lapack::upper_triangle_t: Upper triangle of A is stored;
+ *     - lapack::lower_triangle_t: Lower triangle of A is stored.
+ *
+ * @param[in,out] A
+ *     On entry, the Hermitian matrix A.
+ *     - If uplo = upper_triangle_t, the strictly lower
+ *     triangular part of A is not referenced.
+ *
+ *     - If uplo = lower_triangle_t, the strictly upper
+ *     triangular part of A is not referenced.
+ *
+ *     - On successful exit, the factor U or L from the Cholesky
+ *     factorization $A = U^H U$ or $A = L L^H.$
+ *
+ * @return = 0: successful exit
+ * @return > 0: if return value = i, the leading minor of order i is not
+ *     positive definite, and the factorization could not be completed.
+ *
+ * @ingroup posv_computational
+ */
+template< class uplo_t, class matrix_t,
+    enable_if_t<(
+    /* Requires: */
+        is_same_v< uplo_t, upper_triangle_t > || 
+        is_same_v< uplo_t, lower_triangle_t >
+    ), int > = 0
+>
+int potrf2( uplo_t uplo, matrix_t& A )
+{
+    using idx_t = size_type< matrix_t >;
+
+    // Constants
+    const idx_t n = nrows(A);
+
+    // Check arguments
+    lapack_error_if( nrows(A) != ncols(A), -2 );
+
+    // Quick return
+    if (n == 0)
+        return 0;
+
+    return internal::potrf2_recursive( uplo, A, idx_t(0), n );
+}
+
 } // lapack
 
 #endif // __POTRF2_HH__
\ No newline at end of file
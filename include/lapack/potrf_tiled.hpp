@@ -0,0 +1,265 @@
+/// @file potrf_tiled.hpp Computes the Cholesky factorization of a Hermitian positive definite matrix A using tile tasks.
+//
+// Copyright (c) 2021, University of Colorado Denver. All rights reserved.
+//
+// This file is part of <T>LAPACK.
+// <T>LAPACK is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef __POTRF_TILED_HH__
+#define __POTRF_TILED_HH__
+
+#include "lapack/types.hpp"
+#include "lapack/utils.hpp"
+#include "lapack/mdspan.hpp"
+#include "lapack/potrf2.hpp"
+#include "blas/task_graph.hpp"
+#include "tblas.hpp"
+
+#include <vector>
+#include <atomic>
+
+namespace lapack {
+
+namespace internal {
+
+/** Tiled Cholesky factorization on a nt-by-nt grid of nb-by-nb tiles.
+ *
+ * tile(i,j) returns a view of the tile (i,j). Each POTRF, TRSM, SYRK (herk)
+ * and GEMM on a tile is a task of a blas::internal::task_graph, whose
+ * dependencies come from the last task that wrote each tile.
+ *
+ * @see potrf_tiled( uplo_t uplo, matrix_t& A, size_type< matrix_t > nb )
+ */
+template< class uplo_t, class idx_t, class tile_t >
+int potrf_tiled( uplo_t uplo, idx_t nt, idx_t nb, const tile_t& tile )
+{
+    using T      = type_t< decltype( tile( idx_t(0), idx_t(0) ) ) >;
+    using real_t = blas::real_type<T>;
+    using task_id = blas::internal::task_graph::task_id;
+
+    using blas::trsm;
+    using blas::gemm;
+
+    // Constants
+    const T one( 1.0 );
+    const real_t rone( 1.0 );
+    const bool upper = is_same_v< uplo_t, upper_triangle_t >;
+    const task_id none = task_id(-1);
+
+    // Index of the first non positive definite leading minor, 0 if none
+    std::atomic<idx_t> info( 0 );
+
+    blas::internal::task_graph graph;
+    std::vector< task_id > last( nt*nt, none );
+
+    // Adds a task that writes the tile (i,j), i >= j, of the lower triangle,
+    // or (j,i) of the upper triangle, and depends on the given tasks
+    auto add = [&]( idx_t i, idx_t j, int kind, std::function<void()> f,
+                    task_id dep1, task_id dep2 )
+    {
+        // Tasks that unlock the next steps first
+        const task_id t = graph.add_task( std::move(f), int( 4*(nt-j) + kind ) );
+        task_id& w = upper ? last[j*nt+i] : last[i*nt+j];
+        if( w != none ) graph.add_dependency( w, t );
+        if( dep1 != none ) graph.add_dependency( dep1, t );
+        if( dep2 != none ) graph.add_dependency( dep2, t );
+        w = t;
+        return t;
+    };
+
+    std::vector< task_id > panel( nt, none );
+    for(idx_t k = 0; k < nt; ++k) {
+
+        // POTRF
+        const task_id tkk = add( k, k, 3, [&,k]() {
+            if( info != 0 ) return;
+            auto Akk = tile( k, k );
+            int i = potrf2( uplo, Akk );
+            if( i != 0 ) {
+                idx_t expected = 0;
+                info.compare_exchange_strong( expected, k*nb + i );
+            }
+        }, none, none );
+
+        // TRSM
+        for(idx_t i = k+1; i < nt; ++i)
+            panel[i] = upper
+                ? add( i, k, 2, [&,k,i]() {
+                    if( info != 0 ) return;
+                    auto Aki = tile( k, i );
+                    trsm( Side::Left, Uplo::Upper, Op::ConjTrans, Diag::NonUnit,
+                          one, tile( k, k ), Aki );
+                }, tkk, none )
+                : add( i, k, 2, [&,k,i]() {
+                    if( info != 0 ) return;
+                    auto Aik = tile( i, k );
+                    trsm( Side::Right, Uplo::Lower, Op::ConjTrans, Diag::NonUnit,
+                          one, tile( k, k ), Aik );
+                }, tkk, none );
+
+        // SYRK and GEMM
+        for(idx_t i = k+1; i < nt; ++i) {
+            add( i, i, 1, [&,k,i]() {
+                if( info != 0 ) return;
+                auto Aii = tile( i, i );
+                if( upper )
+                    herk( uplo, Op::ConjTrans, -rone, tile( k, i ), rone, Aii );
+                else
+                    herk( uplo, Op::NoTrans, -rone, tile( i, k ), rone, Aii );
+            }, panel[i], none );
+
+            for(idx_t j = k+1; j < i; ++j)
+                add( i, j, 0, [&,k,i,j]() {
+                    if( info != 0 ) return;
+                    if( upper ) {
+                        auto Aji = tile( j, i );
+                        gemm( Op::ConjTrans, Op::NoTrans,
+                              -one, tile( k, j ), tile( k, i ), one, Aji );
+                    }
+                    else {
+                        auto Aij = tile( i, j );
+                        gemm( Op::NoTrans, Op::ConjTrans,
+                              -one, tile( i, k ), tile( j, k ), one, Aij );
+                    }
+                }, panel[i], panel[j] );
+        }
+    }
+
+    graph.run( blas::get_num_threads() );
+
+    return int( info );
+}
+
+} // namespace internal
+
+/** Computes the Cholesky factorization of a Hermitian
+ * positive definite matrix A using tile tasks.
+ *
+ * The factorization has the form
+ *     $A = U^H U,$ if uplo = Upper, or
+ *     $A = L L^H,$ if uplo = Lower,
+ * where U is an upper triangular matrix and L is lower triangular.
+ *
+ * A is split in nb-by-nb tiles. The factorization of each diagonal tile
+ * (POTRF), the solve with it of each tile of its panel (TRSM) and the update
+ * of each tile of the trailing matrix (SYRK or GEMM) is a task. The tasks
+ * form a dependency graph that is executed by a work-stealing scheduler on
+ * blas::get_num_threads() threads. Thus, tasks of different steps of the
+ * factorization run concurrently, instead of synchronizing after each
+ * Level 3 BLAS call, and each task works on tiles that fit in cache.
+ *
+ * @param[in] uplo
+ *     - lapack::upper_triangle_t: Upper triangle of A is stored;
+ *     - lapack::lower_triangle_t: Lower triangle of A is stored.
+ *
+ * @param[in,out] A
+ *     On entry, the Hermitian matrix A.
+ *     - If uplo = upper_triangle_t, the strictly lower
+ *     triangular part of A is not referenced.
+ *
+ *     - If uplo = lower_triangle_t, the strictly upper
+ *     triangular part of A is not referenced.
+ *
+ *     - On successful exit, the factor U or L from the Cholesky
+ *     factorization $A = U^H U$ or $A = L L^H.$
+ *
+ * @param[in] nb Tile size.
+ *
+ * @return = 0: successful exit
+ * @return > 0: if return value = i, the leading minor of order i is not
+ *     positive definite, and the factorization could not be completed.
+ *
+ * @ingroup posv_computational
+ */
+template< class uplo_t, class matrix_t,
+    enable_if_t<(
+    /* Requires: */
+        is_same_v< uplo_t, upper_triangle_t > ||
+        is_same_v< uplo_t, lower_triangle_t >
+    ), int > = 0
+>
+int potrf_tiled( uplo_t uplo, matrix_t& A, size_type< matrix_t > nb )
+{
+    using idx_t = size_type< matrix_t >;
+    using pair  = std::pair<idx_t,idx_t>;
+
+    // Constants
+    const idx_t n = nrows(A);
+
+    // Check arguments
+    lapack_error_if( nrows(A) != ncols(A), -2 );
+    lapack_error_if( nb <= 0, -3 );
+
+    // Quick return
+    if (n == 0)
+        return 0;
+
+    const idx_t nt = (n + nb-1) / nb;
+    auto tile = [&]( idx_t i, idx_t j ) {
+        return submatrix( A,
+            pair{ i*nb, (i*nb+nb < n) ? i*nb+nb : n },
+            pair{ j*nb, (j*nb+nb < n) ? j*nb+nb : n } );
+    };
+
+    return internal::potrf_tiled( uplo, nt, nb, tile );
+}
+
+/** Computes the Cholesky factorization of a Hermitian
+ * positive definite matrix A stored in a tiled layout.
+ *
+ * The tiles of the layout are the tiles of the factorization. Each task
+ * works on contiguous column-major tiles.
+ *
+ * @param[in] uplo
+ *     - lapack::upper_triangle_t: Upper triangle of A is stored;
+ *     - lapack::lower_triangle_t: Lower triangle of A is stored.
+ *
+ * @param[in,out] A
+ *     Matrix with TiledLayout and square tiles.
+ *
+ * @see potrf_tiled( uplo_t uplo, matrix_t& A, size_type< matrix_t > nb )
+ *
+ * @ingroup posv_computational
+ */
+template< class uplo_t, class T, class Exts,
+    enable_if_t<(
+    /* Requires: */
+        is_same_v< uplo_t, upper_triangle_t > ||
+        is_same_v< uplo_t, lower_triangle_t >
+    ), int > = 0
+>
+int potrf_tiled( uplo_t uplo, mdspan< T, Exts, TiledLayout >& A )
+{
+    using idx_t = typename Exts::size_type;
+
+    // Constants
+    const auto& map = A.mapping();
+    const idx_t n  = A.extent(0);
+    const idx_t nb = map.row_tile_size();
+
+    // Check arguments
+    lapack_error_if( A.extent(0) != A.extent(1), -2 );
+    lapack_error_if( map.row_tile_size() != map.col_tile_size(), -2 );
+
+    // Quick return
+    if (n == 0)
+        return 0;
+
+    // Tile (i,j) is a column-major matrix with leading dimension nb
+    auto tile = [&]( idx_t i, idx_t j ) {
+        return Matrix<T>(
+            A.data() + map.tile_offset( i*nb, j*nb ),
+            StridedMapping(
+                matrix_extents(
+                    (i*nb+nb < n) ? nb : n-i*nb,
+                    (j*nb+nb < n) ? nb : n-j*nb ),
+                std::array<idx_t,2>{ 1, nb } ) );
+    };
+
+    return internal::potrf_tiled( uplo, idx_t( map.n_row_tiles() ), nb, tile );
+}
+
+} // lapack
+
+#endif // __POTRF_TILED_HH__
@@ -0,0 +1,144 @@
+/// @file tsmqrt.hpp Applies the block reflector from tsqrt to a pair of stacked tiles.
+//
+// Copyright (c) 2021, University of Colorado Denver. All rights reserved.
+//
+// This file is part of <T>LAPACK.
+// <T>LAPACK is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef __TSMQRT_HH__
+#define __TSMQRT_HH__
+
+#include "lapack/utils.hpp"
+#include "lapack/types.hpp"
+#include "lapack/lacpy.hpp"
+#include "tblas.hpp"
+
+namespace lapack {
+
+/** Multiplies the (k+m)-by-nc matrix [ C1; C2 ] by Q from `lapack::tsqrt`
+ * from the left:
+ *
+ * - trans = noTranspose:   $Q [ C1; C2 ]$;
+ * - trans = conjTranspose: $Q^H [ C1; C2 ]$,
+ *
+ * where $Q = I - [ I; V2 ] T [ I; V2 ]^H$.
+ *
+ * This is the kernel that updates the trailing tiles of
+ * `lapack::geqrf_tiled`. The reflectors are applied in blocks of 32, using
+ * the diagonal blocks of T, so that almost all flops are done in gemm.
+ *
+ * @return  0 if success
+ * @return -i if the ith argument is invalid
+ *
+ * @param[in] trans noTranspose, conjTranspose or, for real matrices, transpose.
+ * @param[in] V2 m-by-k matrix. The Householder vectors.
+ * @param[in] T k-by-k upper triangular factor of the block reflector.
+ * @param[in,out] C1 k-by-nc matrix.
+ * @param[in,out] C2 m-by-nc matrix.
+ * @param W k-by-nc workspace.
+ *
+ * @see tsqrt( matrixA1_t& A1, matrixA2_t& A2, matrixT_t& T )
+ *
+ * @ingroup geqrf
+ */
+template<
+    class trans_t, class matrixV_t, class matrixT_t,
+    class matrixC1_t, class matrixC2_t, class matrixW_t,
+    enable_if_t<(
+    /* Requires: */
+        is_same_v< trans_t, noTranspose_t > ||
+        is_same_v< trans_t, conjTranspose_t > ||
+        is_same_v< trans_t, transpose_t >
+    ), int > = 0
+>
+int tsmqrt(
+    trans_t trans, const matrixV_t& V2, const matrixT_t& T,
+    matrixC1_t& C1, matrixC2_t& C2, matrixW_t& W )
+{
+    using TW    = type_t< matrixW_t >;
+    using idx_t = size_type< matrixC2_t >;
+    using pair  = std::pair<idx_t,idx_t>;
+    using blas::gemm;
+    using blas::trmm;
+    using std::min;
+
+    // constants
+    const TW one( 1 );
+    const idx_t ib = 32; // inner block size
+    const idx_t m  = nrows(C2);
+    const idx_t nc = ncols(C2);
+    const idx_t k  = ncols(V2);
+
+    // check arguments
+    if( is_complex< type_t< matrixV_t > >::value )
+        lapack_error_if( (is_same_v< trans_t, transpose_t >), -1 );
+    lapack_error_if( nrows(V2) != m, -2 );
+    lapack_error_if( nrows(T) < k || ncols(T) < k, -3 );
+    lapack_error_if( nrows(C1) != k || ncols(C1) != nc, -4 );
+    lapack_error_if( nrows(W) < k || ncols(W) < nc, -6 );
+
+    // quick return
+    if (nc <= 0 || k <= 0) return 0;
+
+    // Apply the reflectors in blocks of ib columns, so that the trmm with
+    // the diagonal blocks of T stays cheap compared to the gemms
+    const idx_t nblocks = (k + ib-1) / ib;
+    const bool forward_sweep = is_same_v< trans_t, conjTranspose_t >
+                            || is_same_v< trans_t, transpose_t >;
+
+    for(idx_t s = 0; s < nblocks; ++s) {
+
+        const idx_t j  = ( forward_sweep ? s : nblocks-1-s ) * ib;
+        const idx_t jb = min<idx_t>( ib, k-j );
+
+        const auto Vj = submatrix( V2, pair{0,m}, pair{j,j+jb} );
+        const auto Tj = submatrix( T, pair{j,j+jb}, pair{j,j+jb} );
+        auto C1j = submatrix( C1, pair{j,j+jb}, pair{0,nc} );
+        auto Wj  = submatrix( W, pair{0,jb}, pair{0,nc} );
+
+        // W := C1 + V2^H C2
+        lacpy( general_matrix, C1j, Wj );
+        if( m > 0 )
+            gemm( Op::ConjTrans, Op::NoTrans, one, Vj, C2, one, Wj );
+
+        // W := op(T) W
+        trmm(
+            Side::Left, Uplo::Upper,
+            trans, Diag::NonUnit,
+            one, Tj, Wj );
+
+        // C1 := C1 - W
+        for(idx_t jj = 0; jj < nc; ++jj)
+            for(idx_t i = 0; i < jb; ++i)
+                C1j(i,jj) -= Wj(i,jj);
+
+        // C2 := C2 - V2 W
+        if( m > 0 )
+            gemm( Op::NoTrans, Op::NoTrans, -one, Vj, Wj, one, C2 );
+    }
+
+    return 0;
+}
+
+/** Workspace query for `lapack::tsmqrt`.
+ *
+ * @return A k-by-nc matrix, where V2 is m-by-k and C2 is m-by-nc.
+ *
+ * @see tsmqrt( trans_t trans, const matrixV_t& V2, const matrixT_t& T, matrixC1_t& C1, matrixC2_t& C2, matrixW_t& W )
+ *
+ * @ingroup geqrf
+ */
+template<
+    class trans_t, class matrixV_t, class matrixT_t,
+    class matrixC1_t, class matrixC2_t >
+inline workinfo_t tsmqrt_worksize(
+    trans_t, const matrixV_t& V2, const matrixT_t&,
+    const matrixC1_t&, const matrixC2_t& C2 )
+{
+    return make_workinfo< type_t<matrixC2_t> >( ncols(V2), ncols(C2) );
+}
+
+} // lapack
+
+#endif // __TSMQRT_HH__
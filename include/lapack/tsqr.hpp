@@ -0,0 +1,541 @@
+/// @file tsqr.hpp Tall-skinny QR factorization with a binary reduction tree.
+//
+// Copyright (c) 2021, University of Colorado Denver. All rights reserved.
+//
+// This file is part of <T>LAPACK.
+// <T>LAPACK is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef __TSQR_HH__
+#define __TSQR_HH__
+
+#include "lapack/utils.hpp"
+#include "lapack/types.hpp"
+#include "lapack/larfg.hpp"
+#include "lapack/larfb.hpp"
+#include "lapack/lacpy.hpp"
+#include "lapack/geqrt3.hpp"
+#include "blas/parallel.hpp"
+
+namespace lapack {
+
+namespace internal {
+
+/** Computes the QR factorization of the 2n-by-n matrix [ R1; R2 ], where R1
+ * and R2 are n-by-n upper triangular.
+ *
+ * The Householder vectors have the form [ e_i; v_i ], where v_i has
+ * nonzeros in its first i+1 entries only.
+ *
+ * @param[in,out] R1 n-by-n matrix. On exit, the upper triangle contains R.
+ * @param[in,out] R2 n-by-n matrix. On exit, the upper triangle contains
+ *      the vectors v_i. The strictly lower triangle is not referenced.
+ * @param[out] T n-by-n matrix. On exit, the upper triangular factor of the
+ *      block reflector. The strictly lower triangle is used as workspace.
+ */
+template< class matrixR1_t, class matrixR2_t, class matrixT_t >
+void tsqr_merge( matrixR1_t& R1, matrixR2_t& R2, matrixT_t& T )
+{
+    using TA    = type_t< matrixR1_t >;
+    using idx_t = size_type< matrixR1_t >;
+    using pair  = std::pair<idx_t,idx_t>;
+    using blas::conj;
+    using blas::gemv;
+    using blas::ger;
+    using blas::scal;
+    using blas::trmv;
+
+    // constants
+    const TA one( 1 );
+    const TA zero( 0 );
+    const idx_t n = ncols(R1);
+
+    for(idx_t i = 0; i < n; ++i) {
+
+        // Generate the reflector that annihilates R2[0:i+1,i]
+        auto v = subvector( col( R2, i ), pair{0,i+1} );
+        larfg( R1(i,i), v, T(i,i) );
+        const auto tau = T(i,i);
+
+        // Apply it to [ R1[i,i+1:n]; R2[0:i+1,i+1:n] ] using T[i+1:n,i]
+        // as workspace
+        if( i+1 < n ) {
+            auto C2 = submatrix( R2, pair{0,i+1}, pair{i+1,n} );
+            auto w  = subvector( col( T, i ), pair{i+1,n} );
+
+            gemv( Op::ConjTrans, one, C2, v, zero, w );
+            for(idx_t j = i+1; j < n; ++j) {
+                w[j-i-1] += conj( R1(i,j) );
+                R1(i,j) -= tau * conj( w[j-i-1] );
+            }
+            ger( -tau, v, w, C2 );
+        }
+
+        // T[0:i,i] := - tau T[0:i,0:i] V2[0:i,0:i]^H v[0:i]
+        if( i > 0 ) {
+            auto Ti = subvector( col( T, i ), pair{0,i} );
+            for(idx_t j = 0; j < i; ++j)
+                Ti[j] = v[j];
+            trmv( Uplo::Upper, Op::ConjTrans, Diag::NonUnit,
+                submatrix( R2, pair{0,i}, pair{0,i} ), Ti );
+            scal( -tau, Ti );
+            trmv( Uplo::Upper, Op::NoTrans, Diag::NonUnit,
+                submatrix( T, pair{0,i}, pair{0,i} ), Ti );
+        }
+    }
+}
+
+/** Applies the block reflector from `tsqr_merge` to the matrix [ C1; C2 ],
+ * where C1 and C2 are n-by-k.
+ *
+ * @param[in] trans
+ *     - noTranspose:   apply $H$;
+ *     - conjTranspose: apply $H^H$.
+ * @param[in] V2 n-by-n matrix. The vectors v_i in its upper triangle.
+ * @param[in] T n-by-n upper triangular factor of the block reflector.
+ * @param[in,out] C1 n-by-k matrix.
+ * @param[in,out] C2 n-by-k matrix.
+ * @param W n-by-k workspace.
+ */
+template<
+    class trans_t, class matrixV_t, class matrixT_t,
+    class matrixC1_t, class matrixC2_t, class matrixW_t >
+void tsqr_merge_apply(
+    trans_t trans, const matrixV_t& V2, const matrixT_t& T,
+    matrixC1_t& C1, matrixC2_t& C2, matrixW_t& W )
+{
+    using TW    = type_t< matrixW_t >;
+    using idx_t = size_type< matrixW_t >;
+    using blas::trmm;
+
+    // constants
+    const TW one( 1 );
+    const idx_t n = nrows(W);
+    const idx_t k = ncols(W);
+
+    // W := C1 + V2^H C2
+    lacpy( general_matrix, C2, W );
+    trmm(
+        Side::Left, Uplo::Upper,
+        Op::ConjTrans, Diag::NonUnit,
+        one, V2, W );
+    for(idx_t j = 0; j < k; ++j)
+        for(idx_t i = 0; i < n; ++i)
+            W(i,j) += C1(i,j);
+
+    // W := op(T) W
+    trmm(
+        Side::Left, Uplo::Upper,
+        trans, Diag::NonUnit,
+        one, T, W );
+
+    // C1 := C1 - W
+    for(idx_t j = 0; j < k; ++j)
+        for(idx_t i = 0; i < n; ++i)
+            C1(i,j) -= W(i,j);
+
+    // C2 := C2 - V2 W
+    trmm(
+        Side::Left, Uplo::Upper,
+        Op::NoTrans, Diag::NonUnit,
+        one, V2, W );
+    for(idx_t j = 0; j < k; ++j)
+        for(idx_t i = 0; i < n; ++i)
+            C2(i,j) -= W(i,j);
+}
+
+/// First and last row of the row-block b in a partition of m rows in nb blocks
+template< class idx_t >
+inline std::pair<idx_t,idx_t> tsqr_rows( idx_t m, idx_t nb, idx_t b )
+{
+    const idx_t mb = m / nb;
+    return std::pair<idx_t,idx_t>{ b*mb, (b+1 < nb) ? (b+1)*mb : m };
+}
+
+/** Applies op(Q) from `tsqr` to the rows of C, using W as workspace.
+ * C and W must have the same number of columns.
+ */
+template< class trans_t, class matrixA_t, class matrixT_t, class matrixC_t, class matrixW_t >
+void tsqr_apply(
+    trans_t trans, const matrixA_t& A, const matrixT_t& T,
+    matrixC_t& C, matrixW_t& W )
+{
+    using idx_t = size_type< matrixA_t >;
+    using pair  = std::pair<idx_t,idx_t>;
+
+    // constants
+    const idx_t m  = nrows(A);
+    const idx_t n  = ncols(A);
+    const idx_t k  = ncols(C);
+    const idx_t nb = ncols(T) / n;
+
+    // Q = Q_leaves Q_tree: Q^H applies the leaves first, Q the tree first
+    const bool leaves_first = is_same_v< trans_t, conjTranspose_t >
+                           || is_same_v< trans_t, transpose_t >;
+
+    auto apply_leaves = [&]() {
+        for(idx_t b = 0; b < nb; ++b) {
+            const pair rb = tsqr_rows( m, nb, b );
+            const auto Vb = rows( A, rb );
+            const auto Tb = submatrix( T, pair{0,n}, pair{b*n,(b+1)*n} );
+            auto Cb = rows( C, rb );
+            larfb( left_side, trans, forward, columnwise_storage, Vb, Tb, Cb, W );
+        }
+    };
+
+    auto apply_node = [&]( idx_t b, idx_t step ) {
+        const idx_t t = tsqr_rows( m, nb, b-step ).first;
+        const idx_t r = tsqr_rows( m, nb, b ).first;
+        const auto V2 = submatrix( A, pair{r,r+n}, pair{0,n} );
+        const auto Tb = submatrix( T, pair{n,2*n}, pair{b*n,(b+1)*n} );
+        auto C1 = submatrix( C, pair{t,t+n}, pair{0,k} );
+        auto C2 = submatrix( C, pair{r,r+n}, pair{0,k} );
+        tsqr_merge_apply( trans, V2, Tb, C1, C2, W );
+    };
+
+    if( leaves_first ) {
+        apply_leaves();
+        for(idx_t step = 1; step < nb; step *= 2)
+            for(idx_t b = step; b < nb; b += 2*step)
+                apply_node( b, step );
+    }
+    else {
+        idx_t top = 1;
+        while( top < nb ) top *= 2;
+        for(idx_t step = top/2; step >= 1; step /= 2)
+            for(idx_t b = step; b < nb; b += 2*step)
+                apply_node( b, step );
+        apply_leaves();
+    }
+}
+
+} // namespace internal
+
+/** Computes a QR factorization of a tall and skinny m-by-n matrix A using
+ * a binary reduction tree (TSQR).
+ *
+ * The rows of A are split in nb row-blocks, where nb = ncols(T)/n. Each
+ * row-block is factored independently by `lapack::geqrt3`, and the R
+ * factors of the blocks are combined pairwise in a binary tree until the
+ * R factor of A is obtained:
+ * \[
+ *      A = Q_{leaves} Q_{tree} R.
+ * \]
+ * The row-blocks and the nodes of each level of the tree are processed in
+ * parallel, see blas::set_num_threads(). The work is done in place, so A is
+ * never copied.
+ *
+ * Q is kept in an implicit form that must be applied with `lapack::unmtsqr`:
+ * - the Householder vectors of row-block b are stored below the diagonal
+ *   of the block, and its triangular factor in T[0:n,b*n:(b+1)*n];
+ * - for b > 0, the vectors of the tree node that merges the R factor of
+ *   row-block b are stored in the upper triangle of the first n rows of the
+ *   block, and its triangular factor in T[n:2n,b*n:(b+1)*n].
+ *
+ * @return  0 if success
+ * @return -i if the ith argument is invalid
+ *
+ * @param[in,out] A m-by-n matrix.
+ *      Each row-block must have at least n rows, i.e., m/nb >= n.
+ *      On exit, the upper triangle of A[0:n,0:n] contains R, and the rest
+ *      of A, with T, represents Q.
+ * @param[out] T 2n-by-(nb*n) matrix.
+ *      The triangular factors of the block reflectors.
+ *
+ * @see tsqr_update( matrixR_t& R, matrixA_t& A, matrixT_t& T )
+ * @see unmtsqr( trans_t trans, const matrixA_t& A, const matrixT_t& T, matrixC_t& C, matrixW_t& W )
+ *
+ * @ingroup geqrf
+ */
+template< class matrixA_t, class matrixT_t >
+int tsqr( matrixA_t& A, matrixT_t& T )
+{
+    using idx_t = size_type< matrixA_t >;
+    using pair  = std::pair<idx_t,idx_t>;
+    using blas::internal::parallel_for;
+    using blas::internal::num_threads_for;
+
+    // constants
+    const idx_t m = nrows(A);
+    const idx_t n = ncols(A);
+
+    // quick return
+    if (n <= 0) return 0;
+
+    const idx_t nb = ncols(T) / n;
+
+    // check arguments
+    lapack_error_if( nb < 1 || m / nb < n, -1 );
+    lapack_error_if( nrows(T) < 2*n, -2 );
+
+    const int nt = num_threads_for( 2.0 * m * n * n );
+
+    // Factor the row-blocks
+    parallel_for( nb, nt, [&]( std::size_t s ) {
+        const idx_t b = idx_t(s);
+        auto Ab = rows( A, internal::tsqr_rows( m, nb, b ) );
+        auto Tb = submatrix( T, pair{0,n}, pair{b*n,(b+1)*n} );
+        auto taub = diag( Tb );
+        geqrt3( Ab, taub, Tb );
+    });
+
+    // Merge the R factors: at each level, block b is merged into b-step
+    for(idx_t step = 1; step < nb; step *= 2) {
+        const idx_t nnodes = (nb - step + 2*step-1) / (2*step);
+        parallel_for( nnodes, nt, [&]( std::size_t p ) {
+            const idx_t b = step + 2*step*idx_t(p);
+            const idx_t t = internal::tsqr_rows( m, nb, b-step ).first;
+            const idx_t r = internal::tsqr_rows( m, nb, b ).first;
+            auto R1 = submatrix( A, pair{t,t+n}, pair{0,n} );
+            auto R2 = submatrix( A, pair{r,r+n}, pair{0,n} );
+            auto Tb = submatrix( T, pair{n,2*n}, pair{b*n,(b+1)*n} );
+            internal::tsqr_merge( R1, R2, Tb );
+        });
+    }
+
+    return 0;
+}
+
+/** Factors a new chunk of rows of a tall and skinny matrix whose R factor
+ * is accumulated in R.
+ *
+ * This allows the factorization of a matrix that is read in chunks of rows,
+ * so that the full matrix never has to be resident in memory:
+ *
+ *     tsqr( A_0, T_0 );            // R := A_0[0:n,0:n]
+ *     for( i = 1, ... ) {
+ *         read( A_i );
+ *         tsqr_update( R, A_i, T_i );
+ *         write( A_i, T_i );       // if Q is needed later
+ *     }
+ *
+ * The chunk A is factored by `lapack::tsqr`, and its R factor is then
+ * merged into R. The vectors of this merge are stored in the upper triangle
+ * of A[0:n,0:n], and its triangular factor in T[n:2n,0:n].
+ *
+ * A least squares problem may be solved in a single pass by appending the
+ * right-hand side to the columns of each chunk.
+ *
+ * @return  0 if success
+ * @return -i if the ith argument is invalid
+ *
+ * @param[in,out] R n-by-n matrix.
+ *      On entry, the R factor of the rows factored so far.
+ *      On exit, the R factor including the rows of A.
+ *      The strictly lower triangle is not referenced.
+ * @param[in,out] A m-by-n matrix. Chunk of rows.
+ * @param[out] T 2n-by-(nb*n) matrix. See `lapack::tsqr`.
+ *
+ * @see unmtsqr_update( trans_t trans, const matrixA_t& A, const matrixT_t& T, matrixC0_t& C0, matrixC_t& C, matrixW_t& W )
+ *
+ * @ingroup geqrf
+ */
+template< class matrixR_t, class matrixA_t, class matrixT_t >
+int tsqr_update( matrixR_t& R, matrixA_t& A, matrixT_t& T )
+{
+    using idx_t = size_type< matrixA_t >;
+    using pair  = std::pair<idx_t,idx_t>;
+
+    // constants
+    const idx_t n = ncols(A);
+
+    // check arguments
+    lapack_error_if( nrows(R) < n || ncols(R) < n, -1 );
+
+    int info = tsqr( A, T );
+    if( info != 0 )
+        return (info == -1) ? -2 : -3;
+    if (n <= 0) return 0;
+
+    auto R1 = submatrix( R, pair{0,n}, pair{0,n} );
+    auto R2 = submatrix( A, pair{0,n}, pair{0,n} );
+    auto T0 = submatrix( T, pair{n,2*n}, pair{0,n} );
+    internal::tsqr_merge( R1, R2, T0 );
+
+    return 0;
+}
+
+/** Multiplies the general m-by-k matrix C by Q from `lapack::tsqr` from the
+ * left:
+ *
+ * - trans = noTranspose:   $Q C$;
+ * - trans = conjTranspose: $Q^H C$.
+ *
+ * The columns of C are split among the threads, see blas::set_num_threads().
+ *
+ * @return  0 if success
+ * @return -i if the ith argument is invalid
+ *
+ * @param[in] trans noTranspose, conjTranspose or, for real matrices, transpose.
+ * @param[in] A m-by-n matrix, as returned by `lapack::tsqr`.
+ * @param[in] T 2n-by-(nb*n) matrix, as returned by `lapack::tsqr`.
+ * @param[in,out] C m-by-k matrix.
+ * @param W n-by-k workspace.
+ *
+ * @ingroup geqrf
+ */
+template<
+    class trans_t, class matrixA_t, class matrixT_t,
+    class matrixC_t, class matrixW_t,
+    enable_if_t<(
+    /* Requires: */
+        is_same_v< trans_t, noTranspose_t > ||
+        is_same_v< trans_t, conjTranspose_t > ||
+        is_same_v< trans_t, transpose_t >
+    ), int > = 0
+>
+int unmtsqr(
+    trans_t trans, const matrixA_t& A, const matrixT_t& T,
+    matrixC_t& C, matrixW_t& W )
+{
+    using idx_t = size_type< matrixC_t >;
+    using pair  = std::pair<idx_t,idx_t>;
+    using blas::internal::parallel_for;
+    using blas::internal::num_threads_for;
+
+    // constants
+    const idx_t m = nrows(C);
+    const idx_t k = ncols(C);
+    const idx_t n = ncols(A);
+
+    // check arguments
+    if( is_complex< type_t< matrixA_t > >::value )
+        lapack_error_if( (is_same_v< trans_t, transpose_t >), -1 );
+    lapack_error_if( nrows(A) != m, -2 );
+    lapack_error_if( n > 0 && (ncols(T) / n < 1 || nrows(T) < 2*n), -3 );
+    lapack_error_if( nrows(W) < n || ncols(W) < k, -5 );
+
+    // quick return
+    if (m <= 0 || n <= 0 || k <= 0) return 0;
+
+    // Split the columns of C among the threads
+    const int nt = num_threads_for( 4.0 * m * n * k );
+    const idx_t ns = (nt > 1) ? idx_t(nt) : idx_t(1);
+    const idx_t kb = (k + ns-1) / ns;
+
+    parallel_for( (k + kb-1) / kb, nt, [&]( std::size_t s ) {
+        const idx_t j0 = idx_t(s) * kb;
+        const pair cols_s{ j0, (j0+kb < k) ? j0+kb : k };
+        auto Cs = cols( C, cols_s );
+        auto Ws = submatrix( W, pair{0,n}, cols_s );
+        internal::tsqr_apply( trans, A, T, Cs, Ws );
+    });
+
+    return 0;
+}
+
+/** Multiplies [ C0; C ] by the factor Q of a chunk from
+ * `lapack::tsqr_update` from the left:
+ *
+ * - trans = noTranspose:   $Q [ C0; C ]$;
+ * - trans = conjTranspose: $Q^H [ C0; C ]$.
+ *
+ * C0 plays the role of the accumulated R: to apply Q^H from a sequence
+ * of updates, call `lapack::unmtsqr` on the first chunk and this routine on
+ * the following chunks in the same order, using the first n rows of the
+ * first chunk of C as C0. To apply Q, go through the chunks in reverse order
+ * and finish with `lapack::unmtsqr` on the first chunk.
+ *
+ * @return  0 if success
+ * @return -i if the ith argument is invalid
+ *
+ * @param[in] trans noTranspose, conjTranspose or, for real matrices, transpose.
+ * @param[in] A m-by-n matrix, as returned by `lapack::tsqr_update`.
+ * @param[in] T 2n-by-(nb*n) matrix, as returned by `lapack::tsqr_update`.
+ * @param[in,out] C0 n-by-k matrix.
+ * @param[in,out] C m-by-k matrix.
+ * @param W n-by-k workspace.
+ *
+ * @ingroup geqrf
+ */
+template<
+    class trans_t, class matrixA_t, class matrixT_t,
+    class matrixC0_t, class matrixC_t, class matrixW_t,
+    enable_if_t<(
+    /* Requires: */
+        is_same_v< trans_t, noTranspose_t > ||
+        is_same_v< trans_t, conjTranspose_t > ||
+        is_same_v< trans_t, transpose_t >
+    ), int > = 0
+>
+int unmtsqr_update(
+    trans_t trans, const matrixA_t& A, const matrixT_t& T,
+    matrixC0_t& C0, matrixC_t& C, matrixW_t& W )
+{
+    using idx_t = size_type< matrixC_t >;
+    using pair  = std::pair<idx_t,idx_t>;
+
+    // constants
+    const idx_t k = ncols(C);
+    const idx_t n = ncols(A);
+
+    // check arguments
+    lapack_error_if( nrows(C0) < n || ncols(C0) != k, -4 );
+    lapack_error_if( nrows(W) < n || ncols(W) < k, -6 );
+
+    // quick return
+    if (nrows(C) <= 0 || n <= 0 || k <= 0) return 0;
+
+    const bool forward_sweep = is_same_v< trans_t, conjTranspose_t >
+                            || is_same_v< trans_t, transpose_t >;
+
+    // Q^H: the chunk first, then the merge with C0
+    if( forward_sweep ) {
+        int info = unmtsqr( trans, A, T, C, W );
+        if( info != 0 ) return (info == -5) ? -6 : info;
+    }
+
+    {
+        const auto V2 = submatrix( A, pair{0,n}, pair{0,n} );
+        const auto T0 = submatrix( T, pair{n,2*n}, pair{0,n} );
+        auto C1 = submatrix( C0, pair{0,n}, pair{0,k} );
+        auto C2 = submatrix( C, pair{0,n}, pair{0,k} );
+        auto W0 = submatrix( W, pair{0,n}, pair{0,k} );
+        internal::tsqr_merge_apply( trans, V2, T0, C1, C2, W0 );
+    }
+
+    // Q: the merge with C0 first, then the chunk
+    if( !forward_sweep ) {
+        int info = unmtsqr( trans, A, T, C, W );
+        if( info != 0 ) return (info == -5) ? -6 : info;
+    }
+
+    return 0;
+}
+
+/** Workspace query for `lapack::unmtsqr`.
+ *
+ * @return A n-by-k matrix, where A is m-by-n and C is m-by-k.
+ *
+ * @see unmtsqr( trans_t trans, const matrixA_t& A, const matrixT_t& T, matrixC_t& C, matrixW_t& W )
+ *
+ * @ingroup geqrf
+ */
+template< class trans_t, class matrixA_t, class matrixT_t, class matrixC_t >
+inline workinfo_t unmtsqr_worksize(
+    trans_t, const matrixA_t& A, const matrixT_t&, const matrixC_t& C )
+{
+    return make_workinfo< type_t<matrixC_t> >( ncols(A), ncols(C) );
+}
+
+/** Workspace query for `lapack::unmtsqr_update`.
+ *
+ * @return A n-by-k matrix, where A is m-by-n and C is m-by-k.
+ *
+ * @see unmtsqr_update( trans_t trans, const matrixA_t& A, const matrixT_t& T, matrixC0_t& C0, matrixC_t& C, matrixW_t& W )
+ *
+ * @ingroup geqrf
+ */
+template<
+    class trans_t, class matrixA_t, class matrixT_t,
+    class matrixC0_t, class matrixC_t >
+inline workinfo_t unmtsqr_update_worksize(
+    trans_t, const matrixA_t& A, const matrixT_t&,
+    const matrixC0_t&, const matrixC_t& C )
+{
+    return make_workinfo< type_t<matrixC_t> >( ncols(A), ncols(C) );
+}
+
+} // lapack
+
+#endif // __TSQR_HH__
@@ -0,0 +1,181 @@
+/// @file tsqrt.hpp Computes a QR factorization of a triangular tile stacked on top of a square tile.
+//
+// Copyright (c) 2021, University of Colorado Denver. All rights reserved.
+//
+// This file is part of <T>LAPACK.
+// <T>LAPACK is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef __TSQRT_HH__
+#define __TSQRT_HH__
+
+#include "lapack/utils.hpp"
+#include "lapack/types.hpp"
+#include "lapack/larfg.hpp"
+#include "lapack/tsmqrt.hpp"
+#include "tblas.hpp"
+
+namespace lapack {
+
+namespace internal {
+
+/** Factors the columns j0:j0+n of [ A1; A2 ] and forms the block
+ * T[j0:j0+n,j0:j0+n] of the triangular factor.
+ *
+ * @see tsqrt( matrixA1_t& A1, matrixA2_t& A2, matrixT_t& T )
+ */
+template< class matrixA1_t, class matrixA2_t, class matrixT_t >
+void tsqrt_recursive(
+    matrixA1_t& A1, matrixA2_t& A2, matrixT_t& T,
+    size_type< matrixA2_t > j0, size_type< matrixA2_t > n )
+{
+    using TA    = type_t< matrixA2_t >;
+    using idx_t = size_type< matrixA2_t >;
+    using pair  = std::pair<idx_t,idx_t>;
+    using blas::conj;
+    using blas::gemm;
+    using blas::gemv;
+    using blas::ger;
+    using blas::trmm;
+    using blas::trmv;
+
+    // constants
+    const TA one( 1 );
+    const TA zero( 0 );
+    const idx_t nbmin = 8; // size of the base case
+    const idx_t m  = nrows(A2);
+    const idx_t j2 = j0 + n;
+
+    // Stop recursion
+    if( n <= nbmin ) {
+        for(idx_t j = j0; j < j2; ++j) {
+
+            // Generate the reflector that annihilates A2[:,j]
+            auto v = col( A2, j );
+            larfg( A1(j,j), v, T(j,j) );
+            const auto tau = T(j,j);
+
+            // Apply it to [ A1[j,j+1:j2]; A2[:,j+1:j2] ] using T[j+1:j2,j]
+            // as workspace
+            if( j+1 < j2 ) {
+                auto C2 = submatrix( A2, pair{0,m}, pair{j+1,j2} );
+                auto w  = subvector( col( T, j ), pair{j+1,j2} );
+
+                gemv( Op::ConjTrans, one, C2, v, zero, w );
+                for(idx_t i = j+1; i < j2; ++i) {
+                    w[i-j-1] += conj( A1(j,i) );
+                    A1(j,i) -= tau * conj( w[i-j-1] );
+                }
+                ger( -tau, v, w, C2 );
+            }
+
+            // T[j0:j,j] := - tau T[j0:j,j0:j] A2[:,j0:j]^H v
+            if( j > j0 ) {
+                auto Tj = subvector( col( T, j ), pair{j0,j} );
+                gemv( Op::ConjTrans, -tau,
+                    submatrix( A2, pair{0,m}, pair{j0,j} ), v, zero, Tj );
+                trmv( Uplo::Upper, Op::NoTrans, Diag::NonUnit,
+                    submatrix( T, pair{j0,j}, pair{j0,j} ), Tj );
+            }
+        }
+        return;
+    }
+
+    const idx_t n1 = n/2;
+    const idx_t j1 = j0 + n1;
+
+    // Factor the left half
+    tsqrt_recursive( A1, A2, T, j0, n1 );
+
+    // Apply H1^H to [ A1[j0:j1,j1:j2]; A2[:,j1:j2] ] using T12 as workspace
+    {
+        const auto V1  = submatrix( A2, pair{0,m}, pair{j0,j1} );
+        const auto T11 = submatrix( T, pair{j0,j1}, pair{j0,j1} );
+        auto C1  = submatrix( A1, pair{j0,j1}, pair{j1,j2} );
+        auto C2  = submatrix( A2, pair{0,m}, pair{j1,j2} );
+        auto T12 = submatrix( T, pair{j0,j1}, pair{j1,j2} );
+        tsmqrt( conjTranspose, V1, T11, C1, C2, T12 );
+    }
+
+    // Factor the right half
+    tsqrt_recursive( A1, A2, T, j1, n-n1 );
+
+    // T12 := - T11 ( V1^H V2 ) T22, since the identity blocks on top of
+    // V1 and V2 do not overlap
+    {
+        const auto T11 = submatrix( T, pair{j0,j1}, pair{j0,j1} );
+        const auto T22 = submatrix( T, pair{j1,j2}, pair{j1,j2} );
+        auto T12 = submatrix( T, pair{j0,j1}, pair{j1,j2} );
+
+        gemm(
+            Op::ConjTrans, Op::NoTrans,
+            one, submatrix( A2, pair{0,m}, pair{j0,j1} ),
+                 submatrix( A2, pair{0,m}, pair{j1,j2} ),
+            zero, T12 );
+        trmm(
+            Side::Left, Uplo::Upper,
+            Op::NoTrans, Diag::NonUnit,
+            -one, T11, T12 );
+        trmm(
+            Side::Right, Uplo::Upper,
+            Op::NoTrans, Diag::NonUnit,
+            one, T22, T12 );
+    }
+}
+
+} // namespace internal
+
+/** Computes a QR factorization of the (n+m)-by-n matrix [ A1; A2 ], where
+ * A1 is n-by-n upper triangular and A2 is m-by-n.
+ *
+ * The Householder vectors have the form [ e_i; v_i ], so that
+ * \[
+ *          Q = H_1 H_2 ... H_n = I - [ I; V2 ] T [ I; V2 ]^H,
+ * \]
+ * where V2 is stored in A2. The columns are split in halves recursively,
+ * as in `lapack::geqrt3`, so that most flops are done in gemm and trmm.
+ *
+ * This is the kernel that annihilates the tiles below the diagonal in
+ * `lapack::geqrf_tiled`.
+ *
+ * @return  0 if success
+ * @return -i if the ith argument is invalid
+ *
+ * @param[in,out] A1 n-by-n matrix.
+ *      On entry, the upper triangular matrix R of a previous factorization.
+ *      On exit, the upper triangle contains the updated R.
+ *      The strictly lower triangle is not referenced.
+ * @param[in,out] A2 m-by-n matrix.
+ *      On exit, the Householder vectors V2.
+ * @param[out] T n-by-n matrix.
+ *      On exit, the upper triangular factor of the block reflector. Its
+ *      diagonal holds the scalar factors of the elementary reflectors.
+ *      The strictly lower triangle is used as workspace.
+ *
+ * @see tsmqrt( trans_t trans, const matrixV_t& V2, const matrixT_t& T, matrixC1_t& C1, matrixC2_t& C2, matrixW_t& W )
+ *
+ * @ingroup geqrf
+ */
+template< class matrixA1_t, class matrixA2_t, class matrixT_t >
+int tsqrt( matrixA1_t& A1, matrixA2_t& A2, matrixT_t& T )
+{
+    using idx_t = size_type< matrixA2_t >;
+
+    // constants
+    const idx_t n = ncols(A2);
+
+    // check arguments
+    lapack_error_if( nrows(A1) < n || ncols(A1) < n, -1 );
+    lapack_error_if( nrows(T) < n || ncols(T) < n, -3 );
+
+    // quick return
+    if (n <= 0) return 0;
+
+    internal::tsqrt_recursive( A1, A2, T, idx_t(0), n );
+
+    return 0;
+}
+
+} // lapack
+
+#endif // __TSQRT_HH__
@@ -0,0 +1,30 @@
+/// @file tuning.hpp Registry of the block sizes of the blocked routines.
+//
+// Copyright (c) 2021, University of Colorado Denver. All rights reserved.
+//
+// This file is part of <T>LAPACK.
+// <T>LAPACK is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef __TLAPACK_TUNING_HH__
+#define __TLAPACK_TUNING_HH__
+
+#include "blas/tuning.hpp"
+
+namespace lapack {
+
+// The registry lives in <T>BLAS, so that the blocked Level 3 BLAS use it too
+using blas::tuning_type;
+using blas::get_blocksize;
+
+#ifndef TLAPACK_STATIC_TUNING
+using blas::tuning_entry;
+using blas::set_blocksize;
+using blas::load_tuning_file;
+using blas::save_tuning_file;
+using blas::clear_tuning;
+#endif
+
+} // namespace lapack
+
+#endif // __TLAPACK_TUNING_HH__
@@ -158,6 +158,64 @@ struct right_side_t {
 constexpr left_side_t left_side { };
 constexpr right_side_t right_side { };
 
+// -----------------------------------------------------------------------------
+// Workspace
+
+/** Minimum alignment of the workspaces, in bytes.
+ *
+ * The default is the size of a cache line and of an AVX-512 register.
+ * May be defined at compile time.
+ */
+#ifndef TLAPACK_WORKSPACE_ALIGNMENT
+    #define TLAPACK_WORKSPACE_ALIGNMENT 64
+#endif
+
+/** Workspace required by a routine, as returned by the `*_worksize` queries.
+ *
+ * The workspace is an m-by-n matrix, or a vector of length m if n = 1,
+ * with elements of the type of the data of the routine. It can be stored in
+ * a buffer of size() elements whose address is a multiple of alignment bytes.
+ *
+ * Use minMax() to compute a single workspace that serves several routines,
+ * so that it can be allocated once and reused across calls. The workspace of
+ * each of the routines is then the leading submatrix of the combined one.
+ */
+struct workinfo_t {
+    std::size_t m = 0;          ///< Number of rows
+    std::size_t n = 0;          ///< Number of columns
+    std::size_t alignment = 1;  ///< Alignment of the first element, in bytes
+
+    constexpr workinfo_t() = default;
+    constexpr workinfo_t( std::size_t m_, std::size_t n_, std::size_t alignment_ )
+    : m(m_), n(n_), alignment(alignment_) {}
+
+    /// Number of elements
+    constexpr std::size_t size() const { return m * n; }
+
+    /// Enlarges this workspace so that it also contains the workspace w
+    constexpr workinfo_t& minMax( const workinfo_t& w ) {
+        if( w.size() > 0 ) {
+            if( m < w.m ) m = w.m;
+            if( n < w.n ) n = w.n;
+            if( alignment < w.alignment ) alignment = w.alignment;
+        }
+        return *this;
+    }
+};
+
+/// Workspace of m-by-n elements of type T, aligned at
+/// TLAPACK_WORKSPACE_ALIGNMENT bytes or more
+template< class T >
+constexpr workinfo_t make_workinfo( std::size_t m, std::size_t n = 1 )
+{
+    constexpr std::size_t alignment =
+        ( alignof(T) > TLAPACK_WORKSPACE_ALIGNMENT )
+            ? alignof(T) : TLAPACK_WORKSPACE_ALIGNMENT;
+    return ( m > 0 && n > 0 )
+        ? workinfo_t( m, n, alignment )
+        : workinfo_t( 0, 0, alignment );
+}
+
 } // namespace lapack
 
 #endif // __TLAPACK_TYPES_HH__
@@ -0,0 +1,173 @@
+/// @file ungqr.hpp Generates the matrix Q with orthonormal columns from `lapack::geqrf` using a blocked code.
+//
+// Copyright (c) 2021, University of Colorado Denver. All rights reserved.
+//
+// This file is part of <T>LAPACK.
+// <T>LAPACK is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef __UNGQR_HH__
+#define __UNGQR_HH__
+
+#include "lapack/utils.hpp"
+#include "lapack/types.hpp"
+#include "lapack/larft.hpp"
+#include "lapack/larfb.hpp"
+#include "lapack/org2r.hpp"
+#include "lapack/tuning.hpp"
+
+namespace lapack {
+
+/** Generates an m-by-n matrix Q with orthonormal columns, which is defined
+ * as the first n columns of a product of k elementary reflectors of order m
+ * \[
+ *     Q  =  H_1 H_2 ... H_k
+ * \]
+ * as returned by `lapack::geqr2` or `lapack::geqrf`.
+ *
+ * This is the blocked version of `lapack::org2r`. The reflectors are
+ * processed backward in blocks of nb columns: the triangular factor of each
+ * block reflector is formed by `lapack::larft` and the block reflector is
+ * applied to the columns to its right by `lapack::larfb`. Only the columns
+ * of each block itself are generated by `lapack::org2r`.
+ *
+ * @return  0 if success
+ * @return -i if the ith argument is invalid
+ *
+ * @param[in] k The number of elementary reflectors, 0 <= k <= n.
+ * @param[in,out] A m-by-n matrix, n <= m.
+ *      On entry, the i-th column must contain the vector which defines the
+ *      elementary reflector $H_i$, for $i=0,1,...,k-1$, as returned by
+ *      `lapack::geqrf` in the first k columns of A.
+ *      On exit, the m-by-n matrix $Q  =  H_1 H_2 ... H_k$.
+ * @param[in] tau Vector of length k.
+ *      The scalar factors of the elementary reflectors.
+ * @param W nb-by-n workspace.
+ *      The number of rows of W defines the block size nb.
+ *      If nb <= 1, the unblocked code is used.
+ *
+ * @see org2r( size_type< matrix_t > k, matrix_t& A, vector_t &tau, work_t &work )
+ *
+ * @ingroup geqrf
+ */
+template< class matrix_t, class vector_t, class matrixW_t >
+int ungqr(
+    size_type< matrix_t > k, matrix_t& A, vector_t &tau, matrixW_t& W )
+{
+    using T     = type_t< matrix_t >;
+    using idx_t = size_type< matrix_t >;
+    using pair  = std::pair<idx_t,idx_t>;
+    using std::min;
+
+    // constants
+    const T zero( 0.0 );
+    const idx_t m = nrows(A);
+    const idx_t n = ncols(A);
+    const idx_t nb = min<idx_t>( nrows(W), k );
+
+    // check arguments
+    lapack_error_if( n > m, -2 );
+    lapack_error_if( k > n, -1 );
+    lapack_error_if( idx_t(size(tau)) < k, -3 );
+    lapack_error_if( nrows(W) < 1 || ncols(W) < n, -4 );
+
+    // quick return
+    if (n <= 0) return 0;
+
+    // The last block, of kk columns, is generated by the unblocked code,
+    // together with the columns k:n-1
+    const idx_t nblocks = ( nb > 1 ) ? ( k + nb-1 ) / nb : 0;
+    const idx_t kk = ( nblocks > 0 ) ? (nblocks-1) * nb : 0;
+    {
+        // Set A[0:kk,kk:n] to zero
+        for(idx_t j = kk; j < n; ++j)
+            for(idx_t i = 0; i < kk; ++i)
+                A(i,j) = zero;
+
+        auto A2   = submatrix( A, pair{kk,m}, pair{kk,n} );
+        auto tau2 = subvector( tau, pair{kk,k} );
+        auto w    = subvector( row( W, 0 ), pair{0,n-kk-1} );
+        org2r( k-kk, A2, tau2, w );
+    }
+
+    for(idx_t i = kk; i != 0; ) {
+        i -= nb;
+
+        // Form the triangular factor of the block reflector
+        // $H = H(i) H(i+1) ... H(i+nb-1)$
+        const auto V = submatrix( A, pair{i,m}, pair{i,i+nb} );
+        auto taui = subvector( tau, pair{i,i+nb} );
+        auto T = submatrix( W, pair{0,nb}, pair{0,nb} );
+        larft( forward, columnwise_storage, V, taui, T );
+
+        // Apply H to A[i:m,i+nb:n] from the left
+        auto C  = submatrix( A, pair{i,m}, pair{i+nb,n} );
+        auto W0 = submatrix( W, pair{0,nb}, pair{nb,n-i} );
+        larfb(
+            left_side, noTranspose, forward, columnwise_storage,
+            V, T, C, W0
+        );
+
+        // Generate the columns A[0:m,i:i+nb]
+        {
+            for(idx_t j = i; j < i+nb; ++j)
+                for(idx_t l = 0; l < i; ++l)
+                    A(l,j) = zero;
+
+            auto Ai = submatrix( A, pair{i,m}, pair{i,i+nb} );
+            auto w  = subvector( row( W, 0 ), pair{0,nb-1} );
+            org2r( nb, Ai, taui, w );
+        }
+    }
+
+    return 0;
+}
+
+/** Generates an m-by-n matrix Q with orthonormal columns from
+ * `lapack::geqrf` using a blocked code.
+ *
+ * @see ungqr( size_type< matrix_t > k, matrix_t& A, vector_t &tau, matrixW_t& W )
+ *
+ * @ingroup geqrf
+ */
+template< class matrix_t, class vector_t, class matrixW_t >
+inline int orgqr(
+    size_type< matrix_t > k, matrix_t& A, vector_t &tau, matrixW_t& W )
+{
+    return ungqr( k, A, tau, W );
+}
+
+/** Workspace query for `lapack::ungqr` and `lapack::orgqr`.
+ *
+ * @param[in] nb Block size.
+ *      If nb = 0, the block size is taken from `get_blocksize()`.
+ *
+ * @return A nb-by-n matrix, where A is m-by-n.
+ *
+ * @see ungqr( size_type< matrix_t > k, matrix_t& A, vector_t &tau, matrixW_t& W )
+ *
+ * @ingroup geqrf
+ */
+template< class matrix_t, class vector_t >
+inline workinfo_t ungqr_worksize(
+    size_type< matrix_t > k, const matrix_t& A, const vector_t&,
+    size_type< matrix_t > nb = 0 )
+{
+    if( nb == 0 )
+        nb = get_blocksize< type_t<matrix_t> >(
+            "ungqr", nrows(A), ncols(A), k );
+    return make_workinfo< type_t<matrix_t> >( (nb > 1) ? nb : 1, ncols(A) );
+}
+
+/// @copydoc ungqr_worksize()
+template< class matrix_t, class vector_t >
+inline workinfo_t orgqr_worksize(
+    size_type< matrix_t > k, const matrix_t& A, const vector_t &tau,
+    size_type< matrix_t > nb = 0 )
+{
+    return ungqr_worksize( k, A, tau, nb );
+}
+
+} // lapack
+
+#endif // __UNGQR_HH__
@@ -14,12 +14,15 @@
 #include "lapack/types.hpp"
 #include "lapack/larft.hpp"
 #include "lapack/larfb.hpp"
+#include "lapack/tuning.hpp"
 
 namespace lapack {
 
 /** Multiplies the general m-by-n matrix C by Q from `lapack::geqrf` using a blocked code.
  * 
- * @param work Vector of size n*nb + nb*nb (m*nb + nb*nb if side == Side::Right).
+ * @param W nb-by-(n+nb) workspace ((m+nb)-by-nb if side == Side::Right).
+ *     The number of rows (columns if side == Side::Right) of W defines the
+ *     block size nb. See unmqr_worksize().
  * @see unmqr( Side, Op, blas::idx_t, blas::idx_t, blas::idx_t, const TA*, blas::idx_t, const blas::real_type<TA,TC>*, TC*, blas::idx_t )
  * 
  * @ingroup geqrf
@@ -51,12 +54,23 @@ int unmqr(
     using std::min;
 
     // Constants
-    const idx_t nb = 32; // number of blocks
     const idx_t m = nrows(C);
     const idx_t n = ncols(C);
     const idx_t k = size(tau);
     const idx_t nA = nrows(A);
     const idx_t nw = ( is_same_v< side_t, left_side_t > ) ? max<idx_t>(1,n) : max<idx_t>(1,m);
+    const idx_t nb = ( is_same_v< side_t, left_side_t > )
+        ? min<idx_t>( nrows(W), k )
+        : min<idx_t>( ncols(W), k );
+
+    // quick return
+    if (m <= 0 || n <= 0 || k <= 0) return 0;
+
+    // check arguments
+    lapack_error_if( nb < 1, -6 );
+    lapack_error_if( ( is_same_v< side_t, left_side_t > )
+        ? ncols(W) < nw + nb
+        : nrows(W) < nw + nb, -6 );
 
     // Preparing loop indexes
     idx_t i0, iN, step;
@@ -68,7 +82,7 @@ int unmqr(
           is_same_v< trans_t, noTranspose_t > )
     ){
         i0 = 0;
-        iN = k-1+nb;
+        iN = ( (k-1) / nb + 1 ) * nb;
         step = nb;
     }
     else {
@@ -83,7 +97,9 @@ int unmqr(
         idx_t ib = min( nb, k-i );
         const auto V = submatrix( A, pair{i,nA}, pair{i,i+ib} );
         const auto taui = subvector( tau, pair{i,i+ib} );
-        auto T = submatrix( W, pair{nw,nw+ib}, pair{nw,nw+ib} );
+        auto T = ( is_same_v< side_t, left_side_t > )
+           ? submatrix( W, pair{0,ib}, pair{nw,nw+ib} )
+           : submatrix( W, pair{nw,nw+ib}, pair{0,ib} );
 
         // Form the triangular factor of the block reflector
         // $H = H(i) H(i+1) ... H(i+ib-1)$
@@ -95,7 +111,9 @@ int unmqr(
            : submatrix( C, pair{0,m}, pair{i,n} );
 
         // Apply H or H**H
-        auto W0 = submatrix( W, pair{0,ib}, pair{0,nw} );
+        auto W0 = ( is_same_v< side_t, left_side_t > )
+           ? submatrix( W, pair{0,ib}, pair{0,nw} )
+           : submatrix( W, pair{0,nw}, pair{0,ib} );
         lapack::larfb(
             side, trans, forward, columnwise_storage,
             V, T, Ci, W0
@@ -105,6 +123,43 @@ int unmqr(
     return 0;
 }
 
+/** Workspace query for `lapack::unmqr`.
+ *
+ * @param[in] nb Block size.
+ *      If nb = 0, the block size is taken from `get_blocksize()`.
+ *
+ * @return A nb-by-(n+nb) matrix if side = left_side, and an
+ *         (m+nb)-by-nb matrix otherwise, where nb is at most k and C is
+ *         m-by-n.
+ *
+ * @ingroup geqrf
+ */
+template<
+    class matrixA_t, class matrixC_t, class tau_t,
+    class side_t, class trans_t >
+inline workinfo_t unmqr_worksize(
+    side_t, trans_t,
+    const matrixA_t&, const tau_t& tau, const matrixC_t& C,
+    size_type< matrixC_t > nb = 0 )
+{
+    using idx_t = size_type< matrixC_t >;
+    using std::max;
+    using std::min;
+
+    const idx_t k = size(tau);
+    if( nb == 0 )
+        nb = get_blocksize< type_t<matrixC_t> >(
+            "unmqr", nrows(C), ncols(C), k );
+    nb = max<idx_t>( 1, min<idx_t>( nb, k ) );
+    const idx_t nw = ( is_same_v< side_t, left_side_t > )
+        ? max<idx_t>( 1, ncols(C) )
+        : max<idx_t>( 1, nrows(C) );
+
+    return ( is_same_v< side_t, left_side_t > )
+        ? make_workinfo< type_t<matrixC_t> >( nb, nw + nb )
+        : make_workinfo< type_t<matrixC_t> >( nw + nb, nb );
+}
+
 }
 
 #endif // __UNMQR_HH__
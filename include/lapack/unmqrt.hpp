@@ -0,0 +1,111 @@
+/// @file unmqrt.hpp Applies the block reflector of a tile from geqrt to a matrix.
+//
+// Copyright (c) 2021, University of Colorado Denver. All rights reserved.
+//
+// This file is part of <T>LAPACK.
+// <T>LAPACK is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef __UNMQRT_HH__
+#define __UNMQRT_HH__
+
+#include "lapack/utils.hpp"
+#include "lapack/types.hpp"
+#include "lapack/larfb.hpp"
+
+namespace lapack {
+
+/** Multiplies the general m-by-nc matrix C by Q from `lapack::geqrt` from
+ * the left:
+ *
+ * - trans = noTranspose:   $Q C$;
+ * - trans = conjTranspose: $Q^H C$.
+ *
+ * @return  0 if success
+ * @return -i if the ith argument is invalid
+ *
+ * @param[in] trans noTranspose, conjTranspose or, for real matrices, transpose.
+ * @param[in] V m-by-k matrix, k <= m.
+ *      The Householder vectors, as returned by `lapack::geqrt`.
+ * @param[in] T k-by-k matrix.
+ *      The upper triangular factor of the block reflector.
+ * @param[in,out] C m-by-nc matrix.
+ * @param W k-by-nc workspace.
+ *
+ * @see geqrt( matrix_t& A, matrixT_t& T, matrixW_t& W )
+ *
+ * @ingroup geqrf
+ */
+template<
+    class trans_t, class matrixV_t, class matrixT_t,
+    class matrixC_t, class matrixW_t,
+    enable_if_t<(
+    /* Requires: */
+        is_same_v< trans_t, noTranspose_t > ||
+        is_same_v< trans_t, conjTranspose_t > ||
+        is_same_v< trans_t, transpose_t >
+    ), int > = 0
+>
+int unmqrt(
+    trans_t trans, const matrixV_t& V, const matrixT_t& T,
+    matrixC_t& C, matrixW_t& W )
+{
+    using idx_t = size_type< matrixC_t >;
+    using pair  = std::pair<idx_t,idx_t>;
+    using std::min;
+
+    // constants
+    const idx_t ib = 32; // inner block size
+    const idx_t m  = nrows(C);
+    const idx_t nc = ncols(C);
+    const idx_t k  = ncols(V);
+
+    // check arguments
+    if( is_complex< type_t< matrixV_t > >::value )
+        lapack_error_if( (is_same_v< trans_t, transpose_t >), -1 );
+    lapack_error_if( nrows(V) != m || k > m, -2 );
+    lapack_error_if( nrows(T) < k || ncols(T) < k, -3 );
+    lapack_error_if( nrows(W) < k || ncols(W) < nc, -5 );
+
+    // quick return
+    if (m <= 0 || nc <= 0 || k <= 0) return 0;
+
+    // Apply the reflectors in blocks of ib columns, so that the trmm with
+    // the diagonal blocks of T stays cheap compared to the gemms
+    const idx_t nblocks = (k + ib-1) / ib;
+    const bool forward_sweep = is_same_v< trans_t, conjTranspose_t >
+                            || is_same_v< trans_t, transpose_t >;
+
+    for(idx_t s = 0; s < nblocks; ++s) {
+
+        const idx_t j  = ( forward_sweep ? s : nblocks-1-s ) * ib;
+        const idx_t jb = min<idx_t>( ib, k-j );
+
+        const auto Vj = submatrix( V, pair{j,m}, pair{j,j+jb} );
+        const auto Tj = submatrix( T, pair{j,j+jb}, pair{j,j+jb} );
+        auto Cj = submatrix( C, pair{j,m}, pair{0,nc} );
+        auto Wj = submatrix( W, pair{0,jb}, pair{0,nc} );
+        larfb( left_side, trans, forward, columnwise_storage, Vj, Tj, Cj, Wj );
+    }
+
+    return 0;
+}
+
+/** Workspace query for `lapack::unmqrt`.
+ *
+ * @return A k-by-nc matrix, where V is m-by-k and C is m-by-nc.
+ *
+ * @see unmqrt( trans_t trans, const matrixV_t& V, const matrixT_t& T, matrixC_t& C, matrixW_t& W )
+ *
+ * @ingroup geqrf
+ */
+template< class trans_t, class matrixV_t, class matrixT_t, class matrixC_t >
+inline workinfo_t unmqrt_worksize(
+    trans_t, const matrixV_t& V, const matrixT_t&, const matrixC_t& C )
+{
+    return make_workinfo< type_t<matrixC_t> >( ncols(V), ncols(C) );
+}
+
+} // lapack
+
+#endif // __UNMQRT_HH__
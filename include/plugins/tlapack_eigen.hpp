@@ -37,6 +37,9 @@ namespace blas{
         template< class T > struct sizet_trait {};
         template< class T >
         using size_type = typename sizet_trait< T >::type;
+        // Strided storage: pointer to the first entry and distance between
+        // entries along each dimension. Only for arrays with such storage.
+        template< class T, class Enable = int > struct storage_trait {};
 
     #endif // TBLAS_ARRAY_TRAITS
 
@@ -76,6 +79,36 @@ namespace blas{
         using type = Eigen::Index;
     };
 
+    // Strided storage, for the expressions with direct access to their data
+    namespace internal {
+        template< class T >
+        using eigen_direct_access = typename std::enable_if<
+            ( Eigen::internal::traits<T>::Flags & Eigen::DirectAccessBit ) != 0, int >::type;
+
+        template< class T >
+        struct eigen_storage_trait {
+            static inline auto data( const T& A ) {
+                return A.data();
+            }
+            static inline Eigen::Index stride( const T& A, std::size_t r ) {
+                return ( T::IsVectorAtCompileTime ) ? A.innerStride()
+                     : ( r == 0 ) ? A.rowStride() : A.colStride();
+            }
+            static constexpr bool is_rowmajor =
+                !T::IsVectorAtCompileTime && ( int(T::Flags) & Eigen::RowMajorBit );
+        };
+    }
+    template<typename Scalar_, int Rows_, int Cols_, int Options_, int MaxRows_, int MaxCols_>
+    struct storage_trait< Eigen::Matrix<Scalar_, Rows_, Cols_, Options_, MaxRows_, MaxCols_> >
+        : internal::eigen_storage_trait< Eigen::Matrix<Scalar_, Rows_, Cols_, Options_, MaxRows_, MaxCols_> > {};
+    template<typename XprType, int BlockRows, int BlockCols, bool InnerPanel>
+    struct storage_trait< Eigen::Block<XprType, BlockRows, BlockCols, InnerPanel>,
+        internal::eigen_direct_access< Eigen::Block<XprType, BlockRows, BlockCols, InnerPanel> > >
+        : internal::eigen_storage_trait< Eigen::Block<XprType, BlockRows, BlockCols, InnerPanel> > {};
+    template<class T>
+    struct storage_trait< Eigen::VectorBlock<T>, internal::eigen_direct_access< Eigen::VectorBlock<T> > >
+        : internal::eigen_storage_trait< Eigen::VectorBlock<T> > {};
+
     // -----------------------------------------------------------------------------
     // blas functions to access Eigen properties
 
@@ -46,6 +46,9 @@ namespace blas {
         template< class T > struct sizet_trait {};
         template< class T >
         using size_type = typename sizet_trait< T >::type;
+        // Strided storage: pointer to the first entry and distance between
+        // entries along each dimension. Only for arrays with such storage.
+        template< class T, class Enable = int > struct storage_trait {};
 
     #endif // TBLAS_ARRAY_TRAITS
 
@@ -59,6 +62,21 @@ namespace blas {
     struct sizet_trait< mdspan<ET,Exts,LP,AP> > {
         using type = typename mdspan<ET,Exts,LP,AP>::size_type;
     };
+    // Strided storage, if the layout is strided and the accessor is the default
+    template< class ET, class Exts, class LP, class AP >
+    struct storage_trait< mdspan<ET,Exts,LP,AP>, enable_if_t<
+        LP::template mapping<Exts>::is_always_strided() &&
+        std::is_same< AP, std::experimental::default_accessor<ET> >::value
+    , int > > {
+        static constexpr ET* data( const mdspan<ET,Exts,LP,AP>& A ) {
+            return A.data();
+        }
+        static constexpr auto stride( const mdspan<ET,Exts,LP,AP>& A, std::size_t r ) {
+            return A.stride(r);
+        }
+        static constexpr bool is_rowmajor =
+            std::is_same< LP, std::experimental::layout_right >::value;
+    };
 
     // -----------------------------------------------------------------------------
     // blas functions to access mdspan properties
@@ -27,6 +27,9 @@ namespace blas {
         template< class T > struct sizet_trait {};
         template< class T >
         using size_type = typename sizet_trait< T >::type;
+        // Strided storage: pointer to the first entry and distance between
+        // entries along each dimension. Only for arrays with such storage.
+        template< class T, class Enable = int > struct storage_trait {};
 
     #endif // TBLAS_ARRAY_TRAITS
 
@@ -40,6 +43,16 @@ namespace blas {
     struct sizet_trait< std::vector<T,Allocator> > {
         using type = typename std::vector<T,Allocator>::size_type;
     };
+    // Strided storage
+    template< class T, class Allocator >
+    struct storage_trait< std::vector<T,Allocator> > {
+        static inline const T* data( const std::vector<T,Allocator>& x ) {
+            return x.data();
+        }
+        static constexpr std::size_t stride( const std::vector<T,Allocator>&, std::size_t ) {
+            return 1;
+        }
+    };
 
     // -----------------------------------------------------------------------------
     // blas functions to access std::vector properties
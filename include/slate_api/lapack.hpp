@@ -21,6 +21,7 @@
 #include "slate_api/lapack/types.hpp"
 #include "slate_api/blas/mdspan.hpp"  // Loads mdspan utilities for the wrappers
 #include "plugins/tlapack_mdspan.hpp" // Loads mdspan plugin
+#include "slate_api/lapack/workspace.hpp" // Workspace of the wrappers
 
 // =============================================================================
 // Template LAPACK
@@ -42,14 +43,28 @@
 #include "slate_api/lapack/larnv.hpp"
 #include "slate_api/lapack/lascl.hpp"
 #include "slate_api/lapack/lassq.hpp"
+#include "slate_api/lapack/laswp.hpp"
 
 // QR factorization
 // ----------------
 
 #include "slate_api/lapack/geqr2.hpp"
+#include "slate_api/lapack/geqrf.hpp"
 #include "slate_api/lapack/org2r.hpp"
+#include "slate_api/lapack/ungqr.hpp"
 #include "slate_api/lapack/orm2r.hpp"
 #include "slate_api/lapack/unmqr.hpp"
 // #include "lapack/potrf2.hpp"
 
+// LU factorization
+// ----------------
+
+#include "slate_api/lapack/getrf.hpp"
+#include "slate_api/lapack/getrs.hpp"
+
+// Cholesky factorization
+// ----------------------
+
+#include "slate_api/lapack/potrf.hpp"
+
 #endif // __SLATE_BLAS_HH__
\ No newline at end of file
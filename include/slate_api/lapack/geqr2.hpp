@@ -12,6 +12,7 @@
 #define __SLATE_GEQR2_HH__
 
 #include "lapack/geqr2.hpp"
+#include "slate_api/lapack/workspace.hpp"
 
 namespace lapack {
 
@@ -54,9 +55,10 @@ inline int geqr2(
 
     // Local parameters
     int info = 0;
+    workspace_arena::frame frame( get_workspace_arena() );
     work_t* work;
     if( !is_same_v< TA, Ttau > || n-1 >= m ) {
-        work = new work_t[ (n > 0) ? n-1 : 0 ];
+        work = frame.allocate<work_t>( n-1 );
     } else {
         work = tau + 1;
     }
@@ -68,9 +70,6 @@ inline int geqr2(
     
     info = geqr2( _A, _tau, _work );
 
-    if( !is_same_v< TA, Ttau > || n-1 >= m )
-        delete[] work;
-        
     return info;
 }
 
@@ -0,0 +1,68 @@
+/// @file geqrf.hpp
+//
+// Copyright (c) 2021, University of Colorado Denver. All rights reserved.
+//
+// This file is part of <T>LAPACK.
+// <T>LAPACK is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef __SLATE_GEQRF_HH__
+#define __SLATE_GEQRF_HH__
+
+#include "lapack/geqrf.hpp"
+#include "slate_api/lapack/workspace.hpp"
+
+namespace lapack {
+
+/** Computes a QR factorization of a matrix A using a blocked code.
+ *
+ * @param[in] m The number of rows of the matrix A.
+ * @param[in] n The number of columns of the matrix A.
+ * @param[in,out] A m-by-n matrix.
+ *      On exit, the elements on and above the diagonal of the array
+ *      contain the min(m,n)-by-n upper trapezoidal matrix R
+ *      (R is upper triangular if m >= n); the elements below the diagonal,
+ *      with the array tau, represent the unitary matrix Q as a
+ *      product of elementary reflectors.
+ * @param[in] lda The leading dimension of A. lda >= max(1,m).
+ * @param[out] tau Real vector of length min(m,n).
+ *      The scalar factors of the elementary reflectors.
+ *
+ * @see geqrf( matrix_t& A, vector_t &tau, matrixW_t& W )
+ *
+ * @ingroup geqrf
+ */
+template< typename TA, typename Ttau >
+inline int geqrf(
+    blas::idx_t m, blas::idx_t n,
+    TA*   A, blas::idx_t lda,
+    Ttau* tau )
+{
+    using blas::internal::colmajor_matrix;
+    using blas::internal::vector;
+    using work_t = scalar_type<TA,Ttau>;
+
+    // check arguments
+    lapack_error_if( m < 0, -1 );
+    lapack_error_if( n < 0, -2 );
+    lapack_error_if( lda < m, -4 );
+
+    // quick return
+    if (n <= 0) return 0;
+
+    // Matrix views
+    auto _A    = colmajor_matrix<TA>( A, m, n, lda );
+    auto _tau  = vector<Ttau>  ( tau, std::min<blas::idx_t>( m, n ), 1 );
+
+    // Workspace
+    const workinfo_t winfo = geqrf_worksize( _A, _tau );
+    workspace_arena::frame frame( get_workspace_arena() );
+    auto _W    = colmajor_matrix<work_t>(
+        frame.allocate<work_t>( winfo ), winfo.m, winfo.n );
+
+    return geqrf( _A, _tau, _W );
+}
+
+} // lapack
+
+#endif // __SLATE_GEQRF_HH__
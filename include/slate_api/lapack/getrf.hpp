@@ -0,0 +1,71 @@
+/// @file getrf.hpp
+//
+// Copyright (c) 2021, University of Colorado Denver. All rights reserved.
+//
+// This file is part of <T>LAPACK.
+// <T>LAPACK is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef __SLATE_GETRF_HH__
+#define __SLATE_GETRF_HH__
+
+#include "lapack/getrf.hpp"
+
+namespace lapack {
+
+/** Computes an LU factorization of a general m-by-n matrix A using partial
+ * pivoting with row interchanges.
+ *
+ * @param[in] m The number of rows of the matrix A.
+ * @param[in] n The number of columns of the matrix A.
+ * @param[in,out] A m-by-n matrix.
+ *      On exit, the factors L and U from the factorization $A = P L U$;
+ *      the unit diagonal elements of L are not stored.
+ * @param[in] lda The leading dimension of A. lda >= max(1,m).
+ * @param[out] ipiv Vector of length min(m,n).
+ *      The pivot indices: for 1 <= i <= min(m,n), the row i of the matrix
+ *      was interchanged with the row ipiv(i).
+ *
+ * @return = 0: successful exit
+ * @return -i if the ith argument is invalid
+ * @return > 0: if return value = i, U(i,i) is exactly zero.
+ *
+ * @see getrf( matrix_t& A, vector_t& piv )
+ *
+ * @ingroup gesv_computational
+ */
+template< typename TA >
+inline int getrf(
+    blas::idx_t m, blas::idx_t n,
+    TA* A, blas::idx_t lda,
+    blas::int_t* ipiv )
+{
+    using blas::internal::colmajor_matrix;
+    using blas::internal::vector;
+
+    // check arguments
+    lapack_error_if( m < 0, -1 );
+    lapack_error_if( n < 0, -2 );
+    lapack_error_if( lda < m, -4 );
+
+    // quick return
+    if (m <= 0 || n <= 0) return 0;
+
+    const blas::idx_t k = std::min<blas::idx_t>( m, n );
+
+    // Matrix views
+    auto _A   = colmajor_matrix<TA>( A, m, n, lda );
+    auto _piv = vector<blas::int_t>( ipiv, k, 1 );
+
+    int info = getrf( _A, _piv );
+
+    // Use 1-based pivot indices
+    for (blas::idx_t i = 0; i < k; ++i)
+        ++ipiv[i];
+
+    return info;
+}
+
+} // lapack
+
+#endif // __SLATE_GETRF_HH__
@@ -0,0 +1,89 @@
+/// @file getrs.hpp
+//
+// Copyright (c) 2021, University of Colorado Denver. All rights reserved.
+//
+// This file is part of <T>LAPACK.
+// <T>LAPACK is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef __SLATE_GETRS_HH__
+#define __SLATE_GETRS_HH__
+
+#include "lapack/getrs.hpp"
+#include "slate_api/lapack/workspace.hpp"
+
+namespace lapack {
+
+/** Solves a system of linear equations op(A) X = B with a general n-by-n
+ * matrix A using the LU factorization computed by `lapack::getrf`.
+ *
+ * @param[in] trans
+ *     - lapack::Op::NoTrans:   $A X = B$;
+ *     - lapack::Op::Trans:     $A^T X = B$;
+ *     - lapack::Op::ConjTrans: $A^H X = B$.
+ * @param[in] n The order of the matrix A. n >= 0.
+ * @param[in] nrhs The number of columns of the matrix B. nrhs >= 0.
+ * @param[in] A n-by-n matrix.
+ *      The factors L and U from the factorization $A = P L U$.
+ * @param[in] lda The leading dimension of A. lda >= max(1,n).
+ * @param[in] ipiv Vector of length n.
+ *      The 1-based pivot indices from `lapack::getrf`.
+ * @param[in,out] B n-by-nrhs matrix.
+ *      On entry, the right hand side matrix B.
+ *      On exit, the solution matrix X.
+ * @param[in] ldb The leading dimension of B. ldb >= max(1,n).
+ *
+ * @return  0 if success
+ * @return -i if the ith argument is invalid
+ *
+ * @see getrs( trans_t trans, const matrix_t& A, const vector_t& piv, matrixB_t& B )
+ *
+ * @ingroup gesv_computational
+ */
+template< typename TA, typename TB >
+inline int getrs(
+    Op trans, blas::idx_t n, blas::idx_t nrhs,
+    TA const* A, blas::idx_t lda,
+    blas::int_t const* ipiv,
+    TB* B, blas::idx_t ldb )
+{
+    using blas::internal::colmajor_matrix;
+    using blas::internal::vector;
+
+    // check arguments
+    lapack_error_if(    trans != Op::NoTrans &&
+                        trans != Op::Trans &&
+                        trans != Op::ConjTrans, -1 );
+    lapack_error_if( n < 0, -2 );
+    lapack_error_if( nrhs < 0, -3 );
+    lapack_error_if( lda < n, -5 );
+    lapack_error_if( ldb < n, -8 );
+
+    // quick return
+    if (n <= 0 || nrhs <= 0) return 0;
+
+    // Use 0-based pivot indices
+    workspace_arena::frame frame( get_workspace_arena() );
+    blas::idx_t* piv = frame.allocate<blas::idx_t>( n );
+    for (blas::idx_t i = 0; i < n; ++i)
+        piv[i] = ipiv[i] - 1;
+
+    // Matrix views
+    const auto _A = colmajor_matrix<TA>( (TA*)A, n, n, lda );
+    const auto _piv = vector<blas::idx_t>( piv, n, 1 );
+    auto _B = colmajor_matrix<TB>( B, n, nrhs, ldb );
+
+    int info = 0;
+    if (trans == Op::NoTrans)
+        info = getrs( noTranspose, _A, _piv, _B );
+    else if (trans == Op::Trans)
+        info = getrs( transpose, _A, _piv, _B );
+    else // (trans == Op::ConjTrans)
+        info = getrs( conjTranspose, _A, _piv, _B );
+
+    return info;
+}
+
+} // lapack
+
+#endif // __SLATE_GETRS_HH__
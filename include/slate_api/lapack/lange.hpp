@@ -12,6 +12,7 @@
 #define __SLATE_LANGE_HH__
 
 #include "lapack/lange.hpp"
+#include "slate_api/lapack/workspace.hpp"
 
 namespace lapack {
 
@@ -59,11 +60,10 @@ inline real_type<TA> lange(
     else if ( normType == Norm::One )
         return lange( one_norm, A );
     else if ( normType == Norm::Inf ){
-        real_t *work = new real_t[m];
+        workspace_arena::frame frame( get_workspace_arena() );
+        real_t *work = frame.allocate<real_t>( m );
         auto _work = vector<real_t>( work, m, 1 );
-        auto aux = lange( inf_norm, A, _work );
-        delete[] work;
-        return aux;
+        return lange( inf_norm, A, _work );
     } else if ( normType == Norm::Fro )
         return lange( frob_norm, A );
     else
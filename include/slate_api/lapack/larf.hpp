@@ -12,7 +12,7 @@
 #define __SLATE_LARF_HH__
 
 #include "lapack/larf.hpp"
-#include <memory>
+#include "slate_api/lapack/workspace.hpp"
 
 namespace lapack {
 
@@ -42,10 +42,8 @@ inline void larf(
     blas_error_if( incv == 0 );
     blas_error_if( ldC < m );
 
-    // scalar_t *work = new scalar_t[ ( side == Side::Left ) ? n : m ];
-    std::unique_ptr<scalar_t[]> work(new scalar_t[
-        ( side == Side::Left ) ? n : m
-    ]);
+    workspace_arena::frame frame( get_workspace_arena() );
+    scalar_t *work = frame.allocate<scalar_t>( ( side == Side::Left ) ? n : m );
 
     // Initialize indexes
     idx_t lenv  = (( side == Side::Left ) ? m : n);
@@ -62,8 +60,6 @@ inline void larf(
         larf( left_side, _v, tau, _C, _work);
     else
         larf( right_side, _v, tau, _C, _work);
-        
-    // delete[] work;
 }
 
 } // lapack
@@ -12,6 +12,7 @@
 #define __SLATE_LARFB_HH__
 
 #include "lapack/larfb.hpp"
+#include "slate_api/lapack/workspace.hpp"
 
 namespace lapack {
 
@@ -131,7 +132,8 @@ int larfb(
     if (m <= 0 || n <= 0) return 0;
 
     // local variables
-    scalar_t *W = new scalar_t[ (side == Side::Left) ? k*n : m*k ];
+    workspace_arena::frame frame( get_workspace_arena() );
+    scalar_t *W = frame.allocate<scalar_t>( (side == Side::Left) ? k*n : m*k );
 
     // Views
     const auto _V = (storeV == StoreV::Columnwise)
@@ -301,7 +303,6 @@ int larfb(
         }
     }
 
-    delete[] W;
     return info;
 }
 
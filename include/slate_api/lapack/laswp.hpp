@@ -0,0 +1,74 @@
+/// @file laswp.hpp
+//
+// Copyright (c) 2021, University of Colorado Denver. All rights reserved.
+//
+// This file is part of <T>LAPACK.
+// <T>LAPACK is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef __SLATE_LASWP_HH__
+#define __SLATE_LASWP_HH__
+
+#include "lapack/laswp.hpp"
+#include "slate_api/lapack/workspace.hpp"
+
+namespace lapack {
+
+/** Performs a series of row interchanges on the matrix A.
+ *
+ * One row interchange is initiated for each of rows k1 through k2 of A.
+ *
+ * @param[in] n The number of columns of the matrix A.
+ * @param[in,out] A lda-by-n matrix.
+ *      On exit, the permuted matrix.
+ * @param[in] lda The leading dimension of A.
+ * @param[in] k1 The first element of ipiv for which a row interchange will
+ *      be done. 1 <= k1.
+ * @param[in] k2 The last element of ipiv for which a row interchange will
+ *      be done. k1 <= k2 <= lda.
+ * @param[in] ipiv Vector of length k1+(k2-k1)*abs(incx).
+ *      The 1-based pivot indices. Row k of A is interchanged with row
+ *      ipiv(k1+(k-k1)*abs(incx)).
+ * @param[in] incx The increment between successive values of ipiv.
+ *      If incx is negative, the pivots are applied in reverse order.
+ *
+ * @see laswp( direction_t direction, matrix_t& A, const vector_t& piv )
+ *
+ * @ingroup auxiliary
+ */
+template< typename TA >
+inline void laswp(
+    blas::idx_t n,
+    TA* A, blas::idx_t lda,
+    blas::idx_t k1, blas::idx_t k2,
+    blas::int_t const* ipiv, blas::int_t incx )
+{
+    using blas::internal::colmajor_matrix;
+    using blas::internal::vector;
+
+    // quick return
+    if (n <= 0 || incx == 0 || k1 < 1 || k2 < k1) return;
+
+    const blas::idx_t inc = (incx > 0) ? incx : -incx;
+
+    // 0-based pivot indices for the rows 0 to k2-1
+    workspace_arena::frame frame( get_workspace_arena() );
+    blas::idx_t* piv = frame.allocate<blas::idx_t>( k2 );
+    for (blas::idx_t i = 0; i < k1-1; ++i)
+        piv[i] = i;
+    for (blas::idx_t i = k1-1; i < k2; ++i)
+        piv[i] = ipiv[ (k1-1) + (i-k1+1)*inc ] - 1;
+
+    // Matrix views
+    auto _A = colmajor_matrix<TA>( A, lda, n, lda );
+    const auto _piv = vector<blas::idx_t>( piv, k2, 1 );
+
+    if (incx > 0)
+        laswp( forward, _A, _piv );
+    else
+        laswp( backward, _A, _piv );
+}
+
+} // lapack
+
+#endif // __SLATE_LASWP_HH__
@@ -12,6 +12,7 @@
 #define __SLATE_ORG2R_HH__
 
 #include "lapack/org2r.hpp"
+#include "slate_api/lapack/workspace.hpp"
 
 #include "tblas.hpp"
 
@@ -59,7 +60,8 @@ inline int org2r(
 
     // Local parameters
     int info = 0;
-    TA* work = new TA[ (n > 0) ? n-1 : 0 ];
+    workspace_arena::frame frame( get_workspace_arena() );
+    TA* work = frame.allocate<TA>( n-1 );
 
     // Matrix views
     auto _A    = colmajor_matrix<TA>( A, m, n, lda );
@@ -68,7 +70,6 @@ inline int org2r(
     
     info = org2r( k, _A, _tau, _work );
 
-    delete[] work;
     return info;
 }
 
@@ -12,6 +12,7 @@
 #define __SLATE_ORM2R_HH__
 
 #include "lapack/orm2r.hpp"
+#include "slate_api/lapack/workspace.hpp"
 
 namespace lapack {
 
@@ -77,32 +78,34 @@ inline int orm2r(
         return 0;
 
     int info = 0;
-    scalar_t* work = new scalar_t[ (q > 0) ? q : 0 ];
 
     // Matrix views
     const auto _A = colmajor_matrix<TA>( (TA*)A, q, k, lda );
-    const auto _tau = vector<TA>( (TA*)tau, k );
+    const auto _tau = vector<TA>( (TA*)tau, k, 1 );
     auto _C = colmajor_matrix<TC>( C, m, n, ldc );
-    auto _work = vector<TC>( work, q );
+
+    // Workspace
+    const idx_t lwork = (side == Side::Left) ? n : m;
+    workspace_arena::frame frame( get_workspace_arena() );
+    auto _work = vector<scalar_t>( frame.allocate<scalar_t>( lwork ), lwork, 1 );
 
     if( side == Side::Left ) {
         if( trans == Op::NoTrans )
-            info = orm2r( left_side, noTranspose, A, _tau, _C, _work );
+            info = orm2r( left_side, noTranspose, _A, _tau, _C, _work );
         else if( trans == Op::Trans )
-            info = orm2r( left_side, transpose, A, _tau, _C, _work );
+            info = orm2r( left_side, transpose, _A, _tau, _C, _work );
         else
-            info = orm2r( left_side, conjTranspose, A, _tau, _C, _work );
+            info = orm2r( left_side, conjTranspose, _A, _tau, _C, _work );
     }
     else { // side == Side::Right
         if( trans == Op::NoTrans )
-            info = orm2r( right_side, noTranspose, A, _tau, _C, _work );
+            info = orm2r( right_side, noTranspose, _A, _tau, _C, _work );
         else if( trans == Op::Trans )
-            info = orm2r( right_side, transpose, A, _tau, _C, _work );
+            info = orm2r( right_side, transpose, _A, _tau, _C, _work );
         else
-            info = orm2r( right_side, conjTranspose, A, _tau, _C, _work );
+            info = orm2r( right_side, conjTranspose, _A, _tau, _C, _work );
     }
 
-    delete[] work;
     return info;
 }
 
@@ -0,0 +1,71 @@
+/// @file potrf.hpp
+//
+// Copyright (c) 2021, University of Colorado Denver. All rights reserved.
+//
+// This file is part of <T>LAPACK.
+// <T>LAPACK is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef __SLATE_POTRF_HH__
+#define __SLATE_POTRF_HH__
+
+#include "lapack/types.hpp"
+#include "lapack/potrf.hpp"
+
+namespace lapack {
+
+/** Computes the Cholesky factorization of a Hermitian
+ * positive definite matrix A using a blocked algorithm.
+ *
+ * The factorization has the form
+ *     $A = U^H U,$ if uplo = Upper, or
+ *     $A = L L^H,$ if uplo = Lower,
+ * where U is an upper triangular matrix and L is lower triangular.
+ *
+ * @param[in] uplo
+ *     - lapack::Uplo::Upper: Upper triangle of A is stored;
+ *     - lapack::Uplo::Lower: Lower triangle of A is stored.
+ * @param[in] n The order of the matrix A. n >= 0.
+ * @param[in,out] A n-by-n matrix.
+ *     On entry, the Hermitian matrix A. Only the triangle given by uplo
+ *     is referenced.
+ *     On successful exit, the factor U or L from the Cholesky
+ *     factorization $A = U^H U$ or $A = L L^H.$
+ * @param[in] lda The leading dimension of A. lda >= max(1,n).
+ *
+ * @return = 0: successful exit
+ * @return -i if the ith argument is invalid
+ * @return > 0: if return value = i, the leading minor of order i is not
+ *     positive definite, and the factorization could not be completed.
+ *
+ * @see potrf( uplo_t uplo, matrix_t& A, size_type< matrix_t > nb )
+ *
+ * @ingroup posv_computational
+ */
+template< typename TA >
+inline int potrf(
+    Uplo uplo, blas::idx_t n,
+    TA* A, blas::idx_t lda )
+{
+    using blas::internal::colmajor_matrix;
+
+    // check arguments
+    lapack_error_if( uplo != Uplo::Lower &&
+                     uplo != Uplo::Upper, -1 );
+    lapack_error_if( n < 0, -2 );
+    lapack_error_if( lda < n, -4 );
+
+    // quick return
+    if (n <= 0) return 0;
+
+    // Matrix views
+    auto _A = colmajor_matrix<TA>( A, n, n, lda );
+
+    return ( uplo == Uplo::Upper )
+        ? potrf( upper_triangle, _A )
+        : potrf( lower_triangle, _A );
+}
+
+} // lapack
+
+#endif // __SLATE_POTRF_HH__
@@ -0,0 +1,89 @@
+/// @file ungqr.hpp
+//
+// Copyright (c) 2021, University of Colorado Denver. All rights reserved.
+//
+// This file is part of <T>LAPACK.
+// <T>LAPACK is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef __SLATE_UNGQR_HH__
+#define __SLATE_UNGQR_HH__
+
+#include "lapack/ungqr.hpp"
+#include "slate_api/lapack/workspace.hpp"
+
+namespace lapack {
+
+/** Generates an m-by-n matrix Q with orthonormal columns using a blocked code.
+ * \[
+ *     Q  =  H_1 H_2 ... H_k
+ * \]
+ *
+ * @return  0 if success
+ * @return -i if the ith argument is invalid
+ *
+ * @param[in] m The number of rows of the matrix A. m>=0
+ * @param[in] n The number of columns of the matrix A. m>=n>=0
+ * @param[in] k The number of elementary reflectors whose product defines the matrix Q. n>=k>=0
+ * @param[in,out] A m-by-n matrix.
+ *      On entry, the i-th column must contains the vector which defines the
+ *      elementary reflector $H_i$, for $i=0,1,...,k-1$, as returned by GEQRF in the
+ *      first k columns of its array argument A.
+ *      On exit, the m-by-n matrix $Q  =  H_1 H_2 ... H_k$.
+ * @param[in] lda The leading dimension of A. lda >= max(1,m).
+ * @param[in] tau Vector of length k.
+ *      The scalar factors of the elementary reflectors.
+ *
+ * @see ungqr( size_type< matrix_t > k, matrix_t& A, const vector_t &tau, matrixW_t& W )
+ *
+ * @ingroup geqrf
+ */
+template< typename TA, typename Ttau >
+inline int ungqr(
+    blas::idx_t m, blas::idx_t n, blas::idx_t k,
+    TA* A, blas::idx_t lda,
+    const Ttau* tau )
+{
+    using blas::internal::colmajor_matrix;
+    using blas::internal::vector;
+
+    // check arguments
+    lapack_error_if( m < 0, -1 );
+    lapack_error_if( n < 0 || n > m, -2 );
+    lapack_error_if( k < 0 || k > n, -3 );
+    lapack_error_if( lda < m, -5 );
+
+    // quick return
+    if (n <= 0) return 0;
+
+    // Matrix views
+    auto _A    = colmajor_matrix<TA>( A, m, n, lda );
+    auto _tau  = vector<Ttau>( (Ttau*)tau, k, 1 );
+
+    // Workspace
+    const workinfo_t winfo = ungqr_worksize( k, _A, _tau );
+    workspace_arena::frame frame( get_workspace_arena() );
+    auto _W    = colmajor_matrix<TA>(
+        frame.allocate<TA>( winfo ), winfo.m, winfo.n );
+
+    return ungqr( k, _A, _tau, _W );
+}
+
+/** Generates an m-by-n matrix Q with orthonormal columns using a blocked code.
+ *
+ * @see ungqr( blas::idx_t, blas::idx_t, blas::idx_t, TA*, blas::idx_t, const Ttau* )
+ *
+ * @ingroup geqrf
+ */
+template< typename TA, typename Ttau >
+inline int orgqr(
+    blas::idx_t m, blas::idx_t n, blas::idx_t k,
+    TA* A, blas::idx_t lda,
+    const Ttau* tau )
+{
+    return ungqr( m, n, k, A, lda, tau );
+}
+
+} // lapack
+
+#endif // __SLATE_UNGQR_HH__
@@ -11,6 +11,7 @@
 #define __SLATE_UNMQR_HH__
 
 #include "lapack/unmqr.hpp"
+#include "slate_api/lapack/workspace.hpp"
 
 namespace lapack {
 
@@ -95,24 +96,20 @@ inline int unmqr(
     using blas::internal::colmajor_matrix;
     using blas::internal::vector;
 
-    // Constants
-    const int nb = 32;      // number of blocks
-    
-    // Allocate work
-    const idx_t nw = (side == Side::Left)
-                ? ( (n >= 1) ? n : 1 )
-                : ( (m >= 1) ? m : 1 );
-    scalar_t* work = new scalar_t[
-        nw*nb + nb*nb
-    ];
-
     // Matrix views
     const auto _A = (side == Side::Left)
             ? colmajor_matrix<TA>( (TA*)A, m, k, lda )
             : colmajor_matrix<TA>( (TA*)A, n, k, lda );
     const auto _tau = vector<TA>( (TA*)tau, k, 1 );
     auto _C = colmajor_matrix<TC>( C, m, n, ldc );
-    auto _W = colmajor_matrix<scalar_t>( work, nb, nw+nb );
+
+    // Workspace
+    const workinfo_t winfo = (side == Side::Left)
+            ? unmqr_worksize( left_side, noTranspose, _A, _tau, _C )
+            : unmqr_worksize( right_side, noTranspose, _A, _tau, _C );
+    workspace_arena::frame frame( get_workspace_arena() );
+    auto _W = colmajor_matrix<scalar_t>(
+        frame.allocate<scalar_t>( winfo ), winfo.m, winfo.n );
     
     int info = 0;
     if (side == Side::Left) {
@@ -146,7 +143,6 @@ inline int unmqr(
         }
     }
 
-    delete[] work;
     return info;
 }
 
@@ -0,0 +1,221 @@
+/// @file workspace.hpp Reusable workspace for the wrappers of the slate_api.
+//
+// Copyright (c) 2021, University of Colorado Denver. All rights reserved.
+//
+// This file is part of <T>LAPACK.
+// <T>LAPACK is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef __SLATE_WORKSPACE_HH__
+#define __SLATE_WORKSPACE_HH__
+
+#include "lapack/types.hpp"
+#include "blas/utils.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace lapack {
+
+/** Stack of workspaces that reuses its memory across calls.
+ *
+ * Workspaces are taken from the arena through a `workspace_arena::frame`.
+ * All the workspaces taken through a frame are given back when the frame is
+ * destroyed, so that the next call reuses the same memory. A workspace is
+ * taken by moving a pointer forward; memory is only allocated when the
+ * arena has no room left. Every workspace is aligned at
+ * TLAPACK_WORKSPACE_ALIGNMENT bytes or more.
+ *
+ * The arena grows monotonically. When a workspace does not fit in the
+ * current block, a new block of at least twice the capacity is appended.
+ * The blocks are merged into a single one the next time the arena is empty,
+ * so that, after a warm-up, every call is served by a single block and no
+ * memory is allocated.
+ *
+ * A workspace_arena must only be used by one thread at a time. Each thread
+ * has its own default arena, see `get_workspace_arena()`.
+ *
+ * @ingroup auxiliary
+ */
+class workspace_arena {
+public:
+
+    /// Workspaces taken through a frame are given back at its destruction
+    class frame {
+    public:
+        explicit frame( workspace_arena& arena )
+        : arena_(arena), block_(arena.block_), offset_(arena.offset_) {}
+
+        ~frame() {
+            arena_.block_  = block_;
+            arena_.offset_ = offset_;
+        }
+
+        frame( const frame& ) = delete;
+        frame& operator=( const frame& ) = delete;
+
+        /// Workspace of n elements of type T aligned at alignment bytes,
+        /// or at TLAPACK_WORKSPACE_ALIGNMENT bytes if that is larger
+        template< class T >
+        T* allocate( std::size_t n, std::size_t alignment = alignof(T) ) {
+            return static_cast<T*>(
+                arena_.allocate( n * sizeof(T), alignment ) );
+        }
+
+        /// Workspace from a `*_worksize` query
+        template< class T >
+        T* allocate( const workinfo_t& w ) {
+            return allocate<T>( w.size(),
+                ( w.alignment > alignof(T) ) ? w.alignment : alignof(T) );
+        }
+
+    private:
+        workspace_arena& arena_;
+        std::size_t block_;
+        std::size_t offset_;
+    };
+
+    workspace_arena() = default;
+    workspace_arena( const workspace_arena& ) = delete;
+    workspace_arena& operator=( const workspace_arena& ) = delete;
+
+    /// Total number of bytes owned by the arena
+    std::size_t capacity() const {
+        std::size_t c = 0;
+        for( const auto& b : blocks_ )
+            c += b.size;
+        return c;
+    }
+
+    /// True if no workspace is taken
+    bool empty() const { return block_ == 0 && offset_ == 0; }
+
+    /// Makes sure the arena holds a workspace of at least nbytes in a
+    /// single block. Must be called while the arena is empty.
+    void reserve( std::size_t nbytes ) {
+        blas_error_if( !empty() );
+        merge_blocks( nbytes );
+    }
+
+    /// Frees all the memory of the arena.
+    /// Must be called while the arena is empty.
+    void release() {
+        blas_error_if( !empty() );
+        blocks_.clear();
+    }
+
+private:
+
+    struct block_t {
+        std::unique_ptr< unsigned char[] > data;
+        std::size_t size;
+    };
+
+    std::vector< block_t > blocks_;
+    std::size_t block_  = 0; ///< Index of the current block
+    std::size_t offset_ = 0; ///< First free byte in the current block
+
+    /// Replaces the blocks by a single one that holds an aligned workspace
+    /// of nbytes, if there is more than one block or it is too small
+    void merge_blocks( std::size_t nbytes ) {
+        if( nbytes > 0 )
+            nbytes += TLAPACK_WORKSPACE_ALIGNMENT;
+        const std::size_t c = capacity();
+        if( c < nbytes || blocks_.size() > 1 ) {
+            const std::size_t size = ( c > nbytes ) ? c : nbytes;
+            blocks_.clear();
+            blocks_.push_back( block_t{
+                std::unique_ptr< unsigned char[] >( new unsigned char[size] ),
+                size } );
+        }
+    }
+
+    /// Pointer to the first byte of the block b, after offset, aligned at
+    /// alignment bytes, or nullptr if nbytes do not fit
+    unsigned char* fit(
+        std::size_t b, std::size_t offset,
+        std::size_t nbytes, std::size_t alignment ) const
+    {
+        if( b >= blocks_.size() )
+            return nullptr;
+        unsigned char* p = blocks_[b].data.get() + offset;
+        const std::size_t pad =
+            ( alignment - std::uintptr_t(p) % alignment ) % alignment;
+        return ( offset + pad + nbytes <= blocks_[b].size ) ? p + pad : nullptr;
+    }
+
+    void* allocate( std::size_t nbytes, std::size_t alignment ) {
+        if( alignment < TLAPACK_WORKSPACE_ALIGNMENT )
+            alignment = TLAPACK_WORKSPACE_ALIGNMENT;
+        if( empty() && blocks_.size() > 1 )
+            merge_blocks( 0 );
+
+        // Current block, then the next blocks, then a new block
+        unsigned char* p = fit( block_, offset_, nbytes, alignment );
+        std::size_t b = block_;
+        while( !p && ++b < blocks_.size() )
+            p = fit( b, 0, nbytes, alignment );
+        if( !p ) {
+            const std::size_t c = 2 * capacity();
+            const std::size_t size = ( c > nbytes + alignment )
+                                   ? c : nbytes + alignment;
+            blocks_.push_back( block_t{
+                std::unique_ptr< unsigned char[] >( new unsigned char[size] ),
+                size } );
+            b = blocks_.size() - 1;
+            p = fit( b, 0, nbytes, alignment );
+        }
+
+        block_  = b;
+        offset_ = ( p - blocks_[b].data.get() ) + nbytes;
+        return p;
+    }
+};
+
+namespace internal {
+
+inline workspace_arena*& current_workspace_arena() {
+    static thread_local workspace_arena* arena = nullptr;
+    return arena;
+}
+
+} // namespace internal
+
+/** Arena used by the wrappers of the slate_api in the calling thread.
+ *
+ * This is the arena set by `set_workspace_arena()` or, if there is none,
+ * an arena owned by the calling thread.
+ *
+ * @ingroup auxiliary
+ */
+inline workspace_arena& get_workspace_arena() {
+    static thread_local workspace_arena default_arena;
+    workspace_arena* arena = internal::current_workspace_arena();
+    return ( arena ) ? *arena : default_arena;
+}
+
+/** Makes the wrappers of the slate_api in the calling thread use the arena
+ * provided by the caller. If arena is nullptr, the arena owned by the
+ * thread is used again.
+ *
+ * @ingroup auxiliary
+ */
+inline void set_workspace_arena( workspace_arena* arena ) {
+    internal::current_workspace_arena() = arena;
+}
+
+/// Reserves nbytes in the arena of the calling thread
+inline void reserve_workspace( std::size_t nbytes ) {
+    get_workspace_arena().reserve( nbytes );
+}
+
+/// Frees the memory of the arena of the calling thread
+inline void release_workspace() {
+    get_workspace_arena().release();
+}
+
+} // namespace lapack
+
+#endif // __SLATE_WORKSPACE_HH__
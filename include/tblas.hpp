@@ -53,6 +53,7 @@
 // Level 3 BLAS template implementations
 
 #include "blas/gemm.hpp"
+#include "blas/packed_matrix.hpp"
 #include "blas/hemm.hpp"
 #include "blas/herk.hpp"
 #include "blas/her2k.hpp"
@@ -61,5 +62,7 @@
 #include "blas/syr2k.hpp"
 #include "blas/trmm.hpp"
 #include "blas/trsm.hpp"
+#include "blas/gemm_batch.hpp"
+#include "blas/trsm_batch.hpp"
 
 #endif // __BLAS_HH__
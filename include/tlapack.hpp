@@ -17,6 +17,7 @@
 // Auxiliary routines
 // ------------------
 
+#include "lapack/tuning.hpp"
 #include "lapack/larf.hpp"
 #include "lapack/larfg.hpp"
 #include "lapack/larft.hpp"
@@ -31,14 +32,31 @@
 #include "lapack/larnv.hpp"
 #include "lapack/lascl.hpp"
 #include "lapack/lassq.hpp"
+#include "lapack/laswp.hpp"
 
 // QR factorization
 // ----------------
 
 #include "lapack/geqr2.hpp"
+#include "lapack/geqrt3.hpp"
+#include "lapack/geqrf.hpp"
+#include "lapack/geqrt.hpp"
+#include "lapack/tsqrt.hpp"
+#include "lapack/tsqr.hpp"
 #include "lapack/org2r.hpp"
+#include "lapack/ungqr.hpp"
 #include "lapack/orm2r.hpp"
 #include "lapack/unmqr.hpp"
+#include "lapack/unmqrt.hpp"
+#include "lapack/tsmqrt.hpp"
 #include "lapack/potrf2.hpp"
+#include "lapack/potrf.hpp"
+
+// LU factorization
+// ----------------
+
+#include "lapack/getrf.hpp"
+#include "lapack/getrs.hpp"
+#include "lapack/getrf_calu.hpp"
 
 #endif // __TLAPACK_HH__
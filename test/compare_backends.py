@@ -0,0 +1,327 @@
+#!/usr/bin/env python
+#
+# Copyright (c) 2021, University of Colorado Denver. All rights reserved.
+#
+# This file is part of <T>LAPACK.
+# <T>LAPACK is free software: you can redistribute it and/or modify it under
+# the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+#
+# Compares the time of the <T>BLAS and <T>LAPACK templates with the one of
+# the library linked to BLAS++ and LAPACK++ (OpenBLAS, MKL, reference, ...).
+#
+# The testers run both on the same input when --ref y is given. This script
+# runs them with --ref y --check n, reads the time columns of their output
+# and prints, for each routine, the ratio
+#
+#     ratio = (time of the templates) / (time of the reference library)
+#
+# so that ratio > 1 means that the templates are slower.
+#
+# Example usage:
+# help
+#     ./compare_backends.py -h
+#
+# compare gemm and gemv in double precision on the default sizes
+#     ./compare_backends.py --type d gemm gemv
+#
+# compare getrf with lapackpp_tester
+#     ./compare_backends.py --test ./lapackpp_tester getrf
+#
+# compare the Level 3 routines and write the size thresholds, which can be
+# used in TLAPACK_DISPATCH_FILE
+#     ./compare_backends.py --thresholds dispatch.txt gemm symm syrk syr2k trmm trsm
+#
+# Only the routines in dispatch_routines below call BLAS++, so --thresholds
+# requires all the routines to be among them.
+#
+# Other options, e.g., --layout r or --transA t, are passed to the tester.
+
+from __future__ import print_function
+
+import sys
+import re
+import math
+import argparse
+import subprocess
+import io
+import collections
+
+# ------------------------------------------------------------------------------
+# command line arguments
+parser = argparse.ArgumentParser(
+    description='Compares the templates with the reference library of the testers.' )
+
+parser.add_argument( '-t', '--test', action='store',
+    help='tester to run; default "%(default)s"',
+    default='./blaspp_tester' )
+parser.add_argument( '--type', action='store',
+    help='types; default=%(default)s', default='s,d,c,z' )
+parser.add_argument( '--dim', action='store',
+    help='sizes, in the format of the testers; default=%(default)s',
+    default='8,16,32,64,128,256,512,1024' )
+parser.add_argument( '--repeat', action='store', type=int,
+    help='runs of each size, the fastest is kept; default=%(default)s',
+    default=3 )
+parser.add_argument( '--margin', action='store', type=float,
+    help='the reference library wins where ratio > margin; default=%(default)s',
+    default=1.0 )
+parser.add_argument( '--csv', action='store',
+    help='writes all measurements to a CSV file' )
+parser.add_argument( '--thresholds', action='store',
+    help='writes the suggested dispatch thresholds to a file; only for the'
+         ' routines that may call BLAS++' )
+parser.add_argument( 'routines', nargs='+', help='routines to compare' )
+
+(opts, tester_args) = parser.parse_known_args()
+
+# Routines that may call BLAS++, see blas::internal::dispatch_id in
+# include/blas/dispatch.hpp. The dispatch file has no effect on the others.
+dispatch_routines = (
+    'axpy', 'dot', 'nrm2', 'scal',
+    'gemv', 'ger', 'symv', 'trmv', 'trsv',
+    'gemm', 'symm', 'syrk', 'syr2k', 'trmm', 'trsm' )
+
+if (opts.thresholds):
+    others = [ r for r in opts.routines if r not in dispatch_routines ]
+    if (others):
+        parser.error( '--thresholds: %s cannot call BLAS++; the routines with'
+                      ' a threshold are %s'
+                      % (', '.join( others ), ', '.join( dispatch_routines )) )
+
+# ------------------------------------------------------------------------------
+# Output columns of the testers. The other columns are input parameters.
+output_prefixes = ( '<T>', 'Ref.', 'error', 'status' )
+
+# Names of the dimensions, whose product is the size of a problem
+dim_names = ( 'm', 'n', 'k' )
+
+def is_output( name ):
+    return name.startswith( output_prefixes )
+
+def to_float( s ):
+    try:
+        return float( s )
+    except ValueError:
+        return None
+
+# ------------------------------------------------------------------------------
+# Splits a line of testsweeper output in columns. Columns are separated by
+# at least two spaces, while names like "time (s)" only have single spaces.
+# Returns a list of (start, end, text).
+def split_columns( line ):
+    return [ (m.start(), m.end(), m.group())
+             for m in re.finditer( r'\S+(?: \S+)*', line ) ]
+
+# ------------------------------------------------------------------------------
+# Parses the output of a tester. Returns a list of ordered dicts, one per
+# row, that map the column names to their values. Two-line column names, such
+# as "<T>BLAS" over "time (s)", are joined with a space.
+def parse_output( output ):
+    rows = []
+    names = None
+    lines = output.splitlines()
+    for i in range( len( lines ) ):
+        line = lines[i]
+        if (line.startswith( '%' ) or not line.strip()):
+            continue
+
+        # header: the second line has "time (s)"
+        if ('time (s)' in line and i > 0):
+            top = split_columns( lines[i-1] )
+            names = []
+            for (start, end, text) in split_columns( line ):
+                # part of the name on the line above, right-aligned with it
+                above = [ t for (s, e, t) in top if s < end and e > start ]
+                names.append( ' '.join( above + [ text ] ) )
+            continue
+
+        if (names is None):
+            continue
+
+        values = [ v for (s, e, v) in split_columns( line ) ]
+        if (len( values ) < len( names ) - 1):
+            continue
+        row = collections.OrderedDict( zip( names, values ) )
+        if (to_float( row.get( time_col( names ), '' ) ) is None):
+            continue
+        rows.append( row )
+    return rows
+
+# Name of the column with the time of the templates, and of the reference
+def time_col( names ):
+    for name in names:
+        if (name.endswith( 'time (s)' ) and not name.startswith( 'Ref.' )):
+            return name
+    return None
+
+def ref_time_col( names ):
+    for name in names:
+        if (name.startswith( 'Ref.' ) and name.endswith( 'time (s)' )):
+            return name
+    return None
+
+# ------------------------------------------------------------------------------
+# Runs a routine on the tester and returns the rows of its output
+def run_routine( routine ):
+    cmd = [ opts.test, '--ref', 'y', '--check', 'n',
+            '--repeat', str( opts.repeat ),
+            '--type', opts.type, '--dim', opts.dim ] + tester_args + [ routine ]
+    print( ' '.join( cmd ), file=sys.stderr )
+    p = subprocess.Popen( cmd, stdout=subprocess.PIPE, stderr=subprocess.STDOUT )
+    p_out = p.stdout
+    if (sys.version_info.major >= 3):
+        p_out = io.TextIOWrapper( p.stdout, encoding='utf-8' )
+    output = p_out.read()
+    err = p.wait()
+    if (err != 0):
+        print( 'FAILED: exit code', err, file=sys.stderr )
+        print( output, file=sys.stderr )
+    return parse_output( output )
+
+# ------------------------------------------------------------------------------
+# A measurement: the input parameters, the size and the best times
+class Measure:
+    def __init__( self, routine, params, size, time, ref_time, gflops, ref_gflops ):
+        self.routine    = routine
+        self.params     = params      # list of (name, value)
+        self.size       = size
+        self.time       = time
+        self.ref_time   = ref_time
+        self.gflops     = gflops
+        self.ref_gflops = ref_gflops
+
+    def ratio( self ):
+        return self.time / self.ref_time
+
+# Collects the rows of a routine. The testers print one row per run, so the
+# fastest of the rows with the same parameters is kept.
+def collect( routine, rows ):
+    measures = []
+    index = {}
+    for row in rows:
+        names = list( row.keys() )
+        tcol  = time_col( names )
+        rcol  = ref_time_col( names )
+        t     = to_float( row.get( tcol, '' ) )
+        tref  = to_float( row.get( rcol, '' ) ) if rcol else None
+        if (t is None or tref is None or t <= 0 or tref <= 0):
+            continue
+
+        gcol  = tcol.replace( 'time (s)', 'Gflop/s' )
+        rgcol = rcol.replace( 'time (s)', 'Gflop/s' )
+        params = [ (k, v) for (k, v) in row.items() if not is_output( k ) ]
+        size = 1
+        for (k, v) in params:
+            if (k in dim_names):
+                size *= int( v )
+
+        key = tuple( params )
+        m = Measure( routine, params, size, t, tref,
+                     to_float( row.get( gcol, '' ) ),
+                     to_float( row.get( rgcol, '' ) ) )
+        if (key not in index):
+            index[ key ] = len( measures )
+            measures.append( m )
+        else:
+            old = measures[ index[ key ] ]
+            if (m.time < old.time):
+                old.time, old.gflops = m.time, m.gflops
+            if (m.ref_time < old.ref_time):
+                old.ref_time, old.ref_gflops = m.ref_time, m.ref_gflops
+    return measures
+
+# ------------------------------------------------------------------------------
+def fmt( x, spec ):
+    return 'NA' if (x is None) else format( x, spec )
+
+# Prints the table of ratios of a routine
+def print_table( routine, measures ):
+    if (not measures):
+        print( routine + ': no measurements' )
+        return
+    pnames = [ k for (k, v) in measures[0].params ]
+    width = [ max( len( k ), 4 ) for k in pnames ]
+    for m in measures:
+        for i in range( len( pnames ) ):
+            width[i] = max( width[i], len( m.params[i][1] ) )
+
+    print( '\n' + routine + ': ratio = <T> time / Ref. time (> 1 means the templates are slower)' )
+    head = '  '.join( [ k.rjust( w ) for (k, w) in zip( pnames, width ) ] )
+    print( head + '  %11s  %11s  %11s  %11s  %7s'
+           % ('<T> time', 'Ref. time', '<T> Gflop/s', 'Ref Gflop/s', 'ratio') )
+    for m in measures:
+        line = '  '.join( [ v.rjust( w ) for ((k, v), w) in zip( m.params, width ) ] )
+        print( line + '  %11s  %11s  %11s  %11s  %7.2f' % (
+            fmt( m.time, '.4e' ), fmt( m.ref_time, '.4e' ),
+            fmt( m.gflops, '.3f' ), fmt( m.ref_gflops, '.3f' ), m.ratio() ) )
+
+# ------------------------------------------------------------------------------
+# Suggests the dispatch threshold of each routine and type: the smallest size
+# from which the reference library is faster on every larger size. The
+# ratios of the rows with the same size, e.g., with different transA, are
+# combined by their geometric mean.
+def thresholds( measures ):
+    by_type = {}
+    for m in measures:
+        t = dict( m.params ).get( 'type', '?' )
+        by_type.setdefault( t, {} ).setdefault( m.size, [] ).append( math.log( m.ratio() ) )
+
+    result = []
+    for t in sorted( by_type ):
+        sizes = sorted( by_type[t] )
+        ratio = [ math.exp( sum( by_type[t][s] ) / len( by_type[t][s] ) ) for s in sizes ]
+        threshold = None
+        for i in reversed( range( len( sizes ) ) ):
+            if (ratio[i] > opts.margin):
+                threshold = sizes[i]
+            else:
+                break
+        result.append( (t, threshold, sizes, ratio) )
+    return result
+
+# ------------------------------------------------------------------------------
+all_measures = []
+summary = []
+for routine in opts.routines:
+    measures = collect( routine, run_routine( routine ) )
+    print_table( routine, measures )
+    all_measures += measures
+    for (t, threshold, sizes, ratio) in thresholds( measures ):
+        summary.append( (routine, t, threshold, sizes, ratio) )
+
+print( '\nSuggested thresholds: problems of size >= threshold are faster in the'
+       ' reference library.\nThe size is the product of the dimensions m, n, k'
+       ' printed by the tester.' )
+print( '%-8s %4s  %12s  %s' % ('routine', 'type', 'threshold', 'ratio by size') )
+for (routine, t, threshold, sizes, ratio) in summary:
+    print( '%-8s %4s  %12s  %s' % (
+        routine, t, 'none' if (threshold is None) else str( threshold ),
+        ' '.join( [ '%d:%.2f' % (s, r) for (s, r) in zip( sizes, ratio ) ] ) ) )
+
+if (opts.thresholds):
+    with open( opts.thresholds, 'w' ) as f:
+        f.write( '# routine type size\n' )
+        for (routine, t, threshold, sizes, ratio) in summary:
+            if (t not in ('s', 'd')):
+                # only float and double call BLAS++
+                continue
+            if (threshold is None):
+                f.write( '# %s %s: the templates are faster on all sizes\n' % (routine, t) )
+            else:
+                f.write( '%s %s %d\n' % (routine, t, threshold) )
+    print( 'Thresholds written to', opts.thresholds )
+
+if (opts.csv):
+    with open( opts.csv, 'w' ) as f:
+        pnames = []
+        for m in all_measures:
+            pnames += [ k for (k, v) in m.params if k not in pnames ]
+        f.write( ','.join( [ 'routine' ] + pnames + [
+            'size', 'time', 'ref_time', 'gflops', 'ref_gflops', 'ratio' ] ) + '\n' )
+        for m in all_measures:
+            p = dict( m.params )
+            f.write( ','.join( [ m.routine ] + [ p.get( k, '' ) for k in pnames ] + [
+                str( m.size ), repr( m.time ), repr( m.ref_time ),
+                fmt( m.gflops, '' ), fmt( m.ref_gflops, '' ),
+                '%.4f' % m.ratio() ] ) + '\n' )
+    print( 'Measurements written to', opts.csv )
@@ -331,18 +331,18 @@ incy_pos = ' --incy ' + filter_csv( ('1', '2'), opts.incy )
 # ------------------------------------------------------------------------------
 cmds = []
 
-# # LU
-# if (opts.lu):
-#     cmds += [
-#     [ 'gesv',  gen + dtype + align + n ],
-#     [ 'gesvx', gen + dtype + align + n + factored + trans + equed ],
-#     [ 'getrf', gen + dtype + align + mn ],
-#     [ 'getrs', gen + dtype + align + n + trans ],
-#     [ 'getri', gen + dtype + align + n ],
-#     [ 'gecon', gen + dtype + align + n ],
-#     [ 'gerfs', gen + dtype + align + n + trans ],
-#     [ 'geequ', gen + dtype + align + n ],
-#     ]
+# LU
+if (opts.lu):
+    cmds += [
+    # [ 'gesv',  gen + dtype + align + n ],
+    # [ 'gesvx', gen + dtype + align + n + factored + trans + equed ],
+    [ 'getrf', gen + dtype + align + mn ],
+    [ 'getrs', gen + dtype + align + n + trans ],
+    # [ 'getri', gen + dtype + align + n ],
+    # [ 'gecon', gen + dtype + align + n ],
+    # [ 'gerfs', gen + dtype + align + n + trans ],
+    # [ 'geequ', gen + dtype + align + n ],
+    ]
 
 # # General Banded
 # if (opts.gb):
@@ -365,41 +365,41 @@ cmds = []
 #     [ 'gtrfs', gen + dtype + align + n + trans ],
 #     ]
 
-# # Cholesky
-# if (opts.chol):
-#     cmds += [
-#     [ 'posv',  gen + dtype + align + n + uplo ],
-#     [ 'potrf', gen + dtype + align + n + uplo ],
-#     [ 'potrs', gen + dtype + align + n + uplo ],
-#     [ 'potri', gen + dtype + align + n + uplo ],
-#     [ 'pocon', gen + dtype + align + n + uplo ],
-#     [ 'porfs', gen + dtype + align + n + uplo ],
-#     [ 'poequ', gen + dtype + align + n ],  # only diagonal elements (no uplo)
-
-#     # Packed
-#     [ 'ppsv',  gen + dtype + align + n + uplo ],
-#     [ 'pptrf', gen + dtype +         n + uplo ],
-#     [ 'pptrs', gen + dtype + align + n + uplo ],
-#     [ 'pptri', gen + dtype +         n + uplo ],
-#     [ 'ppcon', gen + dtype +         n + uplo ],
-#     [ 'pprfs', gen + dtype + align + n + uplo ],
-#     [ 'ppequ', gen + dtype +         n + uplo ],
-
-#     # Banded
-#     [ 'pbsv',  gen + dtype + align + n + kd + uplo ],
-#     [ 'pbtrf', gen + dtype + align + n + kd + uplo ],
-#     [ 'pbtrs', gen + dtype + align + n + kd + uplo ],
-#     [ 'pbcon', gen + dtype + align + n + kd + uplo ],
-#     [ 'pbrfs', gen + dtype + align + n + kd + uplo ],
-#     [ 'pbequ', gen + dtype + align + n + kd + uplo ],
-
-#     # Tri-diagonal
-#     [ 'ptsv',  gen + dtype + align + n ],
-#     [ 'pttrf', gen + dtype         + n ],
-#     [ 'pttrs', gen + dtype + align + n + uplo ],
-#     [ 'ptcon', gen + dtype         + n ],
-#     [ 'ptrfs', gen + dtype + align + n + uplo ],
-#     ]
+# Cholesky
+if (opts.chol):
+    cmds += [
+    # [ 'posv',  gen + dtype + align + n + uplo ],
+    [ 'potrf', gen + dtype + align + n + uplo ],
+    # [ 'potrs', gen + dtype + align + n + uplo ],
+    # [ 'potri', gen + dtype + align + n + uplo ],
+    # [ 'pocon', gen + dtype + align + n + uplo ],
+    # [ 'porfs', gen + dtype + align + n + uplo ],
+    # [ 'poequ', gen + dtype + align + n ],  # only diagonal elements (no uplo)
+
+    # Packed
+    # [ 'ppsv',  gen + dtype + align + n + uplo ],
+    # [ 'pptrf', gen + dtype +         n + uplo ],
+    # [ 'pptrs', gen + dtype + align + n + uplo ],
+    # [ 'pptri', gen + dtype +         n + uplo ],
+    # [ 'ppcon', gen + dtype +         n + uplo ],
+    # [ 'pprfs', gen + dtype + align + n + uplo ],
+    # [ 'ppequ', gen + dtype +         n + uplo ],
+
+    # Banded
+    # [ 'pbsv',  gen + dtype + align + n + kd + uplo ],
+    # [ 'pbtrf', gen + dtype + align + n + kd + uplo ],
+    # [ 'pbtrs', gen + dtype + align + n + kd + uplo ],
+    # [ 'pbcon', gen + dtype + align + n + kd + uplo ],
+    # [ 'pbrfs', gen + dtype + align + n + kd + uplo ],
+    # [ 'pbequ', gen + dtype + align + n + kd + uplo ],
+
+    # Tri-diagonal
+    # [ 'ptsv',  gen + dtype + align + n ],
+    # [ 'pttrf', gen + dtype         + n ],
+    # [ 'pttrs', gen + dtype + align + n + uplo ],
+    # [ 'ptcon', gen + dtype         + n ],
+    # [ 'ptrfs', gen + dtype + align + n + uplo ],
+    ]
 
 # # symmetric indefinite, Bunch-Kaufman
 # if (opts.sysv):
@@ -485,23 +485,23 @@ cmds = []
 #     #[ 'ggglm', gen + dtype + align + mnk ],
 #     ]
 
-# # QR
-# if (opts.qr):
-#     cmds += [
-#     [ 'geqrf', gen + dtype + align + n + wide + tall ],
-#     # todo: ggqrf is failing
-#     #[ 'ggqrf', gen + dtype + align + mnk ],
-#     [ 'ungqr', gen + dtype + align + mn ],  # m >= n
-#     #[ 'unmqr', gen + dtype_real    + align + mnk + side + trans    ],  # real does trans = N, T, C
-#     #[ 'unmqr', gen + dtype_complex + align + mnk + side + trans_nc ],  # complex does trans = N, C, not T
-
-#     # Triangle-pentagon
-#     [ 'tpqrt',  gen + dtype + align + mn + l + nb ],
-#     [ 'tpqrt2', gen + dtype + align + mn + l ],
-#     [ 'tpmqrt', gen + dtype_real    + align + mn + l + nb + side + trans    ],  # real does trans = N, T, C
-#     [ 'tpmqrt', gen + dtype_complex + align + mn + l + nb + side + trans_nc ],  # complex does trans = N, C, not T
-#     #[ 'tprfb',  gen + dtype + align + mn + l ],  # TODO: bug in LAPACKE crashes tester
-#     ]
+# QR
+if (opts.qr):
+    cmds += [
+    [ 'geqrf', gen + dtype + align + n + wide + tall ],
+    # todo: ggqrf is failing
+    #[ 'ggqrf', gen + dtype + align + mnk ],
+    [ 'ungqr', gen + dtype + align + mn ],  # m >= n
+    #[ 'unmqr', gen + dtype_real    + align + mnk + side + trans    ],  # real does trans = N, T, C
+    #[ 'unmqr', gen + dtype_complex + align + mnk + side + trans_nc ],  # complex does trans = N, C, not T
+
+    # # Triangle-pentagon
+    # [ 'tpqrt',  gen + dtype + align + mn + l + nb ],
+    # [ 'tpqrt2', gen + dtype + align + mn + l ],
+    # [ 'tpmqrt', gen + dtype_real    + align + mn + l + nb + side + trans    ],  # real does trans = N, T, C
+    # [ 'tpmqrt', gen + dtype_complex + align + mn + l + nb + side + trans_nc ],  # complex does trans = N, C, not T
+    #[ 'tprfb',  gen + dtype + align + mn + l ],  # TODO: bug in LAPACKE crashes tester
+    ]
 
 # # LQ
 # if (opts.lq):
@@ -644,7 +644,7 @@ if (opts.aux):
     cmds += [
     [ 'lacpy', gen + dtype + align + mn + mtype ],
     [ 'laset', gen + dtype + align + mn + mtype ],
-    # [ 'laswp', gen + dtype + align + mn ],
+    [ 'laswp', gen + dtype + align + mn ],
     ]
 
 # auxilary - householder
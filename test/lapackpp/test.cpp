@@ -82,15 +82,15 @@ std::vector< testsweeper::routines_t > routines = {
 //   //{ "gtsvx",              test_gtsvx,     Section::gesv },
 //     { "",                   nullptr,        Section::newline },
 
-//     { "getrf",              test_getrf,     Section::gesv },
+    { "getrf",              test_getrf,     Section::gesv },
 //     { "gbtrf",              test_gbtrf,     Section::gesv },
 //     { "gttrf",              test_gttrf,     Section::gesv },
-//     { "",                   nullptr,        Section::newline },
+    { "",                   nullptr,        Section::newline },
 
-//     { "getrs",              test_getrs,     Section::gesv },
+    { "getrs",              test_getrs,     Section::gesv },
 //     { "gbtrs",              test_gbtrs,     Section::gesv },
 //     { "gttrs",              test_gttrs,     Section::gesv },
-//     { "",                   nullptr,        Section::newline },
+    { "",                   nullptr,        Section::newline },
 
 //     { "getri",              test_getri,     Section::gesv },    // lawn 41 test
 //     { "",                   nullptr,        Section::newline },
@@ -117,11 +117,11 @@ std::vector< testsweeper::routines_t > routines = {
 //     { "ptsv",               test_ptsv,      Section::posv },
 //     { "",                   nullptr,        Section::newline },
 
-//     { "potrf",              test_potrf,     Section::posv },
+    { "potrf",              test_potrf,     Section::posv },
 //     { "pptrf",              test_pptrf,     Section::posv },
 //     { "pbtrf",              test_pbtrf,     Section::posv },
 //     { "pttrf",              test_pttrf,     Section::posv },
-//     { "",                   nullptr,        Section::newline },
+    { "",                   nullptr,        Section::newline },
 
 //     { "potrs",              test_potrs,     Section::posv },
 //     { "pptrs",              test_pptrs,     Section::posv },
@@ -240,11 +240,11 @@ std::vector< testsweeper::routines_t > routines = {
 
 //     // -----
 //     // QR, LQ, RQ, QL
-//     { "geqrf",              test_geqrf,     Section::qr }, // tested numerically
+    { "geqrf",              test_geqrf,     Section::qr }, // tested numerically
 //     { "gelqf",              test_gelqf,     Section::qr }, // tested numerically
 //     { "geqlf",              test_geqlf,     Section::qr }, // tested numerically
 //     { "gerqf",              test_gerqf,     Section::qr }, // tested numerically; R, Q are full sizeof(A), could be smaller
-//     { "",                   nullptr,        Section::newline },
+    { "",                   nullptr,        Section::newline },
 
 //     { "ggqrf",              test_ggqrf,     Section::qr }, // tested via LAPACKE using gcc/MKL, TODO for now use p=param.k
 //   //{ "gglqf",              test_gglqf,     Section::qr }, // TODO No automagic generation.  No src
@@ -254,11 +254,11 @@ std::vector< testsweeper::routines_t > routines = {
 //     { "ggrqf",              test_ggrqf,     Section::qr }, // tested via LAPACKE using gcc/MKL, TODO for now use p=param.k
 //     { "",                   nullptr,        Section::newline },
 
-//     { "ungqr",              test_ungqr,     Section::qr }, // tested numerically based on lapack; R, Q full sizes
+    { "ungqr",              test_ungqr,     Section::qr }, // tested numerically based on lapack; R, Q full sizes
 //     { "unglq",              test_unglq,     Section::qr }, // tested numerically based on lapack; R, Q full; m<=n, k<=m
 //     { "ungql",              test_ungql,     Section::qr }, // tested numerically based on lapack; R, Q full sizes
 //     { "ungrq",              test_ungrq,     Section::qr }, // tested numerically based on lapack; R, Q full sizes
-//     { "",                   nullptr,        Section::newline },
+    { "",                   nullptr,        Section::newline },
 
 //   //{ "unmqr",              test_unmqr,     Section::qr }, // TODO segfaults
 //   //{ "unmlq",              test_unmlq,     Section::qr },
@@ -386,7 +386,7 @@ std::vector< testsweeper::routines_t > routines = {
     { "lacpy",              test_lacpy,     Section::aux },
 //     { "laed4",              test_laed4,     Section::aux },
     { "laset",              test_laset,     Section::aux },
-//     { "laswp",              test_laswp,     Section::aux },
+    { "laswp",              test_laswp,     Section::aux },
     { "",                   nullptr,        Section::newline },
 
 //     // auxiliary: Householder
@@ -0,0 +1,115 @@
+/// @file wrappers.hh Stub of the BLAS++ wrappers for test_dispatch.
+///
+/// Each routine only records that it was called, with the size of the
+/// problem as defined in blas/dispatch.hpp. The outputs are not touched, so
+/// that a test can tell which backend computed a problem.
+//
+// Copyright (c) 2021, University of Colorado Denver. All rights reserved.
+//
+// This file is part of <T>LAPACK.
+// <T>LAPACK is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef BLASPP_STUB_WRAPPERS_HH
+#define BLASPP_STUB_WRAPPERS_HH
+
+#include "blas/types.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace blaspp_stub {
+
+/// Call to the stub
+struct call_t {
+    std::string routine;
+    std::int64_t size;
+};
+
+/// Calls since the last clear()
+inline std::vector< call_t >& calls() {
+    static std::vector< call_t > c;
+    return c;
+}
+
+inline void record( const char* routine, std::int64_t size ) {
+    calls().push_back( call_t{ routine, size } );
+}
+
+/// Value returned by dot and nrm2
+constexpr double result = -1;
+
+} // namespace blaspp_stub
+
+namespace blas {
+
+#define BLASPP_STUB_ROUTINES( T )                                              \
+                                                                               \
+inline void axpy( std::int64_t n, T, const T*, std::int64_t, T*, std::int64_t ) \
+    { blaspp_stub::record( "axpy", n ); }                                      \
+                                                                               \
+inline T dot( std::int64_t n, const T*, std::int64_t, const T*, std::int64_t ) \
+    { blaspp_stub::record( "dot", n ); return T( blaspp_stub::result ); }      \
+                                                                               \
+inline T nrm2( std::int64_t n, const T*, std::int64_t )                        \
+    { blaspp_stub::record( "nrm2", n ); return T( blaspp_stub::result ); }     \
+                                                                               \
+inline void scal( std::int64_t n, T, T*, std::int64_t )                        \
+    { blaspp_stub::record( "scal", n ); }                                      \
+                                                                               \
+inline void gemv( Layout, Op, std::int64_t m, std::int64_t n,                  \
+    T, const T*, std::int64_t, const T*, std::int64_t,                         \
+    T, T*, std::int64_t )                                                      \
+    { blaspp_stub::record( "gemv", m*n ); }                                    \
+                                                                               \
+inline void ger( Layout, std::int64_t m, std::int64_t n,                       \
+    T, const T*, std::int64_t, const T*, std::int64_t, T*, std::int64_t )      \
+    { blaspp_stub::record( "ger", m*n ); }                                     \
+                                                                               \
+inline void symv( Layout, Uplo, std::int64_t n,                                \
+    T, const T*, std::int64_t, const T*, std::int64_t,                         \
+    T, T*, std::int64_t )                                                      \
+    { blaspp_stub::record( "symv", n ); }                                      \
+                                                                               \
+inline void trmv( Layout, Uplo, Op, Diag, std::int64_t n,                      \
+    const T*, std::int64_t, T*, std::int64_t )                                 \
+    { blaspp_stub::record( "trmv", n ); }                                      \
+                                                                               \
+inline void trsv( Layout, Uplo, Op, Diag, std::int64_t n,                      \
+    const T*, std::int64_t, T*, std::int64_t )                                 \
+    { blaspp_stub::record( "trsv", n ); }                                      \
+                                                                               \
+inline void gemm( Layout, Op, Op, std::int64_t m, std::int64_t n,              \
+    std::int64_t k, T, const T*, std::int64_t, const T*, std::int64_t,         \
+    T, T*, std::int64_t )                                                      \
+    { blaspp_stub::record( "gemm", m*n*k ); }                                  \
+                                                                               \
+inline void symm( Layout, Side, Uplo, std::int64_t m, std::int64_t n,          \
+    T, const T*, std::int64_t, const T*, std::int64_t, T, T*, std::int64_t )   \
+    { blaspp_stub::record( "symm", m*n ); }                                    \
+                                                                               \
+inline void syrk( Layout, Uplo, Op, std::int64_t n, std::int64_t k,            \
+    T, const T*, std::int64_t, T, T*, std::int64_t )                           \
+    { blaspp_stub::record( "syrk", n*k ); }                                    \
+                                                                               \
+inline void syr2k( Layout, Uplo, Op, std::int64_t n, std::int64_t k,           \
+    T, const T*, std::int64_t, const T*, std::int64_t, T, T*, std::int64_t )   \
+    { blaspp_stub::record( "syr2k", n*k ); }                                   \
+                                                                               \
+inline void trmm( Layout, Side, Uplo, Op, Diag, std::int64_t m, std::int64_t n, \
+    T, const T*, std::int64_t, T*, std::int64_t )                              \
+    { blaspp_stub::record( "trmm", m*n ); }                                    \
+                                                                               \
+inline void trsm( Layout, Side, Uplo, Op, Diag, std::int64_t m, std::int64_t n, \
+    T, const T*, std::int64_t, T*, std::int64_t )                              \
+    { blaspp_stub::record( "trsm", m*n ); }
+
+BLASPP_STUB_ROUTINES( float )
+BLASPP_STUB_ROUTINES( double )
+
+#undef BLASPP_STUB_ROUTINES
+
+} // namespace blas
+
+#endif // BLASPP_STUB_WRAPPERS_HH
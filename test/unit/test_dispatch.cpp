@@ -0,0 +1,402 @@
+/// @file test_dispatch.cpp Tests the runtime dispatch to BLAS++.
+///
+/// Built with USE_BLASPP_WRAPPERS and the stub of BLAS++ in blaspp_stub, which
+/// records its calls and does not touch the outputs.
+//
+// Copyright (c) 2021, University of Colorado Denver. All rights reserved.
+//
+// This file is part of <T>LAPACK.
+// <T>LAPACK is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "test_utils.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <limits>
+
+#ifndef USE_BLASPP_WRAPPERS
+    #error "test_dispatch must be built with USE_BLASPP_WRAPPERS"
+#endif
+
+using namespace tlapack_test;
+using blas::Op;
+using blas::Uplo;
+using blas::Diag;
+using blas::Side;
+using blas::internal::vector;
+using blas::get_dispatch_threshold;
+using blas::set_dispatch_threshold;
+
+constexpr std::size_t never = std::numeric_limits< std::size_t >::max();
+
+/// Type of the dispatch registry: 's' or 'd'
+template< typename T > constexpr char dispatch_type() { return 's'; }
+template<> constexpr char dispatch_type< double >() { return 'd'; }
+
+/// True if the only call to BLAS++ was to routine, with the given size
+inline bool called( const char* routine, std::size_t size )
+{
+    const auto& c = blaspp_stub::calls();
+    return c.size() == 1 && c[0].routine == routine
+        && std::size_t( c[0].size ) == size;
+}
+
+//------------------------------------------------------------------------------
+/// Checks both sides of the threshold of routine for the type T.
+///
+/// run() computes a problem of the given size with the generic routine and
+/// returns true if the templates computed it, i.e., if the output changed.
+template< typename T, typename run_t >
+void test_threshold( const char* routine, std::size_t size, run_t&& run )
+{
+    const char t = dispatch_type<T>();
+    const char other = ( t == 's' ) ? 'd' : 's';
+    bool ok = true;
+
+    // No routine goes to BLAS++, but the one tested
+    set_dispatch_threshold( "*", '*', never );
+
+    // At the threshold: BLAS++ only
+    set_dispatch_threshold( routine, t, size );
+    blaspp_stub::calls().clear();
+    ok = TLAPACK_CHECK( !run() ) && ok;
+    ok = TLAPACK_CHECK( called( routine, size ) ) && ok;
+
+    // Just below the threshold: templates only
+    set_dispatch_threshold( routine, t, size+1 );
+    blaspp_stub::calls().clear();
+    ok = TLAPACK_CHECK( run() ) && ok;
+    ok = TLAPACK_CHECK( blaspp_stub::calls().empty() ) && ok;
+
+    // The threshold of the other type does not apply
+    set_dispatch_threshold( routine, other, 0 );
+    blaspp_stub::calls().clear();
+    ok = TLAPACK_CHECK( run() ) && ok;
+    ok = TLAPACK_CHECK( blaspp_stub::calls().empty() ) && ok;
+
+    if( !ok )
+        std::printf( "    in %s<%s>\n", routine, type_name<T>() );
+}
+
+/// True if x and y differ
+template< typename T >
+inline bool differ( const std::vector<T>& x, const std::vector<T>& y ) {
+    return x != y;
+}
+
+template< typename T >
+inline std::vector<T> rand_vector( std::size_t n ) {
+    return rand_matrix<T>( n, 1 ).data;
+}
+
+//------------------------------------------------------------------------------
+/// Each routine on both sides of its threshold
+template< typename T >
+void test_routines()
+{
+    const T alpha( 0.5 ), beta( 2 );
+    const std::size_t n = 20;
+
+    // Level 1
+
+    test_threshold<T>( "axpy", n, [&]() {
+        std::vector<T> x = rand_vector<T>( n ), y = rand_vector<T>( n ), y0 = y;
+        auto y_ = vector( y.data(), n );
+        blas::axpy( alpha, vector( x.data(), n ), y_ );
+        return differ( y, y0 );
+    } );
+    test_threshold<T>( "dot", n, [&]() {
+        std::vector<T> x = rand_vector<T>( n );
+        return blas::dot( vector( x.data(), n ), vector( x.data(), n ) )
+            != T( blaspp_stub::result );
+    } );
+    test_threshold<T>( "nrm2", n, [&]() {
+        std::vector<T> x = rand_vector<T>( n );
+        return blas::nrm2( vector( x.data(), n ) ) != T( blaspp_stub::result );
+    } );
+    test_threshold<T>( "scal", n, [&]() {
+        std::vector<T> x = rand_vector<T>( n ), x0 = x;
+        auto x_ = vector( x.data(), n );
+        blas::scal( alpha, x_ );
+        return differ( x, x0 );
+    } );
+
+    // Level 2
+
+    const std::size_t m2 = 6, n2 = 5;
+    test_threshold<T>( "gemv", m2*n2, [&]() {
+        matrix<T> A = rand_matrix<T>( m2, n2 );
+        std::vector<T> x = rand_vector<T>( n2 ), y = rand_vector<T>( m2 ), y0 = y;
+        auto y_ = vector( y.data(), m2 );
+        blas::gemv( Op::NoTrans, alpha, A.view(), vector( x.data(), n2 ), beta, y_ );
+        return differ( y, y0 );
+    } );
+    test_threshold<T>( "ger", m2*n2, [&]() {
+        matrix<T> A = rand_matrix<T>( m2, n2 ), A0 = A;
+        std::vector<T> x = rand_vector<T>( m2 ), y = rand_vector<T>( n2 );
+        auto A_ = A.view();
+        blas::ger( alpha, vector( x.data(), m2 ), vector( y.data(), n2 ), A_ );
+        return differ( A.data, A0.data );
+    } );
+    test_threshold<T>( "symv", n2, [&]() {
+        matrix<T> A = rand_hpd_matrix<T>( n2 );
+        std::vector<T> x = rand_vector<T>( n2 ), y = rand_vector<T>( n2 ), y0 = y;
+        auto y_ = vector( y.data(), n2 );
+        blas::symv( Uplo::Lower, alpha, A.view(), vector( x.data(), n2 ), beta, y_ );
+        return differ( y, y0 );
+    } );
+    test_threshold<T>( "trmv", n2, [&]() {
+        matrix<T> A = rand_hpd_matrix<T>( n2 );
+        std::vector<T> x = rand_vector<T>( n2 ), x0 = x;
+        auto x_ = vector( x.data(), n2 );
+        blas::trmv( Uplo::Upper, Op::Trans, Diag::NonUnit, A.view(), x_ );
+        return differ( x, x0 );
+    } );
+    test_threshold<T>( "trsv", n2, [&]() {
+        matrix<T> A = rand_hpd_matrix<T>( n2 );
+        std::vector<T> x = rand_vector<T>( n2 ), x0 = x;
+        auto x_ = vector( x.data(), n2 );
+        blas::trsv( Uplo::Lower, Op::NoTrans, Diag::NonUnit, A.view(), x_ );
+        return differ( x, x0 );
+    } );
+
+    // Level 3
+
+    const std::size_t m3 = 6, n3 = 5, k3 = 4;
+    test_threshold<T>( "gemm", m3*n3*k3, [&]() {
+        matrix<T> A = rand_matrix<T>( m3, k3 ), B = rand_matrix<T>( k3, n3 );
+        matrix<T> C = rand_matrix<T>( m3, n3 ), C0 = C;
+        auto C_ = C.view();
+        blas::gemm( Op::NoTrans, Op::NoTrans, alpha, A.view(), B.view(), beta, C_ );
+        return differ( C.data, C0.data );
+    } );
+    test_threshold<T>( "symm", m3*n3, [&]() {
+        matrix<T> A = rand_hpd_matrix<T>( m3 ), B = rand_matrix<T>( m3, n3 );
+        matrix<T> C = rand_matrix<T>( m3, n3 ), C0 = C;
+        auto C_ = C.view();
+        blas::symm( Side::Left, Uplo::Upper, alpha, A.view(), B.view(), beta, C_ );
+        return differ( C.data, C0.data );
+    } );
+    test_threshold<T>( "syrk", n3*k3, [&]() {
+        matrix<T> A = rand_matrix<T>( n3, k3 );
+        matrix<T> C = rand_hpd_matrix<T>( n3 ), C0 = C;
+        auto C_ = C.view();
+        blas::syrk( Uplo::Lower, Op::NoTrans, alpha, A.view(), beta, C_ );
+        return differ( C.data, C0.data );
+    } );
+    test_threshold<T>( "syr2k", n3*k3, [&]() {
+        matrix<T> A = rand_matrix<T>( k3, n3 ), B = rand_matrix<T>( k3, n3 );
+        matrix<T> C = rand_hpd_matrix<T>( n3 ), C0 = C;
+        auto C_ = C.view();
+        blas::syr2k( Uplo::Upper, Op::Trans, alpha, A.view(), B.view(), beta, C_ );
+        return differ( C.data, C0.data );
+    } );
+    test_threshold<T>( "trmm", m3*n3, [&]() {
+        matrix<T> A = rand_hpd_matrix<T>( n3 );
+        matrix<T> B = rand_matrix<T>( m3, n3 ), B0 = B;
+        auto B_ = B.view();
+        blas::trmm( Side::Right, Uplo::Lower, Op::NoTrans, Diag::NonUnit,
+                    alpha, A.view(), B_ );
+        return differ( B.data, B0.data );
+    } );
+    test_threshold<T>( "trsm", m3*n3, [&]() {
+        matrix<T> A = rand_hpd_matrix<T>( m3 );
+        matrix<T> B = rand_matrix<T>( m3, n3 ), B0 = B;
+        auto B_ = B.view();
+        blas::trsm( Side::Left, Uplo::Upper, Op::ConjTrans, Diag::Unit,
+                    alpha, A.view(), B_ );
+        return differ( B.data, B0.data );
+    } );
+
+    blas::reset_dispatch_thresholds();
+}
+
+//------------------------------------------------------------------------------
+/// Problems that stay on the templates whatever their size
+template< typename T >
+void test_not_forwarded()
+{
+    using blas::internal::transpose;
+    const std::size_t m = 6, n = 5, k = 4;
+    set_dispatch_threshold( "*", '*', 0 );
+
+    // Row-major C
+    {
+        matrix<T> A = rand_matrix<T>( m, k ), B = rand_matrix<T>( k, n );
+        matrix<T> C = rand_matrix<T>( n, m ), C0 = C;
+        auto Ct = transpose( C.view() );
+        blaspp_stub::calls().clear();
+        blas::gemm( Op::NoTrans, Op::NoTrans, T(1), A.view(), B.view(), T(1), Ct );
+        TLAPACK_CHECK( blaspp_stub::calls().empty() );
+        TLAPACK_CHECK( differ( C.data, C0.data ) );
+    }
+
+    // Vector with a negative increment
+    {
+        std::vector<T> x = rand_vector<T>( n ), x0 = x;
+        auto x_ = vector( x.data() + n-1, n, -1 );
+        blaspp_stub::calls().clear();
+        blas::scal( T(2), x_ );
+        TLAPACK_CHECK( blaspp_stub::calls().empty() );
+        TLAPACK_CHECK( differ( x, x0 ) );
+    }
+
+    blas::reset_dispatch_thresholds();
+}
+
+/// Types other than float and double are never forwarded
+template< typename T >
+void test_other_types()
+{
+    const std::size_t m = 6, n = 5, k = 4;
+    TLAPACK_CHECK( get_dispatch_threshold<T>( "gemm" ) == never );
+
+    set_dispatch_threshold( "*", '*', 0 );
+    matrix<T> A = rand_matrix<T>( m, k ), B = rand_matrix<T>( k, n );
+    matrix<T> C = rand_matrix<T>( m, n ), C0 = C;
+    auto C_ = C.view();
+    blaspp_stub::calls().clear();
+    blas::gemm( Op::NoTrans, Op::NoTrans, T(1), A.view(), B.view(), T(1), C_ );
+    TLAPACK_CHECK( blaspp_stub::calls().empty() );
+    TLAPACK_CHECK( differ( C.data, C0.data ) );
+
+    blas::reset_dispatch_thresholds();
+}
+
+//------------------------------------------------------------------------------
+/// The default thresholds, on both sides
+template< typename T >
+void test_defaults()
+{
+    using blas::internal::default_dispatch_threshold;
+    using blas::internal::dispatch_id;
+
+    blas::reset_dispatch_thresholds();
+    TLAPACK_CHECK( get_dispatch_threshold<T>( "axpy" ) == 8192 );
+    TLAPACK_CHECK( get_dispatch_threshold<T>( "gemv" ) == 128*128 );
+    TLAPACK_CHECK( get_dispatch_threshold<T>( "trsv" ) == 128 );
+    TLAPACK_CHECK( get_dispatch_threshold<T>( "gemm" ) == 64*64*64 );
+    TLAPACK_CHECK( get_dispatch_threshold<T>( "trsm" ) == 64*64 );
+    TLAPACK_CHECK( get_dispatch_threshold<T>( "gemm" )
+                   == default_dispatch_threshold( dispatch_id::gemm ) );
+    TLAPACK_CHECK( get_dispatch_threshold<T>( "getrf" ) == never );
+
+    // axpy of 8192 entries goes to BLAS++, and of 8191 to the templates
+    for( std::size_t n : { 8192, 8191 } ) {
+        std::vector<T> x = rand_vector<T>( n ), y = rand_vector<T>( n ), y0 = y;
+        auto y_ = vector( y.data(), n );
+        blaspp_stub::calls().clear();
+        blas::axpy( T(1), vector( x.data(), n ), y_ );
+        TLAPACK_CHECK( ( n == 8192 ) ? called( "axpy", n ) : blaspp_stub::calls().empty() );
+        TLAPACK_CHECK( differ( y, y0 ) == ( n < 8192 ) );
+    }
+
+    // gemm of 64*64*64 goes to BLAS++, and of 64*64*63 to the templates
+    for( std::size_t k : { 64, 63 } ) {
+        matrix<T> A = rand_matrix<T>( 64, k ), B = rand_matrix<T>( k, 64 );
+        matrix<T> C = rand_matrix<T>( 64, 64 ), C0 = C;
+        auto C_ = C.view();
+        blaspp_stub::calls().clear();
+        blas::gemm( Op::NoTrans, Op::NoTrans, T(1), A.view(), B.view(), T(1), C_ );
+        TLAPACK_CHECK( ( k == 64 ) ? called( "gemm", 64*64*k ) : blaspp_stub::calls().empty() );
+        TLAPACK_CHECK( differ( C.data, C0.data ) == ( k < 64 ) );
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Thresholds read from test_dispatch.txt, in the environment variable
+/// TLAPACK_DISPATCH_FILE, on the first use of the registry
+void test_dispatch_file()
+{
+    if( !std::getenv( "TLAPACK_DISPATCH_FILE" ) ) {
+        std::printf( "TLAPACK_DISPATCH_FILE is not set: skipping the file\n" );
+        return;
+    }
+
+    TLAPACK_CHECK( get_dispatch_threshold<double>( "gemm" ) == 1000 );
+    TLAPACK_CHECK( get_dispatch_threshold<float>( "gemm" ) == 500 );
+    TLAPACK_CHECK( get_dispatch_threshold<float>( "axpy" ) == 500 );
+    TLAPACK_CHECK( get_dispatch_threshold<float>( "trsv" ) == 3 );
+    TLAPACK_CHECK( get_dispatch_threshold<double>( "trsv" ) == 128 );
+    TLAPACK_CHECK( get_dispatch_threshold<double>( "gemv" ) == 128*128 );
+
+    // A gemm of size 10*10*10 goes to BLAS++ in double, not in float
+    matrix<double> A = rand_matrix<double>( 10, 10 ), C = A;
+    auto C_ = C.view();
+    blaspp_stub::calls().clear();
+    blas::gemm( Op::NoTrans, Op::NoTrans, 1.0, A.view(), A.view(), 1.0, C_ );
+    TLAPACK_CHECK( called( "gemm", 1000 ) );
+
+    matrix<float> As = rand_matrix<float>( 10, 10 ), Cs = As;
+    auto Cs_ = Cs.view();
+    blaspp_stub::calls().clear();
+    blas::gemm( Op::NoTrans, Op::NoTrans, 1.0f, As.view(), As.view(), 1.0f, Cs_ );
+    TLAPACK_CHECK( called( "gemm", 1000 ) );
+    blas::reset_dispatch_thresholds();
+}
+
+/// set_dispatch_threshold rejects unknown routines and types
+void test_set_threshold()
+{
+    TLAPACK_CHECK( !set_dispatch_threshold( "getrf", 'd', 1 ) );
+    TLAPACK_CHECK( !set_dispatch_threshold( "gemm", 'z', 1 ) );
+    TLAPACK_CHECK( set_dispatch_threshold( "gemm", '*', 7 ) );
+    TLAPACK_CHECK( get_dispatch_threshold<float>( "gemm" ) == 7 );
+    TLAPACK_CHECK( get_dispatch_threshold<double>( "gemm" ) == 7 );
+    TLAPACK_CHECK( get_dispatch_threshold<double>( "syrk" ) == 64*64 );
+    blas::reset_dispatch_thresholds();
+}
+
+/// load_dispatch_file applies the valid lines and reports the others
+void test_load_file()
+{
+    const char* path = "test_dispatch_load.txt";
+    {
+        std::ofstream file( path );
+        file << "syrk d 77\n";
+    }
+    TLAPACK_CHECK( blas::load_dispatch_file( path ) );
+    TLAPACK_CHECK( get_dispatch_threshold<double>( "syrk" ) == 77 );
+    {
+        std::ofstream file( path );
+        file << "# LAPACK routines are not dispatched\n"
+             << "getrf d 5\n"
+             << "trmm s 9\n";
+    }
+    TLAPACK_CHECK( !blas::load_dispatch_file( path ) );
+    TLAPACK_CHECK( get_dispatch_threshold<float>( "trmm" ) == 9 );
+    TLAPACK_CHECK( get_dispatch_threshold<double>( "getrf" )
+                   == std::numeric_limits< std::size_t >::max() );
+    std::remove( path );
+
+    TLAPACK_CHECK( !blas::load_dispatch_file( "no/such/file.txt" ) );
+    blas::reset_dispatch_thresholds();
+}
+
+//------------------------------------------------------------------------------
+template< typename T >
+void run()
+{
+    test_routines<T>();
+    test_not_forwarded<T>();
+    test_defaults<T>();
+
+    std::printf( "dispatch<%s> done\n", type_name<T>() );
+}
+
+int main()
+{
+    // Must come first: the file is read on the first use of the registry
+    test_dispatch_file();
+    test_set_threshold();
+    test_load_file();
+
+    run< float >();
+    run< double >();
+    test_other_types< std::complex<float> >();
+    test_other_types< std::complex<double> >();
+
+    return report( "test_dispatch" );
+}
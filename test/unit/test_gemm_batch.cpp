@@ -0,0 +1,154 @@
+/// @file test_gemm_batch.cpp Tests gemm_batch and trsm_batch.
+//
+// Copyright (c) 2021, University of Colorado Denver. All rights reserved.
+//
+// This file is part of <T>LAPACK.
+// <T>LAPACK is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "test_utils.hpp"
+
+using namespace tlapack_test;
+using blas::Op;
+
+//------------------------------------------------------------------------------
+/// Compares gemm_batch with one call to gemm per problem.
+/// Sizes of the problem i are m[i % m.size()], etc.
+template< typename T >
+void test_gemm_batch(
+    std::size_t batch,
+    const std::vector<std::size_t>& m,
+    const std::vector<std::size_t>& n,
+    const std::vector<std::size_t>& k,
+    int nt )
+{
+    using view_t = decltype( std::declval< matrix<T>& >().view() );
+    const Op ops[] = { Op::NoTrans, Op::Trans, Op::ConjTrans };
+    const T alpha = T( 0.75 );
+    const T beta  = T( 1.25 );
+
+    for( Op transA : ops ) {
+        for( Op transB : ops ) {
+            std::vector< matrix<T> > A, B, C, Cref;
+            std::size_t kmax = 1;
+            for(std::size_t i = 0; i < batch; ++i) {
+                const std::size_t mi = m[ i % m.size() ];
+                const std::size_t ni = n[ i % n.size() ];
+                const std::size_t ki = k[ i % k.size() ];
+                kmax = std::max( kmax, ki );
+                A.push_back( ( transA == Op::NoTrans )
+                    ? rand_matrix<T>( mi, ki ) : rand_matrix<T>( ki, mi ) );
+                B.push_back( ( transB == Op::NoTrans )
+                    ? rand_matrix<T>( ki, ni ) : rand_matrix<T>( ni, ki ) );
+                C.push_back( rand_matrix<T>( mi, ni ) );
+            }
+            Cref = C;
+
+            std::vector< view_t > Av, Bv, Cv;
+            for(std::size_t i = 0; i < batch; ++i) {
+                Av.push_back( A[i].view() );
+                Bv.push_back( B[i].view() );
+                Cv.push_back( C[i].view() );
+            }
+            blas::gemm_batch(
+                blas::parallel_policy{ nt }, transA, transB, alpha, Av, Bv, beta, Cv );
+
+            bool ok = true;
+            for(std::size_t i = 0; i < batch; ++i) {
+                auto Ci = Cref[i].view();
+                blas::gemm( transA, transB, alpha, A[i].view(), B[i].view(), beta, Ci );
+                ok = ok && norm_diff( C[i], Cref[i] )
+                        <= tol<T>( 4*kmax ) * ( 1 + norm( Cref[i] ) );
+            }
+            TLAPACK_CHECK( ok );
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Compares trsm_batch with one call to trsm per problem.
+template< typename T >
+void test_trsm_batch( std::size_t batch, std::size_t m, std::size_t n, int nt )
+{
+    using view_t = decltype( std::declval< matrix<T>& >().view() );
+    using blas::Side;
+    using blas::Uplo;
+    using blas::Diag;
+    const T alpha = T( 2 );
+
+    for( Side side : { Side::Left, Side::Right } ) {
+        for( Uplo uplo : { Uplo::Lower, Uplo::Upper } ) {
+            for( Op trans : { Op::NoTrans, Op::Trans, Op::ConjTrans } ) {
+                const std::size_t na = ( side == Side::Left ) ? m : n;
+                std::vector< matrix<T> > A, B, Bref;
+                for(std::size_t i = 0; i < batch; ++i) {
+                    A.push_back( rand_matrix<T>( na, na ) );
+                    for(std::size_t j = 0; j < na; ++j)
+                        A[i](j,j) += T( na );
+                    B.push_back( rand_matrix<T>( m, n ) );
+                }
+                Bref = B;
+
+                std::vector< view_t > Av, Bv;
+                for(std::size_t i = 0; i < batch; ++i) {
+                    Av.push_back( A[i].view() );
+                    Bv.push_back( B[i].view() );
+                }
+                blas::trsm_batch( blas::parallel_policy{ nt },
+                    side, uplo, trans, Diag::NonUnit, alpha, Av, Bv );
+
+                bool ok = true;
+                for(std::size_t i = 0; i < batch; ++i) {
+                    auto Bi = Bref[i].view();
+                    blas::trsm( side, uplo, trans, Diag::NonUnit, alpha, A[i].view(), Bi );
+                    ok = ok && norm_diff( B[i], Bref[i] )
+                            <= tol<T>( 4*na ) * ( 1 + norm( Bref[i] ) );
+                }
+                TLAPACK_CHECK( ok );
+            }
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+template< typename T >
+void run()
+{
+    using bs = blas::gemm_blocksize<T>;
+    const std::size_t w = blas::batch_blocksize<T>::width;
+    const std::size_t wmax = blas::batch_blocksize<T>::max_size;
+
+    for( int nt : { 1, 4 } ) {
+        // Uniform batches of small problems use the compact layout for real
+        // types. The batch is not a multiple of the width of the groups.
+        test_gemm_batch<T>( 2*w + 3, {5}, {3}, {7}, nt );
+        test_gemm_batch<T>( w, {wmax}, {wmax}, {wmax}, nt );
+        test_gemm_batch<T>( w + 1, {1}, {1}, {1}, nt );
+
+        // Uniform batches that are too small or too large for the compact
+        // layout
+        test_gemm_batch<T>( w - 1, {5}, {3}, {7}, nt );
+        test_gemm_batch<T>( 3, {wmax + 1}, {9}, {bs::kc + 1}, nt );
+
+        // Sizes that vary from problem to problem, including empty ones
+        test_gemm_batch<T>( 2*w + 1, {1, 7, 0, 13}, {4, 0, 9}, {3, 11}, nt );
+        test_gemm_batch<T>( 5, {bs::mr + 3, 2*bs::mr - 1}, {bs::nr + 1, 17},
+                            {bs::kc + 5, 33}, nt );
+
+        // trsm_batch
+        test_trsm_batch<T>( 2*w + 3, 5, 7, nt );
+        test_trsm_batch<T>( 4, 37, 29, nt );
+    }
+
+    std::printf( "gemm_batch<%s> done\n", type_name<T>() );
+}
+
+int main()
+{
+    run< float >();
+    run< double >();
+    run< std::complex<float> >();
+    run< std::complex<double> >();
+
+    return report( "test_gemm_batch" );
+}
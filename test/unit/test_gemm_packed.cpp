@@ -0,0 +1,120 @@
+/// @file test_gemm_packed.cpp Tests gemm on pre-packed operands.
+//
+// Copyright (c) 2021, University of Colorado Denver. All rights reserved.
+//
+// This file is part of <T>LAPACK.
+// <T>LAPACK is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "test_utils.hpp"
+
+using namespace tlapack_test;
+using blas::Op;
+using blas::PackedOperand;
+
+//------------------------------------------------------------------------------
+/// Compares gemm on packed operands with gemm on the original matrices
+template< typename T >
+void test_gemm_packed( std::size_t m, std::size_t n, std::size_t k )
+{
+    using real_t = real_type<T>;
+    const Op ops[] = { Op::NoTrans, Op::Trans, Op::ConjTrans };
+    const T alpha = T( 1.5 );
+    const T beta  = T( -0.5 );
+
+    for( Op transA : ops ) {
+        for( Op transB : ops ) {
+            matrix<T> A = ( transA == Op::NoTrans )
+                ? rand_matrix<T>( m, k ) : rand_matrix<T>( k, m );
+            matrix<T> B = ( transB == Op::NoTrans )
+                ? rand_matrix<T>( k, n ) : rand_matrix<T>( n, k );
+            const matrix<T> C0 = rand_matrix<T>( m, n );
+
+            const auto Ap = blas::gemm_pack( PackedOperand::A, transA, A.view() );
+            const auto Bp = blas::gemm_pack( PackedOperand::B, transB, B.view() );
+
+            // The packed matrices behave like the original ones
+            bool same = true;
+            for(std::size_t j = 0; j < A.n; ++j)
+                for(std::size_t i = 0; i < A.m; ++i)
+                    same = same && ( Ap(i,j) == A(i,j) );
+            for(std::size_t j = 0; j < B.n; ++j)
+                for(std::size_t i = 0; i < B.m; ++i)
+                    same = same && ( Bp(i,j) == B(i,j) );
+            TLAPACK_CHECK( same );
+
+            // Reference: gemm on the original matrices
+            matrix<T> Cref = C0;
+            auto Cref_ = Cref.view();
+            blas::gemm( transA, transB, alpha, A.view(), B.view(), beta, Cref_ );
+            const real_t tolC = tol<T>( 4*k ) * ( 1 + norm( Cref ) );
+
+            // ... which agrees with the naive triple loop
+            matrix<T> Cnaive = ref_gemm( transA, transB, A, B );
+            for(std::size_t i = 0; i < Cnaive.data.size(); ++i)
+                Cnaive.data[i] = alpha * Cnaive.data[i] + beta * C0.data[i];
+            TLAPACK_CHECK( norm_diff( Cnaive, Cref ) <= tolC );
+
+            // Both operands packed
+            matrix<T> C = C0;
+            auto C_ = C.view();
+            blas::gemm( transA, transB, alpha, Ap, Bp, beta, C_ );
+            TLAPACK_CHECK( norm_diff( C, Cref ) <= tolC );
+
+            // Only A packed
+            C = C0;
+            blas::gemm( transA, transB, alpha, Ap, B.view(), beta, C_ );
+            TLAPACK_CHECK( norm_diff( C, Cref ) <= tolC );
+
+            // Only B packed
+            C = C0;
+            blas::gemm( transA, transB, alpha, A.view(), Bp, beta, C_ );
+            TLAPACK_CHECK( norm_diff( C, Cref ) <= tolC );
+
+            // A packed for another operation, so that it must be repacked
+            const Op otherA = ( transA == Op::NoTrans ) ? Op::Trans : Op::NoTrans;
+            const auto Ap2 = blas::gemm_pack( PackedOperand::A, otherA, A.view() );
+            C = C0;
+            blas::gemm( transA, transB, alpha, Ap2, Bp, beta, C_ );
+            TLAPACK_CHECK( norm_diff( C, Cref ) <= tolC );
+
+            // A packed as the operand B
+            const auto Ap3 = blas::gemm_pack( PackedOperand::B, transA, A.view() );
+            C = C0;
+            blas::gemm( transA, transB, alpha, Ap3, B.view(), beta, C_ );
+            TLAPACK_CHECK( norm_diff( C, Cref ) <= tolC );
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+template< typename T >
+void run()
+{
+    using bs = blas::gemm_blocksize<T>;
+
+    // Sizes that are not multiples of mr, nr and kc, and a few that are
+    const std::size_t sizes[][3] = {
+        { 1, 1, 1 },
+        { 7, 5, 3 },
+        { bs::mr + 1, bs::nr + 1, bs::kc + 1 },
+        { 2*bs::mr - 1, 3*bs::nr - 1, 2*bs::kc - 3 },
+        { bs::mr, bs::nr, bs::kc },
+        { bs::mc + 3, 37, 41 },
+        { 50, 43, bs::kc + 17 },
+    };
+    for( const auto& s : sizes )
+        test_gemm_packed<T>( s[0], s[1], s[2] );
+
+    std::printf( "gemm_packed<%s> done\n", type_name<T>() );
+}
+
+int main()
+{
+    run< float >();
+    run< double >();
+    run< std::complex<float> >();
+    run< std::complex<double> >();
+
+    return report( "test_gemm_packed" );
+}
@@ -0,0 +1,143 @@
+/// @file test_geqrf_tiled.cpp Tests the tile QR factorization.
+//
+// Copyright (c) 2021, University of Colorado Denver. All rights reserved.
+//
+// This file is part of <T>LAPACK.
+// <T>LAPACK is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "test_utils.hpp"
+#include <lapack/geqrf_tiled.hpp>
+
+using namespace tlapack_test;
+using blas::Op;
+
+//------------------------------------------------------------------------------
+/// Forms the m-by-m matrix Q from the output of geqrf_tiled, applying the
+/// kernels of each step in the reverse order of the factorization
+template< typename T >
+matrix<T> form_q( matrix<T> A, matrix<T> Tm, std::size_t nb )
+{
+    using pair = std::pair<std::size_t,std::size_t>;
+
+    const std::size_t m  = A.m;
+    const std::size_t n  = A.n;
+    const std::size_t mt = ( m + nb-1 ) / nb;
+    const std::size_t nt = ( n + nb-1 ) / nb;
+    const std::size_t kt = std::min( mt, nt );
+    auto rows_of = [&]( std::size_t i ) { return pair{ i*nb, std::min( m, i*nb+nb ) }; };
+    auto cols_of = [&]( std::size_t j ) { return pair{ j*nb, std::min( n, j*nb+nb ) }; };
+
+    matrix<T> Q = eye<T>( m, m );
+    matrix<T> W( nb, m );
+    // Non-const views, so that all the operands have the same type
+    auto A_ = A.view();
+    auto T_ = Tm.view();
+    auto Q_ = Q.view();
+    auto W_ = W.view();
+
+    for(std::size_t k = kt; k-- > 0; ) {
+        const pair ck = cols_of( k );
+        const pair rk = rows_of( k );
+        const std::size_t nk = ck.second - ck.first;
+
+        // TSQRT kernels of the step k
+        for(std::size_t i = mt; i-- > k+1; ) {
+            const auto V2  = lapack::submatrix( A_, rows_of( i ), ck );
+            const auto Tik = lapack::submatrix( T_, pair{ i*nb, i*nb+nk }, ck );
+            auto C1 = lapack::submatrix( Q_, pair{ k*nb, k*nb+nk }, pair{ 0, m } );
+            auto C2 = lapack::submatrix( Q_, rows_of( i ), pair{ 0, m } );
+            auto Wk = lapack::submatrix( W_, pair{ 0, nk }, pair{ 0, m } );
+            lapack::tsmqrt( lapack::noTranspose, V2, Tik, C1, C2, Wk );
+        }
+
+        // GEQRT kernel of the step k
+        const std::size_t r = std::min( rk.second - rk.first, nk );
+        const auto V   = lapack::submatrix( A_, rk, pair{ ck.first, ck.first+r } );
+        const auto Tkk = lapack::submatrix( T_, pair{ k*nb, k*nb+r }, pair{ ck.first, ck.first+r } );
+        auto C  = lapack::submatrix( Q_, rk, pair{ 0, m } );
+        auto Wr = lapack::submatrix( W_, pair{ 0, r }, pair{ 0, m } );
+        lapack::unmqrt( lapack::noTranspose, V, Tkk, C, Wr );
+    }
+
+    return Q;
+}
+
+//------------------------------------------------------------------------------
+template< typename T >
+void test_geqrf_tiled( std::size_t m, std::size_t n, std::size_t nb )
+{
+    using real_t = real_type<T>;
+    const real_t tolQR = tol<T>( 10*std::max( m, n ) );
+
+    const std::size_t mt = ( m + nb-1 ) / nb;
+    const std::size_t nt = ( n + nb-1 ) / nb;
+    const matrix<T> A0 = rand_matrix<T>( m, n );
+
+    // Column-major matrix
+    matrix<T> A = A0;
+    matrix<T> Tm( mt*nb, n );
+    {
+        auto A_ = A.view();
+        auto T_ = Tm.view();
+        TLAPACK_CHECK( lapack::geqrf_tiled( A_, T_, nb ) == 0 );
+    }
+    const matrix<T> R = triu( A, m, n );
+    const matrix<T> Q = form_q( A, Tm, nb );
+    TLAPACK_CHECK( orthogonality( Q ) <= tolQR );
+    TLAPACK_CHECK( rel_diff( ref_gemm( Op::NoTrans, Op::NoTrans, Q, R ), A0 ) <= tolQR );
+
+    // Tiled layout: the same kernels on contiguous tiles
+    std::vector<T> dataA( mt*nt*nb*nb, T( 0 ) );
+    std::vector<T> dataT( mt*nt*nb*nb, T( 0 ) );
+    const lapack::TiledMapping map( lapack::matrix_extents( m, n ), nb, nb );
+    lapack::Matrix< T, lapack::TiledLayout > At( dataA.data(), map );
+    lapack::Matrix< T, lapack::TiledLayout > Tt( dataT.data(), map );
+    for(std::size_t j = 0; j < n; ++j)
+        for(std::size_t i = 0; i < m; ++i)
+            At(i,j) = A0(i,j);
+    TLAPACK_CHECK( lapack::geqrf_tiled( At, Tt ) == 0 );
+    matrix<T> Af( m, n );
+    for(std::size_t j = 0; j < n; ++j)
+        for(std::size_t i = 0; i < m; ++i)
+            Af(i,j) = At(i,j);
+    TLAPACK_CHECK( rel_diff( Af, A ) <= tolQR );
+}
+
+//------------------------------------------------------------------------------
+template< typename T >
+void run()
+{
+    // m, n, tile size. Tall-skinny, square and wide matrices, with sizes that
+    // are not multiples of the tile size.
+    const std::size_t sizes[][3] = {
+        { 1, 1, 1 },
+        { 17, 3, 4 },
+        { 100, 7, 8 },
+        { 203, 11, 5 },
+        { 64, 16, 16 },
+        { 130, 40, 32 },
+        { 50, 50, 7 },
+        { 37, 61, 8 },
+        { 20, 9, 64 },
+    };
+
+    for( int nt : { 1, 3 } ) {
+        blas::set_num_threads( nt );
+        for( const auto& s : sizes )
+            test_geqrf_tiled<T>( s[0], s[1], s[2] );
+    }
+    blas::set_num_threads( 1 );
+
+    std::printf( "geqrf_tiled<%s> done\n", type_name<T>() );
+}
+
+int main()
+{
+    run< float >();
+    run< double >();
+    run< std::complex<float> >();
+    run< std::complex<double> >();
+
+    return report( "test_geqrf_tiled" );
+}
@@ -0,0 +1,146 @@
+/// @file test_getrf_calu.cpp Tests the LU factorization with tournament pivoting.
+//
+// Copyright (c) 2021, University of Colorado Denver. All rights reserved.
+//
+// This file is part of <T>LAPACK.
+// <T>LAPACK is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "test_utils.hpp"
+
+using namespace tlapack_test;
+using blas::Op;
+
+//------------------------------------------------------------------------------
+/// Factors A0 with getrf_calu using P row-blocks of mw rows, and checks the
+/// pivots and ||P A - L U|| / ||A||. Returns max |L(i,j)|.
+template< typename T >
+real_type<T> check_calu(
+    const matrix<T>& A0, std::size_t P, std::size_t mw )
+{
+    using real_t = real_type<T>;
+    const std::size_t m = A0.m;
+    const std::size_t n = A0.n;
+
+    matrix<T> A = A0;
+    std::vector< std::size_t > piv( n, m );
+    matrix<T> W( std::max( mw, 2*n ), P*n );
+    {
+        auto A_ = A.view();
+        auto W_ = W.view();
+        auto piv_ = blas::internal::vector<std::size_t>( piv.data(), n );
+        TLAPACK_CHECK( lapack::getrf_calu( A_, piv_, W_ ) == 0 );
+    }
+
+    // The row i is interchanged with a row that was not chosen before
+    bool valid = true;
+    for(std::size_t i = 0; i < n; ++i)
+        valid = valid && ( i <= piv[i] && piv[i] < m );
+    TLAPACK_CHECK( valid );
+    if( !valid ) return real_t( 0 );
+
+    // P A0, applying the interchanges in order
+    matrix<T> PA = A0;
+    for(std::size_t i = 0; i < n; ++i)
+        if( piv[i] != i )
+            for(std::size_t j = 0; j < n; ++j)
+                std::swap( PA(i,j), PA(piv[i],j) );
+
+    // L is unit lower trapezoidal, U upper triangular
+    matrix<T> L( m, n );
+    real_t maxL( 0 );
+    for(std::size_t j = 0; j < n; ++j) {
+        L(j,j) = T( 1 );
+        for(std::size_t i = j+1; i < m; ++i) {
+            L(i,j) = A(i,j);
+            maxL = std::max( maxL, real_t( std::abs( A(i,j) ) ) );
+        }
+    }
+    const matrix<T> U = triu( A, n, n );
+
+    TLAPACK_CHECK( rel_diff( ref_gemm( Op::NoTrans, Op::NoTrans, L, U ), PA )
+                   <= tol<T>( 10*m ) * ( 1 + maxL ) );
+    return maxL;
+}
+
+//------------------------------------------------------------------------------
+template< typename T >
+void test_getrf_calu( std::size_t m, std::size_t n, std::size_t P, std::size_t mw )
+{
+    using real_t = real_type<T>;
+
+    // Random matrix. The growth of L is small in practice. For complex
+    // matrices, iamax compares |Re| + |Im|, so |L(i,j)| may exceed 1 even
+    // with partial pivoting.
+    const matrix<T> A0 = rand_matrix<T>( m, n );
+    TLAPACK_CHECK( check_calu( A0, P, mw ) <= real_t( 2*n ) );
+
+    // The rows of the first half are tiny. Selecting any of them as a pivot
+    // would make L huge.
+    matrix<T> B0 = A0;
+    if( m >= 4*n ) {
+        for(std::size_t j = 0; j < n; ++j)
+            for(std::size_t i = 0; i < m/2; ++i)
+                B0(i,j) *= real_t( 1e-6 );
+        TLAPACK_CHECK( check_calu( B0, P, mw ) <= real_t( 2*n ) );
+    }
+
+    // When there is a single row-block, getrf_calu is getrf
+    if( P <= 1 || m / n <= 1 ) {
+        matrix<T> A = A0;
+        matrix<T> G = A0;
+        std::vector< std::size_t > pivA( n ), pivG( n );
+        matrix<T> W( 2*n, P*n );
+        auto A_ = A.view();
+        auto G_ = G.view();
+        auto W_ = W.view();
+        auto pA = blas::internal::vector<std::size_t>( pivA.data(), n );
+        auto pG = blas::internal::vector<std::size_t>( pivG.data(), n );
+        lapack::getrf_calu( A_, pA, W_ );
+        lapack::getrf( G_, pG );
+        TLAPACK_CHECK( A.data == G.data && pivA == pivG );
+    }
+}
+
+//------------------------------------------------------------------------------
+template< typename T >
+void run()
+{
+    // m, n, number of row-blocks P, rows mw of each part of the workspace.
+    // mw = 0 means 2n. Tall-skinny matrices whose row-blocks are not
+    // multiples of n, row-blocks larger than mw so that the leaves work in
+    // chunks, numbers of row-blocks that are not powers of 2, and P larger
+    // than m/n.
+    const std::size_t sizes[][4] = {
+        { 1, 1, 1, 0 },
+        { 9, 1, 4, 0 },
+        { 100, 5, 4, 0 },
+        { 203, 11, 3, 25 },
+        { 333, 7, 5, 0 },
+        { 1000, 16, 8, 64 },
+        { 64, 8, 8, 16 },
+        { 30, 7, 10, 14 },
+        { 257, 32, 7, 0 },
+        { 50, 7, 1, 0 },
+        { 40, 40, 4, 0 },
+    };
+
+    for( int nt : { 1, 4 } ) {
+        blas::set_num_threads( nt );
+        for( const auto& s : sizes )
+            test_getrf_calu<T>( s[0], s[1], s[2], s[3] );
+    }
+    blas::set_num_threads( 1 );
+
+    std::printf( "getrf_calu<%s> done\n", type_name<T>() );
+}
+
+int main()
+{
+    run< float >();
+    run< double >();
+    run< std::complex<float> >();
+    run< std::complex<double> >();
+
+    return report( "test_getrf_calu" );
+}
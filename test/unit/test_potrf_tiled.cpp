@@ -0,0 +1,134 @@
+/// @file test_potrf_tiled.cpp Tests the tiled Cholesky factorization.
+//
+// Copyright (c) 2021, University of Colorado Denver. All rights reserved.
+//
+// This file is part of <T>LAPACK.
+// <T>LAPACK is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "test_utils.hpp"
+#include <lapack/potrf_tiled.hpp>
+
+using namespace tlapack_test;
+using blas::Op;
+
+//------------------------------------------------------------------------------
+/// Triangular factor of A: L, or U if upper, with zeros in the other triangle
+template< typename T >
+matrix<T> factor( bool upper, const matrix<T>& A )
+{
+    matrix<T> L( A.n, A.n );
+    for(std::size_t j = 0; j < A.n; ++j)
+        for(std::size_t i = 0; i < A.n; ++i)
+            if( upper ? ( i <= j ) : ( i >= j ) )
+                L(i,j) = A(i,j);
+    return L;
+}
+
+/// ||A - L L^H|| / ||A||, or ||A - U^H U|| / ||A|| if upper, on the triangle
+/// of A given by upper
+template< typename T >
+real_type<T> residual( bool upper, const matrix<T>& A, const matrix<T>& F )
+{
+    const matrix<T> L = factor( upper, F );
+    matrix<T> LLh = upper
+        ? ref_gemm( Op::ConjTrans, Op::NoTrans, L, L )
+        : ref_gemm( Op::NoTrans, Op::ConjTrans, L, L );
+
+    // Compare only the referenced triangle
+    matrix<T> A0 = A;
+    for(std::size_t j = 0; j < A.n; ++j)
+        for(std::size_t i = 0; i < A.n; ++i)
+            if( upper ? ( i > j ) : ( i < j ) )
+                LLh(i,j) = A0(i,j) = T( 0 );
+    return rel_diff( LLh, A0 );
+}
+
+//------------------------------------------------------------------------------
+template< typename T, typename uplo_t >
+void test_potrf_tiled( uplo_t uplo, std::size_t n, std::size_t nb )
+{
+    using lapack::upper_triangle_t;
+    const bool upper = std::is_same< uplo_t, upper_triangle_t >::value;
+
+    const matrix<T> A = rand_hpd_matrix<T>( n );
+
+    // Column-major matrix
+    matrix<T> F = A;
+    auto F_ = F.view();
+    TLAPACK_CHECK( lapack::potrf_tiled( uplo, F_, nb ) == 0 );
+    TLAPACK_CHECK( residual( upper, A, F ) <= tol<T>( 4*n ) );
+
+    // Same factor as the blocked algorithm, up to rounding
+    matrix<T> G = A;
+    auto G_ = G.view();
+    lapack::potrf( uplo, G_ );
+    TLAPACK_CHECK( rel_diff( factor( upper, F ), factor( upper, G ) )
+                   <= tol<T>( 4*n ) );
+
+    // Tiled layout: nb-by-nb tiles, padded if nb does not divide n
+    const std::size_t ntiles = ( n + nb-1 ) / nb;
+    std::vector<T> tiles( ntiles*ntiles*nb*nb, T( 0 ) );
+    lapack::Matrix< T, lapack::TiledLayout > At(
+        tiles.data(),
+        lapack::TiledMapping( lapack::matrix_extents( n, n ), nb, nb ) );
+    for(std::size_t j = 0; j < n; ++j)
+        for(std::size_t i = 0; i < n; ++i)
+            At(i,j) = A(i,j);
+    TLAPACK_CHECK( lapack::potrf_tiled( uplo, At ) == 0 );
+    matrix<T> Ft( n, n );
+    for(std::size_t j = 0; j < n; ++j)
+        for(std::size_t i = 0; i < n; ++i)
+            Ft(i,j) = At(i,j);
+    TLAPACK_CHECK( residual( upper, A, Ft ) <= tol<T>( 4*n ) );
+
+    // A matrix that is not positive definite: the leading minor of
+    // order k+1 is the first one that is not positive definite
+    if( n > 1 ) {
+        const std::size_t k = ( 2*n ) / 3;
+        matrix<T> B = A;
+        B(k,k) = T( -1 );
+        auto B_ = B.view();
+        TLAPACK_CHECK( lapack::potrf_tiled( uplo, B_, nb ) == int( k+1 ) );
+    }
+}
+
+//------------------------------------------------------------------------------
+template< typename T >
+void run()
+{
+    // Tile sizes that divide n, that do not, and that are larger than n
+    const std::size_t sizes[][2] = {
+        { 1, 1 },
+        { 1, 4 },
+        { 7, 1 },
+        { 16, 4 },
+        { 17, 4 },
+        { 50, 8 },
+        { 50, 13 },
+        { 64, 16 },
+        { 65, 16 },
+        { 20, 32 },
+    };
+
+    for( int nt : { 1, 2, 4, 7 } ) {
+        blas::set_num_threads( nt );
+        for( const auto& s : sizes ) {
+            test_potrf_tiled<T>( lapack::lower_triangle, s[0], s[1] );
+            test_potrf_tiled<T>( lapack::upper_triangle, s[0], s[1] );
+        }
+    }
+    blas::set_num_threads( 1 );
+
+    std::printf( "potrf_tiled<%s> done\n", type_name<T>() );
+}
+
+int main()
+{
+    run< float >();
+    run< double >();
+    run< std::complex<float> >();
+    run< std::complex<double> >();
+
+    return report( "test_potrf_tiled" );
+}
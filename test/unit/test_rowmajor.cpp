@@ -0,0 +1,539 @@
+/// @file test_rowmajor.cpp Tests the Level 2 and Level 3 BLAS on row-major
+/// matrices.
+//
+// Copyright (c) 2021, University of Colorado Denver. All rights reserved.
+//
+// This file is part of <T>LAPACK.
+// <T>LAPACK is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "test_utils.hpp"
+
+using namespace tlapack_test;
+using blas::Op;
+using blas::Uplo;
+using blas::Diag;
+using blas::Side;
+using pair = std::pair<std::size_t,std::size_t>;
+
+const Op ops[] = { Op::NoTrans, Op::Trans, Op::ConjTrans };
+const Op ops_conj[] = { Op::NoTrans, Op::Trans, Op::ConjTrans, Op::Conj };
+const Uplo uplos[] = { Uplo::Lower, Uplo::Upper };
+const Diag diags[] = { Diag::NonUnit, Diag::Unit };
+const Side sides[] = { Side::Left, Side::Right };
+
+//------------------------------------------------------------------------------
+// Storage of the matrices under test
+
+/// Column-major, the storage of the reference
+struct colmajor {};
+/// m-by-n layout_right mdspan
+struct rowmajor {};
+/// Submatrix of a larger layout_right mdspan, i.e., a strided view with
+/// unit stride along the rows
+struct rowmajor_sub {};
+
+/// Value of the entries around a submatrix, which must not change
+template< typename T >
+inline T sentinel() { return T( -7.5 ); }
+
+/// Copy of a column-major matrix in the storage L
+template< typename T, typename L >
+struct test_matrix {
+    static constexpr bool sub = std::is_same< L, rowmajor_sub >::value;
+
+    /// The matrix is at rows [i0,i0+m) and columns [j0,j0+n) of an array
+    /// with ld columns
+    std::size_t m, n, i0, j0, ld;
+    std::vector<T> data;
+
+    explicit test_matrix( const matrix<T>& A )
+        : m( A.m ), n( A.n ), i0( sub ? 2 : 0 ), j0( sub ? 1 : 0 ),
+          ld( A.n + ( sub ? 3 : 0 ) ),
+          data( ( A.m + ( sub ? 3 : 0 ) ) * ld, sentinel<T>() )
+    {
+        for(std::size_t i = 0; i < m; ++i)
+            for(std::size_t j = 0; j < n; ++j)
+                data[ (i0+i)*ld + j0+j ] = A(i,j);
+    }
+
+    /// Whole array
+    auto full() {
+        using extents_t = std::experimental::dextents<2>;
+        using mapping_t = std::experimental::layout_right::mapping< extents_t >;
+        return blas::mdspan< T, extents_t, std::experimental::layout_right >(
+            data.data(), mapping_t( extents_t( data.size() / ld, ld ) ) );
+    }
+
+    auto view( rowmajor ) { return full(); }
+    auto view( rowmajor_sub ) {
+        return blas::submatrix( full(), pair{ i0, i0+m }, pair{ j0, j0+n } );
+    }
+    auto view() { return view( L() ); }
+
+    matrix<T> to_matrix() const {
+        matrix<T> A( m, n );
+        for(std::size_t i = 0; i < m; ++i)
+            for(std::size_t j = 0; j < n; ++j)
+                A(i,j) = data[ (i0+i)*ld + j0+j ];
+        return A;
+    }
+
+    /// True if the entries around the submatrix were not written
+    bool padding_intact() const {
+        for(std::size_t r = 0; r < data.size() / ld; ++r)
+            for(std::size_t c = 0; c < ld; ++c)
+                if( ( r < i0 || r >= i0+m || c < j0 || c >= j0+n ) &&
+                    data[ r*ld + c ] != sentinel<T>() )
+                    return false;
+        return true;
+    }
+};
+
+template< typename T >
+struct test_matrix< T, colmajor > {
+    matrix<T> A;
+
+    explicit test_matrix( const matrix<T>& A_ ) : A( A_ ) {}
+
+    auto view() { return A.view(); }
+    matrix<T> to_matrix() const { return A; }
+    bool padding_intact() const { return true; }
+};
+
+/// Vector on every inc-th entry of the column x
+template< typename T >
+inline auto vec( matrix<T>& x, std::size_t inc = 1 ) {
+    return blas::internal::vector<T>( x.data.data(), (x.m - 1) / inc + 1, inc );
+}
+
+/// True if A, computed on row-major storage, agrees with the column-major
+/// reference Aref, for a computation of n terms per entry
+template< typename T >
+inline bool agree( const matrix<T>& A, const matrix<T>& Aref, std::size_t n ) {
+    return norm_diff( A, Aref ) <= tol<T>( 4*n ) * ( 1 + norm( Aref ) );
+}
+
+//------------------------------------------------------------------------------
+// Level 2
+//
+// The inputs are not const: several routines do not accept views of const
+// complex entries.
+
+/// gemv with x and y of increment inc. Row-major A with unit increments goes
+/// to the column-major kernel on A^T, and the other cases to the loops along
+/// the rows of A.
+template< typename T, typename L >
+void test_gemv( std::size_t m, std::size_t n, std::size_t inc )
+{
+    for( Op trans : ops_conj ) {
+        const bool noTrans = ( trans == Op::NoTrans || trans == Op::Conj );
+        const std::size_t lx = noTrans ? n : m;
+        const std::size_t ly = noTrans ? m : n;
+        matrix<T> A = rand_matrix<T>( m, n );
+        matrix<T> x = rand_matrix<T>( (lx-1)*inc + 1, 1 );
+        matrix<T> y = rand_matrix<T>( (ly-1)*inc + 1, 1 ), yref = y;
+        auto y_ = vec( y, inc );
+        auto yref_ = vec( yref, inc );
+
+        test_matrix<T,L> Ar( A );
+        blas::gemv( trans, T( 1.5 ), Ar.view(), vec( x, inc ), T( -0.5 ), y_ );
+        blas::gemv( trans, T( 1.5 ), A.view(), vec( x, inc ), T( -0.5 ), yref_ );
+        TLAPACK_CHECK( agree( y, yref, lx ) && Ar.padding_intact() );
+    }
+}
+
+template< typename T, typename L >
+void test_ger( std::size_t m, std::size_t n )
+{
+    matrix<T> A = rand_matrix<T>( m, n );
+    matrix<T> x = rand_matrix<T>( m, 1 );
+    matrix<T> y = rand_matrix<T>( n, 1 );
+
+    // ger: A += alpha x y^H
+    {
+        matrix<T> Aref = A;
+        auto Aref_ = Aref.view();
+        test_matrix<T,L> Ar( A );
+        auto Ar_ = Ar.view();
+        blas::ger( T( 1.5 ), vec( x ), vec( y ), Ar_ );
+        blas::ger( T( 1.5 ), vec( x ), vec( y ), Aref_ );
+        TLAPACK_CHECK( agree( Ar.to_matrix(), Aref, 1 ) && Ar.padding_intact() );
+    }
+    // geru: A += alpha x y^T
+    {
+        matrix<T> Aref = A;
+        auto Aref_ = Aref.view();
+        test_matrix<T,L> Ar( A );
+        auto Ar_ = Ar.view();
+        blas::geru( T( 1.5 ), vec( x ), vec( y ), Ar_ );
+        blas::geru( T( 1.5 ), vec( x ), vec( y ), Aref_ );
+        TLAPACK_CHECK( agree( Ar.to_matrix(), Aref, 1 ) && Ar.padding_intact() );
+    }
+}
+
+template< typename T, typename L >
+void test_syr_her( std::size_t n )
+{
+    using real_t = real_type<T>;
+
+    for( Uplo uplo : uplos ) {
+        matrix<T> A = rand_matrix<T>( n, n );
+        matrix<T> x = rand_matrix<T>( n, 1 );
+        matrix<T> y = rand_matrix<T>( n, 1 );
+
+        // syr
+        {
+            matrix<T> Aref = A;
+            auto Aref_ = Aref.view();
+            test_matrix<T,L> Ar( A );
+            auto Ar_ = Ar.view();
+            blas::syr( uplo, T( 1.5 ), vec( x ), Ar_ );
+            blas::syr( uplo, T( 1.5 ), vec( x ), Aref_ );
+            TLAPACK_CHECK( agree( Ar.to_matrix(), Aref, 1 ) && Ar.padding_intact() );
+        }
+        // her
+        {
+            matrix<T> Aref = A;
+            auto Aref_ = Aref.view();
+            test_matrix<T,L> Ar( A );
+            auto Ar_ = Ar.view();
+            blas::her( uplo, real_t( 1.5 ), vec( x ), Ar_ );
+            blas::her( uplo, real_t( 1.5 ), vec( x ), Aref_ );
+            TLAPACK_CHECK( agree( Ar.to_matrix(), Aref, 1 ) && Ar.padding_intact() );
+        }
+        // syr2
+        {
+            matrix<T> Aref = A;
+            auto Aref_ = Aref.view();
+            test_matrix<T,L> Ar( A );
+            auto Ar_ = Ar.view();
+            blas::syr2( uplo, T( 1.5 ), vec( x ), vec( y ), Ar_ );
+            blas::syr2( uplo, T( 1.5 ), vec( x ), vec( y ), Aref_ );
+            TLAPACK_CHECK( agree( Ar.to_matrix(), Aref, 2 ) && Ar.padding_intact() );
+        }
+        // her2
+        {
+            matrix<T> Aref = A;
+            auto Aref_ = Aref.view();
+            test_matrix<T,L> Ar( A );
+            auto Ar_ = Ar.view();
+            blas::her2( uplo, T( 1.5 ), vec( x ), vec( y ), Ar_ );
+            blas::her2( uplo, T( 1.5 ), vec( x ), vec( y ), Aref_ );
+            TLAPACK_CHECK( agree( Ar.to_matrix(), Aref, 2 ) && Ar.padding_intact() );
+        }
+    }
+}
+
+template< typename T, typename L >
+void test_symv_hemv( std::size_t n )
+{
+    for( Uplo uplo : uplos ) {
+        matrix<T> A = rand_matrix<T>( n, n );
+        matrix<T> x = rand_matrix<T>( n, 1 );
+        matrix<T> y0 = rand_matrix<T>( n, 1 );
+
+        // symv
+        {
+            matrix<T> y = y0, yref = y0;
+            auto y_ = vec( y );
+            auto yref_ = vec( yref );
+            test_matrix<T,L> Ar( A );
+            blas::symv( uplo, T( 1.5 ), Ar.view(), vec( x ), T( -0.5 ), y_ );
+            blas::symv( uplo, T( 1.5 ), A.view(), vec( x ), T( -0.5 ), yref_ );
+            TLAPACK_CHECK( agree( y, yref, n ) && Ar.padding_intact() );
+        }
+        // hemv
+        {
+            matrix<T> y = y0, yref = y0;
+            auto y_ = vec( y );
+            auto yref_ = vec( yref );
+            test_matrix<T,L> Ar( A );
+            blas::hemv( uplo, T( 1.5 ), Ar.view(), vec( x ), T( -0.5 ), y_ );
+            blas::hemv( uplo, T( 1.5 ), A.view(), vec( x ), T( -0.5 ), yref_ );
+            TLAPACK_CHECK( agree( y, yref, n ) && Ar.padding_intact() );
+        }
+    }
+}
+
+template< typename T, typename L >
+void test_trmv_trsv( std::size_t n )
+{
+    for( Uplo uplo : uplos ) {
+        for( Op trans : ops_conj ) {
+            for( Diag diag : diags ) {
+                matrix<T> A = rand_matrix<T>( n, n );
+                for(std::size_t j = 0; j < n; ++j)
+                    A(j,j) += T( n );
+                matrix<T> x0 = rand_matrix<T>( n, 1 );
+
+                // trmv
+                {
+                    matrix<T> x = x0, xref = x0;
+                    auto x_ = vec( x );
+                    auto xref_ = vec( xref );
+                    test_matrix<T,L> Ar( A );
+                    blas::trmv( uplo, trans, diag, Ar.view(), x_ );
+                    blas::trmv( uplo, trans, diag, A.view(), xref_ );
+                    TLAPACK_CHECK( agree( x, xref, n ) && Ar.padding_intact() );
+                }
+                // trsv
+                {
+                    matrix<T> x = x0, xref = x0;
+                    auto x_ = vec( x );
+                    auto xref_ = vec( xref );
+                    test_matrix<T,L> Ar( A );
+                    blas::trsv( uplo, trans, diag, Ar.view(), x_ );
+                    blas::trsv( uplo, trans, diag, A.view(), xref_ );
+                    TLAPACK_CHECK( agree( x, xref, n ) && Ar.padding_intact() );
+                }
+            }
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+// Level 3
+
+/// gemm with op(A) m-by-k and op(B) k-by-n stored in LA and LB, and C
+/// stored in LC
+template< typename T, typename LA, typename LB, typename LC >
+void test_gemm( std::size_t m, std::size_t n, std::size_t k )
+{
+    for( Op transA : ops ) {
+        for( Op transB : ops ) {
+            matrix<T> A = ( transA == Op::NoTrans )
+                ? rand_matrix<T>( m, k ) : rand_matrix<T>( k, m );
+            matrix<T> B = ( transB == Op::NoTrans )
+                ? rand_matrix<T>( k, n ) : rand_matrix<T>( n, k );
+            matrix<T> C = rand_matrix<T>( m, n );
+
+            matrix<T> Cref = C;
+            auto Cref_ = Cref.view();
+            blas::gemm( transA, transB, T( 1.5 ), A.view(), B.view(), T( -0.5 ), Cref_ );
+
+            test_matrix<T,LA> Ar( A );
+            test_matrix<T,LB> Br( B );
+            test_matrix<T,LC> Cr( C );
+            auto Cr_ = Cr.view();
+            blas::gemm( transA, transB, T( 1.5 ), Ar.view(), Br.view(), T( -0.5 ), Cr_ );
+            TLAPACK_CHECK( agree( Cr.to_matrix(), Cref, k ) &&
+                           Ar.padding_intact() && Br.padding_intact() &&
+                           Cr.padding_intact() );
+        }
+    }
+}
+
+template< typename T, typename L >
+void test_symm_hemm( std::size_t m, std::size_t n )
+{
+    for( Side side : sides ) {
+        for( Uplo uplo : uplos ) {
+            const std::size_t na = ( side == Side::Left ) ? m : n;
+            matrix<T> A = rand_matrix<T>( na, na );
+            matrix<T> B = rand_matrix<T>( m, n );
+            matrix<T> C = rand_matrix<T>( m, n );
+
+            // symm
+            {
+                matrix<T> Cref = C;
+                auto Cref_ = Cref.view();
+                test_matrix<T,L> Ar( A ), Br( B ), Cr( C );
+                auto Cr_ = Cr.view();
+                blas::symm( side, uplo, T( 1.5 ), Ar.view(), Br.view(), T( -0.5 ), Cr_ );
+                blas::symm( side, uplo, T( 1.5 ), A.view(), B.view(), T( -0.5 ), Cref_ );
+                TLAPACK_CHECK( agree( Cr.to_matrix(), Cref, na ) &&
+                               Ar.padding_intact() && Br.padding_intact() &&
+                               Cr.padding_intact() );
+            }
+            // hemm
+            {
+                matrix<T> Cref = C;
+                auto Cref_ = Cref.view();
+                test_matrix<T,L> Ar( A ), Br( B ), Cr( C );
+                auto Cr_ = Cr.view();
+                blas::hemm( side, uplo, T( 1.5 ), Ar.view(), Br.view(), T( -0.5 ), Cr_ );
+                blas::hemm( side, uplo, T( 1.5 ), A.view(), B.view(), T( -0.5 ), Cref_ );
+                TLAPACK_CHECK( agree( Cr.to_matrix(), Cref, na ) &&
+                               Ar.padding_intact() && Br.padding_intact() &&
+                               Cr.padding_intact() );
+            }
+        }
+    }
+}
+
+template< typename T, typename L >
+void test_trmm_trsm( std::size_t m, std::size_t n )
+{
+    for( Side side : sides ) {
+        for( Uplo uplo : uplos ) {
+            for( Op trans : ops ) {
+                for( Diag diag : diags ) {
+                    const std::size_t na = ( side == Side::Left ) ? m : n;
+                    matrix<T> A = rand_matrix<T>( na, na );
+                    for(std::size_t j = 0; j < na; ++j)
+                        A(j,j) += T( na );
+                    matrix<T> B = rand_matrix<T>( m, n );
+
+                    // trmm
+                    {
+                        matrix<T> Bref = B;
+                        auto Bref_ = Bref.view();
+                        test_matrix<T,L> Ar( A ), Br( B );
+                        auto Br_ = Br.view();
+                        blas::trmm( side, uplo, trans, diag, T( 1.5 ), Ar.view(), Br_ );
+                        blas::trmm( side, uplo, trans, diag, T( 1.5 ), A.view(), Bref_ );
+                        TLAPACK_CHECK( agree( Br.to_matrix(), Bref, na ) &&
+                                       Ar.padding_intact() && Br.padding_intact() );
+                    }
+                    // trsm
+                    {
+                        matrix<T> Bref = B;
+                        auto Bref_ = Bref.view();
+                        test_matrix<T,L> Ar( A ), Br( B );
+                        auto Br_ = Br.view();
+                        blas::trsm( side, uplo, trans, diag, T( 1.5 ), Ar.view(), Br_ );
+                        blas::trsm( side, uplo, trans, diag, T( 1.5 ), A.view(), Bref_ );
+                        TLAPACK_CHECK( agree( Br.to_matrix(), Bref, na ) &&
+                                       Ar.padding_intact() && Br.padding_intact() );
+                    }
+                }
+            }
+        }
+    }
+}
+
+/// syrk and syr2k with trans in { NoTrans, Trans }, and herk and her2k with
+/// trans in { NoTrans, ConjTrans }. C is n-by-n and op(A) is n-by-k.
+template< typename T, typename L >
+void test_rank_k( std::size_t n, std::size_t k )
+{
+    using real_t = real_type<T>;
+
+    for( Uplo uplo : uplos ) {
+        for( Op trans : { Op::NoTrans, Op::Trans } ) {
+            const Op transH = ( trans == Op::NoTrans ) ? Op::NoTrans : Op::ConjTrans;
+            matrix<T> A = ( trans == Op::NoTrans )
+                ? rand_matrix<T>( n, k ) : rand_matrix<T>( k, n );
+            matrix<T> B = ( trans == Op::NoTrans )
+                ? rand_matrix<T>( n, k ) : rand_matrix<T>( k, n );
+            matrix<T> C = rand_hpd_matrix<T>( n );
+
+            // syrk
+            {
+                matrix<T> Cref = C;
+                auto Cref_ = Cref.view();
+                test_matrix<T,L> Ar( A ), Cr( C );
+                auto Cr_ = Cr.view();
+                blas::syrk( uplo, trans, T( 1.5 ), Ar.view(), T( -0.5 ), Cr_ );
+                blas::syrk( uplo, trans, T( 1.5 ), A.view(), T( -0.5 ), Cref_ );
+                TLAPACK_CHECK( agree( Cr.to_matrix(), Cref, k ) &&
+                               Ar.padding_intact() && Cr.padding_intact() );
+            }
+            // herk
+            {
+                matrix<T> Cref = C;
+                auto Cref_ = Cref.view();
+                test_matrix<T,L> Ar( A ), Cr( C );
+                auto Cr_ = Cr.view();
+                blas::herk( uplo, transH, real_t( 1.5 ), Ar.view(), real_t( -0.5 ), Cr_ );
+                blas::herk( uplo, transH, real_t( 1.5 ), A.view(), real_t( -0.5 ), Cref_ );
+                TLAPACK_CHECK( agree( Cr.to_matrix(), Cref, k ) &&
+                               Ar.padding_intact() && Cr.padding_intact() );
+            }
+            // syr2k
+            {
+                matrix<T> Cref = C;
+                auto Cref_ = Cref.view();
+                test_matrix<T,L> Ar( A ), Br( B ), Cr( C );
+                auto Cr_ = Cr.view();
+                blas::syr2k( uplo, trans, T( 1.5 ), Ar.view(), Br.view(), T( -0.5 ), Cr_ );
+                blas::syr2k( uplo, trans, T( 1.5 ), A.view(), B.view(), T( -0.5 ), Cref_ );
+                TLAPACK_CHECK( agree( Cr.to_matrix(), Cref, 2*k ) &&
+                               Ar.padding_intact() && Br.padding_intact() &&
+                               Cr.padding_intact() );
+            }
+            // her2k
+            {
+                matrix<T> Cref = C;
+                auto Cref_ = Cref.view();
+                test_matrix<T,L> Ar( A ), Br( B ), Cr( C );
+                auto Cr_ = Cr.view();
+                blas::her2k( uplo, transH, T( 1.5 ), Ar.view(), Br.view(), real_t( -0.5 ), Cr_ );
+                blas::her2k( uplo, transH, T( 1.5 ), A.view(), B.view(), real_t( -0.5 ), Cref_ );
+                TLAPACK_CHECK( agree( Cr.to_matrix(), Cref, 2*k ) &&
+                               Ar.padding_intact() && Br.padding_intact() &&
+                               Cr.padding_intact() );
+            }
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/// All the routines on matrices stored in L
+template< typename T, typename L >
+void run_storage()
+{
+    using bs = blas::gemm_blocksize<T>;
+
+    // Level 2
+    for( std::size_t inc : { 1, 2 } ) {
+        test_gemv<T,L>( 7, 5, inc );
+        test_gemv<T,L>( 1, 6, inc );
+    }
+    test_ger<T,L>( 7, 5 );
+    test_syr_her<T,L>( 6 );
+    test_symv_hemv<T,L>( 6 );
+    test_trmv_trsv<T,L>( 6 );
+
+    // Level 3: unblocked gemm, and blocked gemm with more than one block of
+    // k, with sizes that are not multiples of mr and nr
+    test_gemm<T,L,L,L>( 5, 7, 3 );
+    test_gemm<T,L,L,L>( bs::mr + 3, 2*bs::nr + 1, bs::kc + 5 );
+    test_symm_hemm<T,L>( 7, 5 );
+
+    // Large enough for the blocked trmm, trsm, syrk, herk, syr2k and her2k,
+    // which call gemm on row-major submatrices
+    const std::size_t n = 2 * blas::get_blocksize<T>( "level3", 0, 0, 0 ) + 3;
+    test_trmm_trsm<T,L>( n, 7 );
+    test_trmm_trsm<T,L>( 5, n );
+    test_rank_k<T,L>( n, 9 );
+}
+
+template< typename T >
+void run()
+{
+    using bs = blas::gemm_blocksize<T>;
+
+    #ifndef TLAPACK_STATIC_TUNING
+        // Small blocks, so that the blocked Level 3 BLAS run on small sizes
+        blas::set_blocksize( "level3", blas::tuning_type<T>(), 0, 0, 0, 8 );
+    #endif
+
+    run_storage< T, rowmajor >();
+    run_storage< T, rowmajor_sub >();
+
+    // gemm with operands in different storages: each of A and B is packed
+    // according to its own storage, and C is written according to its own
+    const std::size_t m = bs::mr + 3, n = 2*bs::nr + 1, k = bs::kc + 5;
+    test_gemm< T, rowmajor_sub, colmajor, rowmajor >( m, n, k );
+    test_gemm< T, colmajor, rowmajor_sub, colmajor >( m, n, k );
+    test_gemm< T, rowmajor, rowmajor_sub, colmajor >( m, n, k );
+    test_gemm< T, colmajor, colmajor, rowmajor_sub >( m, n, k );
+
+    #ifndef TLAPACK_STATIC_TUNING
+        blas::clear_tuning();
+    #endif
+
+    std::printf( "rowmajor<%s> done\n", type_name<T>() );
+}
+
+int main()
+{
+    run< float >();
+    run< double >();
+    run< std::complex<float> >();
+    run< std::complex<double> >();
+
+    return report( "test_rowmajor" );
+}
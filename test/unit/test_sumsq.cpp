@@ -0,0 +1,244 @@
+/// @file test_sumsq.cpp Tests the sums of squares of nrm2 and lassq.
+//
+// Copyright (c) 2021, University of Colorado Denver. All rights reserved.
+//
+// This file is part of <T>LAPACK.
+// <T>LAPACK is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "test_utils.hpp"
+
+#include <cmath>
+
+using namespace tlapack_test;
+using blas::internal::vector;
+
+//------------------------------------------------------------------------------
+/// Blue's accumulators computed with the scalar loop that nrm2 and lassq used
+/// before the vectorized kernels
+template< typename T >
+void ref_accumulators(
+    const std::vector<T>& x,
+    real_type<T>& asml, real_type<T>& amed, real_type<T>& abig )
+{
+    using real_t = real_type<T>;
+    const real_t zero( 0 );
+    const real_t tsml = blas::blue_min<real_t>();
+    const real_t tbig = blas::blue_max<real_t>();
+    const real_t ssml = blas::blue_scalingMin<real_t>();
+    const real_t sbig = blas::blue_scalingMax<real_t>();
+
+    for( const T& xi : x ) {
+        real_t ax = blas::abs( xi );
+        if( ax > tbig )
+            abig += (ax*sbig) * (ax*sbig);
+        else if( ax < tsml ) {
+            if( abig == zero ) asml += (ax*ssml) * (ax*ssml);
+        } else
+            amed += ax * ax;
+    }
+}
+
+/// nrm2 with the scalar loop
+template< typename T >
+real_type<T> ref_nrm2( const std::vector<T>& x )
+{
+    using real_t = real_type<T>;
+    real_t asml( 0 ), amed( 0 ), abig( 0 ), scl, sumsq;
+    ref_accumulators( x, asml, amed, abig );
+    blas::internal::sumsq_combine( asml, amed, abig, scl, sumsq );
+    return scl * std::sqrt( sumsq );
+}
+
+/// lassq with the scalar loop, for scl > 0 and sumsq > 0 in the mid range
+template< typename T >
+void ref_lassq( const std::vector<T>& x, real_type<T>& scl, real_type<T>& sumsq )
+{
+    using real_t = real_type<T>;
+    real_t asml( 0 ), amed( 0 ), abig( 0 );
+    ref_accumulators( x, asml, amed, abig );
+    amed += (scl * scl) * sumsq;
+    blas::internal::sumsq_combine( asml, amed, abig, scl, sumsq );
+}
+
+/// True if a and b are both NaN, both the same infinity, or agree to tol
+template< typename real_t >
+bool same( real_t a, real_t b, real_t tol )
+{
+    if( std::isnan(a) || std::isnan(b) )
+        return std::isnan(a) && std::isnan(b);
+    if( std::isinf(a) || std::isinf(b) )
+        return a == b;
+    return std::abs( a - b ) <= tol * std::abs( b );
+}
+
+//------------------------------------------------------------------------------
+/// Vectors whose entries are mid-range, tiny, huge, subnormal, NaN or Inf
+template< typename T >
+std::vector<T> make_vector( std::size_t n, const char* kind )
+{
+    using real_t = real_type<T>;
+    const real_t tsml = blas::blue_min<real_t>();
+    const real_t tbig = blas::blue_max<real_t>();
+    const real_t denorm = std::numeric_limits<real_t>::denorm_min();
+    const real_t inf = std::numeric_limits<real_t>::infinity();
+    const real_t nan = std::numeric_limits<real_t>::quiet_NaN();
+    const std::string k( kind );
+
+    std::vector<T> x( n );
+    for(std::size_t i = 0; i < n; ++i) {
+        const T r = rand_entry<T>();
+        if( k == "tiny" )
+            x[i] = r * tsml;
+        else if( k == "huge" )
+            x[i] = r * tbig;
+        else if( k == "mixed" )
+            // tiny, mid-range, huge and subnormal entries
+            x[i] = ( i % 4 == 0 ) ? r * tsml
+                 : ( i % 4 == 1 ) ? r
+                 : ( i % 4 == 2 ) ? r * tbig : T( denorm * real_t( i ) );
+        else if( k == "tiny-mid" )
+            x[i] = ( i % 3 == 0 ) ? r : r * tsml * real_t( 1e-3 );
+        else
+            x[i] = r;
+    }
+    if( n > 0 ) {
+        if( k == "nan" )
+            x[ n/2 ] = T( nan );
+        else if( k == "inf" )
+            x[ n-1 ] = T( -inf );
+        else if( k == "inf-nan" ) {
+            x[ 0 ] = T( inf );
+            x[ n-1 ] = T( nan );
+        }
+    }
+    return x;
+}
+
+//------------------------------------------------------------------------------
+/// Compares nrm2 and lassq with the scalar loop
+template< typename T >
+void test_sumsq( std::size_t n, const char* kind )
+{
+    using real_t = real_type<T>;
+    std::vector<T> x = make_vector<T>( n, kind );
+    const real_t tolx = tol<T>( 2*n + 2 );
+    bool ok = true;
+
+    // Contiguous vectors use the vectorized kernels
+    const real_t nrm = blas::nrm2( vector( x.data(), n ) );
+    const real_t ref = ref_nrm2( x );
+    ok = TLAPACK_CHECK( same( nrm, ref, tolx ) ) && ok;
+
+    real_t scl = real_t( 0.5 ), sumsq = real_t( 3 );
+    real_t scl_ref = scl, sumsq_ref = sumsq;
+    lapack::lassq( vector( x.data(), n ), scl, sumsq );
+    ref_lassq( x, scl_ref, sumsq_ref );
+    ok = TLAPACK_CHECK( same( scl * std::sqrt( sumsq ),
+                              scl_ref * std::sqrt( sumsq_ref ), tolx ) ) && ok;
+
+    // Strided vectors keep the scalar loop, but for n = 1
+    if( n <= 1000 ) {
+        std::vector<T> y( 2*n );
+        for(std::size_t i = 0; i < n; ++i)
+            y[2*i] = x[i];
+        const real_t nrm_strided = blas::nrm2( vector( y.data(), n, 2 ) );
+        ok = TLAPACK_CHECK(
+            same( nrm_strided, ref, ( n > 1 ) ? real_t( 0 ) : tolx ) ) && ok;
+    }
+
+    if( !ok )
+        std::printf( "    n = %zu, %s, nrm2 = %g, ref = %g\n",
+            n, kind, double( nrm ), double( ref ) );
+}
+
+//------------------------------------------------------------------------------
+/// Compares each SIMD kernel available on this CPU with the generic one
+template< typename real_t, typename kernel_t >
+void test_kernel( const char* name, kernel_t&& kernel )
+{
+    const char* kinds[] = { "mid", "tiny", "huge", "mixed", "tiny-mid", "nan", "inf" };
+    const std::size_t sizes[] = { 0, 1, 7, 8, 15, 16, 17, 31, 32, 33, 63, 64, 65, 1001 };
+
+    for( const char* kind : kinds ) {
+        for( std::size_t n : sizes ) {
+            std::vector<real_t> x = make_vector<real_t>( n, kind );
+            real_t s[3] = { 0, 0, 0 }, r[3] = { 0, 0, 0 };
+            kernel( x.data(), n, s[0], s[1], s[2] );
+            blas::internal::sumsq_kernel_generic( x.data(), n, r[0], r[1], r[2] );
+            bool ok = true;
+            for( int a = 0; a < 3; ++a )
+                ok = ok && same( s[a], r[a], tol<real_t>( n+2 ) );
+            if( !TLAPACK_CHECK( ok ) )
+                std::printf( "    %s, n = %zu, %s\n", name, n, kind );
+        }
+    }
+}
+
+template< typename real_t >
+void test_kernels();
+
+template<>
+void test_kernels< float >()
+{
+    #ifdef TBLAS_SIMD_X86
+        __builtin_cpu_init();
+        if( __builtin_cpu_supports("avx2") )
+            test_kernel<float>( "ssumsq_kernel_avx2",
+                blas::internal::ssumsq_kernel_avx2 );
+        if( __builtin_cpu_supports("avx512f") )
+            test_kernel<float>( "ssumsq_kernel_avx512",
+                blas::internal::ssumsq_kernel_avx512 );
+    #endif
+}
+
+template<>
+void test_kernels< double >()
+{
+    #ifdef TBLAS_SIMD_X86
+        __builtin_cpu_init();
+        if( __builtin_cpu_supports("avx2") )
+            test_kernel<double>( "dsumsq_kernel_avx2",
+                blas::internal::dsumsq_kernel_avx2 );
+        if( __builtin_cpu_supports("avx512f") )
+            test_kernel<double>( "dsumsq_kernel_avx512",
+                blas::internal::dsumsq_kernel_avx512 );
+    #endif
+}
+
+//------------------------------------------------------------------------------
+template< typename T >
+void run()
+{
+    const char* kinds[] = {
+        "mid", "tiny", "huge", "mixed", "tiny-mid", "nan", "inf", "inf-nan" };
+    const std::size_t sizes[] = { 1, 2, 7, 16, 33, 100, 1000 };
+
+    for( const char* kind : kinds )
+        for( std::size_t n : sizes )
+            test_sumsq<T>( n, kind );
+
+    // Vectors that are split in chunks, one per thread
+    const std::size_t nchunked = 2*TBLAS_SUMSQ_MIN_CHUNK + 5;
+    for( int nt : { 1, 2, 4 } ) {
+        blas::set_num_threads( nt );
+        for( const char* kind : { "mid", "mixed", "nan", "inf" } )
+            test_sumsq<T>( nchunked, kind );
+    }
+    blas::set_num_threads( 1 );
+
+    std::printf( "sumsq<%s> done\n", type_name<T>() );
+}
+
+int main()
+{
+    test_kernels< float >();
+    test_kernels< double >();
+
+    run< float >();
+    run< double >();
+    run< std::complex<float> >();
+    run< std::complex<double> >();
+
+    return report( "test_sumsq" );
+}
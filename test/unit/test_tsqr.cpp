@@ -0,0 +1,186 @@
+/// @file test_tsqr.cpp Tests tsqr, unmtsqr, tsqr_update and unmtsqr_update.
+//
+// Copyright (c) 2021, University of Colorado Denver. All rights reserved.
+//
+// This file is part of <T>LAPACK.
+// <T>LAPACK is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "test_utils.hpp"
+
+using namespace tlapack_test;
+using blas::Op;
+
+//------------------------------------------------------------------------------
+/// Factors a m-by-n matrix with nb row-blocks and checks A = Q R and Q^H Q = I
+template< typename T >
+void test_tsqr( std::size_t m, std::size_t n, std::size_t nb )
+{
+    using real_t = real_type<T>;
+    const real_t tolQR = tol<T>( 10*m );
+
+    const matrix<T> A0 = rand_matrix<T>( m, n );
+    matrix<T> A = A0;
+    matrix<T> T_( 2*n, nb*n );
+    auto A_ = A.view();
+    auto T_v = T_.view();
+    TLAPACK_CHECK( lapack::tsqr( A_, T_v ) == 0 );
+    const matrix<T> R = triu( A, n, n );
+
+    // Q = Q I
+    matrix<T> Q = eye<T>( m, n );
+    matrix<T> W( n, n );
+    auto Q_ = Q.view();
+    auto W_ = W.view();
+    TLAPACK_CHECK( lapack::unmtsqr( lapack::noTranspose, A.view(), T_.view(), Q_, W_ ) == 0 );
+    TLAPACK_CHECK( orthogonality( Q ) <= tolQR );
+    TLAPACK_CHECK( rel_diff( ref_gemm( Op::NoTrans, Op::NoTrans, Q, R ), A0 ) <= tolQR );
+
+    // Q^H A0 = [ R; 0 ], with the columns of C split among the threads
+    matrix<T> C = A0;
+    auto C_ = C.view();
+    TLAPACK_CHECK( lapack::unmtsqr( lapack::conjTranspose, A.view(), T_.view(), C_, W_ ) == 0 );
+    matrix<T> R0( m, n );
+    for(std::size_t j = 0; j < n; ++j)
+        for(std::size_t i = 0; i < n; ++i)
+            R0(i,j) = R(i,j);
+    TLAPACK_CHECK( norm_diff( C, R0 ) <= tolQR * norm( A0 ) );
+}
+
+//------------------------------------------------------------------------------
+/// Factors a matrix in chunks of rows with tsqr and tsqr_update, applies
+/// Q^H and Q chunk by chunk, and compares with the factorization of the
+/// whole matrix
+template< typename T >
+void test_tsqr_update(
+    const std::vector<std::size_t>& mchunks, std::size_t n, std::size_t nb )
+{
+    using real_t = real_type<T>;
+    using pair = std::pair<std::size_t,std::size_t>;
+
+    std::size_t m = 0;
+    for( std::size_t mi : mchunks ) m += mi;
+    const real_t tolQR = tol<T>( 10*m );
+
+    const matrix<T> A0 = rand_matrix<T>( m, n );
+    const std::size_t nc = mchunks.size();
+    std::vector< matrix<T> > A, T_;
+    for(std::size_t c = 0, i0 = 0; c < nc; i0 += mchunks[c], ++c) {
+        A.push_back( row_block( A0, i0, i0 + mchunks[c] ) );
+        T_.push_back( matrix<T>( 2*n, nb*n ) );
+    }
+
+    // Factor the chunks
+    auto A_ = A[0].view();
+    auto T_v = T_[0].view();
+    TLAPACK_CHECK( lapack::tsqr( A_, T_v ) == 0 );
+    matrix<T> R = triu( A[0], n, n );
+    auto R_ = R.view();
+    for(std::size_t c = 1; c < nc; ++c) {
+        auto Ac = A[c].view();
+        auto Tc = T_[c].view();
+        TLAPACK_CHECK( lapack::tsqr_update( R_, Ac, Tc ) == 0 );
+    }
+    R = triu( R, n, n );
+
+    // R^H R = A0^H A0
+    const matrix<T> AhA = ref_gemm( Op::ConjTrans, Op::NoTrans, A0, A0 );
+    TLAPACK_CHECK( rel_diff( ref_gemm( Op::ConjTrans, Op::NoTrans, R, R ), AhA ) <= tolQR );
+
+    // Q^H [ A0, I ] = [ R, Q^H(1:n,:)^H ; 0, ... ], chunk by chunk
+    const std::size_t k = n + 2;
+    std::vector< matrix<T> > C;
+    for(std::size_t c = 0, i0 = 0; c < nc; i0 += mchunks[c], ++c) {
+        matrix<T> Cc( mchunks[c], k );
+        for(std::size_t i = 0; i < mchunks[c]; ++i) {
+            for(std::size_t j = 0; j < n; ++j)
+                Cc(i,j) = A0(i0+i,j);
+            Cc(i,n)   = rand_entry<T>();
+            Cc(i,n+1) = rand_entry<T>();
+        }
+        C.push_back( Cc );
+    }
+    const std::vector< matrix<T> > C_orig = C;
+
+    matrix<T> W( n, k );
+    auto W_ = W.view();
+    {
+        auto C0 = C[0].view();
+        TLAPACK_CHECK( lapack::unmtsqr( lapack::conjTranspose, A[0].view(), T_[0].view(), C0, W_ ) == 0 );
+    }
+    auto C0top = lapack::submatrix( C[0].view(), pair{0,n}, pair{0,k} );
+    for(std::size_t c = 1; c < nc; ++c) {
+        auto Cc = C[c].view();
+        TLAPACK_CHECK( lapack::unmtsqr_update(
+            lapack::conjTranspose, A[c].view(), T_[c].view(), C0top, Cc, W_ ) == 0 );
+    }
+
+    // The first n columns are R on top of zeros
+    matrix<T> QhA( m, n );
+    for(std::size_t c = 0, i0 = 0; c < nc; i0 += mchunks[c], ++c)
+        for(std::size_t j = 0; j < n; ++j)
+            for(std::size_t i = 0; i < mchunks[c]; ++i)
+                QhA(i0+i,j) = C[c](i,j);
+    matrix<T> R0( m, n );
+    for(std::size_t j = 0; j < n; ++j)
+        for(std::size_t i = 0; i <= j; ++i)
+            R0(i,j) = R(i,j);
+    TLAPACK_CHECK( norm_diff( QhA, R0 ) <= tolQR * norm( A0 ) );
+
+    // Q, in the reverse order, recovers the original matrix
+    for(std::size_t c = nc-1; c >= 1; --c) {
+        auto Cc = C[c].view();
+        TLAPACK_CHECK( lapack::unmtsqr_update(
+            lapack::noTranspose, A[c].view(), T_[c].view(), C0top, Cc, W_ ) == 0 );
+    }
+    {
+        auto C0 = C[0].view();
+        TLAPACK_CHECK( lapack::unmtsqr( lapack::noTranspose, A[0].view(), T_[0].view(), C0, W_ ) == 0 );
+    }
+    bool same = true;
+    for(std::size_t c = 0; c < nc; ++c)
+        same = same && ( norm_diff( C[c], C_orig[c] ) <= tolQR * ( 1 + norm( C_orig[c] ) ) );
+    TLAPACK_CHECK( same );
+}
+
+//------------------------------------------------------------------------------
+template< typename T >
+void run()
+{
+    // m, n, number of row-blocks. m is not a multiple of the number of
+    // row-blocks, and the row-blocks have n rows or more.
+    const std::size_t sizes[][3] = {
+        { 1, 1, 1 },
+        { 9, 1, 4 },
+        { 30, 7, 1 },
+        { 30, 7, 4 },
+        { 101, 7, 3 },
+        { 203, 11, 5 },
+        { 64, 8, 8 },
+        { 301, 16, 16 },
+    };
+
+    for( int nt : { 1, 4 } ) {
+        blas::set_num_threads( nt );
+        for( const auto& s : sizes )
+            test_tsqr<T>( s[0], s[1], s[2] );
+
+        test_tsqr_update<T>( { 40, 23, 77 }, 5, 2 );
+        test_tsqr_update<T>( { 9, 9 }, 9, 1 );
+        test_tsqr_update<T>( { 100, 37, 51, 12 }, 12, 1 );
+        test_tsqr_update<T>( { 203, 110 }, 13, 7 );
+    }
+    blas::set_num_threads( 1 );
+
+    std::printf( "tsqr<%s> done\n", type_name<T>() );
+}
+
+int main()
+{
+    run< float >();
+    run< double >();
+    run< std::complex<float> >();
+    run< std::complex<double> >();
+
+    return report( "test_tsqr" );
+}
@@ -0,0 +1,236 @@
+/// @file test_tuning.cpp Tests the registry of block sizes.
+//
+// Copyright (c) 2021, University of Colorado Denver. All rights reserved.
+//
+// This file is part of <T>LAPACK.
+// <T>LAPACK is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+// Defaults that differ from each other and from the fallback of 32
+#define TLAPACK_NB_GEQRF 48
+#define TLAPACK_NB_UNGQR 40
+#define TLAPACK_NB_UNMQR 56
+#define TLAPACK_NB_POTRF 72
+
+#include "test_utils.hpp"
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+
+using namespace tlapack_test;
+using blas::internal::default_blocksize;
+
+// The table of defaults is usable at compile time
+static_assert( default_blocksize<double>( "potrf" ) == TLAPACK_NB_POTRF, "" );
+static_assert( default_blocksize<float>( "level3" )
+               == blas::level3_blocksize<float>::nb, "" );
+
+//------------------------------------------------------------------------------
+/// The defaults are looked up by the full name of the routine
+template< typename T >
+void test_static_table()
+{
+    TLAPACK_CHECK( default_blocksize<T>( "geqrf" ) == TLAPACK_NB_GEQRF );
+    TLAPACK_CHECK( default_blocksize<T>( "ungqr" ) == TLAPACK_NB_UNGQR );
+    TLAPACK_CHECK( default_blocksize<T>( "unmqr" ) == TLAPACK_NB_UNMQR );
+    TLAPACK_CHECK( default_blocksize<T>( "potrf" ) == TLAPACK_NB_POTRF );
+    TLAPACK_CHECK( default_blocksize<T>( "level3" )
+                   == blas::level3_blocksize<T>::nb );
+
+    // Names that share a prefix with the ones above, and short names
+    const char* others[] = {
+        "getrf", "gebrd", "geqrf2", "geqr", "ungbr", "unmlq", "u", "ge", "" };
+    for( const char* name : others )
+        TLAPACK_CHECK( default_blocksize<T>( name ) == 32 );
+}
+
+#ifndef TLAPACK_STATIC_TUNING
+
+//------------------------------------------------------------------------------
+/// Entries read from test_tuning.txt, in the environment variable
+/// TLAPACK_TUNING_FILE, on the first use of the registry
+void test_tuning_file()
+{
+    using lapack::get_blocksize;
+
+    if( !std::getenv( "TLAPACK_TUNING_FILE" ) ) {
+        std::printf( "TLAPACK_TUNING_FILE is not set: skipping the file\n" );
+        return;
+    }
+
+    // Entries for the type are preferred, the largest one that fits first
+    TLAPACK_CHECK( get_blocksize<double>( "geqrf", 50, 50, 50 ) == 24 );
+    TLAPACK_CHECK( get_blocksize<double>( "geqrf", 100, 100, 100 ) == 40 );
+    TLAPACK_CHECK( get_blocksize<double>( "geqrf", 500, 50, 500 ) == 24 );
+
+    // Entries for all types
+    TLAPACK_CHECK( get_blocksize<float>( "geqrf", 500, 500, 500 ) == 20 );
+    TLAPACK_CHECK( get_blocksize< std::complex<float> >( "geqrf", 1, 1, 1 ) == 20 );
+
+    // Entries for other types, and routines without entries
+    TLAPACK_CHECK( get_blocksize<float>( "potrf", 10, 10, 10 ) == 16 );
+    TLAPACK_CHECK( get_blocksize<double>( "potrf", 10, 10, 10 ) == TLAPACK_NB_POTRF );
+    TLAPACK_CHECK( get_blocksize<double>( "unmqr", 10, 10, 10 ) == TLAPACK_NB_UNMQR );
+    TLAPACK_CHECK( get_blocksize< std::complex<double> >( "level3", 1, 1, 1 ) == 8 );
+    TLAPACK_CHECK( get_blocksize<double>( "level3", 1, 1, 1 )
+                   == blas::level3_blocksize<double>::nb );
+}
+
+//------------------------------------------------------------------------------
+/// set_blocksize, and the round trip through save and load
+void test_registry()
+{
+    using lapack::get_blocksize;
+    using lapack::set_blocksize;
+
+    lapack::clear_tuning();
+    TLAPACK_CHECK( get_blocksize<double>( "geqrf", 10, 10, 10 ) == TLAPACK_NB_GEQRF );
+
+    set_blocksize( "ungqr", 'd', 0, 0, 0, 8 );
+    set_blocksize( "ungqr", 'd', 0, 0, 0, 12 ); // replaces the entry above
+    set_blocksize( "ungqr", 'd', 64, 0, 0, 16 );
+    set_blocksize( "ungqr", '*', 1000, 1000, 1000, 24 );
+    TLAPACK_CHECK( get_blocksize<double>( "ungqr", 10, 10, 10 ) == 12 );
+    TLAPACK_CHECK( get_blocksize<double>( "ungqr", 64, 10, 10 ) == 16 );
+    TLAPACK_CHECK( get_blocksize<double>( "ungqr", 2000, 2000, 2000 ) == 16 );
+    TLAPACK_CHECK( get_blocksize<float>( "ungqr", 2000, 2000, 2000 ) == 24 );
+    TLAPACK_CHECK( get_blocksize<float>( "ungqr", 999, 2000, 2000 ) == TLAPACK_NB_UNGQR );
+
+    const char* path = "test_tuning_saved.txt";
+    TLAPACK_CHECK( lapack::save_tuning_file( path ) );
+    lapack::clear_tuning();
+    TLAPACK_CHECK( get_blocksize<double>( "ungqr", 64, 10, 10 ) == TLAPACK_NB_UNGQR );
+    TLAPACK_CHECK( lapack::load_tuning_file( path ) );
+    TLAPACK_CHECK( get_blocksize<double>( "ungqr", 10, 10, 10 ) == 12 );
+    TLAPACK_CHECK( get_blocksize<double>( "ungqr", 64, 10, 10 ) == 16 );
+    TLAPACK_CHECK( get_blocksize<float>( "ungqr", 2000, 2000, 2000 ) == 24 );
+    std::remove( path );
+
+    TLAPACK_CHECK( !lapack::load_tuning_file( "no/such/file.txt" ) );
+    lapack::clear_tuning();
+}
+
+//------------------------------------------------------------------------------
+/// Threads read the registry while it is changed: each read sees either the
+/// table before a change or the one after it
+void test_concurrent_access()
+{
+    using lapack::get_blocksize;
+
+    lapack::clear_tuning();
+    lapack::set_blocksize( "unmqr", 'd', 0, 0, 0, 4 );
+
+    std::atomic< bool > done{ false };
+    std::atomic< int > bad{ 0 };
+    std::vector< std::thread > readers;
+    for( int i = 0; i < 4; ++i ) {
+        readers.emplace_back( [&]() {
+            while( !done.load() ) {
+                const std::size_t nb = get_blocksize<double>( "unmqr", 10, 10, 10 );
+                const std::size_t nb2 = get_blocksize<double>( "unmqr", 500, 10, 10 );
+                if( nb != 4 && nb != TLAPACK_NB_UNMQR )
+                    ++bad;
+                if( nb2 != 4 && nb2 != 6 && nb2 != TLAPACK_NB_UNMQR )
+                    ++bad;
+            }
+        } );
+    }
+    for( int i = 0; i < 200; ++i ) {
+        lapack::set_blocksize( "unmqr", 'd', 100, 0, 0, 6 );
+        lapack::set_blocksize( "geqrf", 'd', std::size_t(i), 0, 0, 8 );
+        lapack::clear_tuning();
+        lapack::set_blocksize( "unmqr", 'd', 0, 0, 0, 4 );
+    }
+    done = true;
+    for( auto& r : readers )
+        r.join();
+
+    TLAPACK_CHECK( bad == 0 );
+    TLAPACK_CHECK( get_blocksize<double>( "unmqr", 500, 10, 10 ) == 4 );
+    lapack::clear_tuning();
+}
+
+//------------------------------------------------------------------------------
+/// The blocked routines use the block sizes of the registry
+template< typename T >
+void test_blocked_routines()
+{
+    using blas::Side;
+    using blas::Uplo;
+    using blas::Op;
+    using blas::Diag;
+    const char t = lapack::tuning_type<T>();
+    const std::size_t n = 37, m = 23;
+
+    // trsm and herk with a single block, and with blocks of 5
+    matrix<T> A = rand_hpd_matrix<T>( n );
+    const matrix<T> B0 = rand_matrix<T>( n, m );
+    matrix<T> B1 = B0, B2 = B0;
+    matrix<T> C0 = rand_hpd_matrix<T>( n );
+    matrix<T> C1 = C0, C2 = C0;
+    auto B1_ = B1.view();
+    auto B2_ = B2.view();
+    auto C1_ = C1.view();
+    auto C2_ = C2.view();
+
+    lapack::set_blocksize( "level3", t, 0, 0, 0, 2*n );
+    blas::trsm( Side::Left, Uplo::Lower, Op::NoTrans, Diag::NonUnit,
+                T( 1 ), A.view(), B1_ );
+    blas::herk( Uplo::Upper, Op::NoTrans, real_type<T>( -1 ), B1_,
+                real_type<T>( 1 ), C1_ );
+
+    lapack::set_blocksize( "level3", t, 0, 0, 0, 5 );
+    blas::trsm( Side::Left, Uplo::Lower, Op::NoTrans, Diag::NonUnit,
+                T( 1 ), A.view(), B2_ );
+    blas::herk( Uplo::Upper, Op::NoTrans, real_type<T>( -1 ), B2_,
+                real_type<T>( 1 ), C2_ );
+
+    TLAPACK_CHECK( rel_diff( B2, B1 ) <= tol<T>( 10*n ) );
+    TLAPACK_CHECK( rel_diff( C2, C1 ) <= tol<T>( 10*n ) );
+
+    // potrf with the default block size, which is potrf2 on the whole
+    // matrix, and with blocks of 8
+    matrix<T> L1 = A, L2 = A;
+    auto L1_ = L1.view();
+    auto L2_ = L2.view();
+    lapack::set_blocksize( "potrf", t, 0, 0, 0, 2*n );
+    TLAPACK_CHECK( lapack::potrf( lapack::lower_triangle, L1_ ) == 0 );
+    lapack::set_blocksize( "potrf", t, 0, 0, 0, 8 );
+    TLAPACK_CHECK( lapack::potrf( lapack::lower_triangle, L2_ ) == 0 );
+    TLAPACK_CHECK( rel_diff( L2, L1 ) <= tol<T>( 10*n ) );
+
+    lapack::clear_tuning();
+}
+
+#endif // TLAPACK_STATIC_TUNING
+
+//------------------------------------------------------------------------------
+template< typename T >
+void run()
+{
+    test_static_table<T>();
+    #ifndef TLAPACK_STATIC_TUNING
+        test_blocked_routines<T>();
+    #endif
+
+    std::printf( "tuning<%s> done\n", type_name<T>() );
+}
+
+int main()
+{
+    #ifndef TLAPACK_STATIC_TUNING
+        // Must come first: the file is read on the first use of the registry
+        test_tuning_file();
+        test_registry();
+        test_concurrent_access();
+    #endif
+
+    run< float >();
+    run< double >();
+    run< std::complex<float> >();
+    run< std::complex<double> >();
+
+    return report( "test_tuning" );
+}
@@ -0,0 +1,252 @@
+/// @file test_utils.hpp Utilities for the unit tests of <T>LAPACK.
+//
+// Copyright (c) 2021, University of Colorado Denver. All rights reserved.
+//
+// This file is part of <T>LAPACK.
+// <T>LAPACK is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef TLAPACK_TEST_UTILS_HH
+#define TLAPACK_TEST_UTILS_HH
+
+#include <plugins/tlapack_mdspan.hpp>
+#include <plugins/tlapack_stdvector.hpp>
+#include <slate_api/blas/mdspan.hpp>
+#include <tlapack.hpp>
+
+#include <cstdio>
+#include <complex>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace tlapack_test {
+
+using blas::internal::colmajor_matrix;
+using blas::real_type;
+
+// -----------------------------------------------------------------------------
+// Checks
+
+/// Number of checks and of failed checks
+struct counters {
+    int checks = 0;
+    int failures = 0;
+};
+
+inline counters& test_counters() {
+    static counters c;
+    return c;
+}
+
+/// Records the result of a check, and prints it if it failed
+inline bool check( bool cond, const char* what, const char* file, int line )
+{
+    ++test_counters().checks;
+    if( !cond ) {
+        ++test_counters().failures;
+        std::printf( "%s:%d: check failed: %s\n", file, line, what );
+    }
+    return cond;
+}
+
+#define TLAPACK_CHECK( cond ) \
+    tlapack_test::check( (cond), #cond, __FILE__, __LINE__ )
+
+/// Prints a summary. Returns the exit code of the test.
+inline int report( const char* name )
+{
+    const counters& c = test_counters();
+    std::printf( "%s: %d checks, %d failures\n", name, c.checks, c.failures );
+    return ( c.failures == 0 ) ? 0 : 1;
+}
+
+// -----------------------------------------------------------------------------
+// Matrices
+
+/// Column-major matrix that owns its data
+template< typename T >
+struct matrix {
+    std::size_t m, n;
+    std::vector<T> data;
+
+    matrix( std::size_t m_, std::size_t n_, const T& x = T(0) )
+        : m( m_ ), n( n_ ), data( m_*n_, x ) {}
+
+    auto view() { return colmajor_matrix<T>( data.data(), m, n, (m > 0) ? m : 1 ); }
+    auto view() const { return colmajor_matrix<const T>( data.data(), m, n, (m > 0) ? m : 1 ); }
+
+    T& operator()( std::size_t i, std::size_t j ) { return data[ i + j*m ]; }
+    const T& operator()( std::size_t i, std::size_t j ) const { return data[ i + j*m ]; }
+};
+
+/// Generator used by all the tests, so that they are reproducible
+inline std::mt19937& generator() {
+    static std::mt19937 gen( 2021 );
+    return gen;
+}
+
+/// Random number uniformly distributed in [-1,1], or in the unit square
+template< typename T >
+inline T rand_entry() {
+    std::uniform_real_distribution< real_type<T> > d( -1, 1 );
+    return T( d( generator() ) );
+}
+
+template< typename T >
+inline std::complex<T> rand_complex_entry() {
+    std::uniform_real_distribution<T> d( -1, 1 );
+    const T re = d( generator() );
+    return std::complex<T>( re, d( generator() ) );
+}
+
+template<>
+inline std::complex<float> rand_entry< std::complex<float> >() {
+    return rand_complex_entry<float>();
+}
+
+template<>
+inline std::complex<double> rand_entry< std::complex<double> >() {
+    return rand_complex_entry<double>();
+}
+
+/// Random m-by-n matrix
+template< typename T >
+inline matrix<T> rand_matrix( std::size_t m, std::size_t n )
+{
+    matrix<T> A( m, n );
+    for( auto& a : A.data )
+        a = rand_entry<T>();
+    return A;
+}
+
+/// Random Hermitian positive definite matrix of order n
+template< typename T >
+inline matrix<T> rand_hpd_matrix( std::size_t n )
+{
+    using blas::conj;
+
+    matrix<T> A = rand_matrix<T>( n, n );
+    for(std::size_t j = 0; j < n; ++j) {
+        for(std::size_t i = 0; i < j; ++i) {
+            A(i,j) = conj( A(j,i) );
+        }
+        A(j,j) = T( std::real( A(j,j) ) + real_type<T>( n ) );
+    }
+    return A;
+}
+
+/// Identity matrix
+template< typename T >
+inline matrix<T> eye( std::size_t m, std::size_t n )
+{
+    matrix<T> A( m, n );
+    for(std::size_t i = 0; i < std::min( m, n ); ++i)
+        A(i,i) = T( 1 );
+    return A;
+}
+
+/// Upper trapezoid of the leading m-by-n block of A
+template< typename T >
+inline matrix<T> triu( const matrix<T>& A, std::size_t m, std::size_t n )
+{
+    matrix<T> U( m, n );
+    for(std::size_t j = 0; j < n; ++j)
+        for(std::size_t i = 0; i <= j && i < m; ++i)
+            U(i,j) = A(i,j);
+    return U;
+}
+
+/// Rows [i0,i1) of A
+template< typename T >
+inline matrix<T> row_block( const matrix<T>& A, std::size_t i0, std::size_t i1 )
+{
+    matrix<T> B( i1-i0, A.n );
+    for(std::size_t j = 0; j < A.n; ++j)
+        for(std::size_t i = i0; i < i1; ++i)
+            B(i-i0,j) = A(i,j);
+    return B;
+}
+
+/// C = op(A) op(B), computed with the naive triple loop
+template< typename T >
+inline matrix<T> ref_gemm(
+    blas::Op transA, blas::Op transB, const matrix<T>& A, const matrix<T>& B )
+{
+    using blas::Op;
+    using blas::conj;
+
+    auto opA = [&]( std::size_t i, std::size_t l ) {
+        return ( transA == Op::NoTrans ) ? A(i,l)
+             : ( transA == Op::Trans )   ? A(l,i) : T( conj( A(l,i) ) );
+    };
+    auto opB = [&]( std::size_t l, std::size_t j ) {
+        return ( transB == Op::NoTrans ) ? B(l,j)
+             : ( transB == Op::Trans )   ? B(j,l) : T( conj( B(j,l) ) );
+    };
+    const std::size_t m = ( transA == Op::NoTrans ) ? A.m : A.n;
+    const std::size_t k = ( transA == Op::NoTrans ) ? A.n : A.m;
+    const std::size_t n = ( transB == Op::NoTrans ) ? B.n : B.m;
+
+    matrix<T> C( m, n );
+    for(std::size_t j = 0; j < n; ++j)
+        for(std::size_t l = 0; l < k; ++l)
+            for(std::size_t i = 0; i < m; ++i)
+                C(i,j) += opA(i,l) * opB(l,j);
+    return C;
+}
+
+/// Frobenius norm of A
+template< typename T >
+inline real_type<T> norm( const matrix<T>& A )
+{
+    real_type<T> s( 0 );
+    for( const auto& a : A.data )
+        s += std::norm( std::complex< real_type<T> >( a ) );
+    return std::sqrt( s );
+}
+
+/// Frobenius norm of A - B
+template< typename T >
+inline real_type<T> norm_diff( const matrix<T>& A, const matrix<T>& B )
+{
+    real_type<T> s( 0 );
+    for(std::size_t i = 0; i < A.data.size(); ++i)
+        s += std::norm( std::complex< real_type<T> >( A.data[i] - B.data[i] ) );
+    return std::sqrt( s );
+}
+
+/// ||A - B|| / ||B||, or ||A - B|| if B is zero
+template< typename T >
+inline real_type<T> rel_diff( const matrix<T>& A, const matrix<T>& B )
+{
+    const real_type<T> nB = norm( B );
+    const real_type<T> d = norm_diff( A, B );
+    return ( nB > 0 ) ? d / nB : d;
+}
+
+/// ||Q^H Q - I|| for a matrix Q with orthonormal columns
+template< typename T >
+inline real_type<T> orthogonality( const matrix<T>& Q )
+{
+    matrix<T> QhQ = ref_gemm( blas::Op::ConjTrans, blas::Op::NoTrans, Q, Q );
+    return norm_diff( QhQ, eye<T>( Q.n, Q.n ) );
+}
+
+/// Tolerance for a computation of n terms: n times the machine epsilon
+template< typename T >
+inline real_type<T> tol( std::size_t n ) {
+    return real_type<T>( ( n > 0 ) ? n : 1 )
+        * std::numeric_limits< real_type<T> >::epsilon();
+}
+
+/// Name of a type, for the messages of the tests
+template< typename T > inline const char* type_name();
+template<> inline const char* type_name< float >() { return "float"; }
+template<> inline const char* type_name< double >() { return "double"; }
+template<> inline const char* type_name< std::complex<float> >() { return "complex<float>"; }
+template<> inline const char* type_name< std::complex<double> >() { return "complex<double>"; }
+
+} // namespace tlapack_test
+
+#endif // TLAPACK_TEST_UTILS_HH
@@ -0,0 +1,209 @@
+/// @file test_workspace_arena.cpp Tests the workspace arena of the slate_api.
+//
+// Copyright (c) 2021, University of Colorado Denver. All rights reserved.
+//
+// This file is part of <T>LAPACK.
+// <T>LAPACK is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "test_utils.hpp"
+#include <slate_api/lapack.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <thread>
+
+using namespace tlapack_test;
+using lapack::workspace_arena;
+
+//------------------------------------------------------------------------------
+/// True if p is aligned at TLAPACK_WORKSPACE_ALIGNMENT bytes
+inline bool aligned( const void* p ) {
+    return std::uintptr_t(p) % TLAPACK_WORKSPACE_ALIGNMENT == 0;
+}
+
+/// Fills x[0:n] with a pattern that depends on seed
+inline void fill( double* x, std::size_t n, double seed ) {
+    for(std::size_t i = 0; i < n; ++i)
+        x[i] = seed + double(i);
+}
+
+inline bool has_pattern( const double* x, std::size_t n, double seed ) {
+    for(std::size_t i = 0; i < n; ++i)
+        if( x[i] != seed + double(i) ) return false;
+    return true;
+}
+
+//------------------------------------------------------------------------------
+/// Workspaces of nested frames do not overlap, and are given back in order.
+/// Returns the pointers to the workspaces of each frame.
+void nested_frames( workspace_arena& arena, double* p[4] )
+{
+    workspace_arena::frame outer( arena );
+    p[0] = outer.allocate<double>( 100 );
+    fill( p[0], 100, 1 );
+    TLAPACK_CHECK( aligned( p[0] ) );
+    TLAPACK_CHECK( !arena.empty() );
+    {
+        workspace_arena::frame inner( arena );
+        p[1] = inner.allocate<double>( 50 );
+        fill( p[1], 50, 2 );
+        TLAPACK_CHECK( aligned( p[1] ) );
+        {
+            workspace_arena::frame innermost( arena );
+            p[2] = innermost.allocate<double>( 10 );
+            TLAPACK_CHECK( aligned( p[2] ) );
+        }
+        // The innermost workspace is given back and reused
+        TLAPACK_CHECK( inner.allocate<double>( 10 ) == p[2] );
+        TLAPACK_CHECK( has_pattern( p[1], 50, 2 ) );
+    }
+    // The inner workspaces are given back, the outer one is untouched
+    p[3] = outer.allocate<double>( 50 );
+    TLAPACK_CHECK( p[3] == p[1] );
+    TLAPACK_CHECK( has_pattern( p[0], 100, 1 ) );
+}
+
+void test_nested_frames()
+{
+    workspace_arena arena;
+    TLAPACK_CHECK( arena.empty() );
+    TLAPACK_CHECK( arena.capacity() == 0 );
+
+    // Warm-up: the arena grows while the frames are live
+    double* p[4];
+    nested_frames( arena, p );
+    TLAPACK_CHECK( arena.empty() );
+    TLAPACK_CHECK( arena.capacity() >= 160 * sizeof(double) );
+
+    // Afterwards, the same sequence of frames is served by the same memory
+    double* q[4];
+    nested_frames( arena, q );
+    const std::size_t cap = arena.capacity();
+    TLAPACK_CHECK( q[1] >= q[0] + 100 );
+    TLAPACK_CHECK( q[2] >= q[1] + 50 );
+    for(int rep = 0; rep < 2; ++rep) {
+        nested_frames( arena, p );
+        TLAPACK_CHECK( std::equal( p, p+4, q ) );
+        TLAPACK_CHECK( arena.capacity() == cap );
+    }
+
+    // Larger alignments are honored
+    {
+        workspace_arena::frame f( arena );
+        f.allocate<char>( 1 );
+        const void* c = f.allocate<char>( 1, 4*TLAPACK_WORKSPACE_ALIGNMENT );
+        TLAPACK_CHECK( std::uintptr_t(c) % (4*TLAPACK_WORKSPACE_ALIGNMENT) == 0 );
+    }
+}
+
+//------------------------------------------------------------------------------
+/// The arena grows by doubling while a frame is live, and merges its blocks
+/// the next time it is empty
+void test_growth_and_merge()
+{
+    workspace_arena arena;
+    const std::size_t n1 = 1000;
+    const std::size_t n2 = 5000;
+
+    double *p1, *p2;
+    std::size_t c1, c2;
+    {
+        workspace_arena::frame f( arena );
+        p1 = f.allocate<double>( n1 );
+        fill( p1, n1, 3 );
+        c1 = arena.capacity();
+        TLAPACK_CHECK( c1 >= n1 * sizeof(double) );
+
+        // Does not fit: a new block of at least twice the capacity
+        p2 = f.allocate<double>( n2 );
+        fill( p2, n2, 4 );
+        c2 = arena.capacity();
+        TLAPACK_CHECK( c2 >= c1 + std::max( 2*c1, n2 * sizeof(double) ) );
+        TLAPACK_CHECK( aligned( p2 ) );
+
+        // The first workspace is not moved
+        TLAPACK_CHECK( has_pattern( p1, n1, 3 ) );
+        TLAPACK_CHECK( has_pattern( p2, n2, 4 ) );
+    }
+    TLAPACK_CHECK( arena.empty() );
+
+    // The next frame works on a single block with the total capacity, so
+    // that both workspaces are contiguous and nothing else is allocated
+    for(int rep = 0; rep < 3; ++rep) {
+        workspace_arena::frame f( arena );
+        double* q1 = f.allocate<double>( n1 );
+        double* q2 = f.allocate<double>( n2 );
+        TLAPACK_CHECK( q2 >= q1 + n1 );
+        TLAPACK_CHECK( q2 <= q1 + n1 + TLAPACK_WORKSPACE_ALIGNMENT );
+        TLAPACK_CHECK( arena.capacity() == c2 );
+    }
+
+    // reserve() makes room for a workspace of the given size
+    arena.release();
+    TLAPACK_CHECK( arena.capacity() == 0 );
+    arena.reserve( n2 * sizeof(double) );
+    const std::size_t c3 = arena.capacity();
+    {
+        workspace_arena::frame f( arena );
+        f.allocate<double>( n2 );
+    }
+    TLAPACK_CHECK( arena.capacity() == c3 );
+}
+
+//------------------------------------------------------------------------------
+/// Each thread has its own default arena and its own current arena
+void test_set_workspace_arena_per_thread()
+{
+    workspace_arena& default_main = lapack::get_workspace_arena();
+    workspace_arena mine;
+    lapack::set_workspace_arena( &mine );
+    TLAPACK_CHECK( &lapack::get_workspace_arena() == &mine );
+
+    // The wrappers take their workspace from the current arena
+    const std::size_t m = 40, n = 30;
+    matrix<double> A = rand_matrix<double>( m, n );
+    std::vector<double> tau( n );
+    TLAPACK_CHECK( lapack::geqrf( m, n, A.data.data(), m, tau.data() ) == 0 );
+    TLAPACK_CHECK( mine.capacity() > 0 );
+    TLAPACK_CHECK( mine.empty() );
+
+    workspace_arena theirs;
+    const workspace_arena* seen_default = nullptr;
+    const workspace_arena* seen_set = nullptr;
+    std::size_t their_default_capacity = 0;
+    std::thread t( [&]() {
+        // Not affected by the arena of the main thread
+        workspace_arena& d = lapack::get_workspace_arena();
+        seen_default = &d;
+        matrix<double> B = rand_matrix<double>( m, n );
+        std::vector<double> tauB( n );
+        lapack::geqrf( m, n, B.data.data(), m, tauB.data() );
+        their_default_capacity = d.capacity();
+
+        lapack::set_workspace_arena( &theirs );
+        seen_set = &lapack::get_workspace_arena();
+        lapack::geqrf( m, n, B.data.data(), m, tauB.data() );
+    } );
+    t.join();
+
+    TLAPACK_CHECK( seen_default != &mine && seen_default != &default_main );
+    TLAPACK_CHECK( their_default_capacity > 0 );
+    TLAPACK_CHECK( seen_set == &theirs );
+    TLAPACK_CHECK( theirs.capacity() > 0 );
+
+    // The main thread still uses its own arena
+    TLAPACK_CHECK( &lapack::get_workspace_arena() == &mine );
+    lapack::set_workspace_arena( nullptr );
+    TLAPACK_CHECK( &lapack::get_workspace_arena() == &default_main );
+}
+
+//------------------------------------------------------------------------------
+int main()
+{
+    test_nested_frames();
+    test_growth_and_merge();
+    test_set_workspace_arena_per_thread();
+
+    return report( "test_workspace_arena" );
+}
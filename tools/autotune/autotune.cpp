@@ -0,0 +1,300 @@
+/// @file autotune.cpp Sweeps the block sizes of the blocked routines.
+//
+// Copyright (c) 2021, University of Colorado Denver. All rights reserved.
+//
+// This file is part of <T>LAPACK.
+// <T>LAPACK is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+//
+// Usage: tlapack_autotune [file [n_1 n_2 ...]]
+//
+// For each routine, scalar type and size n_i, times the routine on an
+// n_i-by-n_i matrix with every candidate block size and writes the fastest
+// one to file (default: tlapack_tuning.txt). The routines are geqrf, ungqr,
+// unmqr and potrf, and "level3", the block size of the blocked Level 3 BLAS,
+// which is timed on trsm and herk. The entry for n_i is used on
+// problems of size at least n_i, and the entry for the smallest size on all
+// the smaller problems.
+//
+// Set the environment variable TLAPACK_TUNING_FILE to the file to use it.
+
+#include <plugins/tlapack_mdspan.hpp>
+#include <slate_api/blas/mdspan.hpp>
+#include <tlapack.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <complex>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using blas::internal::colmajor_matrix;
+using idx_t = std::size_t;
+using pair  = std::pair<idx_t,idx_t>;
+
+/// Candidate block sizes
+const std::vector<idx_t> blocksizes = { 8, 16, 24, 32, 48, 64, 96, 128 };
+
+/// Number of runs of each routine. The fastest run is kept.
+const int nruns = 3;
+
+//------------------------------------------------------------------------------
+template< typename T >
+void fill_random( std::vector<T>& v, std::mt19937& gen )
+{
+    using real_t = blas::real_type<T>;
+    std::uniform_real_distribution<real_t> dist( -1, 1 );
+    for( auto& x : v )
+        x = T( dist(gen) );
+}
+
+template< typename T >
+void fill_random( std::vector< std::complex<T> >& v, std::mt19937& gen )
+{
+    std::uniform_real_distribution<T> dist( -1, 1 );
+    for( auto& x : v )
+        x = std::complex<T>( dist(gen), dist(gen) );
+}
+
+/// Time in seconds of the fastest of nruns calls to f, after setup
+template< typename setup_t, typename f_t >
+double best_time( setup_t&& setup, f_t&& f )
+{
+    double best = 0;
+    for( int r = 0; r < nruns; ++r ) {
+        setup();
+        auto start = std::chrono::high_resolution_clock::now();
+        f();
+        auto end = std::chrono::high_resolution_clock::now();
+        const double t = std::chrono::duration<double>( end - start ).count();
+        if( r == 0 || t < best )
+            best = t;
+    }
+    return best;
+}
+
+/// Random Hermitian positive definite n-by-n matrix
+template< typename T >
+void fill_hpd( std::vector<T>& v, idx_t n, std::mt19937& gen )
+{
+    using blas::conj;
+    fill_random( v, gen );
+    for( idx_t j = 0; j < n; ++j ) {
+        for( idx_t i = 0; i < j; ++i )
+            v[ i + j*n ] = conj( v[ j + i*n ] );
+        v[ j + j*n ] = T( std::real( v[ j + j*n ] ) + n );
+    }
+}
+
+/// Registers nb for the routine on problems of size at least nmin, and
+/// prints it
+void register_blocksize(
+    const char* routine, char t, idx_t n, idx_t nmin, idx_t nb, double time )
+{
+    lapack::set_blocksize( routine, t, nmin, nmin, nmin, nb );
+    std::cout << routine << " " << t << " n = " << n
+              << ": nb = " << nb
+              << " (" << time * 1.0e3 << " ms)" << std::endl;
+}
+
+//------------------------------------------------------------------------------
+/// Tunes the blocked Level 3 BLAS for the type T on n-by-n matrices, with
+/// the sum of the times of trsm and herk.
+/// Registers the best block size for problems of size at least nmin.
+template< typename T >
+void tune_level3( idx_t n, idx_t nmin, std::mt19937& gen )
+{
+    using real_t = blas::real_type<T>;
+    const char t = lapack::tuning_type<T>();
+
+    std::vector<T> A( n*n ), B0( n*n ), B( n*n ), C0( n*n ), C( n*n );
+    fill_hpd( A, n, gen );
+    fill_random( B0, gen );
+    fill_hpd( C0, n, gen );
+
+    auto _A = colmajor_matrix<T>( A.data(), n, n );
+    auto _B = colmajor_matrix<T>( B.data(), n, n );
+    auto _C = colmajor_matrix<T>( C.data(), n, n );
+
+    idx_t best_nb = 0;
+    double best_t = -1;
+    for( idx_t nb : blocksizes ) {
+        if( nb > n ) break;
+
+        // trsm and herk read the block size from the registry. The entry
+        // for nmin is the one they use on size n.
+        lapack::set_blocksize( "level3", t, nmin, nmin, nmin, nb );
+
+        const double time = best_time(
+            [&]() { B = B0; },
+            [&]() {
+                blas::trsm(
+                    blas::Side::Left, blas::Uplo::Lower, blas::Op::NoTrans,
+                    blas::Diag::NonUnit, T( 1 ), _A, _B );
+            } )
+        + best_time(
+            [&]() { C = C0; },
+            [&]() {
+                blas::herk(
+                    blas::Uplo::Lower, blas::Op::NoTrans,
+                    real_t( -1 ), _A, real_t( 1 ), _C );
+            } );
+
+        if( best_t < 0 || time < best_t ) {
+            best_t  = time;
+            best_nb = nb;
+        }
+    }
+
+    register_blocksize( "level3", t, n, nmin, best_nb, best_t );
+}
+
+//------------------------------------------------------------------------------
+/// Tunes potrf for the type T on n-by-n matrices.
+/// Registers the best block size for problems of size at least nmin.
+template< typename T >
+void tune_potrf( idx_t n, idx_t nmin, std::mt19937& gen )
+{
+    const char t = lapack::tuning_type<T>();
+
+    std::vector<T> A0( n*n ), A( n*n );
+    fill_hpd( A0, n, gen );
+
+    auto _A = colmajor_matrix<T>( A.data(), n, n );
+
+    idx_t best_nb = 0;
+    double best_t = -1;
+    for( idx_t nb : blocksizes ) {
+        if( nb > n ) break;
+
+        const double time = best_time(
+            [&]() { A = A0; },
+            [&]() { lapack::potrf( lapack::lower_triangle, _A, nb ); } );
+
+        if( best_t < 0 || time < best_t ) {
+            best_t  = time;
+            best_nb = nb;
+        }
+    }
+
+    register_blocksize( "potrf", t, n, nmin, best_nb, best_t );
+}
+
+//------------------------------------------------------------------------------
+/// Tunes geqrf, ungqr and unmqr for the type T on n-by-n matrices.
+/// Registers the best block sizes for problems of size at least nmin.
+template< typename T >
+void tune_qr( idx_t n, idx_t nmin, std::mt19937& gen )
+{
+    const char t = lapack::tuning_type<T>();
+    const idx_t nbmax = blocksizes.back();
+
+    std::vector<T> A0( n*n ), A( n*n ), Q( n*n ), C0( n*n ), C( n*n );
+    std::vector<T> tau( n ), work( nbmax*(n+nbmax) );
+    fill_random( A0, gen );
+    fill_random( C0, gen );
+
+    auto _A   = colmajor_matrix<T>( A.data(), n, n );
+    auto _Q   = colmajor_matrix<T>( Q.data(), n, n );
+    auto _C   = colmajor_matrix<T>( C.data(), n, n );
+    auto _tau = blas::internal::vector<T>( tau.data(), n, 1 );
+
+    // Reflectors used by ungqr and unmqr
+    {
+        A = A0;
+        auto W = colmajor_matrix<T>( work.data(), 1, n );
+        lapack::geqrf( _A, _tau, W );
+    }
+
+    idx_t best_nb[3];
+    double best_t[3];
+    for( int r = 0; r < 3; ++r )
+        best_t[r] = -1;
+
+    for( idx_t nb : blocksizes ) {
+        if( nb > n ) break;
+        double times[3];
+
+        times[0] = best_time(
+            [&]() { Q = A0; },
+            [&]() {
+                auto W = colmajor_matrix<T>( work.data(), nb, n );
+                lapack::geqrf( _Q, _tau, W );
+            } );
+
+        // geqrf overwrote tau with the reflectors of A0
+        times[1] = best_time(
+            [&]() { Q = A; },
+            [&]() {
+                auto W = colmajor_matrix<T>( work.data(), nb, n );
+                lapack::ungqr( n, _Q, _tau, W );
+            } );
+
+        times[2] = best_time(
+            [&]() { C = C0; },
+            [&]() {
+                auto W = colmajor_matrix<T>( work.data(), nb, n+nb );
+                lapack::unmqr(
+                    lapack::left_side, lapack::conjTranspose,
+                    _A, _tau, _C, W );
+            } );
+
+        for( int r = 0; r < 3; ++r ) {
+            if( best_t[r] < 0 || times[r] < best_t[r] ) {
+                best_t[r]  = times[r];
+                best_nb[r] = nb;
+            }
+        }
+    }
+
+    const char* routines[] = { "geqrf", "ungqr", "unmqr" };
+    for( int r = 0; r < 3; ++r )
+        register_blocksize( routines[r], t, n, nmin, best_nb[r], best_t[r] );
+}
+
+//------------------------------------------------------------------------------
+/// Tunes all the routines for the type T. The Level 3 BLAS come first,
+/// since the other routines call them.
+template< typename T >
+void tune( idx_t n, idx_t nmin, std::mt19937& gen )
+{
+    tune_level3<T>( n, nmin, gen );
+    tune_potrf<T>( n, nmin, gen );
+    tune_qr<T>( n, nmin, gen );
+}
+
+//------------------------------------------------------------------------------
+int main( int argc, char** argv )
+{
+    const char* file = ( argc < 2 ) ? "tlapack_tuning.txt" : argv[1];
+
+    std::vector<idx_t> sizes;
+    for( int i = 2; i < argc; ++i )
+        sizes.push_back( std::strtoul( argv[i], nullptr, 10 ) );
+    if( sizes.empty() )
+        sizes = { 128, 512, 1024 };
+    std::sort( sizes.begin(), sizes.end() );
+
+    std::mt19937 gen( 3 );
+
+    // Start from the compile-time defaults
+    lapack::clear_tuning();
+
+    for( idx_t i = 0; i < sizes.size(); ++i ) {
+        const idx_t nmin = ( i == 0 ) ? 0 : sizes[i];
+        tune< float  >( sizes[i], nmin, gen );
+        tune< double >( sizes[i], nmin, gen );
+        tune< std::complex<float>  >( sizes[i], nmin, gen );
+        tune< std::complex<double> >( sizes[i], nmin, gen );
+    }
+
+    if( !lapack::save_tuning_file( file ) ) {
+        std::cerr << "Could not write " << file << std::endl;
+        return 1;
+    }
+    std::cout << "Block sizes written to " << file << std::endl;
+
+    return 0;
+}